@@ -0,0 +1,11 @@
+set "OutputDir=%1"
+set "Configuration=%2"
+set "Platform=%3"
+
+rem Debugging
+rem echo %OutputDir% > log.txt
+rem echo %OutputDir%..\..\..\..\3rdParty\DLL >> log.txt
+
+cd %OutputDir%
+
+(robocopy ..\..\..\..\Celeste\bin\%Platform%\%Configuration%\ .\ /E /IS /IT /XO) & exit 0
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "Resources/2D/AtlasBuilder.h"
+#include "FileSystem/Directory.h"
+#include "Debug/Assert.h"
+#include "Debug/Asserting/NullAsserter.h"
+
+#include <iostream>
+
+using namespace Celeste;
+using namespace Celeste::Resources;
+
+int main(int argc, char** argv)
+{
+  Assertion::setAsserter(new NullAsserter());
+
+  if (argc < 4)
+  {
+    std::cout << "Usage: AtlasPacker <image directory> <output directory> <atlas name> [max dimension]" << std::endl;
+    return -1;
+  }
+
+  Path pathToImageDirectory(argv[1]);
+  Path pathToOutputDirectory(argv[2]);
+  std::string atlasName(argv[3]);
+  uint32_t maxDimension = argc > 4 ? static_cast<uint32_t>(std::stoul(argv[4])) : 4096;
+
+  std::cout << "Using image directory " << pathToImageDirectory.c_str() << std::endl;
+
+  // Not recursive, as regions are named after their file and names have to be unique
+  std::vector<File> files;
+  Directory(pathToImageDirectory).findFiles(files, ".png", false);
+
+  std::cout << std::to_string(files.size()) << " png files found" << std::endl;
+
+  AtlasBuilder builder;
+
+  int errorFileCount = 0;
+  for (const File& file : files)
+  {
+    if (!builder.addImage(file.getExtensionlessFileName(), file.getFilePath()))
+    {
+      ++errorFileCount;
+      std::cout << file.getFilePath().c_str() << ": Failed" << std::endl;
+    }
+  }
+
+  if (!builder.build(maxDimension))
+  {
+    std::cout << "Images do not fit in a " << maxDimension << "x" << maxDimension << " atlas" << std::endl;
+    return -1;
+  }
+
+  if (!builder.save(pathToOutputDirectory, atlasName))
+  {
+    std::cout << "Failed to save " << atlasName << " to " << pathToOutputDirectory.c_str() << std::endl;
+    return -1;
+  }
+
+  std::cout << "Packed " << builder.getRegions().size() << " images into a " << builder.getWidth() << "x" << builder.getHeight() << " atlas" << std::endl;
+
+  return errorFileCount;
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Memory/Iterators/ResizeableAllocatorIterator.h"
 #include "Memory/Allocators/ResizeableAllocator.h"
+#include "Memory/Allocators/DenseAllocator.h"
 
 
 namespace Celeste::Algorithm
@@ -23,4 +24,22 @@ namespace Celeste::Algorithm
       obj.update(elapsedGameTime);
     }
   }
+
+  template <typename T>
+  inline void update(DenseAllocator<T>& allocator)
+  {
+    for (T& obj : allocator)
+    {
+      obj.update();
+    }
+  }
+
+  template <typename T>
+  inline void update(DenseAllocator<T>& allocator, float elapsedGameTime)
+  {
+    for (T& obj : allocator)
+    {
+      obj.update(elapsedGameTime);
+    }
+  }
 }
\ No newline at end of file
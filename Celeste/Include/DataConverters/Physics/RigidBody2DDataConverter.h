@@ -23,6 +23,7 @@ namespace Celeste
       inline float getAngularVelocity() const { return m_angularVelocity.getValue(); }
       inline float getMinAngularVelocity() const { return m_minAngularVelocity.getValue(); }
       inline float getMaxAngularVelocity() const { return m_maxAngularVelocity.getValue(); }
+      inline bool isBullet() const { return m_bullet.getValue(); }
 
       CelesteDllExport static const char* const LINEAR_VELOCITY_ATTRIBUTE_NAME;
       CelesteDllExport static const char* const MIN_LINEAR_VELOCITY_ATTRIBUTE_NAME;
@@ -30,6 +31,7 @@ namespace Celeste
       CelesteDllExport static const char* const ANGULAR_VELOCITY_ATTRIBUTE_NAME;
       CelesteDllExport static const char* const MIN_ANGULAR_VELOCITY_ATTRIBUTE_NAME;
       CelesteDllExport static const char* const MAX_ANGULAR_VELOCITY_ATTRIBUTE_NAME;
+      CelesteDllExport static const char* const BULLET_ATTRIBUTE_NAME;
 
     private:
       using Inherited = ComponentDataConverter;
@@ -40,5 +42,6 @@ namespace Celeste
       XML::ValueAttribute<float>& m_angularVelocity;
       XML::ValueAttribute<float>& m_minAngularVelocity;
       XML::ValueAttribute<float>& m_maxAngularVelocity;
+      XML::ValueAttribute<bool>& m_bullet;
   };
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "XML/ChildXMLElementWalker.h"
 #include "DataConverters/Objects/GameObjectDataConverter.h"
 #include "DataConverters/Resources/PrefabDataConverter.h"
+#include "Memory/AllocatorRegistry.h"
 
 
 namespace Celeste
@@ -16,12 +17,29 @@ namespace Celeste
       using GameObjectDataConverters = typename XML::DataConverterListElement<GameObjectDataConverter>::Items;
 
     public:
+      using CapacityHints = AllocatorRegistry::CapacityHints;
+
       CelesteDllExport SceneDataConverter(const std::string& elementName = SCENE_ELEMENT_NAME);
       SceneDataConverter(const SceneDataConverter&) = delete;
       SceneDataConverter& operator=(const SceneDataConverter&) = delete;
 
+      /// \brief Reserves space in the object allocators for everything in the scene, then creates its game objects
       CelesteDllExport std::vector<GameObject*> instantiate() const;
 
+      /// \brief Returns how many of each object type instantiating this scene will create, keyed by allocator name
+      /// This is computed by counting the game objects, components and prefab contents in the scene,
+      /// raised to any capacity declared in the scene's Capacities element or added with addCapacityHint,
+      /// then added to by anything added with addRuntimeCapacity
+      CelesteDllExport CapacityHints getCapacityHints() const;
+
+      /// \brief Declares that at least count objects of the inputted type will be needed when this scene is instantiated
+      /// This is a minimum for the whole scene, so it only changes anything if it is more than the scene contains
+      CelesteDllExport void addCapacityHint(const std::string& typeName, size_t count);
+
+      /// \brief Declares that count objects of the inputted type will be created at runtime, on top of those in the scene
+      /// Use for objects which cannot be counted from the scene file, such as spawned enemies or projectiles
+      CelesteDllExport void addRuntimeCapacity(const std::string& typeName, size_t count);
+
       inline const std::vector<std::string>& getPreloadableFonts() const { return m_fonts.getChildren(); }
       inline const std::vector<std::string>& getPreloadableVertexShaders() const { return m_vertexShaders.getChildren(); }
       inline const std::vector<std::string>& getPreloadableFragmentShaders() const { return m_fragmentShaders.getChildren(); }
@@ -43,6 +61,10 @@ namespace Celeste
       CelesteDllExport static const char* const PRELOADABLE_SOUND_ELEMENT_NAME;
       CelesteDllExport static const char* const PRELOADABLE_TEXTURES_ELEMENT_NAME;
       CelesteDllExport static const char* const PRELOADABLE_TEXTURE_ELEMENT_NAME;
+      CelesteDllExport static const char* const CAPACITIES_ELEMENT_NAME;
+      CelesteDllExport static const char* const CAPACITY_ELEMENT_NAME;
+      CelesteDllExport static const char* const CAPACITY_TYPE_ATTRIBUTE_NAME;
+      CelesteDllExport static const char* const CAPACITY_COUNT_ATTRIBUTE_NAME;
 
     protected:
       CelesteDllExport bool doConvertFromXML(const tinyxml2::XMLElement* element) override;
@@ -51,6 +73,7 @@ namespace Celeste
       using Inherited = DataConverter;
 
       bool tryConvertResources(const tinyxml2::XMLElement* screenElement);
+      bool tryConvertCapacities(const tinyxml2::XMLElement* screenElement);
 
       XML::ListElement<std::string>& m_fonts;
       XML::ListElement<std::string>& m_vertexShaders;
@@ -59,5 +82,7 @@ namespace Celeste
       XML::ListElement<std::string>& m_sounds;
       XML::ListElement<std::string>& m_textures;
       XML::DataConverterListElement<GameObjectDataConverter>& m_gameObjects;
+      CapacityHints m_declaredCapacities;
+      CapacityHints m_runtimeCapacities;
   };
 }
\ No newline at end of file
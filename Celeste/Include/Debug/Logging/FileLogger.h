@@ -1,10 +1,12 @@
 #pragma once
 
 #include "CelesteDllExport.h"
-#include "Memory/Allocators/DoubleBufferAllocator.h"
+#include "Memory/Allocators/ConcurrentDoubleBufferAllocator.h"
 #include "FileSystem/File.h"
 #include "Log/ILogger.h"
 
+#include <mutex>
+
 
 namespace Celeste::Log
 {
@@ -19,6 +21,8 @@ namespace Celeste::Log
   // Also writes to a file when it's buffer becomes too large
   // Any messages in the front buffer of the log are considered 'untouchable'
   // If you wish to obtain them, call flush() and then call getLog() or read from the log file
+  // Messages can be logged from any thread - they are copied into the front buffer without taking a lock
+  // Only swapping the buffers and writing to the file (flush, clear or when the front buffer fills up) is serialised
   class FileLogger : public ILogger
   {
     public:
@@ -32,7 +36,7 @@ namespace Celeste::Log
       /// Use the FUNCTION, FILENAME and LINE macros for the last three parameters
       CelesteDllExport void log(const std::string& message, Verbosity verbosity, const char* function, const char* file, int line) override;
 
-      /// \brief Returns the string in the back log buffer
+      /// \brief Returns the messages which were written to the file by the most recent flush
       CelesteDllExport const std::string& getLog();
 
       /// \brief Swaps the front log buffer with the back log buffer and writes the new back log buffer contents to the file
@@ -51,10 +55,13 @@ namespace Celeste::Log
       /// \brief Obtain a string we will use to build our error logging based on the inputted verbosity
       static const char* getVerbosityString(Verbosity verbosity);
       
+      /// \brief Swaps the log buffers and writes the contents of the old front buffer to the file
+      /// The flush lock must be held when calling this
       void writeLogBackBufferToFile();
 
       // The memory we will write to and use to write to the log file
-      DoubleBufferAllocator<char, LOGGER_BUFFER_SIZE> m_logBuffer;
+      ConcurrentDoubleBufferAllocator<char, LOGGER_BUFFER_SIZE> m_logBuffer;
+      std::mutex m_flushLock;
 
       File m_logFile;
       std::string m_backLogBufferStr;
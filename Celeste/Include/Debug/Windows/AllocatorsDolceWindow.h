@@ -0,0 +1,20 @@
+#pragma once
+
+#if _DEBUG
+
+#include "Dolce/DolceWindow.h"
+
+
+namespace Celeste::Debug
+{
+  class AllocatorsDolceWindow : public Dolce::DolceWindow
+  {
+    public:
+      AllocatorsDolceWindow();
+      ~AllocatorsDolceWindow() override = default;
+
+      void render() override;
+  };
+}
+
+#endif
@@ -3,6 +3,8 @@
 #include "Resources/ResourceManager.h"
 #include "Viewport/OpenGLWindow.h"
 #include "Time/Clock.h"
+#include "Memory/Allocators/FrameAllocator.h"
+#include "Threads/JobSystem.h"
 #include "CelesteStl/Memory/ObserverPtr.h"
 #include "System/ISystemContainer.h"
 #include "System/ISystem.h"
@@ -10,6 +12,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 
 namespace Dolce
@@ -17,6 +20,11 @@ namespace Dolce
   class IDolce;
 }
 
+namespace Celeste::Input
+{
+  class InputRecorder;
+}
+
 namespace Celeste
 {
   /// Grouper class for all of the game managers
@@ -43,6 +51,15 @@ namespace Celeste
 
       /// Returns true if run() has been called on the game and false if exit() has been called.
       inline bool isRunning() const { return m_running; }
+
+      /// \brief Records the input, frame times and a transform checksum for every physics tick while the game runs
+      /// Pass nullptr to stop recording.  The recorder must outlive the recording.
+      void setInputRecorder(observer_ptr<Input::InputRecorder> inputRecorder) { m_inputRecorder = inputRecorder; }
+
+      /// \brief Plays the recorded frames back without polling the window or rendering, as fast as they can be simulated
+      /// The game should be in the state it was in when recording started, with the same fixed time step and physics settings.
+      /// The transform checksum after every physics tick is appended to tickChecksums, ready to compare with the recording's.
+      CelesteDllExport void replay(const Input::InputRecorder& recording, std::vector<uint64_t>& tickChecksums);
       
       CelesteDllExport static Game& current();
 
@@ -62,6 +79,8 @@ namespace Celeste
       CelesteDllExport ResourceManager& getResourceManager();
       CelesteDllExport OpenGLWindow& getWindow();
       CelesteDllExport Clock& getClock();
+      CelesteDllExport FrameAllocator& getFrameAllocator();
+      CelesteDllExport JobSystem& getJobSystem();
 
     protected:
       virtual void onInitialize() { }
@@ -79,6 +98,7 @@ namespace Celeste
       void deregisterSystems();
       void initialize();
       void update(GLfloat elapsedGameTime);
+      void fixedUpdate(GLfloat fixedTimeStep);
       void render(GLfloat lag);
 
       void applySettings() const;
@@ -96,9 +116,12 @@ namespace Celeste
       ResourceManager m_resourceManager;
       OpenGLWindow m_window;
       Clock m_clock;
+      FrameAllocator m_frameAllocator;
+      JobSystem m_jobSystem;
       Systems m_systems;
 
       bool m_running = false;
+      observer_ptr<Input::InputRecorder> m_inputRecorder = nullptr;
   };
 
 
@@ -4,11 +4,19 @@
 #include "Mouse.h"
 #include "Input/InputUtils.h"
 #include "System/ISystem.h"
+#include "Memory/Allocators/FrameAllocator.h"
+#include "CelesteStl/Memory/ObserverPtr.h"
 
 #include <memory.h>
+#include <vector>
 
 struct GLFWwindow;
 
+namespace Celeste
+{
+  class GameObject;
+}
+
 
 namespace Celeste::Input
 {
@@ -27,16 +35,27 @@ namespace Celeste::Input
       inline Mouse& getMouse() { return m_mouse; }
       inline const Mouse& getMouse() const { return m_mouse; }
 
+      /// \brief Whilst replaying, the mouse is left where the replay puts it rather than following the cursor
+      inline bool isReplaying() const { return m_replaying; }
+      inline void setReplaying(bool replaying) { m_replaying = replaying; }
+
       CelesteDllExport void update(float elapsedGameTime) override;
 
     private:
       using Inherited = System::ISystem;
 
       void updateMousePosition();
-      void raycast() const;
+      void raycast();
 
       Keyboard m_keyboard;
       Mouse m_mouse;
+      bool m_replaying = false;
+
+      /// \brief Reused by every raycaster each frame, so raycasting does not allocate once it has grown
+      std::vector<observer_ptr<GameObject>> m_raycastHits;
+
+      /// \brief Scratch space for raycast, reset at the start of every one
+      FrameAllocator m_frameAllocator;
   };
 
   //------------------------------------------------------------------------------------------------
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CelesteDllExport.h"
+#include "Keyboard.h"
+#include "InputEnums.h"
+#include "Utils/BitUtils.h"
+#include "glm/glm.hpp"
+
+#include <vector>
+
+
+namespace Celeste
+{
+  class Path;
+}
+
+namespace Celeste::Input
+{
+  class Mouse;
+
+  /// The keyboard and mouse state seen during one frame of a recording, along with how far the game moved on that frame
+  struct InputFrame
+  {
+    float m_elapsedGameTime = 0;
+    uint32_t m_fixedStepCount = 0;
+    uint32_t m_mouseButtons = 0;
+    glm::vec2 m_mousePosition = glm::vec2();
+    uint64_t m_keys[wordCount(KEYBOARD_KEY_COUNT)] = {};
+  };
+
+  /// Captures the keyboard and mouse every frame so that a run can be replayed exactly, without a window, at full speed
+  /// Frames also store the elapsed time and the number of fixed physics steps taken, so a replay advances the game
+  /// by exactly what the recorded run did, however long its frames took.
+  class InputRecorder
+  {
+    public:
+      CelesteDllExport InputRecorder();
+
+      /// \brief Appends the current state of the inputted keyboard and mouse as the next frame
+      /// Call once per frame, after input has been updated
+      CelesteDllExport void record(const Keyboard& keyboard, const Mouse& mouse, float elapsedGameTime, size_t fixedStepCount);
+
+      /// \brief Buffers the state recorded for the inputted frame into the keyboard and mouse, ready for their next update
+      /// Only keys and buttons which differ from their current state are changed, so events fire just as they did when recording
+      CelesteDllExport void apply(size_t frameIndex, Keyboard& keyboard, Mouse& mouse) const;
+
+      /// \brief Appends a checksum of the game state after a fixed step, such as checksumTransforms()
+      void recordTick(uint64_t checksum) { m_tickChecksums.push_back(checksum); }
+
+      /// \brief Returns the first tick whose recorded checksum differs from the inputted one, or the number of ticks compared if none do
+      /// Replaying with the same checksums finds the exact step where a run diverged from its recording.
+      CelesteDllExport size_t findDivergence(const std::vector<uint64_t>& tickChecksums) const;
+
+      size_t getFrameCount() const { return m_frames.size(); }
+      const InputFrame& getFrame(size_t frameIndex) const { return m_frames[frameIndex]; }
+
+      size_t getTickCount() const { return m_tickChecksums.size(); }
+      uint64_t getTickChecksum(size_t tickIndex) const { return m_tickChecksums[tickIndex]; }
+
+      void clear() { m_frames.clear(); m_tickChecksums.clear(); }
+
+      /// \brief Writes every frame and tick checksum to the inputted file, returning false if it could not be written
+      CelesteDllExport bool save(const Path& path) const;
+
+      /// \brief Replaces the frames and checksums with those in the inputted file, returning false and leaving them empty if it could not be read
+      CelesteDllExport bool load(const Path& path);
+
+    private:
+      std::vector<InputFrame> m_frames;
+      std::vector<uint64_t> m_tickChecksums;
+  };
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Objects/Component.h"
 
 #include <deque>
+#include <vector>
 
 
 namespace Celeste::Rendering
@@ -17,8 +18,13 @@ namespace Celeste::Input
     DECLARE_MANAGED_COMPONENT(PhysicsRaycaster, InputManager, CelesteDllExport);
 
     public:
+      /// \brief Returns the game objects under the mouse, in descending z order
       CelesteDllExport std::vector<observer_ptr<GameObject>> raycast();
 
+      /// \brief Fills hitGameObjects with the game objects under the mouse, in descending z order
+      /// It is cleared first, so the same vector can be passed in every frame without reallocating
+      CelesteDllExport void raycast(std::vector<observer_ptr<GameObject>>& hitGameObjects);
+
     private:
       using Inherited = Component;
   
@@ -11,7 +11,8 @@ namespace Celeste::Layout
 
   class ResolutionScaler : public Component
   {
-    DECLARE_MANAGED_COMPONENT(ResolutionScaler, LayoutSystem, CelesteDllExport);
+    // Packed densely, as the layout system sweeps through every scaler each frame - hold handles to them rather than pointers
+    DECLARE_MANAGED_COMPONENT_WITH_ALLOCATOR(ResolutionScaler, LayoutSystem, Celeste::DenseAllocator, CelesteDllExport);
 
     public:
       bool needsRescale() const { return m_needsRescale; }
@@ -116,4 +116,8 @@ namespace Celeste
 
       friend class GameObject;
   };
+
+  /// \brief Hashes the local translation, rotation and scale of every live transform, in allocation order
+  /// Two runs which have simulated identically give the same value, so comparing this every tick finds the first tick a replay diverged
+  CelesteDllExport uint64_t checksumTransforms();
 }
\ No newline at end of file
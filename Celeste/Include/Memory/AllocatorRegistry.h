@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CelesteDllExport.h"
+#include "Memory/Allocators/AllocatorStats.h"
+#include "FileSystem/Path.h"
+
+#include <functional>
+#include <vector>
+#include <unordered_map>
+
+
+namespace Celeste
+{
+  /// \brief A process wide list of every object allocator declared with CUSTOM_MEMORY_CREATION
+  /// Allocators register themselves during static initialisation, so this can be queried at any time
+  class AllocatorRegistry
+  {
+    public:
+      using StatsFunction = std::function<AllocatorStats()>;
+      using ReserveFunction = std::function<void(size_t)>;
+
+      /// \brief A number of additional objects expected to be allocated, keyed by allocator name
+      using CapacityHints = std::unordered_map<std::string, size_t>;
+
+      /// \brief Adds an allocator under the inputted name, replacing any allocator already registered with that name
+      /// Returns true if the name was not already registered
+      CelesteDllExport static bool registerAllocator(const std::string& name, const StatsFunction& getStats, const ReserveFunction& reserve = ReserveFunction());
+      CelesteDllExport static bool deregisterAllocator(const std::string& name);
+
+      CelesteDllExport static bool isRegistered(const std::string& name);
+      CelesteDllExport static size_t getAllocatorCount();
+
+      /// \brief Returns the current stats for the allocator with the inputted name
+      /// If no allocator is registered with that name, empty stats are returned with an empty name
+      CelesteDllExport static AllocatorStats getStats(const std::string& name);
+
+      /// \brief Returns the current stats for every registered allocator, ordered by name
+      CelesteDllExport static std::vector<AllocatorStats> getAllStats();
+
+      /// \brief Ensures the allocator with the inputted name can hold at least capacity objects in total without growing
+      /// Returns false if no allocator is registered with that name or it does not support reserving
+      CelesteDllExport static bool reserve(const std::string& name, size_t capacity);
+
+      /// \brief For every hint, reserves enough space in the named allocator for that many more objects on top of those already alive
+      /// Hints for names with no registered allocator are ignored
+      CelesteDllExport static void prewarm(const CapacityHints& capacityHints);
+
+      /// \brief Writes a table of the stats for every registered allocator to the inputted file, overwriting it
+      CelesteDllExport static void dump(const Path& path);
+  };
+}
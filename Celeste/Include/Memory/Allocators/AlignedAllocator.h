@@ -2,6 +2,11 @@
 
 #include "CelesteDllExport.h"
 
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <new>
+
 
 namespace Celeste
 {
@@ -9,14 +14,96 @@ namespace Celeste
 class CelesteDllExport AlignedAllocator
 {
   public:
+    /// \brief The alignment needed for aligned AVX loads and stores
+    static constexpr size_t SIMD_ALIGNMENT = 32;
+
+    /// \brief The alignment needed to start an allocation on a cache line boundary
+    static constexpr size_t CACHE_LINE_ALIGNMENT = 64;
+
     AlignedAllocator();
     ~AlignedAllocator();
 
-    // Have templated version too?
     void* allocateUnaligned(size_t numberOfBytes) const;
+    void freeUnaligned(void* memory) const;
 
     /// \brief Alignment must be a power of 2
+    /// Memory returned from here must be released with freeAligned
     void* allocateAligned(size_t numberOfBytes, size_t alignment) const;
+
+    /// \brief Releases memory returned from allocateAligned
+    /// In debug builds, freeing memory which is not currently allocated (e.g. a double free) will assert
+    void freeAligned(void* memory) const;
+
+    /// \brief Typed version of allocateAligned which allocates room for count objects of type T, but does not construct them
+    /// Returns nullptr if count * sizeof(T) does not fit in a size_t
+    template <typename T>
+    T* allocateAligned(size_t count, size_t alignment = SIMD_ALIGNMENT) const
+    {
+      if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+      {
+        return nullptr;
+      }
+
+      return static_cast<T*>(allocateAligned(count * sizeof(T), std::max(alignment, alignof(T))));
+    }
+
+    /// \brief The number of aligned allocations which have not yet been freed
+    /// Only tracked in debug builds - always returns 0 in release
+    static size_t getLiveAllocationCount();
 };
 
-};
\ No newline at end of file
+/// An STL-compatible adaptor which allocates from the AlignedAllocator
+/// Use this to guarantee aligned SIMD loads on container storage e.g. AlignedVector<glm::mat4>
+template <typename T, size_t Alignment = AlignedAllocator::SIMD_ALIGNMENT>
+class AlignedStlAllocator
+{
+  public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+      using other = AlignedStlAllocator<U, Alignment>;
+    };
+
+    AlignedStlAllocator() = default;
+
+    template <typename U>
+    AlignedStlAllocator(const AlignedStlAllocator<U, Alignment>&) { }
+
+    /// \brief Containers expect a failed allocation to throw rather than return nullptr
+    T* allocate(size_t count)
+    {
+      if (count > max_size())
+      {
+        throw std::bad_alloc();
+      }
+
+      T* memory = AlignedAllocator().allocateAligned<T>(count, Alignment);
+      if (memory == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+
+      return memory;
+    }
+
+    void deallocate(T* memory, size_t) { AlignedAllocator().freeAligned(memory); }
+
+    /// \brief The most objects which can be asked for without the size in bytes, plus room to align it, overflowing
+    size_t max_size() const
+    {
+      return (std::numeric_limits<size_t>::max() - std::max({ Alignment, alignof(T), sizeof(size_t) })) / sizeof(T);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedStlAllocator<U, Alignment>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedStlAllocator<U, Alignment>&) const { return false; }
+};
+
+template <typename T, size_t Alignment = AlignedAllocator::SIMD_ALIGNMENT>
+using AlignedVector = std::vector<T, AlignedStlAllocator<T, Alignment>>;
+
+};
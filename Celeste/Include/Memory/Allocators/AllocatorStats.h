@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <algorithm>
+
+
+// Timing allocations reads the clock twice inside every allocate, so it is left out of release builds unless asked for
+#ifndef CELESTE_ALLOCATOR_TIMING
+#if _DEBUG
+#define CELESTE_ALLOCATOR_TIMING 1
+#else
+#define CELESTE_ALLOCATOR_TIMING 0
+#endif
+#endif
+
+
+namespace Celeste
+{
+  /// \brief Measures how long a call to allocate takes when CELESTE_ALLOCATOR_TIMING is enabled, and compiles away otherwise
+  class AllocationTimer
+  {
+    public:
+#if CELESTE_ALLOCATOR_TIMING
+      AllocationTimer() : m_start(std::chrono::steady_clock::now()) { }
+
+      std::chrono::steady_clock::duration elapsed() const { return std::chrono::steady_clock::now() - m_start; }
+
+    private:
+      std::chrono::steady_clock::time_point m_start;
+#else
+      std::chrono::steady_clock::duration elapsed() const { return std::chrono::steady_clock::duration::zero(); }
+#endif
+  };
+
+  /// \brief Usage counters for a growable object allocator, used to right-size the pools declared with REGISTER_COMPONENT
+  struct AllocatorStats
+  {
+    /// \brief The name the allocator was registered under - filled in by the AllocatorRegistry
+    std::string m_name;
+
+    /// \brief The number of objects the allocator can hold before it next has to grow
+    size_t m_capacity = 0;
+
+    /// \brief The number of objects currently allocated
+    size_t m_liveCount = 0;
+
+    /// \brief The largest number of objects that have been allocated at once
+    size_t m_highWaterMark = 0;
+
+    /// \brief The number of times the allocator has run out of space and had to allocate more memory
+    size_t m_growCount = 0;
+
+    /// \brief The number of times memory has been reserved up front, e.g. when prewarming from scene capacity hints
+    size_t m_reserveCount = 0;
+
+    /// \brief The total number of allocations made
+    size_t m_allocationCount = 0;
+
+    /// \brief The total time spent inside allocate, in nanoseconds - always zero unless CELESTE_ALLOCATOR_TIMING is enabled
+    long long m_allocationTimeNs = 0;
+
+    void onAllocate(std::chrono::steady_clock::duration elapsed)
+    {
+      ++m_liveCount;
+      ++m_allocationCount;
+      m_highWaterMark = std::max(m_highWaterMark, m_liveCount);
+      m_allocationTimeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+    void onDeallocate() { --m_liveCount; }
+    void onDeallocateAll() { m_liveCount = 0; }
+    void onGrow() { ++m_growCount; }
+    void onReserve() { ++m_reserveCount; }
+  };
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Assert/Assert.h"
+
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+
+namespace Celeste
+{
+  // A multi-producer, single-consumer variant of the DoubleBufferAllocator
+  // Any number of threads can copy data into the front buffer at once without taking a lock - each producer reserves
+  // a range of the buffer with an atomic fetch-add and then memcpys its data into it.
+  // A single consumer thread periodically calls swapBuffers to take ownership of everything written so far, which it
+  // can then drain (e.g. write to a file) whilst producers carry on filling the other buffer.
+  // Unlike DoubleBufferAllocator, producers cannot swap the buffers themselves, so if the front buffer fills up before
+  // the consumer swaps, the data is dropped and counted in getDroppedCount.
+  template <typename T, size_t BufferSize>
+  class ConcurrentDoubleBufferAllocator
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "ConcurrentDoubleBufferAllocator copies with memcpy so T must be trivially copyable");
+
+    public:
+      ConcurrentDoubleBufferAllocator();
+      ~ConcurrentDoubleBufferAllocator() = default;
+      ConcurrentDoubleBufferAllocator(const ConcurrentDoubleBufferAllocator&) = delete;
+      ConcurrentDoubleBufferAllocator& operator=(const ConcurrentDoubleBufferAllocator&) = delete;
+
+      /// \brief Thread safe - copy the inputted data into the front buffer as one contiguous range
+      /// Returns false and drops the data if there is not enough room left in the front buffer
+      bool copy(size_t count, const T* data);
+
+      /// \brief Consumer only - swap the buffers and return the start and size of everything written to the old front buffer
+      /// Waits for any producers which are still copying into the old front buffer to finish before returning
+      /// The returned data is valid until the next call to swapBuffers
+      size_t swapBuffers(const T** dataStart);
+
+      /// \brief Consumer only - discard the contents of both buffers
+      void deallocateAll();
+
+      /// \brief The total number of elements which have been rejected because the front buffer was full
+      inline size_t getDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+    private:
+      struct Buffer
+      {
+        T m_data[BufferSize];
+
+        // Keep the counters on their own cache lines so producers hammering them do not false share with the data
+        alignas(64) std::atomic<size_t> m_reserved;
+        alignas(64) std::atomic<size_t> m_activeWriters;
+      };
+
+      Buffer m_buffers[2];
+      std::atomic<size_t> m_current;
+      std::atomic<size_t> m_droppedCount;
+  };
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T, size_t BufferSize>
+  ConcurrentDoubleBufferAllocator<T, BufferSize>::ConcurrentDoubleBufferAllocator() :
+    m_current(0),
+    m_droppedCount(0)
+  {
+    for (Buffer& buffer : m_buffers)
+    {
+      buffer.m_reserved.store(0);
+      buffer.m_activeWriters.store(0);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T, size_t BufferSize>
+  bool ConcurrentDoubleBufferAllocator<T, BufferSize>::copy(size_t count, const T* data)
+  {
+    if (!data || count > BufferSize)
+    {
+      ASSERT_FAIL();
+      return false;
+    }
+
+    while (true)
+    {
+      size_t current = m_current.load();
+      Buffer& buffer = m_buffers[current];
+
+      // Register ourselves as writing to this buffer, then check it is still the front buffer.
+      // If the consumer swapped in between, back off and try again on the new front buffer
+      buffer.m_activeWriters.fetch_add(1);
+      if (m_current.load() != current)
+      {
+        buffer.m_activeWriters.fetch_sub(1);
+        continue;
+      }
+
+      size_t offset = buffer.m_reserved.fetch_add(count);
+      bool fits = offset + count <= BufferSize;
+
+      if (fits)
+      {
+        std::memcpy(buffer.m_data + offset, data, count * sizeof(T));
+      }
+      else
+      {
+        m_droppedCount.fetch_add(count, std::memory_order_relaxed);
+      }
+
+      buffer.m_activeWriters.fetch_sub(1);
+      return fits;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T, size_t BufferSize>
+  size_t ConcurrentDoubleBufferAllocator<T, BufferSize>::swapBuffers(const T** dataStart)
+  {
+    size_t old = m_current.load();
+    size_t next = 1 - old;
+
+    // The back buffer is owned by us (the consumer) so nobody can be reserving in it yet
+    m_buffers[next].m_reserved.store(0);
+    m_current.store(next);
+
+    // Wait for any producers who reserved a range before the swap to finish copying
+    // They only hold the buffer for one memcpy, but give up the core so a descheduled producer can get back to it
+    while (m_buffers[old].m_activeWriters.load() != 0)
+    {
+      std::this_thread::yield();
+    }
+
+    *dataStart = m_buffers[old].m_data;
+
+    // Producers which overflowed will have pushed the reserved count past the end of the buffer
+    return std::min(m_buffers[old].m_reserved.load(), BufferSize);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T, size_t BufferSize>
+  void ConcurrentDoubleBufferAllocator<T, BufferSize>::deallocateAll()
+  {
+    const T* unused = nullptr;
+    swapBuffers(&unused);
+    swapBuffers(&unused);
+  }
+};
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "Memory/Iterators/DenseAllocatorIterator.h"
+#include "Memory/Allocators/AllocatorStats.h"
+#include "Memory/Handle.h"
+#include "CelesteStl/Memory/ObserverPtr.h"
+#include "Assert/Assert.h"
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <functional>
+#include <algorithm>
+#include <new>
+
+
+namespace Celeste
+{
+  /// An alternative to ResizeableAllocator which stores all of the live objects themselves packed into one contiguous array
+  /// Removal is swap-and-pop - the last object is moved into the hole - and growing moves every object into a larger array,
+  /// so allocate and size are O(1), deallocate, contains and isAllocated are O(1) address arithmetic, and iteration is
+  /// a straight linear sweep through memory with no dead slots and no pointer chasing.
+  /// Because objects move, pointers to them only last until the next allocation or deallocation.  Hold a Handle instead -
+  /// handles name a slot in an indirection table which always knows where its object currently is.
+  /// Objects are moved with their move constructor and the moved-from object is then destroyed, so T must be move constructible.
+  /// Like the other allocators, this only hands out and takes back memory - constructing and destroying the objects placed
+  /// in it is up to the caller, as operator new and operator delete do for types declared with CUSTOM_MEMORY_DECLARATION_WITH_ALLOCATOR.
+  template <typename T>
+  class DenseAllocator
+  {
+    public:
+      using type = T;
+      using iterator = DenseAllocatorIterator<T>;
+      using const_iterator = DenseAllocatorIterator<const T>;
+
+      DenseAllocator(size_t initialCapacity);
+      DenseAllocator(DenseAllocator<T>&&) = default;
+      DenseAllocator(const DenseAllocator<T>&) = delete;
+      ~DenseAllocator() = default;
+
+      DenseAllocator<T>& operator=(const DenseAllocator<T>&) = delete;
+      DenseAllocator<T>& operator=(DenseAllocator<T>&&) = default;
+
+      /// \brief Returns the memory for a new object at the end of the packed array, moving every live object into a larger array first if it is full
+      observer_ptr<T> allocate();
+
+      /// \brief Takes back the inputted object's memory, which must no longer hold a live object, and moves the last object into it
+      bool deallocate(T& item);
+      void deallocateAll();
+
+      /// Iteration runs from the last object to the first, so objects can deallocate themselves whilst being iterated over
+      inline DenseAllocatorIterator<T> begin() { return DenseAllocatorIterator<T>(m_objects.get(), m_size, m_size); }
+      inline DenseAllocatorIterator<T> end() { return DenseAllocatorIterator<T>(m_objects.get(), m_size, 0); }
+
+      inline DenseAllocatorIterator<const T> begin() const { return cbegin(); }
+      inline DenseAllocatorIterator<const T> end() const { return cend(); }
+
+      inline DenseAllocatorIterator<const T> cbegin() const { return DenseAllocatorIterator<const T>(m_objects.get(), m_size, m_size); }
+      inline DenseAllocatorIterator<const T> cend() const { return DenseAllocatorIterator<const T>(m_objects.get(), m_size, 0); }
+
+      inline bool contains(const T& item) const { return getObjectIndex(item) < capacity(); }
+      inline bool isAllocated(const T& item) const { return getObjectIndex(item) < m_size; }
+
+      /// \brief Returns a handle to the inputted item, or a null handle if it is not allocated from this allocator
+      Handle<T> getHandle(const T& item) const;
+
+      /// \brief Returns where the object the inputted handle refers to currently is, or nullptr if it has since been deallocated
+      observer_ptr<T> resolve(Handle<T> handle);
+      observer_ptr<const T> resolve(Handle<T> handle) const { return const_cast<DenseAllocator<T>*>(this)->resolve(handle); }
+
+      observer_ptr<T> find(const std::function<bool(const T&)>& predicate)
+      {
+        for (size_t i = 0; i < m_size; ++i)
+        {
+          if (predicate(m_objects[i]))
+          {
+            return &m_objects[i];
+          }
+        }
+
+        return nullptr;
+      }
+
+      observer_ptr<const T> find(const std::function<bool(const T&)>& predicate) const
+      {
+        return const_cast<DenseAllocator<T>*>(this)->find(predicate);
+      }
+
+      void findAll(const std::function<bool(const T&)>& predicate, std::vector<std::reference_wrapper<T>>& foundObjects)
+      {
+        for (size_t i = 0; i < m_size; ++i)
+        {
+          if (predicate(m_objects[i]))
+          {
+            foundObjects.push_back(m_objects[i]);
+          }
+        }
+      }
+
+      void findAll(const std::function<bool(const T&)>& predicate, std::vector<std::reference_wrapper<const T>>& foundObjects) const
+      {
+        for (size_t i = 0; i < m_size; ++i)
+        {
+          if (predicate(m_objects[i]))
+          {
+            foundObjects.push_back(m_objects[i]);
+          }
+        }
+      }
+
+      /// \brief Returns the object at the inputted position in the packed array - index must be less than size()
+      inline T& operator[](size_t index) { return m_objects[index]; }
+      inline const T& operator[](size_t index) const { return m_objects[index]; }
+
+      inline size_t size() const { return m_size; }
+      inline size_t capacity() const { return m_capacity; }
+
+      /// \brief Ensures the allocator can hold at least the inputted number of objects without moving them all again
+      void reserve(size_t capacity)
+      {
+        if (capacity > m_capacity)
+        {
+          grow(capacity);
+          m_stats.onReserve();
+        }
+      }
+
+      /// \brief Returns the usage counters for this allocator - the name is left empty
+      AllocatorStats getStats() const
+      {
+        AllocatorStats stats = m_stats;
+        stats.m_capacity = capacity();
+        return stats;
+      }
+
+    private:
+      using ObjectMemory = std::unique_ptr<T[], void(*)(T*)>;
+
+      static constexpr size_t INVALID_INDEX = std::numeric_limits<size_t>::max();
+
+      /// \brief Moves the live objects into a new array able to hold the inputted number of objects
+      void grow(size_t capacity);
+
+      /// \brief Returns the inputted item's position in the array, which is at least capacity() if it is not in the array at all
+      size_t getObjectIndex(const T& item) const;
+
+      /// \brief The objects themselves - the first m_size are live and the rest is raw memory
+      ObjectMemory m_objects;
+      size_t m_size;
+      size_t m_capacity;
+
+      /// \brief The handle slot of each live object, kept in step with the objects as they move
+      std::vector<size_t> m_objectSlots;
+
+      /// \brief The indirection table mapping a handle slot to where its object is in the array, or INVALID_INDEX if the slot is free
+      std::vector<size_t> m_slotObjects;
+
+      /// \brief The generation of every slot, incremented whenever the slot is deallocated to invalidate outstanding handles
+      std::vector<uint32_t> m_generations;
+
+      /// \brief A stack of free slots - the most recently freed slot is reused first
+      std::vector<size_t> m_freeSlots;
+
+      AllocatorStats m_stats;
+  };
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  DenseAllocator<T>::DenseAllocator(size_t initialCapacity) :
+    m_objects(nullptr, [](T* objects) { ::operator delete(objects); }),
+    m_size(0),
+    m_capacity(0),
+    m_objectSlots(),
+    m_slotObjects(),
+    m_generations(),
+    m_freeSlots(),
+    m_stats()
+  {
+    ASSERT(initialCapacity > 0);
+    grow(initialCapacity > 0 ? initialCapacity : 1);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  observer_ptr<T> DenseAllocator<T>::allocate()
+  {
+    AllocationTimer timer;
+
+    if (m_size == m_capacity)
+    {
+      // Doubling keeps the total cost of moving objects as we grow linear in the number allocated
+      grow(2 * m_capacity);
+      m_stats.onGrow();
+    }
+
+    size_t slot = m_slotObjects.size();
+    if (!m_freeSlots.empty())
+    {
+      slot = m_freeSlots.back();
+      m_freeSlots.pop_back();
+    }
+    else
+    {
+      m_slotObjects.push_back(INVALID_INDEX);
+      m_generations.push_back(0);
+    }
+
+    size_t objectIndex = m_size++;
+    m_slotObjects[slot] = objectIndex;
+    m_objectSlots.push_back(slot);
+
+    m_stats.onAllocate(timer.elapsed());
+
+    return &m_objects[objectIndex];
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  bool DenseAllocator<T>::deallocate(T& item)
+  {
+    size_t objectIndex = getObjectIndex(item);
+    if (objectIndex >= m_size)
+    {
+      ASSERT_FAIL();
+      return false;
+    }
+
+    size_t slot = m_objectSlots[objectIndex];
+    size_t lastIndex = m_size - 1;
+
+    if (objectIndex != lastIndex)
+    {
+      // Swap and pop - move the last live object into the hole and fix up its entry in the indirection table
+      size_t lastSlot = m_objectSlots[lastIndex];
+      new (&m_objects[objectIndex]) T(std::move(m_objects[lastIndex]));
+      m_objects[lastIndex].~T();
+
+      m_objectSlots[objectIndex] = lastSlot;
+      m_slotObjects[lastSlot] = objectIndex;
+    }
+
+    m_objectSlots.pop_back();
+    --m_size;
+
+    m_slotObjects[slot] = INVALID_INDEX;
+    ++m_generations[slot];
+    m_freeSlots.push_back(slot);
+    m_stats.onDeallocate();
+
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  void DenseAllocator<T>::deallocateAll()
+  {
+    for (size_t slot : m_objectSlots)
+    {
+      m_slotObjects[slot] = INVALID_INDEX;
+      ++m_generations[slot];
+      m_freeSlots.push_back(slot);
+    }
+
+    m_objectSlots.clear();
+    m_size = 0;
+
+    m_stats.onDeallocateAll();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  Handle<T> DenseAllocator<T>::getHandle(const T& item) const
+  {
+    size_t objectIndex = getObjectIndex(item);
+    if (objectIndex >= m_size)
+    {
+      return Handle<T>();
+    }
+
+    size_t slot = m_objectSlots[objectIndex];
+    return Handle<T>(slot, m_generations[slot]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  observer_ptr<T> DenseAllocator<T>::resolve(Handle<T> handle)
+  {
+    size_t slot = handle.getIndex();
+    if (slot >= m_slotObjects.size() ||
+        m_slotObjects[slot] == INVALID_INDEX ||
+        m_generations[slot] != handle.getGeneration())
+    {
+      return nullptr;
+    }
+
+    return &m_objects[m_slotObjects[slot]];
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  void DenseAllocator<T>::grow(size_t capacity)
+  {
+    ObjectMemory objects(static_cast<T*>(::operator new(capacity * sizeof(T))), m_objects.get_deleter());
+
+    for (size_t i = 0; i < m_size; ++i)
+    {
+      new (&objects[i]) T(std::move(m_objects[i]));
+      m_objects[i].~T();
+    }
+
+    m_objects = std::move(objects);
+    m_capacity = capacity;
+    m_objectSlots.reserve(capacity);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  size_t DenseAllocator<T>::getObjectIndex(const T& item) const
+  {
+    // Addresses before the array wrap around to huge offsets, so one comparison against the capacity rules out both sides
+    size_t offset = static_cast<size_t>(&item - m_objects.get());
+    return offset < m_capacity ? offset : INVALID_INDEX;
+  }
+}
@@ -2,6 +2,8 @@
 
 #include "Assert/Assert.h"
 
+#include <algorithm>
+
 
 namespace Celeste
 {
@@ -42,12 +44,12 @@ namespace Celeste
       /// No copying is required as you are returning the memory to assign your values to so faster than copy
       AllocateResult allocate(size_t desiredSpace, T** outputData);
 
-      /// \brief Flushes both the front and the back buffer and resets the head index.
+      /// \brief Discards the contents of both the front and the back buffer and resets the head index.
+      /// The buffer memory itself is not cleared - only the used ranges are ever read back
       void deallocateAll()
       {
-        flushCurrentBuffer();
-        swapBuffers();
-        flushCurrentBuffer();
+        m_index = 0;
+        m_backBufferSpaceUsage = 0;
       }
 
       /// \brief Changes around the current in use buffer and resets our element index
@@ -60,8 +62,6 @@ namespace Celeste
       /// \brief Utility function to swap buffers if we do not have enough to allocate the requested amount
       AllocateResult checkSpaceAndSwapBuffersIfNecessary(size_t requestedSpace);
 
-      void flushCurrentBuffer();
-
       T m_bufferOne[BufferSize];
       T m_bufferTwo[BufferSize];
 
@@ -107,11 +107,9 @@ namespace Celeste
 
     AllocateResult result = checkSpaceAndSwapBuffersIfNecessary(count);
 
-    for (int i = 0; i < count; i++)
-    {
-      m_currentBuffer[m_index] = data[i];
-      m_index++;
-    }
+    // Bulk copy - this becomes a memcpy for trivially copyable types
+    std::copy_n(data, count, m_currentBuffer + m_index);
+    m_index += count;
 
     return result;
   }
@@ -172,14 +170,4 @@ namespace Celeste
     m_backBufferSpaceUsage = m_index;
     m_index = 0;
   }
-
-  //------------------------------------------------------------------------------------------------
-  template <typename T, size_t BufferSize>
-  void DoubleBufferAllocator<T, BufferSize>::flushCurrentBuffer()
-  {
-    for (size_t i = 0; i < BufferSize; ++i)
-    {
-      m_currentBuffer[i] = 0;
-    }
-  }
 };
\ No newline at end of file
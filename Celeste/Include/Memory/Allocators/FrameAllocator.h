@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CelesteDllExport.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace Celeste
+{
+  /// A linear (bump) allocator for transient data which only needs to live until the end of the current frame
+  /// Allocating is just an aligned pointer increment and there is no per-allocation deallocation - instead the whole arena
+  /// is reset once per frame by whoever owns it - the Game owns one for game code, and systems own their own for scratch space.
+  /// Memory handed out by this allocator must not be held on to past that reset.
+  /// If a frame needs more memory than we have, the excess is served from overflow blocks and the arena is grown
+  /// to the high-water mark on the next reset so that subsequent frames fit.
+  class FrameAllocator
+  {
+    public:
+      static constexpr size_t DEFAULT_CAPACITY = 1024 * 1024;
+
+      CelesteDllExport FrameAllocator(size_t capacity = DEFAULT_CAPACITY);
+      CelesteDllExport ~FrameAllocator();
+      FrameAllocator(const FrameAllocator&) = delete;
+      FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+      /// \brief Alignment must be a power of 2
+      CelesteDllExport void* allocate(size_t numberOfBytes, size_t alignment);
+
+      /// \brief Invalidates every allocation made since the last reset
+      CelesteDllExport void reset();
+
+      inline size_t getCapacity() const { return m_capacity; }
+      inline size_t getUsed() const { return m_offset + m_overflowBytes; }
+
+      /// \brief The most memory that has been used in a single frame since this allocator was created
+      inline size_t getHighWaterMark() const { return m_highWaterMark; }
+
+    private:
+      void* allocateOverflow(size_t numberOfBytes, size_t alignment);
+
+      std::unique_ptr<char[]> m_buffer;
+      size_t m_capacity;
+      size_t m_offset;
+
+      std::vector<std::unique_ptr<char[]>> m_overflowBlocks;
+      size_t m_overflowBytes;
+
+      size_t m_highWaterMark;
+  };
+
+  /// An STL-compatible adaptor which allocates from the FrameAllocator it was created with
+  /// Deallocation is a no-op, so containers using this must not outlive the next reset of that allocator.
+  /// FrameAllocators are not thread safe, so keep these containers on the thread which owns the allocator, and inside
+  /// the system which resets it - hand anything which needs to outlive that to callers in an ordinary container.
+  template <typename T>
+  class FrameStlAllocator
+  {
+    public:
+      using value_type = T;
+
+      FrameStlAllocator(FrameAllocator& frameAllocator) : m_frameAllocator(&frameAllocator) { }
+
+      template <typename U>
+      FrameStlAllocator(const FrameStlAllocator<U>& other) : m_frameAllocator(&other.getFrameAllocator()) { }
+
+      T* allocate(size_t count) { return static_cast<T*>(m_frameAllocator->allocate(count * sizeof(T), alignof(T))); }
+      void deallocate(T*, size_t) { }
+
+      FrameAllocator& getFrameAllocator() const { return *m_frameAllocator; }
+
+      template <typename U>
+      bool operator==(const FrameStlAllocator<U>& other) const { return m_frameAllocator == &other.getFrameAllocator(); }
+
+      template <typename U>
+      bool operator!=(const FrameStlAllocator<U>& other) const { return !(*this == other); }
+
+    private:
+      FrameAllocator* m_frameAllocator;
+  };
+
+  template <typename T>
+  using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+}
\ No newline at end of file
@@ -2,6 +2,11 @@
 
 #include "Assert/Assert.h"
 #include "Memory/Iterators/PoolAllocatorIterator.h"
+#include "Memory/Handle.h"
+#include "Utils/BitUtils.h"
+
+#include <algorithm>
+#include <memory>
 
 
 namespace Celeste
@@ -30,7 +35,14 @@ namespace Celeste
       void deallocateAll();
 
       inline bool contains(const T& item) const { return static_cast<size_t>(&item - m_pool) < m_capacity; }
-      inline bool isAllocated(const T& item) const { return contains(item) && m_allocated[&item - m_pool]; }
+      inline bool isAllocated(const T& item) const { return contains(item) && isBitSet(m_allocated, &item - m_pool); }
+
+      /// \brief Returns a handle to the inputted item, or a null handle if the item is not allocated from this pool
+      Handle<T> getHandle(const T& item) const;
+
+      /// \brief Returns the object the inputted handle refers to, or nullptr if it has since been deallocated
+      T* resolve(Handle<T> handle);
+      const T* resolve(Handle<T> handle) const { return const_cast<PoolAllocator<T>*>(this)->resolve(handle); }
 
       inline PoolAllocatorIterator<T> begin() { return PoolAllocatorIterator<T>(m_pool, m_allocated, m_capacity); }
       inline PoolAllocatorIterator<T> end() { return PoolAllocatorIterator<T>(m_pool + m_capacity); }
@@ -38,21 +50,46 @@ namespace Celeste
       inline PoolAllocatorIterator<const T> begin() const { return PoolAllocatorIterator<const T>(m_pool, m_allocated, m_capacity); }
       inline PoolAllocatorIterator<const T> end() const { return PoolAllocatorIterator<const T>(m_pool + m_capacity); }
 
+      /// \brief Iterates over the allocated objects in the slot range [firstSlot, lastSlot)
+      /// firstSlot must be a multiple of BITS_PER_WORD, so that disjoint ranges can be iterated from different threads
+      /// lastSlot can be anywhere - allocated slots at or after it are never visited
+      inline PoolAllocatorIterator<T> begin(size_t firstSlot, size_t lastSlot)
+      {
+        ASSERT(firstSlot % BITS_PER_WORD == 0 && firstSlot <= lastSlot && lastSlot <= m_capacity);
+        return PoolAllocatorIterator<T>(m_pool + firstSlot, m_allocated + firstSlot / BITS_PER_WORD, lastSlot - firstSlot);
+      }
+      inline PoolAllocatorIterator<T> end(size_t lastSlot) { return PoolAllocatorIterator<T>(m_pool + lastSlot); }
+
       inline size_t size() const { return m_size; }
       inline size_t capacity() const { return m_capacity; }
       
     private:
       using PoolMemory = std::unique_ptr<T[], void(*)(T*)>;
-      using AllocatedMemory = std::unique_ptr<bool>;
+      using AllocatedMemory = std::unique_ptr<uint64_t[]>;
+      using FreeListMemory = std::unique_ptr<size_t[]>;
+      using GenerationMemory = std::unique_ptr<uint32_t[]>;
+
+      /// \brief Pushes every slot onto the free list so that slots are handed out in ascending order
+      void resetFreeList();
 
       PoolMemory m_poolMemory;
       AllocatedMemory m_allocatedMemory;
+      FreeListMemory m_freeListMemory;
+      GenerationMemory m_generationMemory;
       T* m_pool;
-      bool* m_allocated;
+
+      /// \brief One bit per slot, packed into 64 bit words so iteration can skip empty words at a time
+      uint64_t* m_allocated;
+
+      /// \brief A stack of the indices of all the unallocated slots
+      /// The top of the stack lives at m_freeList[m_capacity - m_size - 1] so allocate and deallocate are O(1)
+      size_t* m_freeList;
+
+      /// \brief The generation of each slot, incremented whenever the slot is deallocated to invalidate outstanding handles
+      uint32_t* m_generations;
 
       size_t m_size;
       size_t m_capacity;
-      size_t m_hint;
   };
 
   //------------------------------------------------------------------------------------------------
@@ -61,17 +98,19 @@ namespace Celeste
     m_poolMemory(
       static_cast<T*>(::operator new(capacity * sizeof(T))),
       [](T* b) {::operator delete[](b); }),
-    m_allocatedMemory(new bool[capacity]),
+    m_allocatedMemory(new uint64_t[wordCount(capacity)]),
+    m_freeListMemory(new size_t[capacity]),
+    m_generationMemory(new uint32_t[capacity]),
     m_pool(m_poolMemory.get()),
     m_allocated(m_allocatedMemory.get()),
+    m_freeList(m_freeListMemory.get()),
+    m_generations(m_generationMemory.get()),
     m_size(0),
-    m_capacity(capacity),
-    m_hint(0)
+    m_capacity(capacity)
   {
-    for (size_t i = 0; i < capacity; ++i)
-    {
-      m_allocated[i] = false;
-    }
+    std::fill(m_allocated, m_allocated + wordCount(capacity), static_cast<uint64_t>(0));
+    std::fill(m_generations, m_generations + capacity, static_cast<uint32_t>(0));
+    resetFreeList();
   }
 
   //------------------------------------------------------------------------------------------------
@@ -79,12 +118,17 @@ namespace Celeste
   PoolAllocator<T>::PoolAllocator(Celeste::PoolAllocator<T>&& rhs) :
     m_poolMemory(std::move(rhs.m_poolMemory)),
     m_allocatedMemory(std::move(rhs.m_allocatedMemory)),
+    m_freeListMemory(std::move(rhs.m_freeListMemory)),
+    m_generationMemory(std::move(rhs.m_generationMemory)),
     m_pool(m_poolMemory.get()),
     m_allocated(m_allocatedMemory.get()),
+    m_freeList(m_freeListMemory.get()),
+    m_generations(m_generationMemory.get()),
     m_size(rhs.m_size),
-    m_capacity(rhs.m_capacity),
-    m_hint(rhs.m_hint)
+    m_capacity(rhs.m_capacity)
   {
+    rhs.m_size = 0;
+    rhs.m_capacity = 0;
   }
 
 
@@ -101,37 +145,36 @@ namespace Celeste
   {
     m_poolMemory = std::move(rhs.m_poolMemory);
     m_allocatedMemory = std::move(rhs.m_allocatedMemory);
+    m_freeListMemory = std::move(rhs.m_freeListMemory);
+    m_generationMemory = std::move(rhs.m_generationMemory);
     m_pool = m_poolMemory.get();
     m_allocated = m_allocatedMemory.get();
+    m_freeList = m_freeListMemory.get();
+    m_generations = m_generationMemory.get();
     m_size = rhs.m_size;
     m_capacity = rhs.m_capacity;
-    m_hint = rhs.m_hint;
+
+    rhs.m_size = 0;
+    rhs.m_capacity = 0;
+
+    return *this;
   }
 
   //------------------------------------------------------------------------------------------------
   template <typename T>
   T* PoolAllocator<T>::allocate()
   {
-#if _DEBUG
     if (!canAllocate(1))
     {
       ASSERT_FAIL();
       return nullptr;
     }
-#endif
 
-    size_t allocationIndex = m_hint;
-    if (m_allocated[allocationIndex])
-    {
-      allocationIndex = 0;
-      while (allocationIndex < m_capacity && m_allocated[allocationIndex]) 
-      {
-        ++allocationIndex;
-      }
-    }
+    // Pop the most recently freed slot off the top of the free list
+    size_t allocationIndex = m_freeList[m_capacity - m_size - 1];
 
     ++m_size;
-    m_allocated[allocationIndex] = true;
+    setBit(m_allocated, allocationIndex);
     return m_pool + allocationIndex;
   }
 
@@ -139,7 +182,7 @@ namespace Celeste
   template <typename T>
   bool PoolAllocator<T>::deallocate(T& item)
   {
-#if _DEBUG
+    // Always validate here - pushing a slot onto the free list twice would hand it out to two objects
     if (!contains(item))
     {
       ASSERT_FAIL();
@@ -151,12 +194,14 @@ namespace Celeste
       ASSERT_FAIL();
       return false;
     }
-#endif
 
     size_t poolIndex = &item - m_pool;
-    m_allocated[poolIndex] = false;
+    clearBit(m_allocated, poolIndex);
+    ++m_generations[poolIndex];
     m_size--;
-    m_hint = poolIndex;
+
+    // Push the slot onto the top of the free list so it is the next one to be handed out
+    m_freeList[m_capacity - m_size - 1] = poolIndex;
 
     return true;
   }
@@ -167,13 +212,53 @@ namespace Celeste
   {
     for (size_t i = 0; i < m_capacity; ++i)
     {
-      if (m_allocated[i])
+      if (isBitSet(m_allocated, i))
       {
-        deallocate(m_pool[i]);
+        ++m_generations[i];
       }
     }
 
+    std::fill(m_allocated, m_allocated + wordCount(m_capacity), static_cast<uint64_t>(0));
     m_size = 0;
-    m_hint = 0;
+    resetFreeList();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  Handle<T> PoolAllocator<T>::getHandle(const T& item) const
+  {
+    if (!isAllocated(item))
+    {
+      return Handle<T>();
+    }
+
+    size_t poolIndex = &item - m_pool;
+    return Handle<T>(poolIndex, m_generations[poolIndex]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  T* PoolAllocator<T>::resolve(Handle<T> handle)
+  {
+    size_t poolIndex = handle.getIndex();
+    if (poolIndex >= m_capacity || 
+        !isBitSet(m_allocated, poolIndex) || 
+        m_generations[poolIndex] != handle.getGeneration())
+    {
+      return nullptr;
+    }
+
+    return m_pool + poolIndex;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  void PoolAllocator<T>::resetFreeList()
+  {
+    // The top of the stack is the last element, so store the indices in descending order
+    for (size_t i = 0; i < m_capacity; ++i)
+    {
+      m_freeList[i] = m_capacity - i - 1;
+    }
   }
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Memory/Iterators/ResizeableAllocatorIterator.h"
 #include "Memory/Allocators/PoolAllocator.h"
+#include "Memory/Allocators/AllocatorStats.h"
+#include "Memory/Handle.h"
 #include "CelesteStl/Memory/ObserverPtr.h"
 #include "Assert/Assert.h"
 #include "Log/Log.h"
@@ -9,6 +11,7 @@
 #include <algorithm>
 #include <numeric>
 #include <list>
+#include <vector>
 #include <functional>
 
 
@@ -58,6 +61,14 @@ namespace Celeste
       bool contains(const T& entity) const;
       bool isAllocated(const T& entity) const;
 
+      /// \brief Returns a handle to the inputted entity, or a null handle if it is not allocated from this allocator
+      Handle<T> getHandle(const T& entity) const;
+
+      /// \brief Returns the entity the inputted handle refers to, or nullptr if it has since been deallocated
+      /// O(log n) in the number of pools - the handle's index tells us which pool to look in
+      observer_ptr<T> resolve(Handle<T> handle);
+      observer_ptr<const T> resolve(Handle<T> handle) const { return const_cast<ResizeableAllocator<T>*>(this)->resolve(handle); }
+
       observer_ptr<T> find(const std::function<bool(const T&)>& predicate)
       {
         auto it = begin();
@@ -122,24 +133,65 @@ namespace Celeste
           });
       }
 
+      size_t capacity() const { return m_capacity; }
+
+      /// \brief The pools making up this allocator, in the order they were added
+      size_t getPoolCount() const { return m_allocatorLookup.size(); }
+      PoolAllocator<T>& getPool(size_t index) { return *m_allocatorLookup[index]; }
+      const PoolAllocator<T>& getPool(size_t index) const { return *m_allocatorLookup[index]; }
+
+      /// \brief Ensures the allocator can hold at least the inputted number of objects without growing again
+      /// Any shortfall is allocated as a single contiguous pool, rather than growing pool by pool
+      void reserve(size_t capacity);
+
+      /// \brief Returns the usage counters for this allocator - the name is left empty
+      AllocatorStats getStats() const
+      {
+        AllocatorStats stats = m_stats;
+        stats.m_capacity = capacity();
+        return stats;
+      }
+
     private:
       observer_ptr<PoolAllocator<T>> getAllocator(T& item);
 
+      observer_ptr<PoolAllocator<T>> addAllocator(size_t poolCapacity);
+
       std::list<std::unique_ptr<PoolAllocator<T>>> m_allocators;
+
+      /// \brief The same pools as m_allocators, in the same order, for lookup by handle index
+      std::vector<observer_ptr<PoolAllocator<T>>> m_allocatorLookup;
+
+      /// \brief The handle index of the first slot in each pool in m_allocatorLookup
+      /// Pools created by reserve can be larger than the others, so these are not evenly spaced
+      std::vector<size_t> m_poolStartIndices;
+
+      /// \brief The capacity of each new pool added when the allocator runs out of space
+      size_t m_poolCapacity;
+      size_t m_capacity;
+
+      AllocatorStats m_stats;
   };
 
   //------------------------------------------------------------------------------------------------
   template <typename T>
   ResizeableAllocator<T>::ResizeableAllocator(size_t initialCapacity) :
-    m_allocators()
+    m_allocators(),
+    m_allocatorLookup(),
+    m_poolStartIndices(),
+    m_poolCapacity(initialCapacity),
+    m_capacity(0),
+    m_stats()
   {
-    m_allocators.emplace_back(std::make_unique<typename Celeste::PoolAllocator<T>>(initialCapacity));
+    addAllocator(m_poolCapacity);
   }
 
   //------------------------------------------------------------------------------------------------
   template <typename T>
   observer_ptr<T> ResizeableAllocator<T>::allocate()
   {
+    AllocationTimer timer;
+
     // Find an allocator with space
     observer_ptr<typename Celeste::PoolAllocator<T>> chosenAllocator = nullptr;
     auto allocWithSpace = std::find_if(m_allocators.begin(), m_allocators.end(),
@@ -150,15 +202,41 @@ namespace Celeste
 
     if (allocWithSpace == m_allocators.end())
     {
-      m_allocators.emplace_back(std::make_unique<typename Celeste::PoolAllocator<T>>(m_allocators.front()->capacity()));
-      chosenAllocator = m_allocators.back().get();
+      chosenAllocator = addAllocator(m_poolCapacity);
+      m_stats.onGrow();
     }
     else
     {
       chosenAllocator = (*allocWithSpace).get();
     }
 
-    return chosenAllocator->allocate();
+    observer_ptr<T> allocated = chosenAllocator->allocate();
+    m_stats.onAllocate(timer.elapsed());
+
+    return allocated;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  observer_ptr<typename Celeste::PoolAllocator<T>> ResizeableAllocator<T>::addAllocator(size_t poolCapacity)
+  {
+    m_allocators.emplace_back(std::make_unique<typename Celeste::PoolAllocator<T>>(poolCapacity));
+    m_allocatorLookup.push_back(m_allocators.back().get());
+    m_poolStartIndices.push_back(m_capacity);
+    m_capacity += poolCapacity;
+
+    return m_allocators.back().get();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  void ResizeableAllocator<T>::reserve(size_t capacity)
+  {
+    if (capacity > m_capacity)
+    {
+      addAllocator(capacity - m_capacity);
+      m_stats.onReserve();
+    }
   }
 
   //------------------------------------------------------------------------------------------------
@@ -173,7 +251,13 @@ namespace Celeste
     }
 
     // Deallocate the actual memory
-    return allocator->deallocate(item);
+    if (!allocator->deallocate(item))
+    {
+      return false;
+    }
+
+    m_stats.onDeallocate();
+    return true;
   }
 
   //------------------------------------------------------------------------------------------------
@@ -200,6 +284,8 @@ namespace Celeste
     {
       allocator->deallocateAll();
     }
+
+    m_stats.onDeallocateAll();
   }
 
   //------------------------------------------------------------------------------------------------
@@ -231,4 +317,36 @@ namespace Celeste
 
     return false;
   }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  Handle<T> ResizeableAllocator<T>::getHandle(const T& object) const
+  {
+    for (size_t i = 0, n = m_allocatorLookup.size(); i < n; ++i)
+    {
+      if (m_allocatorLookup[i]->contains(object))
+      {
+        Handle<T> poolHandle = m_allocatorLookup[i]->getHandle(object);
+        return poolHandle.isNull() ? poolHandle : Handle<T>(m_poolStartIndices[i] + poolHandle.getIndex(), poolHandle.getGeneration());
+      }
+    }
+
+    return Handle<T>();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T>
+  observer_ptr<T> ResizeableAllocator<T>::resolve(Handle<T> handle)
+  {
+    if (handle.isNull() || handle.getIndex() >= m_capacity)
+    {
+      return nullptr;
+    }
+
+    // Find the last pool starting at or before the handle's index
+    size_t allocatorIndex = std::upper_bound(m_poolStartIndices.begin(), m_poolStartIndices.end(), handle.getIndex()) - m_poolStartIndices.begin() - 1;
+    size_t poolIndex = handle.getIndex() - m_poolStartIndices[allocatorIndex];
+
+    return m_allocatorLookup[allocatorIndex]->resolve(Handle<T>(poolIndex, handle.getGeneration()));
+  }
 }
\ No newline at end of file
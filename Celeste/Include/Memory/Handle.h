@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+
+namespace Celeste
+{
+  /// A weak reference to an object living in one of our allocators, made up of the object's slot index and the generation of that slot
+  /// The allocator bumps a slot's generation every time it is deallocated, so a handle to an object that has since been destroyed
+  /// (even if its slot has been reused for a new object) can be detected in O(1) when it is resolved
+  template <typename T>
+  class Handle
+  {
+    public:
+      static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+      Handle() : m_index(INVALID_INDEX), m_generation(0) { }
+      Handle(size_t index, uint32_t generation) : m_index(static_cast<uint32_t>(index)), m_generation(generation) { }
+
+      inline bool isNull() const { return m_index == INVALID_INDEX; }
+
+      inline size_t getIndex() const { return m_index; }
+      inline uint32_t getGeneration() const { return m_generation; }
+
+      inline bool operator==(const Handle<T>& other) const { return m_index == other.m_index && m_generation == other.m_generation; }
+      inline bool operator!=(const Handle<T>& other) const { return !(*this == other); }
+
+    private:
+      uint32_t m_index;
+      uint32_t m_generation;
+  };
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace Celeste
+{
+  /// An iterator over the packed array of live objects in a DenseAllocator, walking from the back of the array to the front
+  /// Deallocation moves the last object into the hole, and the last object has always been visited already when walking backwards,
+  /// so deallocating the current object (or one already visited) whilst iterating never skips or repeats an object.
+  /// Deallocating an object which has not been visited yet can move an already visited object in front of the iterator.
+  /// Allocating whilst iterating can move every object into a new array, so the iterator must not be used again afterwards.
+  template <typename T>
+  class DenseAllocatorIterator
+  {
+    private:
+      using Object = typename std::remove_const<T>::type;
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = T;
+      using difference_type = ptrdiff_t;
+      using pointer = T*;
+      using reference = T&;
+
+      /// Remaining is the number of objects left to visit - the current object is the one at index remaining - 1
+      /// The allocator's live object count is tracked through size, so the iterator sees objects being deallocated
+      DenseAllocatorIterator(Object* objects, const size_t& size, size_t remaining) :
+        m_objects(objects),
+        m_size(&size),
+        m_remaining(remaining)
+      {
+      }
+
+      inline DenseAllocatorIterator<T>& operator++() { advance(); return *this; }
+      inline DenseAllocatorIterator<T> operator++(int) { DenseAllocatorIterator<T> it(*this); advance(); return it; }
+
+      inline bool operator==(const DenseAllocatorIterator<T>& other) const
+      {
+        return (isEnd() && other.isEnd()) || (m_objects == other.m_objects && m_remaining == other.m_remaining);
+      }
+
+      inline bool operator!=(const DenseAllocatorIterator<T>& other) const { return !(*this == other); }
+
+      inline reference operator*() const { return m_objects[m_remaining - 1]; }
+      inline pointer get() const { return isEnd() ? nullptr : &m_objects[m_remaining - 1]; }
+
+    private:
+      /// Clamped to the number of live objects so that deallocating everything whilst iterating ends the iteration
+      inline void advance() { m_remaining = (std::min)(m_remaining - 1, *m_size); }
+      inline bool isEnd() const { return m_remaining == 0; }
+
+      Object* m_objects;
+      const size_t* m_size;
+      size_t m_remaining;
+  };
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Utils/BitUtils.h"
+
 #include <iterator>
 
 
@@ -16,7 +18,7 @@ namespace Celeste
       using reference = T&;
 
       PoolAllocatorIterator(T* ptr);
-      PoolAllocatorIterator(T* ptr, const bool* allocated, size_t size);
+      PoolAllocatorIterator(T* ptr, const uint64_t* allocated, size_t size);
       PoolAllocatorIterator(const PoolAllocatorIterator<T>&);
       
       PoolAllocatorIterator<T>& operator=(const PoolAllocatorIterator<T>&);
@@ -31,22 +33,47 @@ namespace Celeste
       inline T* get() const { return m_ptr; }
 
     private:
-      inline void next() 
+      inline void skip(size_t count) 
       { 
-        ++m_ptr;
-        ++m_current;
+        m_ptr += count;
+        m_current += count;
       }
 
+      /// \brief Moves to the next allocated slot at or after the current one
+      /// Whole words with no allocated slots are skipped in a single step
+      /// Bits past m_size in the last word are masked off, as they may belong to slots another iterator is responsible for
       inline void advance()
       {
-        while (m_current < m_size && !m_allocated[m_current])
+        while (m_current < m_size)
+        {
+          size_t bitIndex = m_current % BITS_PER_WORD;
+          uint64_t word = m_allocated[m_current / BITS_PER_WORD] >> bitIndex;
+
+          size_t remaining = m_size - m_current;
+          if (remaining < BITS_PER_WORD)
+          {
+            word &= (static_cast<uint64_t>(1) << remaining) - 1;
+          }
+
+          if (word != 0)
+          {
+            skip(countTrailingZeros(word));
+            return;
+          }
+
+          skip(BITS_PER_WORD - bitIndex);
+        }
+
+        // Skipping the remainder of the last word can take us past the end, so clamp back to it
+        if (m_current > m_size)
         {
-          next();
+          m_ptr -= (m_current - m_size);
+          m_current = m_size;
         }
       }
 
       T* m_ptr;
-      const bool* m_allocated;
+      const uint64_t* m_allocated;
       size_t m_size;
       size_t m_current = 0;
   };
@@ -63,7 +90,7 @@ namespace Celeste
 
   //------------------------------------------------------------------------------------------------
   template <typename T>
-  PoolAllocatorIterator<T>::PoolAllocatorIterator(T* ptr, const bool* allocated, size_t size) :
+  PoolAllocatorIterator<T>::PoolAllocatorIterator(T* ptr, const uint64_t* allocated, size_t size) :
     m_ptr(ptr),
     m_allocated(allocated),
     m_size(size),
@@ -98,7 +125,7 @@ namespace Celeste
   template <typename T>
   PoolAllocatorIterator<T>& PoolAllocatorIterator<T>::operator++()
   {
-    next();
+    skip(1);
     advance();
     return *this;
   }
@@ -107,8 +134,8 @@ namespace Celeste
   template <typename T>
   PoolAllocatorIterator<T> PoolAllocatorIterator<T>::operator++(int)
   {
-    next();
+    skip(1);
     advance();
     return PoolAllocatorIterator<T>(*this);
   }
-}
\ No newline at end of file
+}
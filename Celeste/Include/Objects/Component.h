@@ -33,6 +33,11 @@ namespace Celeste
       inline CelesteDllExport Transform* getTransform();
       inline CelesteDllExport const Transform* getTransform() const { return const_cast<Component*>(this)->getTransform(); }
 
+    protected:
+      /// Used by allocators which move their objects, such as DenseAllocator - the new component takes the old one's place
+      /// in its game object, so destroying the old one afterwards leaves the game object exactly as it was
+      CelesteDllExport Component(Component&& other) noexcept;
+
     private:
       using Inherited = Entity;
 
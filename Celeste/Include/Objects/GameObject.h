@@ -18,6 +18,7 @@ namespace Celeste
   namespace Physics
   {
     class Collider;
+    class RigidBody2D;
   }
 
   namespace Rendering
@@ -34,6 +35,7 @@ namespace Celeste
       CelesteDllExport ~GameObject() override;
 
       /// Submit this gameobject for rendering into the inputted spritebatch
+      /// Lag is the game time in seconds that has passed since physics was last simulated
       CelesteDllExport void render(Rendering::SpriteBatch& spriteBatch, float lag);
 
       /// Called when a collider on the gameobject collides with a collider it was not in collision with last frame
@@ -114,6 +116,10 @@ namespace Celeste
     private:
       using Inherited = Entity;
 
+      /// Puts to just in front of from in this game object's components, for when an allocator moves a component
+      /// Destroying from afterwards removes it, leaving to in exactly the place from had
+      void relocateComponent(const Component& from, Component& to);
+
       std::unique_ptr<Transform> m_transform;
 
       /// Name should be a unique identifier
@@ -125,7 +131,11 @@ namespace Celeste
       std::vector<Component*> m_managedComponents;
       std::vector<Component*> m_unmanagedComponents;
 
+      /// Cached when added so rendering does not have to search every ancestor's components for one each frame
+      Physics::RigidBody2D* m_rigidBody;
+
       friend class SceneManager;
+      friend class Component;
   };
 
   //------------------------------------------------------------------------------------------------
@@ -152,6 +162,11 @@ namespace Celeste
       m_unmanagedComponents.push_back(component);
     }
 
+    if constexpr (std::is_base_of<Physics::RigidBody2D, T>::value)
+    {
+      m_rigidBody = component;
+    }
+
     return component;
   }
 
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace Celeste::Physics
+{
+  /// An axis aligned bounding box, stored as its minimum and maximum corners
+  /// Used by the broadphase to find pairs of colliders which might be touching
+  struct AABB
+  {
+    AABB() : m_min(), m_max() { }
+    AABB(const glm::vec2& min, const glm::vec2& max) : m_min(min), m_max(max) { }
+
+    /// \brief Creates a box from a centre and full (possibly negative) dimensions
+    static AABB fromCentre(const glm::vec2& centre, const glm::vec2& dimensions)
+    {
+      glm::vec2 halfExtents = glm::abs(dimensions) * 0.5f;
+      return AABB(centre - halfExtents, centre + halfExtents);
+    }
+
+    static AABB merge(const AABB& a, const AABB& b)
+    {
+      return AABB(glm::min(a.m_min, b.m_min), glm::max(a.m_max, b.m_max));
+    }
+
+    /// \brief Closed interval test - boxes which only touch at an edge count as overlapping
+    /// The broadphase must never reject a pair which the narrowphase would accept, so it errs on the side of inclusion
+    inline bool overlaps(const AABB& other) const
+    {
+      return m_min.x <= other.m_max.x && other.m_min.x <= m_max.x &&
+             m_min.y <= other.m_max.y && other.m_min.y <= m_max.y;
+    }
+
+    inline bool contains(const AABB& other) const
+    {
+      return m_min.x <= other.m_min.x && m_min.y <= other.m_min.y &&
+             other.m_max.x <= m_max.x && other.m_max.y <= m_max.y;
+    }
+
+    /// \brief Returns the box covering everything this box passes through when moved by the inputted displacement
+    inline AABB swept(const glm::vec2& displacement) const { return merge(*this, AABB(m_min + displacement, m_max + displacement)); }
+
+    /// \brief Finds the fraction of the displacement this box can move before it first touches target
+    /// Returns false if it never does, or if the boxes already overlap (that case is left to the narrowphase)
+    /// On a hit, normal is the face of target that was struck
+    inline bool sweep(const glm::vec2& displacement, const AABB& target, float& timeOfImpact, glm::vec2& normal) const;
+
+    /// \brief Closed test for whether the line segment from start to end touches this box
+    /// Uses the separating axis theorem on the box's axes and the segment's normal, so never divides
+    inline bool intersectsSegment(const glm::vec2& start, const glm::vec2& end) const
+    {
+      glm::vec2 halfExtents = (m_max - m_min) * 0.5f;
+      glm::vec2 halfSegment = (end - start) * 0.5f;
+      glm::vec2 absHalfSegment = glm::abs(halfSegment);
+      glm::vec2 offset = (start + end) * 0.5f - (m_min + m_max) * 0.5f;
+
+      if (std::abs(offset.x) > halfExtents.x + absHalfSegment.x ||
+          std::abs(offset.y) > halfExtents.y + absHalfSegment.y)
+      {
+        return false;
+      }
+
+      return std::abs(offset.x * halfSegment.y - offset.y * halfSegment.x) <= halfExtents.x * absHalfSegment.y + halfExtents.y * absHalfSegment.x;
+    }
+
+    inline AABB expanded(float margin) const { return AABB(m_min - glm::vec2(margin), m_max + glm::vec2(margin)); }
+    inline float getPerimeter() const { return 2 * ((m_max.x - m_min.x) + (m_max.y - m_min.y)); }
+
+    glm::vec2 m_min;
+    glm::vec2 m_max;
+  };
+
+  //------------------------------------------------------------------------------------------------
+  inline bool AABB::sweep(const glm::vec2& displacement, const AABB& target, float& timeOfImpact, glm::vec2& normal) const
+  {
+    // Slab test - find the interval of time over which the boxes overlap on each axis, then intersect the two intervals
+    float entry[2];
+    float exit[2];
+
+    for (int axis = 0; axis < 2; ++axis)
+    {
+      if (displacement[axis] == 0)
+      {
+        // Colliders are open sets, so boxes which only touch on this axis never collide
+        if (m_max[axis] <= target.m_min[axis] || target.m_max[axis] <= m_min[axis])
+        {
+          return false;
+        }
+
+        entry[axis] = -std::numeric_limits<float>::infinity();
+        exit[axis] = std::numeric_limits<float>::infinity();
+      }
+      else if (displacement[axis] > 0)
+      {
+        entry[axis] = (target.m_min[axis] - m_max[axis]) / displacement[axis];
+        exit[axis] = (target.m_max[axis] - m_min[axis]) / displacement[axis];
+      }
+      else
+      {
+        entry[axis] = (target.m_max[axis] - m_min[axis]) / displacement[axis];
+        exit[axis] = (target.m_min[axis] - m_max[axis]) / displacement[axis];
+      }
+    }
+
+    int hitAxis = entry[0] > entry[1] ? 0 : 1;
+    float entryTime = entry[hitAxis];
+    float exitTime = std::min(exit[0], exit[1]);
+
+    if (entryTime < 0 || entryTime > 1 || entryTime >= exitTime)
+    {
+      return false;
+    }
+
+    timeOfImpact = entryTime;
+    normal = glm::vec2();
+    normal[hitAxis] = displacement[hitAxis] > 0 ? -1.0f : 1.0f;
+    return true;
+  }
+}
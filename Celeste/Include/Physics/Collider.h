@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Objects/Component.h"
+#include "Physics/AABB.h"
+#include "Physics/CollisionShape.h"
 #include "glm/glm.hpp"
 
 
@@ -13,6 +15,8 @@ namespace Celeste::Maths
 
 namespace Celeste::Physics
 {
+  class PhysicsManager;
+
   enum class ColliderType
   {
     kTrigger = true,
@@ -28,6 +32,19 @@ namespace Celeste::Physics
 
       virtual glm::vec2 getCentre() const = 0;
 
+      /// \brief Returns a box which completely encloses this collider, for use in the broadphase
+      virtual AABB getBounds() const = 0;
+
+      /// \brief Returns the exact shape of this collider in world space, for use in the narrowphase
+      virtual CollisionShape getShape() const = 0;
+
+      /// \brief Colliders on sleeping bodies are not synced to their transforms or put back into the broadphase each frame
+      inline bool isSleeping() const { return m_sleeping; }
+
+      /// \brief Goes up every time any collider is switched on or off, which changes which colliders are in the broadphase
+      CelesteDllExport static size_t getActiveChangeCount();
+      CelesteDllExport void setActive(bool isActive) override;
+
       inline ColliderType getColliderType() const { return m_colliderType; }
       inline void setColliderType(ColliderType colliderType) { m_colliderType = colliderType; }
 
@@ -51,7 +68,12 @@ namespace Celeste::Physics
     private:
       using Inherited = Component;
 
+      inline void setSleeping(bool sleeping) { m_sleeping = sleeping; }
+
       ColliderType m_colliderType;
       glm::vec2 m_offset;
+      bool m_sleeping;
+
+      friend class PhysicsManager;
   };
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CelesteDllExport.h"
+#include "Physics/AABB.h"
+#include "glm/glm.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Celeste::Physics
+{
+  enum class ShapeType
+  {
+    kBox,
+    kEllipse
+  };
+
+  /// A box or ellipse rotated about its centre - the form every collider takes in the narrowphase
+  /// For boxes the extents are the half width and half height, and for ellipses they are the semi-axes.
+  /// Like colliders themselves, shapes are open sets, so shapes which only touch do not intersect.
+  struct CollisionShape
+  {
+    /// \brief Rotation is in radians and positive is clockwise, as with Transform
+    CelesteDllExport static CollisionShape box(const glm::vec2& centre, const glm::vec2& halfExtents, float rotation = 0);
+    CelesteDllExport static CollisionShape ellipse(const glm::vec2& centre, const glm::vec2& semiAxes, float rotation = 0);
+
+    /// \brief Shapes with no area, including zero width or zero height lines, never intersect anything
+    inline bool isDegenerate() const { return m_extents.x == 0 || m_extents.y == 0; }
+
+    /// \brief Returns the smallest axis aligned box containing this shape
+    CelesteDllExport AABB getBounds() const;
+
+    /// \brief Returns the point on this shape furthest along the inputted direction
+    CelesteDllExport glm::vec2 support(const glm::vec2& direction) const;
+
+    /// \brief Transforms a world space point into this shape's space, where it is axis aligned and centred on the origin
+    inline glm::vec2 toLocal(const glm::vec2& point) const
+    {
+      glm::vec2 offset = point - m_centre;
+      return glm::vec2(glm::dot(offset, m_axisX), glm::dot(offset, m_axisY));
+    }
+
+    ShapeType m_type;
+    glm::vec2 m_centre;
+    glm::vec2 m_extents;
+
+    /// \brief This shape's local x and y axes in world space
+    glm::vec2 m_axisX;
+    glm::vec2 m_axisY;
+  };
+
+  /// \brief Exact test for whether the inputted point lies strictly inside the shape
+  CelesteDllExport bool contains(const CollisionShape& shape, const glm::vec2& point);
+
+  /// \brief Finds how far along the line segment from start to end it first enters the shape, from 0 at start to 1 at end
+  /// Returns false if it misses or only grazes the edge.  Segments starting inside the shape hit at a fraction of 0.
+  CelesteDllExport bool raycast(const CollisionShape& shape, const glm::vec2& start, const glm::vec2& end, float& fraction);
+
+  /// \brief Exact test for whether two shapes overlap
+  /// Box against box uses the separating axis theorem, and anything involving an ellipse uses GJK
+  CelesteDllExport bool intersects(const CollisionShape& a, const CollisionShape& b);
+
+  /// \brief Finds how far along the displacement shape can move before it first overlaps target, from 0 to 1
+  /// Steps through the time their bounding boxes overlap, never further than shape's smallest extent at once, then bisects
+  /// down to the moment of impact, so the empty corners of target's bounding box are passed straight through.
+  /// Returns false if shape never overlaps target, or already does at the start.
+  /// On a hit, normal is the unit normal pointing out of target where shape struck it.
+  CelesteDllExport bool sweep(const CollisionShape& shape, const glm::vec2& displacement, const CollisionShape& target, float& timeOfImpact, glm::vec2& normal);
+
+  /// \brief Tests shape against others[indices[i]] for every i in [0, count), writing 1 into results[i] if they intersect and 0 otherwise
+  /// This never allocates, so it is safe to call from many threads at once with their own results
+  CelesteDllExport void intersects(const CollisionShape& shape, const CollisionShape* others, const size_t* indices, size_t count, uint8_t* results);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CelesteDllExport.h"
+#include "Physics/IBroadphase.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+
+namespace Celeste::Physics
+{
+  /// A broadphase which keeps every entry as a leaf in a balanced bounding volume hierarchy
+  /// Leaves store their bounds fattened by a margin, so an entry which moves a little between frames does not touch the tree at all.
+  /// Only entries which move outside their fattened bounds are removed and reinserted.
+  /// Leaves are found by each entry's key rather than its index, so adding or removing one entry leaves the others alone.
+  class DynamicAABBTreeBroadphase : public IBroadphase
+  {
+    public:
+      static constexpr float DEFAULT_MARGIN = 4;
+
+      CelesteDllExport explicit DynamicAABBTreeBroadphase(float margin = DEFAULT_MARGIN);
+
+      inline float getMargin() const { return m_margin; }
+
+      using IBroadphase::update;
+      CelesteDllExport void update(const std::vector<AABB>& bounds, const std::vector<uint64_t>& keys) override;
+      CelesteDllExport void query(const AABB& bounds, std::vector<size_t>& results) const override;
+
+      /// \brief Only descends into nodes the segment actually passes through, rather than every node overlapping its box
+      CelesteDllExport void querySegment(const glm::vec2& start, const glm::vec2& end, std::vector<size_t>& results) const override;
+      inline size_t size() const override { return m_leaves.size(); }
+
+      /// \brief The number of edges from the root to the deepest leaf - a balanced tree of n leaves is around log2(n) high
+      CelesteDllExport size_t getHeight() const;
+
+      /// \brief The number of leaves which were inserted or reinserted during the last update
+      inline size_t getMovedCount() const { return m_movedCount; }
+
+    private:
+      static constexpr int32_t NULL_NODE = -1;
+      static constexpr size_t NO_ENTRY = static_cast<size_t>(-1);
+      static constexpr size_t MAX_QUERY_DEPTH = 256;
+
+      struct Node
+      {
+        inline bool isLeaf() const { return m_left == NULL_NODE; }
+
+        AABB m_bounds;
+
+        /// \brief The next free node instead when this node is on the free list
+        int32_t m_parent;
+        int32_t m_left;
+        int32_t m_right;
+
+        /// \brief 0 for leaves, -1 for free nodes
+        int32_t m_height;
+        size_t m_entry;
+        uint64_t m_key;
+      };
+
+      int32_t allocateNode();
+      void freeNode(int32_t node);
+
+      void insertLeaf(int32_t leaf);
+      void removeLeaf(int32_t leaf);
+      void refit(int32_t node);
+      void replaceChild(int32_t parent, int32_t oldChild, int32_t newChild);
+
+      /// \brief Rotates the subtree rooted at the inputted node if its children's heights differ by more than one
+      /// Returns the new root of the subtree
+      int32_t balance(int32_t node);
+
+      float m_margin;
+
+      /// \brief The exact bounds of each entry, as opposed to the fattened bounds stored in the tree
+      std::vector<AABB> m_bounds;
+      std::vector<Node> m_nodes;
+      int32_t m_root;
+      int32_t m_freeList;
+
+      /// \brief The leaf node of each entry, indexed by entry
+      std::vector<int32_t> m_leaves;
+      std::vector<int32_t> m_previousLeaves;
+      std::unordered_map<uint64_t, int32_t> m_keyLeaves;
+      size_t m_movedCount;
+  };
+}
@@ -24,9 +24,15 @@ namespace Celeste::Physics
       CelesteDllExport void setDimensions(const glm::vec2& dimensions);
 
       inline glm::vec2 getCentre() const override { return m_ellipse.m_centre; }
+
+      /// The ellipse's dimensions are its semi-axes, so the bounds are twice their size
+      inline AABB getBounds() const override { return getShape().getBounds(); }
+      inline CollisionShape getShape() const override { return CollisionShape::ellipse(m_ellipse.m_centre, m_ellipse.m_dimensions, m_rotation); }
       inline void setCentre(const glm::vec2& centre) { m_ellipse.m_centre = centre; }
 
+      /// The ellipse is axis aligned - the collider is this rotated about its centre by getRotation()
       inline const Maths::Ellipse& getEllipse() const { return m_ellipse; }
+      inline float getRotation() const { return m_rotation; }
 
       /// Use the attached game object to ensure the collider's values are up to date
       CelesteDllExport void sync();
@@ -41,5 +47,6 @@ namespace Celeste::Physics
 
       glm::vec2 m_unscaledDimensions;
       Maths::Ellipse m_ellipse;
+      float m_rotation;
   };
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Physics/AABB.h"
+
+#include <vector>
+#include <cstdint>
+#include <numeric>
+
+
+namespace Celeste::Physics
+{
+  /// The first stage of collision detection - cheaply narrows every collider down to the handful it might be touching
+  /// Each frame the PhysicsManager hands over the bounds of every collider taking part in the simulation, in a fixed order.
+  /// An entry is referred to by its index in that list, both in update and in query results.
+  /// Alongside each entry's bounds is a key which identifies it from one update to the next, as its index shifts whenever
+  /// an earlier entry is added or removed.
+  class IBroadphase
+  {
+    public:
+      IBroadphase() = default;
+      virtual ~IBroadphase() = default;
+
+      IBroadphase(const IBroadphase&) = delete;
+      IBroadphase& operator=(const IBroadphase&) = delete;
+
+      /// \brief Brings the broadphase up to date with this frame's bounds, where keys[i] identifies the entry at bounds[i]
+      /// Entries which have the same key and have not moved since the last update should be cheap to process
+      virtual void update(const std::vector<AABB>& bounds, const std::vector<uint64_t>& keys) = 0;
+
+      /// \brief As above, but using each entry's index as its key
+      void update(const std::vector<AABB>& bounds)
+      {
+        std::vector<uint64_t> keys(bounds.size());
+        std::iota(keys.begin(), keys.end(), static_cast<uint64_t>(0));
+        update(bounds, keys);
+      }
+
+      /// \brief Appends the index of every entry whose bounds overlap the inputted bounds to results, with no duplicates
+      /// The order of the results is unspecified.  May be called from multiple threads at once between updates.
+      virtual void query(const AABB& bounds, std::vector<size_t>& results) const = 0;
+
+      /// \brief Appends the index of every entry whose bounds the line segment from start to end might pass through, with no duplicates
+      /// By default this returns everything overlapping the box around the segment, which is correct but loose for long diagonal segments.
+      /// Broadphases which can cheaply skip the entries the segment misses should override this.
+      virtual void querySegment(const glm::vec2& start, const glm::vec2& end, std::vector<size_t>& results) const
+      {
+        query(AABB(glm::min(start, end), glm::max(start, end)), results);
+      }
+
+      /// \brief The number of entries passed to the last update
+      virtual size_t size() const = 0;
+  };
+}
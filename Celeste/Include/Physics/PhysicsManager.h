@@ -3,11 +3,20 @@
 #include "System/ISystem.h"
 #include "PhysicsUtils.h"
 #include "SimulatedBody.h"
+#include "IBroadphase.h"
+#include "RigidBodyIntegrator.h"
+#include "CollisionShape.h"
+#include "PhysicsQueries.h"
+#include "Memory/Handle.h"
+
+#include <memory>
 
 
 namespace Celeste::Physics
 {
   class Collider;
+  class RectangleCollider;
+  class EllipseCollider;
   class RigidBody2D;
 
   class PhysicsManager : public System::ISystem
@@ -23,21 +32,222 @@ namespace Celeste::Physics
       void setGravityScale(float gravityScale) { m_gravityScale = gravityScale; }
 
       size_t getSimulatedBodiesSize() const { return m_simulatedBodies.size(); }
-      void clearSimulatedBodies() { m_simulatedBodies.clear(); }
+      CelesteDllExport void clearSimulatedBodies();
 
       CelesteDllExport void addSimulatedBody(Collider& collider);
       CelesteDllExport void addSimulatedBody(RigidBody2D& rigidBody);
       CelesteDllExport void addSimulatedBody(Collider& collider, RigidBody2D& rigidBody);
 
+      /// \brief Replaces the broadphase used to find which colliders each simulated body might be touching
+      /// Defaults to a UniformGridBroadphase, which rebuilds faster than a DynamicAABBTreeBroadphase can update for typical scenes
+      /// of similarly sized colliders - the tree is better suited to scenes with colliders of wildly differing sizes.
+      /// Colliders on sleeping bodies are kept out of it, in a separate tree which is only updated when bodies fall asleep or wake.
+      CelesteDllExport void setBroadphase(std::unique_ptr<IBroadphase>&& broadphase);
+      const IBroadphase& getBroadphase() const { return *m_broadphase; }
+
+      /// \brief The number of candidate colliders the broadphase passed on to the narrowphase during the last update
+      size_t getCandidateCount() const { return m_candidateCount; }
+
+      /// \brief Whether rigid bodies which have stopped moving are put to sleep until something disturbs them
+      bool isSleepingEnabled() const { return m_sleepingEnabled; }
+      void setSleepingEnabled(bool sleepingEnabled) { m_sleepingEnabled = sleepingEnabled; }
+
+      /// \brief How many frames in a row a body, and everything touching it, must be idle before it falls asleep
+      size_t getSleepFrameCount() const { return m_sleepFrameCount; }
+      void setSleepFrameCount(size_t sleepFrameCount) { m_sleepFrameCount = sleepFrameCount; }
+
+      /// \brief Bodies moving or rotating slower than these speeds are considered idle
+      float getSleepLinearVelocity() const { return m_sleepLinearVelocity; }
+      void setSleepLinearVelocity(float sleepLinearVelocity) { m_sleepLinearVelocity = sleepLinearVelocity; }
+
+      float getSleepAngularVelocity() const { return m_sleepAngularVelocity; }
+      void setSleepAngularVelocity(float sleepAngularVelocity) { m_sleepAngularVelocity = sleepAngularVelocity; }
+
+      /// \brief Whether every update gives bit for bit the same results for the same starting state, on any machine
+      /// Deterministic updates run the narrowphase on the calling thread and integrate bodies with scalar maths only,
+      /// so nothing depends on the thread count or on where bodies fall in a SIMD batch.  Used to record and replay desyncs.
+      bool isDeterministic() const { return m_deterministic; }
+      CelesteDllExport void setDeterministic(bool deterministic);
+
+      /// Batched scene queries, which go through the broadphase rather than testing every collider
+      /// They see the active colliders where they were at the last update.  If colliders have been created or destroyed since,
+      /// the broadphase is rebuilt first so they are found or left out respectively.  Queries made from collision callbacks
+      /// cannot rebuild it partway through an update, so they skip destroyed colliders but do not find new ones.
+      /// Results are written into caller provided buffers, and once their scratch space has grown the queries never allocate.
+      /// Triggers are left out unless includeTriggers is true.
+
+      /// \brief Writes the first collider rays[i] hits into hits[i]
+      CelesteDllExport void raycast(const RaycastQuery* rays, size_t rayCount, RaycastHit* hits, bool includeTriggers = false);
+
+      /// \brief Finds the colliders overlapping each box, packing them into the colliders buffer one query after another
+      /// counts[i] is set to the number written for boxes[i] - once capacity colliders have been written no more are added.
+      /// Returns the total number written.
+      CelesteDllExport size_t overlapBoxes(const AABB* boxes, size_t boxCount, observer_ptr<Collider>* colliders, size_t capacity, size_t* counts, bool includeTriggers = false);
+
+      /// \brief As overlapBoxes, but for circles
+      CelesteDllExport size_t overlapCircles(const CircleQuery* circles, size_t circleCount, observer_ptr<Collider>* colliders, size_t capacity, size_t* counts, bool includeTriggers = false);
+
       CelesteDllExport void update(float elapsedGameTime) override;
 
     private:
       using Inherited = System::ISystem;
       using SimulatedBodies = std::vector<SimulatedBody>;
 
-      void doCollision(SimulatedBody& body, Collider& collider);
+      /// \brief The result of testing a simulated body against one of its broadphase candidates
+      struct Contact
+      {
+        size_t m_bodyIndex;
+        size_t m_colliderIndex;
+        bool m_intersecting;
+        bool m_wasTouching;
+      };
+
+      /// \brief Aligned so that threads appending to their own buffers do not share cache lines
+      struct alignas(64) ThreadContacts
+      {
+        std::vector<Contact> m_contacts;
+        std::vector<size_t> m_candidates;
+        std::vector<uint8_t> m_intersections;
+        size_t m_candidateCount = 0;
+      };
+
+      /// \brief A weak reference to a broadphase collider, as collision callbacks and scripts can destroy colliders between updates
+      /// Only the handle for the allocator the collider lives in is set
+      struct ColliderHandle
+      {
+        Handle<RectangleCollider> m_rectangleCollider;
+        Handle<EllipseCollider> m_ellipseCollider;
+      };
+
+      /// \brief Where a bullet should end this frame, having struck a collider it would otherwise have passed through and slid along it
+      struct BulletHit
+      {
+        observer_ptr<RigidBody2D> m_rigidBody;
+        glm::vec2 m_position;
+      };
+
+      static constexpr size_t NARROWPHASE_BATCH_SIZE = 16;
+      static constexpr size_t NO_BODY = static_cast<size_t>(-1);
+      static constexpr size_t NO_ISLAND = static_cast<size_t>(-1);
+      static constexpr size_t NO_COLLIDER = static_cast<size_t>(-1);
+
+      /// \brief Refreshes the shapes and bounds of the awake colliders, only rebuilding the broadphase entries from scratch
+      /// when colliders have been created, destroyed, switched on or off, or bodies have fallen asleep or woken
+      void updateBroadphase();
+      void rebuildBroadphase();
+
+      /// \brief Returns the broadphase index of the inputted collider, or NO_COLLIDER if it is not in the broadphase
+      /// Only the collider's address is used, so this is safe to call with colliders which have since been destroyed
+      size_t findBroadphaseIndex(const Collider* collider) const;
+
+      /// \brief Rebuilds the broadphase if colliders have been created or destroyed since it was built, unless we are partway through an update
+      void refreshBroadphase();
+
+      /// \brief Returns the broadphase collider at the inputted index, or nullptr if it has been destroyed since the broadphase was built
+      observer_ptr<Collider> resolveBroadphaseCollider(size_t index) const;
+
+      /// \brief Appends the index of every sleeping and awake broadphase collider whose bounds overlap the inputted bounds
+      void queryBroadphase(const AABB& bounds, std::vector<size_t>& results) const;
+      void queryBroadphaseSegment(const glm::vec2& start, const glm::vec2& end, std::vector<size_t>& results) const;
+
+      /// \brief Goes up every time a collider is created, destroyed or switched on or off
+      static size_t getColliderChangeCount();
+      void findCandidates(const SimulatedBody& body, std::vector<size_t>& candidates) const;
+
+      /// \brief Runs the narrowphase for every active body in parallel, filling the per thread contact buffers
+      void findContacts();
+
+      /// \brief Merges the per thread contact buffers and calls the collision callbacks for each contact in a stable order
+      void dispatchContacts();
+      void doCollision(SimulatedBody& body, Collider& collider, bool intersecting, bool wasTouching);
+
+      /// \brief Sweeps every bullet along this frame's movement, stopping it at the first collider it would hit and sliding it along that collider's surface
+      void sweepBullets(float elapsedGameTime);
+
+      /// \brief Moves every rigid body by its velocities in one pass, then applies gravity ready for the next frame
+      void integrateRigidBodies(float elapsedGameTime);
+
+      /// \brief Brings the integrator's bodies up to date - destroyed and sleeping bodies leave it, newly awake ones join it
+      /// and the rest have their state gathered again in place
+      void syncIntegrator();
+      void removeFromIntegrator(size_t index);
+      size_t findIntegratorIndex(const RigidBody2D& rigidBody) const;
+
+      /// \brief Wakes any sleeping body which has been moved, given a velocity or woken since it fell asleep
+      void checkSleepingBodies();
+
+      /// \brief Groups bodies into islands by this frame's contacts, and puts islands to sleep once every body in them is idle
+      void updateIslands();
+
+      size_t findIsland(size_t bodyIndex);
+      void sleep(SimulatedBody& body, size_t islandId);
+      void wake(SimulatedBody& body);
+      void wakeIsland(size_t islandId);
+
+      /// \brief Moves every sleeping body in one island into another, for when a body comes to rest touching both
+      void mergeIslands(size_t fromIslandId, size_t toIslandId);
+
+      /// \brief Writes the colliders overlapping shape into colliders, up to capacity, in broadphase order and returns how many were written
+      size_t overlap(const CollisionShape& shape, observer_ptr<Collider>* colliders, size_t capacity, bool includeTriggers);
+
+      /// \brief Only simulated rigid bodies can sleep - bodies without them never move by themselves anyway
+      static bool canSleep(const SimulatedBody& body);
 
       float m_gravityScale;
       SimulatedBodies m_simulatedBodies;
+
+      std::unique_ptr<IBroadphase> m_broadphase;
+      std::unique_ptr<IBroadphase> m_sleepingBroadphase;
+
+      /// \brief The active colliders in this frame's broadphase - the sleeping ones first, followed by the awake ones
+      /// The sleeping ones are left where they are from one frame to the next until bodies fall asleep or wake
+      std::vector<observer_ptr<Collider>> m_broadphaseColliders;
+      std::vector<ColliderHandle> m_broadphaseHandles;
+      std::vector<CollisionShape> m_broadphaseShapes;
+      size_t m_sleepingColliderCount;
+      bool m_sleepingChanged;
+      size_t m_broadphaseChangeCount;
+
+      /// \brief What each broadphase was last updated with - awake entry i is broadphase collider m_sleepingColliderCount + i
+      std::vector<AABB> m_sleepingBounds;
+      std::vector<uint64_t> m_sleepingKeys;
+      std::vector<AABB> m_awakeBounds;
+      std::vector<uint64_t> m_awakeKeys;
+
+      /// \brief The broadphase index of every collider, by the slot it occupies in its allocator, or NO_COLLIDER
+      std::vector<size_t> m_rectangleBroadphaseIndices;
+      std::vector<size_t> m_ellipseBroadphaseIndices;
+      std::vector<size_t> m_activeBodies;
+      std::vector<ThreadContacts> m_threadContacts;
+      std::vector<Contact> m_contacts;
+      size_t m_candidateCount;
+
+      RigidBodyIntegrator m_integrator;
+
+      /// \brief The integrator index of every rigid body, by the slot it occupies in its allocator, or NO_BODY
+      std::vector<size_t> m_integratorIndices;
+
+      /// \brief The rigid body at each integrator index, to tell when one has been destroyed
+      std::vector<Handle<RigidBody2D>> m_integratorHandles;
+      std::vector<BulletHit> m_bulletHits;
+      std::vector<size_t> m_sweepCandidates;
+
+      bool m_sleepingEnabled;
+      size_t m_sleepFrameCount;
+      float m_sleepLinearVelocity;
+      float m_sleepAngularVelocity;
+
+      /// \brief The simulated body each broadphase collider belongs to, or NO_BODY
+      std::vector<size_t> m_broadphaseBodyIndices;
+      std::vector<size_t> m_islandParents;
+      std::vector<uint8_t> m_islandAwake;
+      std::vector<size_t> m_islandSleepIds;
+      size_t m_nextIslandId;
+
+      std::vector<size_t> m_queryCandidates;
+      std::vector<uint8_t> m_queryIntersections;
+
+      bool m_deterministic;
+      bool m_updating;
   };
 }
\ No newline at end of file
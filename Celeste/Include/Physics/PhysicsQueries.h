@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CelesteStl/Memory/ObserverPtr.h"
+#include "glm/glm.hpp"
+
+
+namespace Celeste::Physics
+{
+  class Collider;
+
+  /// A ray for the batched PhysicsManager queries, running from m_start to m_end
+  struct RaycastQuery
+  {
+    glm::vec2 m_start;
+    glm::vec2 m_end;
+  };
+
+  /// The first collider a ray hit, or a null collider if it hit nothing
+  struct RaycastHit
+  {
+    inline bool isHit() const { return m_collider != nullptr; }
+
+    observer_ptr<Collider> m_collider = nullptr;
+    glm::vec2 m_point;
+
+    /// \brief How far along the ray the hit was, from 0 at its start to 1 at its end
+    float m_fraction = 1;
+  };
+
+  /// A circle for the batched PhysicsManager overlap queries
+  struct CircleQuery
+  {
+    glm::vec2 m_centre;
+    float m_radius;
+  };
+}
@@ -20,8 +20,8 @@ namespace Celeste::Physics
       using Collider::intersects;
 
       CelesteDllExport bool intersects(const Maths::Ray& ray) const override;
-      inline bool intersects(const glm::vec2& point) const override { return m_rectangle.contains(point); }
-      inline bool intersects(const Maths::Rectangle& rectangle) const override { return m_rectangle.intersects(rectangle); }
+      CelesteDllExport bool intersects(const glm::vec2& point) const override;
+      CelesteDllExport bool intersects(const Maths::Rectangle& rectangle) const override;
       CelesteDllExport bool intersects(const Maths::Ellipse& ellipse) const override;
 
       CelesteDllExport glm::vec2 getDimensions() const;
@@ -29,11 +29,16 @@ namespace Celeste::Physics
       CelesteDllExport void setDimensions(const glm::vec2& dimensions);
 
       inline glm::vec2 getCentre() const override { return m_rectangle.getCentre(); }
+      inline AABB getBounds() const override { return getShape().getBounds(); }
+      inline CollisionShape getShape() const override { return CollisionShape::box(m_rectangle.getCentre(), m_rectangle.getDimensions() * 0.5f, m_rotation); }
       inline glm::vec2 getLeft() const { return m_rectangle.getLeft(); }
       inline glm::vec2 getTop() const { return m_rectangle.getTop(); }
       inline glm::vec2 getRight() const { return m_rectangle.getRight(); }
       inline glm::vec2 getBottom() const { return m_rectangle.getBottom(); }
+
+      /// The rectangle is axis aligned - the collider is this rotated about its centre by getRotation()
       inline const Maths::Rectangle& getRectangle() const { return m_rectangle; }
+      inline float getRotation() const { return m_rotation; }
       inline float getWidth() const { return m_rectangle.getDimensions().x; }
       inline float getHeight() const { return m_rectangle.getDimensions().y; }
 
@@ -50,5 +55,6 @@ namespace Celeste::Physics
 
       glm::vec2 m_dimensions;
       Maths::Rectangle m_rectangle;
+      float m_rotation;
   };
 }
\ No newline at end of file
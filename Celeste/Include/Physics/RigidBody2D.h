@@ -44,6 +44,26 @@ namespace Celeste::Physics
 
       inline void incrementAngularVelocity(float angularVelocityDelta) { setAngularVelocity(m_angularVelocity + angularVelocityDelta); }
 
+      /// Bullets are swept along their path each frame, so they cannot pass through thin colliders however fast they move
+      /// This costs a broadphase query per bullet, so only use it for fast, small bodies
+      inline bool isBullet() const { return m_bullet; }
+      inline void setBullet(bool bullet) { m_bullet = bullet; }
+
+      /// Sleeping bodies are not moved, feel no gravity and are not tested for collisions
+      /// The PhysicsManager puts bodies to sleep once they and everything touching them have been idle for a while,
+      /// and wakes them when something new touches them, their transform changes or their velocity is set
+      inline bool isAwake() const { return m_awake; }
+      inline void setAwake(bool awake)
+      {
+        m_awake = awake;
+
+        if (!awake)
+        {
+          m_linearVelocity = glm::zero<glm::vec2>();
+          m_angularVelocity = 0;
+        }
+      }
+
       CelesteDllExport void update(float elapsedGameTime);
 
     private:
@@ -58,5 +78,8 @@ namespace Celeste::Physics
       float m_angularVelocity;
       float m_minAngularVelocity;
       float m_maxAngularVelocity;
+
+      bool m_bullet;
+      bool m_awake;
   };
 }
\ No newline at end of file
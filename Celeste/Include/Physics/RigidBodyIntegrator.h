@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CelesteDllExport.h"
+#include "CelesteStl/Memory/ObserverPtr.h"
+#include "Memory/Allocators/AlignedAllocator.h"
+#include "glm/glm.hpp"
+
+#include <array>
+#include <vector>
+
+
+namespace Celeste
+{
+  class Transform;
+}
+
+namespace Celeste::Physics
+{
+  class RigidBody2D;
+
+  /// Integrates many rigid bodies in a single vectorised pass
+  /// Bodies' state is kept in one aligned array per field, which bodies are added to and removed from as they come and go.
+  /// Each frame their state is gathered in place, integrated four bodies at a time and then scattered back out to the bodies
+  /// and their transforms.
+  class RigidBodyIntegrator
+  {
+    public:
+      CelesteDllExport RigidBodyIntegrator();
+
+      RigidBodyIntegrator(const RigidBodyIntegrator&) = delete;
+      RigidBodyIntegrator& operator=(const RigidBodyIntegrator&) = delete;
+
+      /// \brief Removes every body, keeping the storage for next frame
+      CelesteDllExport void clear();
+
+      /// \brief Copies the state of the inputted body and its transform in, returning its index
+      /// Bodies without a transform cannot be integrated and are not added - in which case this returns size()
+      CelesteDllExport size_t add(RigidBody2D& rigidBody);
+
+      /// \brief Removes the body at the inputted index by moving the last body into its place
+      CelesteDllExport void remove(size_t index);
+
+      /// \brief Copies the current state of the body at the inputted index and its transform back in, ready to integrate again
+      /// This also marks it as unaffected by gravity until told otherwise
+      CelesteDllExport void gather(size_t index);
+
+      /// \brief Marks the body at the inputted index as affected by gravity
+      inline void setAffectedByGravity(size_t index) { m_affectedByGravity[index] = 1; }
+
+      /// \brief Moves every body by its velocities, then accelerates bodies affected by gravity ready for the next frame
+      /// Velocities of bodies affected by gravity are clamped to their limits afterwards, as incrementLinearVelocity would
+      CelesteDllExport void integrate(float elapsedGameTime, const glm::vec2& gravityDelta);
+
+      /// \brief Writes the integrated positions back to the transforms of bodies which moved, and velocities back to bodies affected by gravity
+      CelesteDllExport void scatter() const;
+
+      inline size_t size() const { return m_rigidBodies.size(); }
+      inline RigidBody2D& getRigidBody(size_t index) const { return *m_rigidBodies[index]; }
+
+      /// \brief Whether bodies are integrated four at a time where the platform supports it
+      /// Turning this off moves every body with the same scalar code, so results never depend on where in a batch of four a body lands,
+      /// or on whether the build has SIMD at all.  Defaults to true.
+      inline bool isVectorised() const { return m_vectorised; }
+      inline void setVectorised(bool vectorised) { m_vectorised = vectorised; }
+
+      inline glm::vec2 getPosition(size_t index) const { return glm::vec2(m_positionX[index], m_positionY[index]); }
+      inline void setPosition(size_t index, const glm::vec2& position)
+      {
+        m_positionX[index] = position.x;
+        m_positionY[index] = position.y;
+        m_moved[index] = 1;
+      }
+      inline glm::vec2 getLinearVelocity(size_t index) const { return glm::vec2(m_linearVelocityX[index], m_linearVelocityY[index]); }
+      inline float getRotation(size_t index) const { return m_rotation[index]; }
+
+    private:
+      using Fields = std::array<AlignedVector<float>*, 12>;
+
+      /// \brief Every per body array, for operations which treat them all alike
+      Fields getFields();
+
+      /// \brief Resizes every per body array to hold count bodies, rounded up to a multiple of four
+      void resizeFields(size_t count);
+
+      std::vector<observer_ptr<RigidBody2D>> m_rigidBodies;
+      std::vector<observer_ptr<Transform>> m_transforms;
+
+      /// \brief Padded with zeroes to a multiple of four, so the vectorised loop can use aligned loads right to the end
+      AlignedVector<float> m_positionX;
+      AlignedVector<float> m_positionY;
+      AlignedVector<float> m_rotation;
+
+      AlignedVector<float> m_linearVelocityX;
+      AlignedVector<float> m_linearVelocityY;
+      AlignedVector<float> m_minLinearVelocityX;
+      AlignedVector<float> m_minLinearVelocityY;
+      AlignedVector<float> m_maxLinearVelocityX;
+      AlignedVector<float> m_maxLinearVelocityY;
+      AlignedVector<float> m_angularVelocity;
+
+      /// \brief Non zero for bodies affected by gravity - stored as floats so it can be loaded straight into a mask
+      AlignedVector<float> m_affectedByGravity;
+
+      /// \brief Non zero for bodies whose position or rotation changed in the last integrate, so scatter can leave the rest alone
+      AlignedVector<float> m_moved;
+
+      bool m_vectorised;
+  };
+}
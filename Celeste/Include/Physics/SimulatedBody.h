@@ -1,8 +1,10 @@
 #pragma once
 
 #include "CelesteStl/Memory/ObserverPtr.h"
+#include "glm/glm.hpp"
 
 #include <vector>
+#include <algorithm>
 
 
 namespace Celeste::Physics
@@ -20,13 +22,48 @@ namespace Celeste::Physics
       m_collider(collider),
       m_rigidBody(rigidBody),
       m_collidersLastFrame(),
-      m_collidersThisFrame()
+      m_collidersThisFrame(),
+      m_sleeping(false),
+      m_idleFrameCount(0),
+      m_islandId(0),
+      m_sleepTranslation(),
+      m_sleepRotation(0)
     {
     }
 
+    /// \brief Moves this frame's collisions into last frame's, ready for the next frame
+    /// The two vectors swap storage rather than copying, so once they have grown this never allocates
+    void beginFrame()
+    {
+      std::swap(m_collidersLastFrame, m_collidersThisFrame);
+      m_collidersThisFrame.clear();
+      std::sort(m_collidersLastFrame.begin(), m_collidersLastFrame.end());
+    }
+
+    /// \brief Returns true if this body was touching the inputted collider last frame
+    inline bool wasTouching(const Collider* collider) const
+    {
+      return std::binary_search(m_collidersLastFrame.begin(), m_collidersLastFrame.end(), collider);
+    }
+
     observer_ptr<Collider> m_collider;
     observer_ptr<RigidBody2D> m_rigidBody;
+
+    /// \brief Sorted by address, so entries can be looked up by binary search
     std::vector<observer_ptr<Collider>> m_collidersLastFrame;
     std::vector<observer_ptr<Collider>> m_collidersThisFrame;
+
+    /// \brief Sleeping bodies skip the narrowphase and keep the collisions they had when they fell asleep
+    bool m_sleeping;
+
+    /// \brief The number of frames in a row this body has barely moved
+    size_t m_idleFrameCount;
+
+    /// \brief Bodies which fell asleep touching one another share an island, and are woken together
+    size_t m_islandId;
+
+    /// \brief Where this body was when it fell asleep, so we can tell if anything has moved it since
+    glm::vec3 m_sleepTranslation;
+    float m_sleepRotation;
   };
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CelesteDllExport.h"
+#include "Physics/IBroadphase.h"
+
+#include <cstdint>
+
+
+namespace Celeste::Physics
+{
+  /// A broadphase which buckets entries by the grid cells their bounds cover
+  /// The grid is unbounded - cells are hashed into a flat table which is rebuilt from scratch on every update.
+  /// Works best when entries are of a similar size to the cells; entries covering too many cells are kept in a separate list
+  /// which every query checks.
+  class UniformGridBroadphase : public IBroadphase
+  {
+    public:
+      static constexpr float DEFAULT_CELL_SIZE = 128;
+      static constexpr size_t MAX_CELLS_PER_ENTRY = 64;
+
+      CelesteDllExport explicit UniformGridBroadphase(float cellSize = DEFAULT_CELL_SIZE);
+
+      inline float getCellSize() const { return m_cellSize; }
+
+      using IBroadphase::update;
+      CelesteDllExport void update(const std::vector<AABB>& bounds, const std::vector<uint64_t>& keys) override;
+      CelesteDllExport void query(const AABB& bounds, std::vector<size_t>& results) const override;
+      inline size_t size() const override { return m_bounds.size(); }
+
+      /// \brief The number of entries which covered too many cells to be bucketed
+      inline size_t getOversizedCount() const { return m_oversizedEntries.size(); }
+
+    private:
+      struct CellRange
+      {
+        int64_t m_minX;
+        int64_t m_minY;
+        int64_t m_maxX;
+        int64_t m_maxY;
+      };
+
+      /// \brief Returns false if the bounds cover more than MAX_CELLS_PER_ENTRY cells
+      bool getCellRange(const AABB& bounds, CellRange& cellRange) const;
+      size_t getBucket(int64_t x, int64_t y) const;
+
+      float m_cellSize;
+      float m_inverseCellSize;
+
+      std::vector<AABB> m_bounds;
+      std::vector<size_t> m_oversizedEntries;
+
+      /// \brief Entry indices grouped by bucket - bucket i occupies [m_bucketStarts[i], m_bucketStarts[i + 1])
+      std::vector<size_t> m_entries;
+      std::vector<size_t> m_bucketStarts;
+      size_t m_bucketMask;
+  };
+}
@@ -2,6 +2,7 @@
 
 #include "System/ISystem.h"
 #include "Rendering/RenderUtils.h"
+#include "Memory/Allocators/FrameAllocator.h"
 
 
 namespace Celeste::Rendering
@@ -21,5 +22,8 @@ namespace Celeste::Rendering
 
     private:
       using Inherited = System::ISystem;
+
+      /// \brief Scratch space for the canvasses being rendered, reset at the start of every render
+      FrameAllocator m_frameAllocator;
   };
 }
\ No newline at end of file
@@ -3,14 +3,19 @@
 #include "Objects/Component.h"
 #include "Maths/Rectangle.h"
 
+#include <cstdint>
+
 
 namespace Celeste::Resources
 {
   class Program;
+  class Texture2D;
 }
 
 namespace Celeste::Rendering
 {
+  class SpriteBatch;
+
   class Renderer : public Component
   {
     public:
@@ -20,6 +25,14 @@ namespace Celeste::Rendering
 
       virtual void render(const Resources::Program& shaderProgram, const glm::mat4& viewModelMatrix) const = 0;
 
+      /// \brief Adds this renderer's quads to the sprite batch's instance stream rather than drawing them itself
+      /// Returns false if this renderer cannot be instanced, in which case the sprite batch calls render instead
+      virtual bool addInstances(SpriteBatch& /*spriteBatch*/, const glm::mat4& /*viewModelMatrix*/) const { return false; }
+
+      /// \brief Returns the texture this renderer's instances are drawn with, or nullptr if it draws itself
+      /// Used by the sprite batch to keep renderers sharing a texture together when it sorts
+      virtual const Resources::Texture2D* getInstanceTexture() const { return nullptr; }
+
       inline const glm::vec2& getOrigin() const { return m_origin; }
       inline void setOrigin(const glm::vec2& origin) { m_origin = origin; }
       inline void setOrigin(float x, float y) { setOrigin(glm::vec2(x, y)); }
@@ -33,6 +46,10 @@ namespace Celeste::Rendering
       inline float getOpacity() const { return m_colour.a; }
       inline void setOpacity(float opacity) { m_colour.a = opacity; }
 
+      /// \brief Renderers on higher sorting layers are drawn after, and so on top of, those on lower ones, whatever their depth
+      inline uint8_t getSortingLayer() const { return m_sortingLayer; }
+      inline void setSortingLayer(uint8_t sortingLayer) { m_sortingLayer = sortingLayer; }
+
       inline Maths::Rectangle& getScissorRectangle() { return m_scissorRectangle; }
       inline const Maths::Rectangle& getScissorRectangle() const { return m_scissorRectangle; }
 
@@ -48,5 +65,6 @@ namespace Celeste::Rendering
       glm::vec2 m_origin;
       glm::vec4 m_colour;
       Maths::Rectangle m_scissorRectangle;
+      uint8_t m_sortingLayer;
   };
 }
\ No newline at end of file
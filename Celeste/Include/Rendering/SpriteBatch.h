@@ -3,19 +3,30 @@
 #include "CelesteDllExport.h"
 #include "UtilityHeaders/GLHeaders.h"
 #include "Resources/Shaders/Program.h"
+#include "CelesteStl/Memory/ObserverPtr.h"
 
-#include <set>
+#include <vector>
 
 
+namespace Celeste::Resources
+{
+  class Texture2D;
+}
+
 namespace Celeste::Rendering
 {
   class Renderer;
 
-  struct ZComparison
-  {	
-    typedef std::pair<Renderer*, glm::mat4> ArgType;
+  /// The per instance data for one textured quad, laid out exactly as it is streamed to the instanced sprite shader
+  struct SpriteInstance
+  {
+    /// Maps the unit quad into view space
+    glm::mat4 m_viewModelMatrix;
 
-    bool operator()(const ArgType& lhs, const ArgType& rhs) const { return lhs.second[3].z < rhs.second[3].z; }
+    /// The bottom left and top right texture coordinates to sample, as (u0, v0, u1, v1)
+    glm::vec4 m_uvRectangle;
+
+    glm::vec4 m_colour;
   };
 
   class SpriteBatch
@@ -28,16 +39,64 @@ namespace Celeste::Rendering
       CelesteDllExport void destroy();
 
       CelesteDllExport void begin(const glm::mat4& cameraProjectionMatrix, const glm::mat4& cameraViewMatrix);
+
+      /// \brief Draws everything added since begin, in z order
+      /// Runs of consecutive quads sharing a texture are drawn with a single instanced draw call.  Renderers which
+      /// cannot be instanced are drawn one at a time in between.  The draw calls are worked out before anything
+      /// is sent to OpenGL, so they can be inspected without a context.
       CelesteDllExport void end();
 
       CelesteDllExport void render(Renderer& renderer, const glm::mat4& renderMatrix);
       CelesteDllExport void render(Renderer& renderer, const glm::vec3& translation, float rotation, const glm::vec3& scale);
 
+      /// \brief Called by renderers during end to add a textured quad to the current run of instances
+      CelesteDllExport void addInstance(const Resources::Texture2D& texture, const SpriteInstance& instance);
+
+      /// \brief The number of draw calls the last end issued - one per run of instances, plus one per renderer drawn on its own
+      size_t getDrawCallCount() const { return m_drawCalls.size(); }
+
+      /// \brief The number of quads the last end drew instanced
+      size_t getInstanceCount() const { return m_instances.size(); }
+
+      /// \brief Whether renderers at the same layer and depth are grouped by program and texture, rather than drawn in the order they were added
+      /// Off by default, as game objects add their sprite and then their text at the same depth, and grouping could put a
+      /// button's label beneath its background.  Turn it on when renderers sharing a depth do not overlap, such as tiles,
+      /// to get fewer, larger instanced draws.
+      bool isSortingByState() const { return m_sortingByState; }
+      void setSortingByState(bool sortingByState) { m_sortingByState = sortingByState; }
+
     protected:
       size_t renderers_size() const { return m_renderers.size(); }
+      const glm::mat4& getRenderMatrix(size_t index) const { return m_renderMatrices[index]; }
+      const SpriteInstance& getInstance(size_t index) const { return m_instances[index]; }
 
     private:
-      using RenderPair = std::pair<Renderer*, glm::mat4>;
+      /// \brief An entry in the render queue, ordered by its key, which refers to a renderer and its matrix by index
+      /// The key is, from most to least significant bits, sorting layer (8), depth (32), program (4) and texture (20)
+      struct RenderCommand
+      {
+        uint64_t m_sortKey;
+        uint32_t m_renderIndex;
+      };
+
+      uint64_t createSortKey(const Renderer& renderer, const glm::mat4& renderMatrix) const;
+
+      /// \brief Either a run of instances sharing a texture, or a renderer which draws itself
+      struct DrawCall
+      {
+        observer_ptr<const Resources::Texture2D> m_texture;
+        size_t m_firstInstance;
+        size_t m_instanceCount;
+        observer_ptr<const Renderer> m_renderer;
+        glm::mat4 m_viewModelMatrix;
+      };
+
+      void buildDrawCalls();
+      void submitDrawCalls();
+
+      /// \brief Points the per instance attributes at the inputted instance in the instance buffer
+      /// Base instances need GL 4.2, so each run's attributes are offset to its first instance instead
+      void setInstanceAttributes(size_t firstInstance) const;
 
       void bindVertexArray() const
       {
@@ -56,11 +115,22 @@ namespace Celeste::Rendering
       glm::mat4 m_cameraProjectionMatrix;
       glm::mat4 m_cameraViewMatrix;
 
-      // Maybe use a vector and sort before rendering - will need to check profiling
-      // Set is good because it does spread load to insertion rather than rendering
-      std::multiset<RenderPair, ZComparison> m_renderers;
+      // Renderers and their matrices are appended as they are added and only the small commands are sorted, once, in end
+      std::vector<observer_ptr<Renderer>> m_renderers;
+      std::vector<glm::mat4> m_renderMatrices;
+      std::vector<RenderCommand> m_commands;
+      std::vector<RenderCommand> m_sortScratch;
+      bool m_sortingByState;
+
+      std::vector<SpriteInstance> m_instances;
+      std::vector<DrawCall> m_drawCalls;
 
       Resources::Program m_program;
       GLuint m_vao;
+
+      Resources::Program m_instancedProgram;
+      GLuint m_instancedVao;
+      GLuint m_instanceBuffer;
+      size_t m_instanceBufferCapacity;
   };
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 namespace Celeste::Resources
 {
   class Texture2D;
+  class TextureAtlas;
 }
 
 namespace Celeste::Rendering
@@ -27,14 +28,26 @@ namespace Celeste::Rendering
     public:
       CelesteDllExport void render(const Resources::Program& shaderProgram, const glm::mat4& viewModelMatrix) const override;
 
+      /// Sprites with a texture and no scissor rectangle are drawn as a single instanced quad
+      CelesteDllExport bool addInstances(SpriteBatch& spriteBatch, const glm::mat4& viewModelMatrix) const override;
+      CelesteDllExport const Resources::Texture2D* getInstanceTexture() const override;
+
       /// Load a texture from the resource manager and set it as the texture to render on this sprite renderer
       CelesteDllExport void setTexture(const Path& textureRelativeString);
 
       /// Sets the current rendered texture to be the inputted value
       CelesteDllExport void setTexture(Resources::Texture2D* texture);
 
+      /// Sets the texture to be the inputted atlas, showing just the named region of it
+      /// Sprites drawn from the same atlas share a texture, so are batched together
+      CelesteDllExport void setTexture(Resources::TextureAtlas& textureAtlas, const std::string& regionName);
+
       inline Resources::Texture2D* getTexture() const { return m_texture; }
 
+      /// The texture coordinates of the part of the texture being rendered, as (u0, v0, u1, v1)
+      inline const glm::vec4& getUVRectangle() const { return m_uvRectangle; }
+      inline void setUVRectangle(const glm::vec4& uvRectangle) { m_uvRectangle = uvRectangle; }
+
       /// Set the dimensions of the texture being rendered
       CelesteDllExport void setDimensions(const glm::vec2& dimensions);
       void setDimensions(float x, float y) { setDimensions(glm::vec2(x, y)); }
@@ -48,9 +61,11 @@ namespace Celeste::Rendering
     private:
       using Inherited = Renderer;
 
+      void updateDimensionsForImage(const glm::vec2& imageDimensions);
       void updateDimensionsForAspectRatio(const glm::vec2& imageDimensions);
 
       Resources::Texture2D* m_texture;
+      glm::vec4 m_uvRectangle;
       glm::vec2 m_dimensions;
       bool m_preserveAspectRatio;
   };
@@ -4,6 +4,7 @@
 #include "Renderer.h"
 #include "UI/LayoutEnums.h"
 #include "FileSystem/Path.h"
+#include "UtilityHeaders/GLHeaders.h"
 
 
 namespace Celeste::Rendering
@@ -14,8 +15,15 @@ namespace Celeste::Rendering
     DECLARE_UNMANAGED_COMPONENT(TextRenderer, CelesteDllExport)
 
     public:
+      CelesteDllExport ~TextRenderer() override;
+
+      /// Draws every glyph with a single draw from a vertex buffer, which is only refilled when the layout or alignment changes
       CelesteDllExport void render(const Resources::Program& shaderProgram, const glm::mat4& viewModelMatrix) const override;
 
+      /// Every glyph is a quad in the font's atlas, so the whole text is added as instances drawn with one texture
+      CelesteDllExport bool addInstances(SpriteBatch& spriteBatch, const glm::mat4& viewModelMatrix) const override;
+      const Resources::Texture2D* getInstanceTexture() const override { return m_font.getAtlas(); }
+
       /// Loads a font from the resource manager and sets it to be the font this renderer uses
       CelesteDllExport void setFont(const std::string& relativePathToFont, float height = 12);
       void setFont(const char* relativePathToFont, float height = 12) { setFont(std::string(relativePathToFont), height); }
@@ -34,15 +42,25 @@ namespace Celeste::Rendering
       CelesteDllExport void setHorizontalWrapMode(UI::HorizontalWrapMode horizontalWrapMode);
       inline UI::HorizontalWrapMode getHorizontalWrapMode() const { return m_horizontalWrapMode; }
 
-      inline void setHorizontalAlignment(UI::HorizontalAlignment horizontalAlignment) { m_horizontalAlignment = horizontalAlignment; }
+      CelesteDllExport void setHorizontalAlignment(UI::HorizontalAlignment horizontalAlignment);
       inline UI::HorizontalAlignment getHorizontalAlignment() const { return m_horizontalAlignment; }
 
-      inline void setVerticalAlignment(UI::VerticalAlignment verticalAlignment) { m_verticalAlignment = verticalAlignment; }
+      CelesteDllExport void setVerticalAlignment(UI::VerticalAlignment verticalAlignment);
       inline UI::VerticalAlignment getVerticalAlignment() const { return m_verticalAlignment; }
 
       CelesteDllExport void setMaxWidth(float maxWidth);
       inline float getMaxWidth() const { return m_maxWidth; }
 
+      /// Returns the number of glyph quads the current text is laid out as - whitespace has no quad
+      inline size_t getGlyphCount() const { return m_glyphQuads.size(); }
+
+      /// Returns the number of lines the current text is laid out over, including any made by wrapping
+      inline size_t getLineCount() const { return m_lines.size(); }
+
+      /// Returns the text of the inputted line, without the new line or space it was broken at
+      /// Wrapping only breaks the layout into lines, so the text itself is never changed
+      CelesteDllExport std::string getLine(size_t lineIndex) const;
+
     protected:
       inline float getXPosition(float halfLineWidth) const { return -static_cast<int>(m_horizontalAlignment)* halfLineWidth; }
       inline float getYPosition(float halfMaxHeight) const { return (2 - static_cast<int>(m_verticalAlignment))* halfMaxHeight; }
@@ -50,10 +68,90 @@ namespace Celeste::Rendering
     private:
       using Inherited = Renderer;
 
-      void layoutText();
-      void recalculateDimensions();
+      /// A glyph's quad relative to the start of its line on the baseline, along with where the glyph lies in the font's atlas
+      struct GlyphQuad
+      {
+        glm::vec2 m_position;
+        glm::vec2 m_size;
+        glm::vec4 m_uvRectangle;
+      };
+
+      /// A line of the laid out text - its glyphs run from the end of the previous line up to m_glyphsEnd
+      /// and its characters are [m_textBegin, m_textEnd) of the text
+      struct TextLine
+      {
+        size_t m_glyphsEnd;
+        float m_width;
+        size_t m_textBegin;
+        size_t m_textEnd;
+      };
+
+      /// A glyph's quad relative to the text's origin for the current alignment, so drawing it only needs the view model matrix
+      struct PlacedGlyph
+      {
+        /// \brief The bottom left of the quad, as (x, y, 0, 1)
+        glm::vec4 m_position;
+        glm::vec2 m_size;
+        glm::vec4 m_uvRectangle;
+      };
+
+      /// A corner of a placed glyph's quad, laid out as the sprite shader's position and texCoord attributes
+      /// The texture coordinates are already mapped into the glyph's rectangle of the atlas
+      struct GlyphVertex
+      {
+        glm::vec2 m_position;
+        glm::vec2 m_texCoord;
+      };
+
+      /// Everything other than the text which the layout depends on
+      struct LayoutKey
+      {
+        bool operator==(const LayoutKey& other) const
+        {
+          return m_fontName == other.m_fontName && m_fontHeight == other.m_fontHeight && m_wrapWidth == other.m_wrapWidth;
+        }
+
+        bool operator!=(const LayoutKey& other) const { return !(*this == other); }
+
+        StringId m_fontName = 0;
+        float m_fontHeight = 0;
+
+        /// \brief The width lines are wrapped to, or 0 if they are not wrapped
+        float m_wrapWidth = 0;
+      };
+
+      LayoutKey getLayoutKey() const;
+
+      /// Lays the text out again if it or anything in its layout key has changed since it was last laid out
+      void updateLayout(bool textChanged);
+
+      /// Finds where words must move onto new lines so that no line is wider than the max width
+      void findWrapBreaks();
+
+      /// Rebuilds the glyph quads, lines and dimensions from the current text, font and wrap breaks in a single pass
+      /// Only called when one of those changes, so neither rendering nor measuring has to walk the text again
+      void layoutGlyphs();
+
+      /// Offsets every glyph by its line's origin and rebuilds the vertex buffer from the results
+      /// Only alignment moves lines about, so changing it needs this but no layout
+      void placeGlyphs();
+
+      /// Returns where the inputted line starts on its baseline, relative to the text's origin
+      glm::vec2 getLineOrigin(size_t lineIndex) const;
 
       Resources::FontInstance m_font;
+      std::vector<GlyphQuad> m_glyphQuads;
+      std::vector<TextLine> m_lines;
+      std::vector<PlacedGlyph> m_placedGlyphs;
+      std::vector<GlyphVertex> m_glyphVertices;
+
+      /// Created the first time glyphs are placed with OpenGL running, which it must be for the font's atlas to exist
+      GLuint m_vertexArray;
+      GLuint m_vertexBuffer;
+
+      /// The index of every space in the text which wrapping starts a new line at, in ascending order
+      std::vector<size_t> m_wrapBreaks;
+      LayoutKey m_layoutKey;
 
       UI::HorizontalWrapMode m_horizontalWrapMode = UI::HorizontalWrapMode::kOverflow;
       UI::HorizontalAlignment m_horizontalAlignment = UI::HorizontalAlignment::kCentre;
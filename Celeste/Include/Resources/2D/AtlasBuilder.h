@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CelesteDllExport.h"
+#include "glm/glm.hpp"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace Celeste
+{
+  class Path;
+}
+
+namespace Celeste::Resources
+{
+  /// Where one of the packed images ended up in the atlas, in pixels from the first row of the atlas image
+  struct AtlasRegion
+  {
+    std::string m_name;
+    glm::uvec2 m_position;
+    glm::uvec2 m_dimensions;
+  };
+
+  /// Packs RGBA images into a single image plus a manifest of where each one went, which TextureAtlas can load
+  /// Everything happens in memory, so atlases can be built offline or in tests without a GPU.
+  class AtlasBuilder
+  {
+    public:
+      CelesteDllExport AtlasBuilder();
+
+      /// \brief Copies the inputted tightly packed RGBA pixels, ready to be packed under the inputted name
+      CelesteDllExport void addImage(const std::string& name, uint32_t width, uint32_t height, const unsigned char* rgbaPixels);
+
+      /// \brief Loads the inputted image file and adds it under the inputted name, returning false if it could not be loaded
+      CelesteDllExport bool addImage(const std::string& name, const Path& imageFullPath);
+
+      size_t getImageCount() const { return m_images.size(); }
+
+      /// \brief Packs every image, tallest first, into the smallest power of two image no wider or taller than maxDimension
+      /// A side which would have to grow past maxDimension is clamped to it, so the last size tried is maxDimension square.
+      /// Images are kept padding pixels apart so that filtering never bleeds one into its neighbours.
+      /// Returns false if they do not all fit.
+      CelesteDllExport bool build(uint32_t maxDimension, uint32_t padding = 1);
+
+      uint32_t getWidth() const { return m_width; }
+      uint32_t getHeight() const { return m_height; }
+      const std::vector<unsigned char>& getPixels() const { return m_pixels; }
+      const std::vector<AtlasRegion>& getRegions() const { return m_regions; }
+
+      /// \brief Writes the built atlas into the inputted directory as <atlasName>.png and the <atlasName>.atlas manifest which refers to it
+      CelesteDllExport bool save(const Path& directoryFullPath, const std::string& atlasName) const;
+
+    private:
+      struct Image
+      {
+        std::string m_name;
+        uint32_t m_width;
+        uint32_t m_height;
+        std::vector<unsigned char> m_pixels;
+      };
+
+      bool tryPack(const std::vector<size_t>& packingOrder, uint32_t width, uint32_t height, uint32_t padding);
+
+      std::vector<Image> m_images;
+
+      uint32_t m_width;
+      uint32_t m_height;
+      std::vector<unsigned char> m_pixels;
+      std::vector<AtlasRegion> m_regions;
+  };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CelesteDllExport.h"
+#include "glm/glm.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace Celeste::Resources
+{
+  /// Packs rectangles into a fixed size area by tracking the top edge of everything packed so far
+  /// Each rectangle goes wherever it leaves that edge lowest, which keeps wasted space small for sprite sized images.
+  /// Purely positional - it knows nothing about textures, so can be used and tested without a GPU.
+  class SkylinePacker
+  {
+    public:
+      CelesteDllExport SkylinePacker(uint32_t width, uint32_t height);
+
+      /// \brief Finds space for a rectangle of the inputted size and reserves it, returning false if there is no room left
+      /// outputPosition is the corner of the rectangle with the smallest coordinates
+      CelesteDllExport bool pack(uint32_t width, uint32_t height, glm::uvec2& outputPosition);
+
+      /// \brief Discards everything packed and starts again with an empty area of the inputted size
+      CelesteDllExport void reset(uint32_t width, uint32_t height);
+
+      uint32_t getWidth() const { return m_width; }
+      uint32_t getHeight() const { return m_height; }
+
+      /// \brief The total area of every rectangle packed so far
+      uint64_t getUsedArea() const { return m_usedArea; }
+
+    private:
+      /// A horizontal run of the skyline, at height m_y, starting at m_x
+      struct Segment
+      {
+        uint32_t m_x;
+        uint32_t m_y;
+        uint32_t m_width;
+      };
+
+      /// \brief Returns true if the rectangle fits starting at the inputted segment, outputting the height it would sit at
+      bool fits(size_t segmentIndex, uint32_t width, uint32_t height, uint32_t& outputY) const;
+
+      void addSegment(size_t segmentIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+      uint32_t m_width;
+      uint32_t m_height;
+      uint64_t m_usedArea;
+      std::vector<Segment> m_skyline;
+  };
+}
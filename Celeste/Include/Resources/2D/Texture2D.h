@@ -37,6 +37,9 @@ namespace Celeste::Resources
 
       CelesteDllExport void setPixel(GLint x, GLint y, unsigned char* data);
 
+      /// Replaces a block of the texture with the inputted image data, which must be in the image format
+      CelesteDllExport void setPixels(GLint x, GLint y, GLsizei width, GLsizei height, const unsigned char* data);
+
     protected:
       CelesteDllExport bool doLoadFromFile(const Path& path) override;
       CelesteDllExport void doUnload() override;
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Resources/Resource.h"
+#include "Resources/2D/Texture2D.h"
+#include "Resources/2D/SkylinePacker.h"
+
+#include <string>
+#include <unordered_map>
+
+
+namespace Celeste::Resources
+{
+  /// A single texture containing many images, each looked up by name as a rectangle of texture coordinates
+  /// Sprites drawn from the same atlas share a texture, so the sprite batch draws them together however many source
+  /// images they came from.  Atlases are either loaded from a manifest written by AtlasBuilder, or created empty and
+  /// filled at runtime, in which case each image is packed into free space as it is added.
+  class TextureAtlas : public Resource
+  {
+    public:
+      CelesteDllExport TextureAtlas();
+      TextureAtlas(const TextureAtlas&) = delete;
+      TextureAtlas(TextureAtlas&&) = default;
+      ~TextureAtlas() = default;
+
+      TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+      CelesteDllExport static const char* const FILE_EXTENSION;
+      CelesteDllExport static const char* const MANIFEST_ELEMENT_NAME;
+      CelesteDllExport static const char* const REGION_ELEMENT_NAME;
+      CelesteDllExport static const char* const TEXTURE_ATTRIBUTE_NAME;
+      CelesteDllExport static const char* const NAME_ATTRIBUTE_NAME;
+      CelesteDllExport static const char* const X_ATTRIBUTE_NAME;
+      CelesteDllExport static const char* const Y_ATTRIBUTE_NAME;
+      CelesteDllExport static const char* const WIDTH_ATTRIBUTE_NAME;
+      CelesteDllExport static const char* const HEIGHT_ATTRIBUTE_NAME;
+
+      /// \brief Discards any regions and creates an empty atlas of the inputted size for images to be added to at runtime
+      CelesteDllExport void create(uint32_t width, uint32_t height);
+
+      /// \brief Packs the inputted RGBA pixels into free space and names the region they occupy
+      /// The pixels are uploaded straight away when there is a GL context.  Returns false if there is no room left,
+      /// the name is already taken, or the atlas was loaded from a manifest, as those are packed offline.
+      CelesteDllExport bool addRegion(const std::string& name, uint32_t width, uint32_t height, const unsigned char* rgbaPixels);
+
+      /// \brief Loads the inputted image file and adds it as a region, returning false if it could not be loaded or packed
+      CelesteDllExport bool addRegion(const std::string& name, const Path& imageFullPath);
+
+      bool hasRegion(const std::string& name) const { return m_regions.find(name) != m_regions.end(); }
+      size_t getRegionCount() const { return m_regions.size(); }
+
+      /// \brief Returns the texture coordinates of the named region as (u0, v0, u1, v1), v increasing from the first row of the image
+      CelesteDllExport glm::vec4 getUVRectangle(const std::string& name) const;
+
+      /// \brief Returns the size of the named region in pixels
+      CelesteDllExport glm::vec2 getRegionDimensions(const std::string& name) const;
+
+      uint32_t getWidth() const { return m_width; }
+      uint32_t getHeight() const { return m_height; }
+
+      Texture2D& getTexture() { return m_texture; }
+      const Texture2D& getTexture() const { return m_texture; }
+
+    protected:
+      CelesteDllExport bool doLoadFromFile(const Path& path) override;
+      CelesteDllExport void doUnload() override;
+
+    private:
+      using Inherited = Resource;
+
+      struct Region
+      {
+        glm::vec4 m_uvRectangle;
+        glm::vec2 m_dimensions;
+      };
+
+      void insertRegion(const std::string& name, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+      Texture2D m_texture;
+      SkylinePacker m_packer;
+      std::unordered_map<std::string, Region> m_regions;
+      uint32_t m_width;
+      uint32_t m_height;
+  };
+}
@@ -9,7 +9,7 @@ namespace Celeste
   {
     struct Character
     {
-      GLuint      m_textureId;    // ID handle of the glyph texture
+      glm::vec4   m_uvRectangle;  // Texture coordinates of the glyph within its font's atlas, as (u0, v0, u1, v1)
       glm::ivec2  m_size;         // Size of glyph
       glm::ivec2  m_bearing;      // Offset from baseline to left/top of glyph
       float       m_advance;      // Offset to advance to next glyph
@@ -4,6 +4,7 @@
 #include "UtilityHeaders/GLHeaders.h"
 #include "ft2build.h"
 #include "Resources/Resource.h"
+#include "Resources/2D/Texture2D.h"
 #include "FontInstance.h"
 #include "Character.h"
 #include FT_FREETYPE_H 
@@ -26,10 +27,18 @@ namespace Celeste::Resources
 
     private:
       typedef std::unordered_map<char, Character> Characters;
-      typedef std::unordered_map<float, Characters> CharactersLookup;
+
+      /// Every glyph of one height, rasterised into a single texture so text can be drawn with one texture bound
+      struct GlyphAtlas
+      {
+        Characters m_characters;
+        Texture2D m_texture;
+      };
+
+      typedef std::unordered_map<float, GlyphAtlas> CharactersLookup;
       typedef Resource Inherited;
 
-      /// Load the characters, create textures for the inputted height and add to the characters lookup.
+      /// Load the characters, pack them into an atlas texture for the inputted height and add to the characters lookup.
       /// If the characters already exist for the inputted height, do nothing.
       void loadCharacters(float height);
 
@@ -3,6 +3,10 @@
 #include "CelesteDllExport.h"
 #include "Character.h"
 #include "UID/StringId.h"
+#include "CelesteStl/Memory/ObserverPtr.h"
+
+#include <array>
+#include <bitset>
 
 
 namespace Celeste
@@ -10,16 +14,23 @@ namespace Celeste
   namespace Resources
   {
     class Font;
+    class Texture2D;
 
     class FontInstance
     {
       public:
+        /// Fonts only load the ASCII characters, so every character can be looked up by indexing a flat table
+        static constexpr size_t CHARACTER_COUNT = 128;
+
         CelesteDllExport FontInstance();
 
         CelesteDllExport const Character* getCharacter(GLchar character) const;
         float getHeight() const { return m_height; }
         StringId getFontName() const { return m_fontName; }
 
+        /// Returns the texture every glyph of this height is packed into, or nullptr if no font is loaded
+        observer_ptr<const Texture2D> getAtlas() const { return m_atlas; }
+
         CelesteDllExport glm::vec2 measureString(std::string::const_iterator start, std::string::const_iterator end) const;
         CelesteDllExport glm::vec2 measureString(const std::string& text) const;
         CelesteDllExport void getLines(const std::string& text, float m_maxWidth, std::vector<std::string>& outputLines) const;
@@ -27,15 +38,17 @@ namespace Celeste
         CelesteDllExport void reset();
 
       protected:
-        size_t getNumberOfCharacters() const { return m_characters.size(); }
+        size_t getNumberOfCharacters() const { return m_loadedCharacters.count(); }
 
       private:
         typedef std::unordered_map<GLchar, Character> Characters;
 
         /// Only create FontInstances through a Font class
-        FontInstance(const Characters& fontCharacters, float height, StringId fontName);
+        FontInstance(const Characters& fontCharacters, observer_ptr<const Texture2D> atlas, float height, StringId fontName);
 
-        Characters m_characters;
+        std::array<Character, CHARACTER_COUNT> m_characters;
+        std::bitset<CHARACTER_COUNT> m_loadedCharacters;
+        observer_ptr<const Texture2D> m_atlas;
         float m_height;
         StringId m_fontName;
 
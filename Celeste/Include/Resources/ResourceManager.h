@@ -6,6 +6,7 @@
 #include "Shaders/VertexShader.h"
 #include "Shaders/FragmentShader.h"
 #include "2D/Texture2D.h"
+#include "2D/TextureAtlas.h"
 #include "Fonts/Font.h"
 #include "Audio/Sound.h"
 #include "Data/Data.h"
@@ -82,6 +83,7 @@ namespace Celeste::Resources
       DEFINE_RESOURCE(Sound, m_sounds)
       DEFINE_RESOURCE(Data, m_data)
       DEFINE_RESOURCE(Texture2D, m_textures)
+      DEFINE_RESOURCE(TextureAtlas, m_textureAtlases)
       DEFINE_RESOURCE(Font, m_fonts)
       DEFINE_RESOURCE(Prefab, m_prefabs)
       DEFINE_RESOURCE(Model, m_models)
@@ -2,6 +2,7 @@
 
 #include "CelesteDllExport.h"
 #include "CelesteStl/Memory/ObserverPtr.h"
+#include "Memory/AllocatorRegistry.h"
 
 #include <vector>
 #include <tuple>
@@ -15,5 +16,11 @@ namespace Celeste
 
 namespace Celeste::SceneLoader
 {
-  CelesteDllExport std::tuple<bool, std::vector<GameObject*>> load(const Path& relativePathToLevelFile);
+  /// \brief Loads and instantiates the scene at the inputted path
+  /// Before anything is created, the object allocators are grown to fit everything the scene contains
+  /// Pass capacity hints for anything else the scene is known to need, such as objects spawned at runtime.
+  /// These are added on top of the scene's own counts, rather than being a minimum for them.
+  CelesteDllExport std::tuple<bool, std::vector<GameObject*>> load(
+    const Path& relativePathToLevelFile,
+    const AllocatorRegistry::CapacityHints& capacityHints = AllocatorRegistry::CapacityHints());
 }
\ No newline at end of file
@@ -4,8 +4,10 @@
 #include "UID/StringId.h"
 #include "Memory/Iterators/ResizeableAllocatorIterator.h"
 #include "System/ISystem.h"
+#include "Memory/Allocators/FrameAllocator.h"
 
 #include <functional>
+#include <vector>
 
 
 namespace Celeste
@@ -39,5 +41,8 @@ namespace Celeste
       using Inherited = System::ISystem;
 
       void updateGameObjectHierarchy(GameObject& gameObject);
+
+      /// \brief Scratch space for the root game objects during update, reset at the start of every update
+      FrameAllocator m_frameAllocator;
   };
 }
\ No newline at end of file
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "CelesteDllExport.h"
+#include "Memory/Allocators/ResizeableAllocator.h"
+#include "Memory/Allocators/DenseAllocator.h"
+#include "Utils/BitUtils.h"
+#include "Assert/Assert.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <algorithm>
+
+
+namespace Celeste
+{
+  /// A unit of work for the JobSystem
+  /// The work to do is stored inline in the job itself, so creating a job never allocates
+  struct alignas(64) Job
+  {
+    static constexpr size_t MAX_CONTINUATIONS = 4;
+    static constexpr size_t DATA_SIZE = 64;
+
+    using Function = void(*)(Job&);
+
+    Function m_function;
+    Job* m_parent;
+
+    /// \brief This job plus any of its children which have not yet finished
+    std::atomic<int32_t> m_unfinishedJobs;
+    std::atomic<int32_t> m_continuationCount;
+    Job* m_continuations[MAX_CONTINUATIONS];
+
+    alignas(std::max_align_t) unsigned char m_data[DATA_SIZE];
+  };
+
+  /// A fixed size Chase-Lev work stealing deque
+  /// The owning thread pushes and pops jobs at the bottom, whilst any other thread can steal from the top
+  /// None of these operations take a lock
+  class WorkStealingQueue
+  {
+    public:
+      static constexpr size_t CAPACITY = 4096;
+
+      CelesteDllExport WorkStealingQueue();
+      WorkStealingQueue(const WorkStealingQueue&) = delete;
+      WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+      /// \brief Owner only - returns false if the queue is full
+      CelesteDllExport bool push(Job* job);
+
+      /// \brief Owner only - takes the most recently pushed job, or returns nullptr if the queue is empty
+      CelesteDllExport Job* pop();
+
+      /// \brief Any thread - takes the oldest job, or returns nullptr if the queue is empty or we lost a race for the last job
+      CelesteDllExport Job* steal();
+
+    private:
+      static constexpr size_t MASK = CAPACITY - 1;
+
+      alignas(64) std::atomic<int64_t> m_top;
+      alignas(64) std::atomic<int64_t> m_bottom;
+      std::unique_ptr<std::atomic<Job*>[]> m_jobs;
+  };
+
+  /// A work stealing job system
+  /// Each worker thread has its own deque of jobs, and steals from the others when its own runs dry.
+  /// The thread which creates the JobSystem takes part as well, whenever it waits on a job.
+  /// Jobs can have a parent, which is not considered finished until all of its children are, and continuations,
+  /// which are run as soon as the job they are attached to finishes.
+  /// Each thread can have up to JOBS_PER_THREAD jobs in flight at once.
+  class JobSystem
+  {
+    public:
+      static constexpr size_t JOBS_PER_THREAD = WorkStealingQueue::CAPACITY;
+
+      /// \brief Creates the inputted number of worker threads in addition to the calling thread
+      CelesteDllExport explicit JobSystem(size_t workerThreadCount = getDefaultWorkerThreadCount());
+      CelesteDllExport ~JobSystem();
+      JobSystem(const JobSystem&) = delete;
+      JobSystem& operator=(const JobSystem&) = delete;
+
+      /// \brief The number of threads executing jobs, including the thread which created the JobSystem
+      inline size_t getThreadCount() const { return m_threadCount; }
+
+      /// \brief Creates a job which will call the inputted function when run
+      /// The function is stored inside the job, so it must be small and trivially destructible
+      /// (e.g. a lambda capturing a few pointers or values) - anything bigger should be captured by pointer
+      /// If a parent is specified, this must be called before the parent finishes
+      template <typename Function>
+      Job* createJob(Function&& function, Job* parent = nullptr);
+
+      /// \brief Makes the inputted job available to be executed by any thread
+      CelesteDllExport void run(Job* job);
+
+      /// \brief Runs continuation as soon as job finishes - must be called before job is run
+      CelesteDllExport void addContinuation(Job* job, Job* continuation);
+
+      /// \brief Blocks until the inputted job and all of its children have finished, executing other jobs in the meantime
+      CelesteDllExport void wait(const Job* job);
+
+      static bool isFinished(const Job* job) { return job->m_unfinishedJobs.load() == 0; }
+
+      /// \brief Calls function(begin, end) over the range [0, count) split into jobs, and waits for them all to finish
+      /// Each job handles at least minBatchSize items - batches are made larger if there would otherwise be far more jobs than threads
+      template <typename Function>
+      void parallelFor(size_t count, size_t minBatchSize, const Function& function);
+
+      /// \brief Calls function(object) for every allocated object in the allocator in parallel, and waits for them all to finish
+      /// The allocator must not be allocated from or deallocated from until this returns
+      template <typename T, typename Function>
+      void parallelForEach(ResizeableAllocator<T>& allocator, const Function& function, size_t minBatchSize = DEFAULT_BATCH_SIZE);
+
+      template <typename T, typename Function>
+      void parallelForEach(DenseAllocator<T>& allocator, const Function& function, size_t minBatchSize = DEFAULT_BATCH_SIZE);
+
+      /// \brief Returns the index of the calling thread, for indexing per thread data from inside jobs
+      /// This is in [0, getThreadCount()) for the creating thread and workers.
+      /// Every other thread shares the index getThreadCount(), so per thread data should have getThreadCount() + 1 entries.
+      CelesteDllExport size_t getCurrentThreadIndex() const;
+
+      CelesteDllExport static size_t getDefaultWorkerThreadCount();
+
+    private:
+      static constexpr size_t DEFAULT_BATCH_SIZE = 64;
+      static constexpr size_t BATCHES_PER_THREAD = 8;
+
+      struct ThreadData
+      {
+        WorkStealingQueue m_queue;
+        std::unique_ptr<Job[]> m_jobs;
+        size_t m_allocatedJobCount = 0;
+      };
+
+      CelesteDllExport Job* allocateJob();
+
+      void workerMain(size_t threadIndex);
+      Job* getJob(size_t threadIndex);
+      void execute(Job* job);
+      void finish(Job* job);
+
+      std::vector<std::unique_ptr<ThreadData>> m_threadData;
+      std::vector<std::thread> m_workerThreads;
+      size_t m_threadCount;
+      std::thread::id m_creatingThread;
+
+      /// \brief Threads other than the workers and the creating thread share the last ThreadData, guarded by this
+      std::mutex m_externalThreadLock;
+
+      std::atomic<bool> m_running;
+      std::atomic<int64_t> m_queuedJobCount;
+      std::atomic<size_t> m_sleepingWorkerCount;
+      std::mutex m_sleepLock;
+      std::condition_variable m_wakeCondition;
+  };
+
+  //------------------------------------------------------------------------------------------------
+  template <typename Function>
+  Job* JobSystem::createJob(Function&& function, Job* parent)
+  {
+    using StoredFunction = typename std::decay<Function>::type;
+    static_assert(sizeof(StoredFunction) <= Job::DATA_SIZE, "Job function is too large to store inline - capture by pointer instead");
+    static_assert(alignof(StoredFunction) <= alignof(std::max_align_t), "Job function is over-aligned");
+    static_assert(std::is_trivially_destructible<StoredFunction>::value, "Job functions are never destroyed so must be trivially destructible");
+
+    Job* job = allocateJob();
+    new (job->m_data) StoredFunction(std::forward<Function>(function));
+    job->m_function = [](Job& j) { (*reinterpret_cast<StoredFunction*>(j.m_data))(); };
+    job->m_parent = parent;
+    job->m_unfinishedJobs.store(1);
+    job->m_continuationCount.store(0);
+
+    if (parent != nullptr)
+    {
+      parent->m_unfinishedJobs.fetch_add(1);
+    }
+
+    return job;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename Function>
+  void JobSystem::parallelFor(size_t count, size_t minBatchSize, const Function& function)
+  {
+    if (count == 0)
+    {
+      return;
+    }
+
+    // Enough batches for threads to steal from one another if some finish early, but not so many that overhead dominates
+    size_t maxBatchCount = m_threadCount * BATCHES_PER_THREAD;
+    size_t batchSize = std::max(std::max<size_t>(minBatchSize, 1), (count + maxBatchCount - 1) / maxBatchCount);
+
+    if (batchSize >= count)
+    {
+      function(static_cast<size_t>(0), count);
+      return;
+    }
+
+    Job* root = createJob([]() {});
+    const Function* functionPtr = &function;
+
+    for (size_t begin = 0; begin < count; begin += batchSize)
+    {
+      size_t end = std::min(begin + batchSize, count);
+      run(createJob([functionPtr, begin, end]() { (*functionPtr)(begin, end); }, root));
+    }
+
+    run(root);
+    wait(root);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T, typename Function>
+  void JobSystem::parallelForEach(ResizeableAllocator<T>& allocator, const Function& function, size_t minBatchSize)
+  {
+    for (size_t poolIndex = 0, poolCount = allocator.getPoolCount(); poolIndex < poolCount; ++poolIndex)
+    {
+      PoolAllocator<T>& pool = allocator.getPool(poolIndex);
+      if (pool.size() == 0)
+      {
+        continue;
+      }
+
+      // Split the pool on whole occupancy words, so every job can skip its empty words itself
+      size_t capacity = pool.capacity();
+      parallelFor(wordCount(capacity), std::max<size_t>(minBatchSize / BITS_PER_WORD, 1),
+        [&pool, &function, capacity](size_t firstWord, size_t lastWord)
+        {
+          size_t lastSlot = std::min(lastWord * BITS_PER_WORD, capacity);
+
+          for (auto it = pool.begin(firstWord * BITS_PER_WORD, lastSlot), endIt = pool.end(lastSlot); it != endIt; ++it)
+          {
+            function(*it);
+          }
+        });
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  template <typename T, typename Function>
+  void JobSystem::parallelForEach(DenseAllocator<T>& allocator, const Function& function, size_t minBatchSize)
+  {
+    parallelFor(allocator.size(), minBatchSize,
+      [&allocator, &function](size_t begin, size_t end)
+      {
+        for (size_t i = begin; i < end; ++i)
+        {
+          function(allocator[i]);
+        }
+      });
+  }
+
+  /// \brief Returns the job system owned by the current game
+  CelesteDllExport JobSystem& getJobSystem();
+}
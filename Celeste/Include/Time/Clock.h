@@ -9,6 +9,7 @@
 namespace Celeste
 {
   #define DEFAULT_TARGET_FPS 60
+  #define DEFAULT_MAX_SUBSTEPS 5
 
   class Clock
   {
@@ -34,6 +35,19 @@ namespace Celeste
       /// \brief Reset the clock cycles counter to zero
       CelesteDllExport void reset();
 
+      /// \brief Adds the time since the clock was last updated to the lag, then removes and returns as many whole
+      /// target frames as fit into it, up to the max substeps.  Call once per frame after update and simulate
+      /// a fixed step of getTargetSecondsPerFrame() for each one.
+      /// If more steps are needed than are allowed, the extra time is dropped so a slow frame cannot cause an even slower one.
+      CelesteDllExport size_t consumeFixedSteps();
+
+      /// \brief The time left over after the last call to consumeFixedSteps, which has not yet been simulated
+      /// This is always less than one target frame, and can be used to compensate when rendering
+      float getLag() const { return m_lag; }
+
+      void setMaxSubsteps(size_t maxSubsteps) { m_maxSubsteps = maxSubsteps; }
+      size_t getMaxSubsteps() const { return m_maxSubsteps; }
+
       /// \brief Return the total cycles since the last reset rather than the time in seconds
       /// as a float does not have enough accuracy
       uint64_t getElapsedCycles() const { return m_cycles; }
@@ -58,6 +72,8 @@ namespace Celeste
       float m_previous;
       float m_timeScale;
       float m_targetSecondsPerFrame;
+      float m_lag;
+      size_t m_maxSubsteps;
       bool m_paused;
   };
 
@@ -31,6 +31,26 @@
     CUSTOM_MEMORY_DECLARATION(ComponentType, DllExport) \
     COMPONENT_MEMBER_DECLARATION(ComponentType, DllExport)
 
+  //------------------------------------------------------------------------------------------------
+#define DECLARE_MANAGED_COMPONENT_WITH_ALLOCATOR(ComponentType, Manager, AllocatorType, DllExport) \
+  public: \
+    static constexpr bool isManaged() { return true; } \
+    \
+  private: \
+    CUSTOM_MEMORY_DECLARATION_WITH_ALLOCATOR(ComponentType, AllocatorType, DllExport) \
+    COMPONENT_MEMBER_DECLARATION(ComponentType, DllExport); \
+    \
+    friend class Manager;
+
+  //------------------------------------------------------------------------------------------------
+#define DECLARE_UNMANAGED_COMPONENT_WITH_ALLOCATOR(ComponentType, AllocatorType, DllExport) \
+  public: \
+    static constexpr bool isManaged() { return false; } \
+    \
+  private: \
+    CUSTOM_MEMORY_DECLARATION_WITH_ALLOCATOR(ComponentType, AllocatorType, DllExport) \
+    COMPONENT_MEMBER_DECLARATION(ComponentType, DllExport)
+
   //------------------------------------------------------------------------------------------------
 #define ADD_COMPONENT_TO_REGISTRY(ComponentType) \
   bool ComponentType::m_registered = Celeste::ComponentRegistry::registerComponent(ComponentType::type_name(), [](Celeste::GameObject& gameObject) { return gameObject.addComponent<ComponentType>(); });
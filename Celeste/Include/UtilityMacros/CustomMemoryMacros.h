@@ -1,22 +1,40 @@
 #pragma once
 
 #include "Memory/Allocators/ResizeableAllocator.h"
+#include "Memory/Allocators/DenseAllocator.h"
+#include "Memory/Handle.h"
+#include "Memory/AllocatorRegistry.h"
 
 //------------------------------------------------------------------------------------------------
-#define CUSTOM_MEMORY_DECLARATION(Type, DllExport) \
+// AllocatorType is the allocator template to use for this type, e.g. Celeste::ResizeableAllocator or Celeste::DenseAllocator
+#define CUSTOM_MEMORY_DECLARATION_WITH_ALLOCATOR(Type, AllocatorType, DllExport) \
   public: \
     static constexpr const char* const type_name() { return #Type; } \
     \
     DllExport void* operator new(size_t); \
     DllExport void operator delete(void*); \
     \
+    /* Returns a handle which can be used to detect if this object has been destroyed */ \
+    DllExport Celeste::Handle<Type> handle() const; \
+    \
+    /* Returns the object the inputted handle refers to, or nullptr if it has been destroyed */ \
+    DllExport static observer_ptr<Type> resolve(Celeste::Handle<Type> handle); \
+    \
   private: \
-    using Allocator = Celeste::ResizeableAllocator<Type>; \
-    static Allocator m_allocator;
+    using Allocator = AllocatorType<Type>; \
+    static Allocator m_allocator; \
+    static const bool m_allocatorRegistered;
+
+//------------------------------------------------------------------------------------------------
+#define CUSTOM_MEMORY_DECLARATION(Type, DllExport) \
+  CUSTOM_MEMORY_DECLARATION_WITH_ALLOCATOR(Type, Celeste::ResizeableAllocator, DllExport)
 
   //------------------------------------------------------------------------------------------------
 #define CUSTOM_MEMORY_CREATION(Type, PoolSize) \
   Type::Allocator Type::m_allocator = Type::Allocator(PoolSize); \
+  const bool Type::m_allocatorRegistered = Celeste::AllocatorRegistry::registerAllocator(#Type, \
+    []() { return m_allocator.getStats(); }, \
+    [](size_t capacity) { m_allocator.reserve(capacity); }); \
   \
   void* Type::operator new(size_t) \
   { \
@@ -32,4 +50,14 @@
     { \
       m_allocator.deallocate(type); \
     } \
+  } \
+  \
+  Celeste::Handle<Type> Type::handle() const \
+  { \
+    return m_allocator.getHandle(*this); \
+  } \
+  \
+  observer_ptr<Type> Type::resolve(Celeste::Handle<Type> handle) \
+  { \
+    return m_allocator.resolve(handle); \
   }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if _MSC_VER
+#include <intrin.h>
+#endif
+
+
+namespace Celeste
+{
+  /// The number of bits stored in each word of an occupancy bitset
+  static constexpr size_t BITS_PER_WORD = 64;
+
+  /// Returns the number of 64 bit words needed to store the inputted number of bits
+  inline constexpr size_t wordCount(size_t bitCount)
+  {
+    return (bitCount + BITS_PER_WORD - 1) / BITS_PER_WORD;
+  }
+
+  /// Returns true if the bit at the inputted index is set in the inputted bitset
+  inline bool isBitSet(const uint64_t* words, size_t index)
+  {
+    return ((words[index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1) != 0;
+  }
+
+  inline void setBit(uint64_t* words, size_t index)
+  {
+    words[index / BITS_PER_WORD] |= (static_cast<uint64_t>(1) << (index % BITS_PER_WORD));
+  }
+
+  inline void clearBit(uint64_t* words, size_t index)
+  {
+    words[index / BITS_PER_WORD] &= ~(static_cast<uint64_t>(1) << (index % BITS_PER_WORD));
+  }
+
+  /// Returns the index of the lowest set bit in the inputted word
+  /// The word must be non-zero
+  inline size_t countTrailingZeros(uint64_t word)
+  {
+#if _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return static_cast<size_t>(index);
+#else
+    return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+  }
+}
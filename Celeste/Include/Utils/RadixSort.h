@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+namespace Celeste
+{
+  /// Stable least significant digit radix sort of the inputted items by a 64 bit key, one byte per pass
+  /// Items with equal keys keep the order they were inputted in.  Passes over a byte which every key shares are
+  /// skipped, so keys which only use a few of their bits take only a few passes.
+  /// The scratch vector is used as the second buffer, so reusing it between sorts avoids reallocating.
+  template <typename T, typename GetKey>
+  void radixSort(std::vector<T>& items, std::vector<T>& scratch, GetKey getKey)
+  {
+    const size_t count = items.size();
+    if (count < 2)
+    {
+      return;
+    }
+
+    // Every byte's histogram is built in one read of the keys up front
+    size_t histograms[sizeof(uint64_t)][256] = {};
+    for (const T& item : items)
+    {
+      uint64_t key = getKey(item);
+      for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+      {
+        ++histograms[byte][(key >> (byte * 8)) & 0xFF];
+      }
+    }
+
+    scratch.resize(count);
+
+    for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+    {
+      size_t* histogram = histograms[byte];
+      const size_t shift = byte * 8;
+
+      if (histogram[(getKey(items[0]) >> shift) & 0xFF] == count)
+      {
+        continue;
+      }
+
+      size_t offset = 0;
+      for (size_t digit = 0; digit < 256; ++digit)
+      {
+        size_t digitCount = histogram[digit];
+        histogram[digit] = offset;
+        offset += digitCount;
+      }
+
+      for (T& item : items)
+      {
+        scratch[histogram[(getKey(item) >> shift) & 0xFF]++] = std::move(item);
+      }
+
+      items.swap(scratch);
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+
+namespace sol
+{
+  class state;
+}
+
+namespace Celeste::Lua::Memory::ScriptCommands
+{
+  void initialize(sol::state& state);
+}
@@ -20,6 +20,7 @@
 #include "ScriptCommands/Lua/Components/LuaComponentManifestRegistryScriptCommands.h"
 #include "ScriptCommands/System/SystemScriptCommands.h"
 #include "ScriptCommands/Layout/LayoutScriptCommands.h"
+#include "ScriptCommands/Memory/MemoryScriptCommands.h"
 #include "Lua/LuaState.h"
 
 #include "Resources/ResourceUtils.h"
@@ -57,6 +58,7 @@ namespace Celeste::Lua::CelesteScriptCommands
     Lua::LuaComponentManifestRegistryScriptCommands::initialize(state);
     Lua::Time::ScriptCommands::initialize(state);
     Lua::Layout::ScriptCommands::initialize(state);
+    Lua::Memory::ScriptCommands::initialize(state);
     
     // Need these for both debug and release so our lua scripts will work no matter what
     Dolce::Lua::ScriptCommands::initialize(state, Debug::getDolce());
@@ -0,0 +1,55 @@
+#include "ScriptCommands/Memory/MemoryScriptCommands.h"
+#include "Lua/LuaState.h"
+
+#include "Memory/AllocatorRegistry.h"
+
+
+namespace Celeste::Lua::Memory::ScriptCommands
+{
+  namespace Internals
+  {
+    //------------------------------------------------------------------------------------------------
+    sol::object getStats(const std::string& allocatorName)
+    {
+      if (!AllocatorRegistry::isRegistered(allocatorName))
+      {
+        return sol::make_object(LuaState::instance(), sol::nil);
+      }
+
+      return sol::make_object(LuaState::instance(), AllocatorRegistry::getStats(allocatorName));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    auto getAllStats()
+    {
+      return sol::as_table(AllocatorRegistry::getAllStats());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void dump(const std::string& filePath)
+    {
+      AllocatorRegistry::dump(Path(filePath));
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void initialize(sol::state& state)
+  {
+    state.new_usertype<AllocatorStats>(
+      "AllocatorStats",
+      "name", sol::readonly(&AllocatorStats::m_name),
+      "capacity", sol::readonly(&AllocatorStats::m_capacity),
+      "liveCount", sol::readonly(&AllocatorStats::m_liveCount),
+      "highWaterMark", sol::readonly(&AllocatorStats::m_highWaterMark),
+      "growCount", sol::readonly(&AllocatorStats::m_growCount),
+      "reserveCount", sol::readonly(&AllocatorStats::m_reserveCount),
+      "allocationCount", sol::readonly(&AllocatorStats::m_allocationCount),
+      "allocationTimeNs", sol::readonly(&AllocatorStats::m_allocationTimeNs));
+
+    sol::table allocatorsTable = state.create_named_table("Allocators");
+    allocatorsTable["getAllocatorCount"] = &AllocatorRegistry::getAllocatorCount;
+    allocatorsTable["getStats"] = &Internals::getStats;
+    allocatorsTable["getAllStats"] = &Internals::getAllStats;
+    allocatorsTable["dump"] = &Internals::dump;
+  }
+}
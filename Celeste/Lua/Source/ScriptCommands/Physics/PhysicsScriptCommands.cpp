@@ -2,12 +2,131 @@
 #include "ScriptCommands/Physics/EllipseColliderScriptCommands.h"
 #include "sol/sol.hpp"
 
+#include "Physics/PhysicsManager.h"
+#include "Physics/PhysicsUtils.h"
+#include "Physics/Collider.h"
+#include "Objects/GameObject.h"
+
+#include <vector>
+
+using RaycastQuery = Celeste::Physics::RaycastQuery;
+using RaycastHit = Celeste::Physics::RaycastHit;
+using CircleQuery = Celeste::Physics::CircleQuery;
+using AABB = Celeste::Physics::AABB;
+using Collider = Celeste::Physics::Collider;
+
 
 namespace Celeste::Lua::Physics::ScriptCommands
 {
+  namespace Internals
+  {
+    /// Scripts all run on the main thread, so the queries can share these buffers rather than allocating every call
+    static std::vector<RaycastQuery> rays;
+    static std::vector<RaycastHit> hits;
+    static std::vector<observer_ptr<Collider>> colliders;
+
+    //------------------------------------------------------------------------------------------------
+    sol::table toGameObjects(sol::this_state state, size_t colliderCount)
+    {
+      sol::state_view lua(state);
+      sol::table gameObjects = lua.create_table(static_cast<int>(colliderCount), 0);
+
+      for (size_t i = 0; i < colliderCount; ++i)
+      {
+        gameObjects[i + 1] = &colliders[i]->getGameObject();
+      }
+
+      return gameObjects;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    std::tuple<observer_ptr<GameObject>, glm::vec2> raycast(const glm::vec2& start, const glm::vec2& end)
+    {
+      RaycastQuery ray{ start, end };
+      RaycastHit hit;
+      Celeste::Physics::getPhysicsManager().raycast(&ray, 1, &hit);
+
+      return std::make_tuple(hit.isHit() ? &hit.m_collider->getGameObject() : nullptr, hit.m_point);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sol::table raycastBatch(sol::this_state state, const sol::table& starts, const sol::table& ends)
+    {
+      size_t rayCount = std::min(starts.size(), ends.size());
+      rays.resize(rayCount);
+      hits.resize(rayCount);
+
+      for (size_t i = 0; i < rayCount; ++i)
+      {
+        rays[i].m_start = starts.get<glm::vec2>(i + 1);
+        rays[i].m_end = ends.get<glm::vec2>(i + 1);
+      }
+
+      Celeste::Physics::getPhysicsManager().raycast(rays.data(), rayCount, hits.data());
+
+      // Misses are false rather than nil, so the table has no holes and its length is always the number of rays
+      sol::state_view lua(state);
+      sol::table results = lua.create_table(static_cast<int>(rayCount), 0);
+
+      for (size_t i = 0; i < rayCount; ++i)
+      {
+        if (hits[i].isHit())
+        {
+          results[i + 1] = &hits[i].m_collider->getGameObject();
+        }
+        else
+        {
+          results[i + 1] = false;
+        }
+      }
+
+      return results;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sol::table overlapBox(sol::this_state state, const glm::vec2& centre, const glm::vec2& dimensions)
+    {
+      Celeste::Physics::PhysicsManager& physicsManager = Celeste::Physics::getPhysicsManager();
+      AABB box = AABB::fromCentre(centre, dimensions);
+      size_t count = 0;
+
+      // Grow the buffer until every result fits - it soon settles at the largest number of results any script needs
+      colliders.resize(std::max<size_t>(colliders.size(), 16));
+      while (physicsManager.overlapBoxes(&box, 1, colliders.data(), colliders.size(), &count) == colliders.size())
+      {
+        colliders.resize(colliders.size() * 2);
+      }
+
+      return toGameObjects(state, count);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sol::table overlapCircle(sol::this_state state, const glm::vec2& centre, float radius)
+    {
+      Celeste::Physics::PhysicsManager& physicsManager = Celeste::Physics::getPhysicsManager();
+      CircleQuery circle{ centre, radius };
+      size_t count = 0;
+
+      colliders.resize(std::max<size_t>(colliders.size(), 16));
+      while (physicsManager.overlapCircles(&circle, 1, colliders.data(), colliders.size(), &count) == colliders.size())
+      {
+        colliders.resize(colliders.size() * 2);
+      }
+
+      return toGameObjects(state, count);
+    }
+  }
+
   //------------------------------------------------------------------------------------------------
   void initialize(sol::state& state)
   {
     EllipseColliderScriptCommands::initialize(state);
+
+    state.create_named_table(
+      "Physics",
+      "raycast", &Internals::raycast,
+      "raycastBatch", &Internals::raycastBatch,
+      "overlapBox", &Internals::overlapBox,
+      "overlapCircle", &Internals::overlapCircle);
   }
-}
\ No newline at end of file
+}
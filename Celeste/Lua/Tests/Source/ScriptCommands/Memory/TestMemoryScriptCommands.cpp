@@ -0,0 +1,103 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "ScriptCommands/Memory/MemoryScriptCommands.h"
+#include "Lua/LuaState.h"
+
+#include "Memory/AllocatorRegistry.h"
+
+using LuaState = Celeste::Lua::LuaState;
+
+using namespace Celeste;
+
+
+namespace TestCeleste::Lua::ScriptCommands
+{
+  CELESTE_TEST_CLASS(TestMemoryScriptCommands)
+
+#pragma region Initialize Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(MemoryScriptCommands_Initialize_CreatesAllocatorsTable)
+  {
+    sol::state& state = LuaState::instance();
+
+    Assert::IsFalse(state["Allocators"].valid());
+
+    Celeste::Lua::Memory::ScriptCommands::initialize(state);
+
+    Assert::IsTrue(state["Allocators"].valid());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(MemoryScriptCommands_Initialize_AddsAllocatorStatsUserType)
+  {
+    sol::state& state = LuaState::instance();
+
+    Assert::IsFalse(state["AllocatorStats"].valid());
+
+    Celeste::Lua::Memory::ScriptCommands::initialize(state);
+
+    Assert::IsTrue(state["AllocatorStats"].valid());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(MemoryScriptCommands_Initialize_AddsFunctions_ToAllocatorsTable)
+  {
+    sol::state& state = LuaState::instance();
+
+    Celeste::Lua::Memory::ScriptCommands::initialize(state);
+
+    Assert::IsTrue(state["Allocators"]["getAllocatorCount"].valid());
+    Assert::IsTrue(state["Allocators"]["getStats"].valid());
+    Assert::IsTrue(state["Allocators"]["getAllStats"].valid());
+    Assert::IsTrue(state["Allocators"]["dump"].valid());
+  }
+
+#pragma endregion
+
+#pragma region Get Stats Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(MemoryScriptCommands_getStats_InputtingUnregisteredName_ReturnsNil)
+  {
+    sol::state& state = LuaState::instance();
+
+    Celeste::Lua::Memory::ScriptCommands::initialize(state);
+
+    auto result = state["Allocators"]["getStats"].get<sol::protected_function>().call("WubbaLubbaDubDub");
+
+    Assert::IsTrue(result.valid());
+    Assert::IsTrue(result.get<sol::object>() == sol::nil);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(MemoryScriptCommands_getStats_InputtingRegisteredName_ReturnsStats)
+  {
+    sol::state& state = LuaState::instance();
+
+    Celeste::Lua::Memory::ScriptCommands::initialize(state);
+
+    auto result = state.script("local stats = Allocators.getStats('GameObject') return stats.name, stats.capacity");
+
+    Assert::IsTrue(result.valid());
+    Assert::AreEqual(std::string("GameObject"), result.get<std::string>(0));
+    Assert::AreEqual(AllocatorRegistry::getStats("GameObject").m_capacity, result.get<size_t>(1));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(MemoryScriptCommands_getAllStats_ReturnsTableWithEntryForEveryAllocator)
+  {
+    sol::state& state = LuaState::instance();
+
+    Celeste::Lua::Memory::ScriptCommands::initialize(state);
+
+    auto result = state.script("return #Allocators.getAllStats()");
+
+    Assert::IsTrue(result.valid());
+    Assert::AreEqual(AllocatorRegistry::getAllocatorCount(), result.get<size_t>());
+  }
+
+#pragma endregion
+
+  };
+}
@@ -4,10 +4,14 @@
 #include "ScriptCommands/Objects/ComponentScriptCommands.h"
 #include "Lua/LuaState.h"
 
-#include "Objects/Component.h"
+#include "Objects/GameObject.h"
+#include "Physics/PhysicsManager.h"
+#include "Physics/PhysicsUtils.h"
+#include "Physics/RectangleCollider.h"
 
 using LuaState = Celeste::Lua::LuaState;
 using namespace Celeste;
+using namespace Celeste::Physics;
 
 
 namespace TestCeleste::Lua::Physics
@@ -32,7 +36,338 @@ namespace TestCeleste::Lua::Physics
     Assert::IsTrue(LuaState::instance().globals()["EllipseCollider"].valid());
   }
 
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_Initialize_AddsPhysicsTable)
+  {
+    Assert::IsFalse(LuaState::instance().globals()["Physics"].valid());
+
+    Celeste::Lua::Physics::ScriptCommands::initialize(LuaState::instance());
+
+    Assert::IsTrue(LuaState::instance().globals()["Physics"].valid());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_Initialize_AddsQueryFunctions_ToPhysicsTable)
+  {
+    Celeste::Lua::Physics::ScriptCommands::initialize(LuaState::instance());
+
+    sol::table physicsTable = LuaState::instance().globals()["Physics"];
+
+    Assert::IsTrue(physicsTable["raycast"].valid());
+    Assert::IsTrue(physicsTable["raycastBatch"].valid());
+    Assert::IsTrue(physicsTable["overlapBox"].valid());
+    Assert::IsTrue(physicsTable["overlapCircle"].valid());
+  }
+
+#pragma endregion
+
+#pragma region Raycast Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_Raycast_HittingCollider_ReturnsNearestGameObjectAndPoint)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    GameObject farthest;
+    farthest.getTransform()->setTranslation(50, 0);
+    farthest.addComponent<RectangleCollider>()->setDimensions(2, 10);
+
+    GameObject nearest;
+    nearest.getTransform()->setTranslation(20, 0);
+    nearest.addComponent<RectangleCollider>()->setDimensions(2, 10);
+
+    auto result = state.globals()["Physics"]["raycast"].get<sol::protected_function>().call(glm::vec2(0, 0), glm::vec2(100, 0));
+
+    Assert::IsTrue(result.valid());
+    Assert::IsTrue(&nearest == result.get<observer_ptr<GameObject>>(0));
+
+    glm::vec2 point = result.get<glm::vec2>(1);
+    Assert::AreEqual(19.0f, point.x, 0.001f);
+    Assert::AreEqual(0.0f, point.y, 0.001f);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_Raycast_MissingEveryCollider_ReturnsNil)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    GameObject gameObject;
+    gameObject.getTransform()->setTranslation(20, 0);
+    gameObject.addComponent<RectangleCollider>()->setDimensions(2, 10);
+
+    auto result = state.globals()["Physics"]["raycast"].get<sol::protected_function>().call(glm::vec2(0, 20), glm::vec2(100, 20));
+
+    Assert::IsTrue(result.valid());
+    Assert::IsTrue(sol::type::nil == result.get_type(0));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_Raycast_NearestColliderDestroyedSinceUpdate_ReturnsNextGameObject)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    std::unique_ptr<GameObject> nearest = std::make_unique<GameObject>();
+    nearest->getTransform()->setTranslation(20, 0);
+    nearest->addComponent<RectangleCollider>()->setDimensions(2, 10);
+
+    GameObject farthest;
+    farthest.getTransform()->setTranslation(50, 0);
+    farthest.addComponent<RectangleCollider>()->setDimensions(2, 10);
+
+    getPhysicsManager().update(0);
+
+    // Destroyed part way through the frame, e.g. by another script, before the next update rebuilds the broadphase
+    nearest.reset();
+
+    auto result = state.globals()["Physics"]["raycast"].get<sol::protected_function>().call(glm::vec2(0, 0), glm::vec2(100, 0));
+
+    Assert::IsTrue(result.valid());
+    Assert::IsTrue(&farthest == result.get<observer_ptr<GameObject>>(0));
+  }
+
+#pragma endregion
+
+#pragma region Raycast Batch Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_RaycastBatch_ReturnsGameObjectHitByEachRay_AndFalseForMisses)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    GameObject right;
+    right.getTransform()->setTranslation(20, 0);
+    right.addComponent<RectangleCollider>()->setDimensions(2, 10);
+
+    GameObject up;
+    up.getTransform()->setTranslation(0, 20);
+    up.addComponent<RectangleCollider>()->setDimensions(10, 2);
+
+    sol::table starts = state.create_table();
+    starts.add(glm::vec2(0, 0));
+    starts.add(glm::vec2(0, 0));
+    starts.add(glm::vec2(0, 0));
+
+    sol::table ends = state.create_table();
+    ends.add(glm::vec2(100, 0));
+    ends.add(glm::vec2(0, -100));
+    ends.add(glm::vec2(0, 100));
+
+    auto result = state.globals()["Physics"]["raycastBatch"].get<sol::protected_function>().call(starts, ends);
+
+    Assert::IsTrue(result.valid());
+
+    sol::table hits = result;
+
+    Assert::AreEqual(static_cast<size_t>(3), hits.size());
+    Assert::IsTrue(&right == hits.get<observer_ptr<GameObject>>(1));
+    Assert::IsFalse(hits.get<bool>(2));
+    Assert::IsTrue(&up == hits.get<observer_ptr<GameObject>>(3));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_RaycastBatch_ColliderDestroyedSinceUpdate_ReturnsFalseForRaysOnlyHittingIt)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    std::unique_ptr<GameObject> destroyed = std::make_unique<GameObject>();
+    destroyed->getTransform()->setTranslation(20, 0);
+    destroyed->addComponent<RectangleCollider>()->setDimensions(2, 10);
+
+    GameObject kept;
+    kept.getTransform()->setTranslation(0, 20);
+    kept.addComponent<RectangleCollider>()->setDimensions(10, 2);
+
+    getPhysicsManager().update(0);
+    destroyed.reset();
+
+    sol::table starts = state.create_table();
+    starts.add(glm::vec2(0, 0));
+    starts.add(glm::vec2(0, 0));
+
+    sol::table ends = state.create_table();
+    ends.add(glm::vec2(100, 0));
+    ends.add(glm::vec2(0, 100));
+
+    auto result = state.globals()["Physics"]["raycastBatch"].get<sol::protected_function>().call(starts, ends);
+
+    Assert::IsTrue(result.valid());
+
+    sol::table hits = result;
+
+    Assert::AreEqual(static_cast<size_t>(2), hits.size());
+    Assert::IsFalse(hits.get<bool>(1));
+    Assert::IsTrue(&kept == hits.get<observer_ptr<GameObject>>(2));
+  }
+
+#pragma endregion
+
+#pragma region Overlap Box Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_OverlapBox_OverlappingSeveralColliders_ReturnsAllOfTheirGameObjects)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    GameObject left;
+    left.addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    GameObject right;
+    right.getTransform()->setTranslation(10, 0);
+    right.addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    GameObject outside;
+    outside.getTransform()->setTranslation(100, 0);
+    outside.addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    auto result = state.globals()["Physics"]["overlapBox"].get<sol::protected_function>().call(glm::vec2(5, 0), glm::vec2(20, 4));
+
+    Assert::IsTrue(result.valid());
+
+    sol::table gameObjects = result;
+    observer_ptr<GameObject> first = gameObjects.get<observer_ptr<GameObject>>(1);
+    observer_ptr<GameObject> second = gameObjects.get<observer_ptr<GameObject>>(2);
+
+    // Results come back in broadphase order, so only check both game objects are there
+    Assert::AreEqual(static_cast<size_t>(2), gameObjects.size());
+    Assert::IsTrue((first == &left && second == &right) || (first == &right && second == &left));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_OverlapBox_OverlappingNoColliders_ReturnsEmptyTable)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    GameObject gameObject;
+    gameObject.addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    auto result = state.globals()["Physics"]["overlapBox"].get<sol::protected_function>().call(glm::vec2(100, 0), glm::vec2(2, 2));
+
+    Assert::IsTrue(result.valid());
+
+    sol::table gameObjects = result;
+
+    Assert::AreEqual(static_cast<size_t>(0), gameObjects.size());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_OverlapBox_ColliderDestroyedBetweenQueriesInSameFrame_IsNotReturnedBySecondQuery)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    std::unique_ptr<GameObject> destroyed = std::make_unique<GameObject>();
+    destroyed->addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    GameObject kept;
+    kept.addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    getPhysicsManager().update(0);
+
+    sol::protected_function overlapBox = state.globals()["Physics"]["overlapBox"];
+    auto beforeResult = overlapBox.call(glm::vec2(), glm::vec2(10, 10));
+
+    Assert::IsTrue(beforeResult.valid());
+    Assert::AreEqual(static_cast<size_t>(2), beforeResult.get<sol::table>().size());
+
+    destroyed.reset();
+    auto afterResult = overlapBox.call(glm::vec2(), glm::vec2(10, 10));
+
+    Assert::IsTrue(afterResult.valid());
+
+    sol::table gameObjects = afterResult;
+
+    Assert::AreEqual(static_cast<size_t>(1), gameObjects.size());
+    Assert::IsTrue(&kept == gameObjects.get<observer_ptr<GameObject>>(1));
+  }
+
+#pragma endregion
+
+#pragma region Overlap Circle Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_OverlapCircle_OverlappingSeveralColliders_ReturnsOnlyGameObjectsInsideCircle)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    GameObject left;
+    left.getTransform()->setTranslation(-5, 0);
+    left.addComponent<RectangleCollider>()->setDimensions(1, 1);
+
+    GameObject right;
+    right.getTransform()->setTranslation(5, 0);
+    right.addComponent<RectangleCollider>()->setDimensions(1, 1);
+
+    // Inside the corner of the circle's bounding box, but outside the circle itself
+    GameObject corner;
+    corner.getTransform()->setTranslation(9, 9);
+    corner.addComponent<RectangleCollider>()->setDimensions(1, 1);
+
+    auto result = state.globals()["Physics"]["overlapCircle"].get<sol::protected_function>().call(glm::vec2(), 10.0f);
+
+    Assert::IsTrue(result.valid());
+
+    sol::table gameObjects = result;
+    observer_ptr<GameObject> first = gameObjects.get<observer_ptr<GameObject>>(1);
+    observer_ptr<GameObject> second = gameObjects.get<observer_ptr<GameObject>>(2);
+
+    Assert::AreEqual(static_cast<size_t>(2), gameObjects.size());
+    Assert::IsTrue((first == &left && second == &right) || (first == &right && second == &left));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_OverlapCircle_OverlappingNoColliders_ReturnsEmptyTable)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    GameObject gameObject;
+    gameObject.getTransform()->setTranslation(9, 9);
+    gameObject.addComponent<RectangleCollider>()->setDimensions(1, 1);
+
+    auto result = state.globals()["Physics"]["overlapCircle"].get<sol::protected_function>().call(glm::vec2(), 10.0f);
+
+    Assert::IsTrue(result.valid());
+
+    sol::table gameObjects = result;
+
+    Assert::AreEqual(static_cast<size_t>(0), gameObjects.size());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsScriptCommands_OverlapCircle_ColliderDestroyedSinceUpdate_IsNotReturned)
+  {
+    sol::state& state = LuaState::instance();
+    Celeste::Lua::Physics::ScriptCommands::initialize(state);
+
+    std::unique_ptr<GameObject> destroyed = std::make_unique<GameObject>();
+    destroyed->addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    GameObject kept;
+    kept.getTransform()->setTranslation(3, 0);
+    kept.addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    getPhysicsManager().update(0);
+    destroyed.reset();
+
+    auto result = state.globals()["Physics"]["overlapCircle"].get<sol::protected_function>().call(glm::vec2(), 10.0f);
+
+    Assert::IsTrue(result.valid());
+
+    sol::table gameObjects = result;
+
+    Assert::AreEqual(static_cast<size_t>(1), gameObjects.size());
+    Assert::IsTrue(&kept == gameObjects.get<observer_ptr<GameObject>>(1));
+  }
+
 #pragma endregion
 
   };
-}
\ No newline at end of file
+}
@@ -16,6 +16,7 @@ namespace Celeste
   const char* const RigidBody2DDataConverter::ANGULAR_VELOCITY_ATTRIBUTE_NAME("angular_velocity");
   const char* const RigidBody2DDataConverter::MIN_ANGULAR_VELOCITY_ATTRIBUTE_NAME("min_angular_velocity");
   const char* const RigidBody2DDataConverter::MAX_ANGULAR_VELOCITY_ATTRIBUTE_NAME("max_angular_velocity");
+  const char* const RigidBody2DDataConverter::BULLET_ATTRIBUTE_NAME("bullet");
 
   //------------------------------------------------------------------------------------------------
   RigidBody2DDataConverter::RigidBody2DDataConverter() :
@@ -25,7 +26,8 @@ namespace Celeste
     m_maxLinearVelocity(createReferenceAttribute(MAX_LINEAR_VELOCITY_ATTRIBUTE_NAME, glm::vec2((std::numeric_limits<float>::max)(), (std::numeric_limits<float>::max)()))),
     m_angularVelocity(createValueAttribute<float>(ANGULAR_VELOCITY_ATTRIBUTE_NAME)),
     m_minAngularVelocity(createValueAttribute(MIN_ANGULAR_VELOCITY_ATTRIBUTE_NAME, -(std::numeric_limits<float>::max)())),
-    m_maxAngularVelocity(createValueAttribute(MAX_ANGULAR_VELOCITY_ATTRIBUTE_NAME, (std::numeric_limits<float>::max)()))
+    m_maxAngularVelocity(createValueAttribute(MAX_ANGULAR_VELOCITY_ATTRIBUTE_NAME, (std::numeric_limits<float>::max)())),
+    m_bullet(createValueAttribute<bool>(BULLET_ATTRIBUTE_NAME))
   {
   }
 
@@ -38,5 +40,6 @@ namespace Celeste
     rigidBody.setAngularVelocity(getAngularVelocity());
     rigidBody.setMinAngularVelocity(getMinAngularVelocity());
     rigidBody.setMaxAngularVelocity(getMaxAngularVelocity());
+    rigidBody.setBullet(isBullet());
   }
 }
\ No newline at end of file
@@ -1,5 +1,10 @@
 #include "DataConverters/Scene/SceneDataConverter.h"
+#include "DataConverters/Objects/ComponentDataConverter.h"
 #include "Resources/ResourceManager.h"
+#include "Resources/Data/Prefab.h"
+#include "Maths/Transform.h"
+
+#include <algorithm>
 
 
 namespace Celeste
@@ -19,6 +24,45 @@ namespace Celeste
   const char* const SceneDataConverter::PRELOADABLE_SOUND_ELEMENT_NAME("Sound");
   const char* const SceneDataConverter::PRELOADABLE_TEXTURES_ELEMENT_NAME("Textures");
   const char* const SceneDataConverter::PRELOADABLE_TEXTURE_ELEMENT_NAME("Texture");
+  const char* const SceneDataConverter::CAPACITIES_ELEMENT_NAME("Capacities");
+  const char* const SceneDataConverter::CAPACITY_ELEMENT_NAME("Capacity");
+  const char* const SceneDataConverter::CAPACITY_TYPE_ATTRIBUTE_NAME("type");
+  const char* const SceneDataConverter::CAPACITY_COUNT_ATTRIBUTE_NAME("count");
+
+  namespace Internals
+  {
+    //------------------------------------------------------------------------------------------------
+    void countObjects(const GameObjectDataConverter& gameObjectConverter, SceneDataConverter::CapacityHints& capacityHints)
+    {
+      if (const PrefabDataConverter* prefabConverter = dynamic_cast<const PrefabDataConverter*>(&gameObjectConverter))
+      {
+        // Prefabs are instantiated purely from the prefab's own game objects
+        if (prefabConverter->getPrefab() != nullptr)
+        {
+          for (const GameObjectDataConverter* prefabGameObject : prefabConverter->getPrefab()->getGameObjects())
+          {
+            countObjects(*prefabGameObject, capacityHints);
+          }
+        }
+
+        return;
+      }
+
+      ++capacityHints[GameObject::type_name()];
+      ++capacityHints[Transform::type_name()];
+
+      // Component element names are the names they are registered with, which is also the name of their allocator
+      for (const ComponentDataConverter* componentConverter : gameObjectConverter.getComponents())
+      {
+        ++capacityHints[componentConverter->getElementName()];
+      }
+
+      for (const GameObjectDataConverter* childConverter : gameObjectConverter.getChildGameObjects())
+      {
+        countObjects(*childConverter, capacityHints);
+      }
+    }
+  }
 
   //------------------------------------------------------------------------------------------------
   SceneDataConverter::SceneDataConverter(const std::string& elementName) :
@@ -29,7 +73,8 @@ namespace Celeste
     m_data(createListElement<std::string>(PRELOADABLE_DATAS_ELEMENT_NAME, XML::ChildElementName(PRELOADABLE_DATA_ELEMENT_NAME))),
     m_sounds(createListElement<std::string>(PRELOADABLE_SOUNDS_ELEMENT_NAME, XML::ChildElementName(PRELOADABLE_SOUND_ELEMENT_NAME))),
     m_textures(createListElement<std::string>(PRELOADABLE_TEXTURES_ELEMENT_NAME, XML::ChildElementName(PRELOADABLE_TEXTURE_ELEMENT_NAME))),
-    m_gameObjects(createDataConverterListElement<GameObjectDataConverter>(GameObjectDataConverter::CHILD_GAME_OBJECTS_ELEMENT_NAME, DeserializationRequirement::kNotRequired))
+    m_gameObjects(createDataConverterListElement<GameObjectDataConverter>(GameObjectDataConverter::CHILD_GAME_OBJECTS_ELEMENT_NAME, DeserializationRequirement::kNotRequired)),
+    m_declaredCapacities()
   {
   }
 
@@ -44,6 +89,12 @@ namespace Celeste
       return false;
     }
 
+    if (!tryConvertCapacities(screenElement))
+    {
+      ASSERT_FAIL();
+      return false;
+    }
+
     return true;
   }
 
@@ -95,6 +146,70 @@ namespace Celeste
     return true;
   }
 
+  //------------------------------------------------------------------------------------------------
+  bool SceneDataConverter::tryConvertCapacities(const tinyxml2::XMLElement* screenElement)
+  {
+    const tinyxml2::XMLElement* capacitiesElement = screenElement->FirstChildElement(CAPACITIES_ELEMENT_NAME);
+    if (capacitiesElement == nullptr)
+    {
+      return true;
+    }
+
+    for (const tinyxml2::XMLElement* capacityElement : XML::children(capacitiesElement, CAPACITY_ELEMENT_NAME))
+    {
+      const char* typeName = capacityElement->Attribute(CAPACITY_TYPE_ATTRIBUTE_NAME);
+      unsigned int count = 0;
+
+      if (typeName == nullptr || capacityElement->QueryUnsignedAttribute(CAPACITY_COUNT_ATTRIBUTE_NAME, &count) != tinyxml2::XML_SUCCESS)
+      {
+        // Capacity elements require a type and a count
+        ASSERT_FAIL();
+        return false;
+      }
+
+      addCapacityHint(typeName, count);
+    }
+
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  SceneDataConverter::CapacityHints SceneDataConverter::getCapacityHints() const
+  {
+    CapacityHints capacityHints;
+
+    for (const GameObjectDataConverter* gameObjectConverter : getGameObjects())
+    {
+      Internals::countObjects(*gameObjectConverter, capacityHints);
+    }
+
+    for (const auto& declaredPair : m_declaredCapacities)
+    {
+      size_t& count = capacityHints[declaredPair.first];
+      count = std::max(count, declaredPair.second);
+    }
+
+    for (const auto& runtimePair : m_runtimeCapacities)
+    {
+      capacityHints[runtimePair.first] += runtimePair.second;
+    }
+
+    return capacityHints;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void SceneDataConverter::addCapacityHint(const std::string& typeName, size_t count)
+  {
+    size_t& declaredCount = m_declaredCapacities[typeName];
+    declaredCount = std::max(declaredCount, count);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void SceneDataConverter::addRuntimeCapacity(const std::string& typeName, size_t count)
+  {
+    m_runtimeCapacities[typeName] += count;
+  }
+
   //------------------------------------------------------------------------------------------------
   std::vector<GameObject*> SceneDataConverter::instantiate() const
   {
@@ -129,7 +244,12 @@ namespace Celeste
       resourceManager.load<VertexShader>(vertexShader);
     }
 
+    // Grow each allocator once up front, rather than pool by pool as the objects are created
+    AllocatorRegistry::prewarm(getCapacityHints());
+
     std::vector<GameObject*> createdGameObjects;
+    createdGameObjects.reserve(getGameObjects().size());
+
     for (const auto& gameObjectConverter : getGameObjects())
     {
       createdGameObjects.push_back(gameObjectConverter->instantiate());
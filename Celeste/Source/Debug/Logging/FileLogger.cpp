@@ -29,12 +29,6 @@ namespace Celeste::Log
     flush();
   }
 
-  //------------------------------------------------------------------------------------------------
-  /*void asyncWriteToLogFile(const std::string& logFileFullPath, const std::string& bufferedLog)
-  {
-    File::appendToFile(logFileFullPath, bufferedLog);
-  }*/
-
   //------------------------------------------------------------------------------------------------
   void FileLogger::log(
     const std::string& message,
@@ -70,51 +64,63 @@ namespace Celeste::Log
     }
 
     // Store the message into our buffer and add a new line to the end of it
-    AllocateResult allocResult = m_logBuffer.copy(fullMessage.length() + 1, (fullMessage + "\n").c_str());
+    fullMessage.push_back('\n');
 
-    if (m_shouldFlushAfterEveryLog && allocResult != AllocateResult::kSwapRequired)
+    // Messages too long for a buffer could never be copied into one, so they skip straight to the file below
+    bool fitsInBuffer = fullMessage.length() <= LOGGER_BUFFER_SIZE;
+
+    if (!fitsInBuffer || !m_logBuffer.copy(fullMessage.length(), fullMessage.c_str()))
     {
-      // We didn't require a swap but we will be flushing the log so we manually swap the buffers here
-      m_logBuffer.swapBuffers();
+      // The front buffer is full so write it out to make room and try again
+      std::lock_guard<std::mutex> lock(m_flushLock);
+      writeLogBackBufferToFile();
+
+      if (!fitsInBuffer || !m_logBuffer.copy(fullMessage.length(), fullMessage.c_str()))
+      {
+        // Other threads filled the new front buffer before we got to it, so write the message out ourselves rather than lose it
+        // We hold the flush lock, so it still lands after everything written out above
+        m_backLogBufferStr.append(fullMessage);
+        m_logFile.append(fullMessage);
+      }
     }
 
-    if (m_shouldFlushAfterEveryLog || allocResult == AllocateResult::kSwapRequired)
+    if (m_shouldFlushAfterEveryLog)
     {
-      writeLogBackBufferToFile();
+      flush();
     }
   }
 
   //------------------------------------------------------------------------------------------------
   void FileLogger::flush()
   {
-    m_logBuffer.swapBuffers();
-
+    std::lock_guard<std::mutex> lock(m_flushLock);
     writeLogBackBufferToFile();
   }
 
   //------------------------------------------------------------------------------------------------
   void FileLogger::writeLogBackBufferToFile()
   {
-    m_logFile.append(getLog());
+    const char* bufferedMessages = nullptr;
+    size_t bufferedDataCount = m_logBuffer.swapBuffers(&bufferedMessages);
+
+    m_backLogBufferStr.clear();
+    m_backLogBufferStr.append(bufferedMessages, bufferedDataCount);
+
+    m_logFile.append(m_backLogBufferStr);
   }
 
   //------------------------------------------------------------------------------------------------
   const std::string& FileLogger::getLog()
   {
-    m_backLogBufferStr.clear();
-
-    const char* bufferedMessages = nullptr;
-    size_t bufferedDataCount = m_logBuffer.getBufferedData(&bufferedMessages);
-
-    m_backLogBufferStr.append(bufferedMessages, bufferedDataCount);
-
     return m_backLogBufferStr;
   }
 
   //------------------------------------------------------------------------------------------------
   void FileLogger::clear()
   {
+    std::lock_guard<std::mutex> lock(m_flushLock);
     m_logBuffer.deallocateAll();
+    m_backLogBufferStr.clear();
     m_logFile.clear();
   }
 
@@ -0,0 +1,57 @@
+#if _DEBUG
+
+#include "Debug/Windows/AllocatorsDolceWindow.h"
+#include "Memory/AllocatorRegistry.h"
+
+#include "imgui/imgui.h"
+
+
+namespace Celeste::Debug
+{
+  //------------------------------------------------------------------------------------------------
+  AllocatorsDolceWindow::AllocatorsDolceWindow() :
+    Dolce::DolceWindow("Allocators")
+  {
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void AllocatorsDolceWindow::render()
+  {
+    ImGui::Columns(8, "Allocators");
+    ImGui::Text("Allocator"); ImGui::NextColumn();
+    ImGui::Text("Capacity"); ImGui::NextColumn();
+    ImGui::Text("Live"); ImGui::NextColumn();
+    ImGui::Text("High Water"); ImGui::NextColumn();
+    ImGui::Text("Grows"); ImGui::NextColumn();
+    ImGui::Text("Reserves"); ImGui::NextColumn();
+    ImGui::Text("Allocations"); ImGui::NextColumn();
+    ImGui::Text("Time (ms)"); ImGui::NextColumn();
+    ImGui::Separator();
+
+    for (const AllocatorStats& stats : AllocatorRegistry::getAllStats())
+    {
+      // Highlight pools which have had to grow, as their REGISTER_COMPONENT pool size is too small for the content
+      if (stats.m_growCount > 0)
+      {
+        ImGui::TextColored(ImVec4(1, 0.5f, 0, 1), "%s", stats.m_name.c_str());
+      }
+      else
+      {
+        ImGui::Text("%s", stats.m_name.c_str());
+      }
+      ImGui::NextColumn();
+
+      ImGui::Text("%zu", stats.m_capacity); ImGui::NextColumn();
+      ImGui::Text("%zu", stats.m_liveCount); ImGui::NextColumn();
+      ImGui::Text("%zu", stats.m_highWaterMark); ImGui::NextColumn();
+      ImGui::Text("%zu", stats.m_growCount); ImGui::NextColumn();
+      ImGui::Text("%zu", stats.m_reserveCount); ImGui::NextColumn();
+      ImGui::Text("%zu", stats.m_allocationCount); ImGui::NextColumn();
+      ImGui::Text("%.3f", stats.m_allocationTimeNs / 1000000.0); ImGui::NextColumn();
+    }
+
+    ImGui::Columns(1);
+  }
+}
+
+#endif
@@ -12,16 +12,20 @@
 #include "Debug/Logging/FileLogger.h"
 #include "Scene/SceneManager.h"
 #include "Input/InputManager.h"
+#include "Input/InputRecorder.h"
+#include "Maths/Transform.h"
 #include "Physics/PhysicsManager.h"
 #include "Rendering/RenderManager.h"
 #include "Audio/AudioManager.h"
 #include "Layout/LayoutSystem.h"
+#include "Memory/AllocatorRegistry.h"
 
 #if _DEBUG
 #include "Dolce/Dolce.h"
 #include "Debug/Windows/HierarchyDolceWindow.h"
 #include "Debug/Windows/LuaScriptDolceWindow.h"
 #include "Debug/Windows/LogDolceWindow.h"
+#include "Debug/Windows/AllocatorsDolceWindow.h"
 #include "Debug/Logging/DolceLogger.h"
 #include "Settings/DolceSettings.h"
 
@@ -40,7 +44,9 @@ namespace Celeste
   Game::Game() :
     m_resourceManager(Path(Directory::getExecutingAppDirectory(), "Resources")),
     m_window(),
-    m_clock()
+    m_clock(),
+    m_frameAllocator(),
+    m_jobSystem()
   {
     ASSERT(!m_current);
     m_current = this;
@@ -56,7 +62,9 @@ namespace Celeste
     const std::string& windowTitle) :
     m_resourceManager(Path(Directory::getExecutingAppDirectory(), "Resources")),
     m_window(windowWidth, windowHeight, windowMode, windowTitle),
-    m_clock()
+    m_clock(),
+    m_frameAllocator(),
+    m_jobSystem()
   {
     ASSERT(!m_current);
     m_current = this;
@@ -88,6 +96,18 @@ namespace Celeste
     return m_clock;
   }
 
+  //------------------------------------------------------------------------------------------------
+  FrameAllocator& Game::getFrameAllocator()
+  {
+    return m_frameAllocator;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  JobSystem& Game::getJobSystem()
+  {
+    return m_jobSystem;
+  }
+
   //------------------------------------------------------------------------------------------------
   void Game::addSystem(static_type_info::TypeIndex id, std::unique_ptr<System::ISystem>&& system)
   {
@@ -196,6 +216,7 @@ namespace Celeste
 
     dolce.addWindow(std::make_unique<Debug::HierarchyDolceWindow>(*getSystem<SceneManager>()));
     dolce.addWindow(std::make_unique<Debug::LuaScriptDolceWindow>());
+    dolce.addWindow(std::make_unique<Debug::AllocatorsDolceWindow>());
     auto logWindow = dolce.addWindow(std::make_unique<Debug::LogDolceWindow>());
 
     Path logPath(Directory::getExecutingAppDirectory(), "Log.txt");
@@ -236,9 +257,9 @@ namespace Celeste
 
     // Game loop:
     // Measure the time since last frame
-    // Get the elapsed in game time by using our fixed frame rate & time scale
-    // If the time since last frame is greater than our elapsed game time we advance the game forward as many times
-    // as necessary before the real time is in the range 0 <= real time <= elapsedGameTime
+    // Update everything but physics once with the elapsed game time (real time scaled by the clock's time scale)
+    // Add the elapsed game time to the clock's lag and advance physics forward by our fixed frame rate as many times
+    // as necessary to bring the lag back below one fixed step (or until we hit the clock's max substeps)
     // Then we draw the scene
     // The lag now is the amount leftover that the game is actually ahead of the simulation (i.e. realtime - elapsedgametime)
     // We can use that lag to compensate in the rendering by pretending that much extra simulation has occurred
@@ -247,6 +268,9 @@ namespace Celeste
 
     while (m_running)
     {
+      // Everything allocated from the frame allocator last frame is now dead
+      m_frameAllocator.reset();
+
       glfwPollEvents();
 
       auto current = std::chrono::high_resolution_clock::now();
@@ -255,20 +279,40 @@ namespace Celeste
 
       elapsedRealTime = m_clock.getElapsedDeltaTime();
 
-      // Can also implement fixed update here by performing as many fixed update calls as is required to get the elapsedRealTime below
-      // the target FPS in the clock
       update(elapsedRealTime);
 
+      size_t stepCount = m_clock.consumeFixedSteps();
+
+      if (m_inputRecorder != nullptr)
+      {
+        const Input::InputManager& inputManager = *getSystem<Input::InputManager>();
+        m_inputRecorder->record(inputManager.getKeyboard(), inputManager.getMouse(), elapsedRealTime, stepCount);
+      }
+
+      // Physics always moves in steps of the same size, however long the frame took, so it behaves the same at any frame rate
+      for (size_t step = 0; step < stepCount; ++step)
+      {
+        fixedUpdate(m_clock.getTargetSecondsPerFrame());
+
+        if (m_inputRecorder != nullptr)
+        {
+          m_inputRecorder->recordTick(checksumTransforms());
+        }
+      }
+
       glClear(GL_COLOR_BUFFER_BIT);
 
       // Render
-      render(0);
+      render(m_clock.getLag());
 
       glfwSwapBuffers(m_window.getGLWindow());
     }
 
     onExit();
 
+    // Record how full every object pool got this run so that the REGISTER_COMPONENT pool sizes can be tuned
+    AllocatorRegistry::dump(Path(Directory::getExecutingAppDirectory(), "AllocatorStats.txt"));
+
 #if _DEBUG
     shutdownDolce();
 #endif
@@ -283,17 +327,58 @@ namespace Celeste
     Log::Logging::setLogger(std::unique_ptr<Log::ILogger>(nullptr));
   }
 
+  //------------------------------------------------------------------------------------------------
+  void Game::replay(const Input::InputRecorder& recording, std::vector<uint64_t>& tickChecksums)
+  {
+    Input::InputManager& inputManager = *getSystem<Input::InputManager>();
+    inputManager.setReplaying(true);
+
+    for (size_t frameIndex = 0, frameCount = recording.getFrameCount(); frameIndex < frameCount; ++frameIndex)
+    {
+      m_frameAllocator.reset();
+
+      // Buffer the recorded input, so the input manager's update makes it current exactly as the window's callbacks would have
+      const Input::InputFrame& frame = recording.getFrame(frameIndex);
+      recording.apply(frameIndex, inputManager.getKeyboard(), inputManager.getMouse());
+
+      update(frame.m_elapsedGameTime);
+
+      for (uint32_t step = 0; step < frame.m_fixedStepCount; ++step)
+      {
+        fixedUpdate(m_clock.getTargetSecondsPerFrame());
+        tickChecksums.push_back(checksumTransforms());
+      }
+    }
+
+    inputManager.setReplaying(false);
+  }
+
   //------------------------------------------------------------------------------------------------
   void Game::update(GLfloat elapsedGameTime)
   {
+    const static_type_info::TypeIndex physicsManagerId = static_type_info::getTypeIndex<Physics::PhysicsManager>();
+
     for (const auto& systemPair : m_systems)
     {
-      systemPair.second->update(elapsedGameTime);
+      // Physics is updated separately with a fixed time step
+      if (systemPair.first != physicsManagerId)
+      {
+        systemPair.second->update(elapsedGameTime);
+      }
     }
 
     onUpdate(elapsedGameTime);
   }
 
+  //------------------------------------------------------------------------------------------------
+  void Game::fixedUpdate(GLfloat fixedTimeStep)
+  {
+    if (auto it = m_systems.find(static_type_info::getTypeIndex<Physics::PhysicsManager>()); it != m_systems.end())
+    {
+      it->second->update(fixedTimeStep);
+    }
+  }
+
   //------------------------------------------------------------------------------------------------
   void Game::render(GLfloat lag)
   {
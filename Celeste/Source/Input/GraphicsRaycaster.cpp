@@ -25,6 +25,15 @@ namespace Celeste::Input
   std::vector<observer_ptr<GameObject>> GraphicsRaycaster::raycast()
   {
     std::vector<observer_ptr<GameObject>> hitGameObjects;
+    raycast(hitGameObjects);
+
+    return hitGameObjects;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void GraphicsRaycaster::raycast(std::vector<observer_ptr<GameObject>>& hitGameObjects)
+  {
+    hitGameObjects.clear();
 
     Ray ray = Ray(Input::getMouse().getTransform().getWorldTranslation(), glm::vec3(0, 0, -1));
 
@@ -79,6 +88,5 @@ namespace Celeste::Input
       {
         return lhs->getTransform()->getWorldTranslation().z > rhs->getTransform()->getWorldTranslation().z;
       });
-    return hitGameObjects;
   }
 }
\ No newline at end of file
@@ -15,8 +15,15 @@
 
 namespace Celeste::Input
 {
+  namespace
+  {
+    constexpr size_t FRAME_ALLOCATOR_CAPACITY = 4 * 1024;
+  }
+
   //------------------------------------------------------------------------------------------------
-  InputManager::InputManager(GLFWwindow* window)
+  InputManager::InputManager(GLFWwindow* window) :
+    m_raycastHits(),
+    m_frameAllocator(FRAME_ALLOCATOR_CAPACITY)
   {
     glfwSetKeyCallback(window, &keyCallback);
     glfwSetCharCallback(window, &charCallback);
@@ -39,7 +46,11 @@ namespace Celeste::Input
 
     // Do this here rather than in the mouse class so that we can completely control the mouse behaviour
     // from outside the class
-    updateMousePosition();
+    if (!m_replaying)
+    {
+      updateMousePosition();
+    }
+
     m_mouse.update();
 
     raycast();
@@ -61,27 +72,33 @@ namespace Celeste::Input
   }
 
   //------------------------------------------------------------------------------------------------
-  void InputManager::raycast() const
+  void InputManager::raycast()
   {
-    std::unordered_set<observer_ptr<GameObject>> hitGameObjects;
+    m_frameAllocator.reset();
+
+    std::unordered_set<
+      observer_ptr<GameObject>, 
+      std::hash<observer_ptr<GameObject>>, 
+      std::equal_to<observer_ptr<GameObject>>,
+      FrameStlAllocator<observer_ptr<GameObject>>> hitGameObjects(m_frameAllocator);
 
     for (GraphicsRaycaster& graphicsRaycaster : GraphicsRaycaster::m_allocator)
     {
-      auto hitObjects = graphicsRaycaster.raycast();
-      if (!hitObjects.empty())
+      graphicsRaycaster.raycast(m_raycastHits);
+      if (!m_raycastHits.empty())
       {
-        ASSERT(hitGameObjects.find(hitObjects[0]) == hitGameObjects.end());
-        hitGameObjects.emplace(hitObjects[0]);
+        ASSERT(hitGameObjects.find(m_raycastHits[0]) == hitGameObjects.end());
+        hitGameObjects.emplace(m_raycastHits[0]);
       }
     }
 
     for (PhysicsRaycaster& physicsRaycaster : PhysicsRaycaster::m_allocator)
     {
-      auto hitObjects = physicsRaycaster.raycast();
-      if (!hitObjects.empty())
+      physicsRaycaster.raycast(m_raycastHits);
+      if (!m_raycastHits.empty())
       {
-        ASSERT(hitGameObjects.find(hitObjects[0]) == hitGameObjects.end());
-        hitGameObjects.emplace(hitObjects[0]);
+        ASSERT(hitGameObjects.find(m_raycastHits[0]) == hitGameObjects.end());
+        hitGameObjects.emplace(m_raycastHits[0]);
       }
     }
 
@@ -0,0 +1,168 @@
+#include "Input/InputRecorder.h"
+#include "Input/Mouse.h"
+#include "FileSystem/Path.h"
+#include "Assert/Assert.h"
+
+#include <fstream>
+#include <algorithm>
+#include <type_traits>
+
+
+namespace Celeste::Input
+{
+  namespace
+  {
+    constexpr uint32_t RECORDING_MAGIC = 0x43524E49; // "INRC"
+    constexpr uint32_t RECORDING_VERSION = 1;
+
+    static_assert(std::is_trivially_copyable_v<InputFrame>, "Input frames are written to and read from disc as raw bytes");
+  }
+
+  //------------------------------------------------------------------------------------------------
+  InputRecorder::InputRecorder() :
+    m_frames(),
+    m_tickChecksums()
+  {
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void InputRecorder::record(const Keyboard& keyboard, const Mouse& mouse, float elapsedGameTime, size_t fixedStepCount)
+  {
+    InputFrame& frame = m_frames.emplace_back();
+    frame.m_elapsedGameTime = elapsedGameTime;
+    frame.m_fixedStepCount = static_cast<uint32_t>(fixedStepCount);
+
+    for (int key = 0; key < KEYBOARD_KEY_COUNT; ++key)
+    {
+      if (keyboard.isKeyPressed(key))
+      {
+        setBit(frame.m_keys, static_cast<size_t>(key));
+      }
+    }
+
+    for (int button = 0; button < static_cast<int>(MouseButton::kNumButtons); ++button)
+    {
+      if (mouse.isButtonPressed(static_cast<MouseButton>(button)))
+      {
+        frame.m_mouseButtons |= 1u << button;
+      }
+    }
+
+    const glm::vec3& mousePosition = mouse.getTransform().getTranslation();
+    frame.m_mousePosition = glm::vec2(mousePosition.x, mousePosition.y);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void InputRecorder::apply(size_t frameIndex, Keyboard& keyboard, Mouse& mouse) const
+  {
+    ASSERT(frameIndex < m_frames.size());
+    if (frameIndex >= m_frames.size())
+    {
+      return;
+    }
+
+    const InputFrame& frame = m_frames[frameIndex];
+
+    for (int key = 0; key < KEYBOARD_KEY_COUNT; ++key)
+    {
+      bool pressed = isBitSet(frame.m_keys, static_cast<size_t>(key));
+      if (pressed != keyboard.isKeyPressed(key))
+      {
+        pressed ? keyboard.setKeyPressed(key) : keyboard.setKeyReleased(key);
+      }
+    }
+
+    for (int button = 0; button < static_cast<int>(MouseButton::kNumButtons); ++button)
+    {
+      MouseButton mouseButton = static_cast<MouseButton>(button);
+      bool pressed = (frame.m_mouseButtons & (1u << button)) != 0;
+
+      if (pressed != mouse.isButtonPressed(mouseButton))
+      {
+        pressed ? mouse.setButtonPressed(mouseButton) : mouse.setButtonReleased(mouseButton);
+      }
+    }
+
+    mouse.getTransform().setTranslation(frame.m_mousePosition);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t InputRecorder::findDivergence(const std::vector<uint64_t>& tickChecksums) const
+  {
+    size_t tickCount = std::min(m_tickChecksums.size(), tickChecksums.size());
+    return static_cast<size_t>(std::mismatch(m_tickChecksums.begin(), m_tickChecksums.begin() + tickCount, tickChecksums.begin()).first - m_tickChecksums.begin());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool InputRecorder::save(const Path& path) const
+  {
+    std::ofstream file(path.as_string(), std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+      return false;
+    }
+
+    uint64_t frameCount = m_frames.size();
+    uint64_t tickCount = m_tickChecksums.size();
+    file.write(reinterpret_cast<const char*>(&RECORDING_MAGIC), sizeof(RECORDING_MAGIC));
+    file.write(reinterpret_cast<const char*>(&RECORDING_VERSION), sizeof(RECORDING_VERSION));
+    file.write(reinterpret_cast<const char*>(&frameCount), sizeof(frameCount));
+    file.write(reinterpret_cast<const char*>(&tickCount), sizeof(tickCount));
+    file.write(reinterpret_cast<const char*>(m_frames.data()), static_cast<std::streamsize>(m_frames.size() * sizeof(InputFrame)));
+    file.write(reinterpret_cast<const char*>(m_tickChecksums.data()), static_cast<std::streamsize>(m_tickChecksums.size() * sizeof(uint64_t)));
+
+    return static_cast<bool>(file);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool InputRecorder::load(const Path& path)
+  {
+    clear();
+
+    std::ifstream file(path.as_string(), std::ios::binary);
+    if (!file)
+    {
+      return false;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t frameCount = 0;
+    uint64_t tickCount = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&frameCount), sizeof(frameCount));
+    file.read(reinterpret_cast<char*>(&tickCount), sizeof(tickCount));
+
+    if (!file || magic != RECORDING_MAGIC || version != RECORDING_VERSION)
+    {
+      return false;
+    }
+
+    // The counts come straight from the file, so check the data for them is actually there before allocating for it
+    std::streamoff dataStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    uint64_t remainingBytes = static_cast<uint64_t>(file.tellg() - dataStart);
+    file.seekg(dataStart);
+
+    if (frameCount > remainingBytes / sizeof(InputFrame) ||
+        tickCount > (remainingBytes - frameCount * sizeof(InputFrame)) / sizeof(uint64_t))
+    {
+      return false;
+    }
+
+    m_frames.resize(static_cast<size_t>(frameCount));
+    m_tickChecksums.resize(static_cast<size_t>(tickCount));
+    file.read(reinterpret_cast<char*>(m_frames.data()), static_cast<std::streamsize>(m_frames.size() * sizeof(InputFrame)));
+    file.read(reinterpret_cast<char*>(m_tickChecksums.data()), static_cast<std::streamsize>(m_tickChecksums.size() * sizeof(uint64_t)));
+
+    if (!file)
+    {
+      // Truncated, so nothing in it can be trusted
+      clear();
+      return false;
+    }
+
+    return true;
+  }
+}
\ No newline at end of file
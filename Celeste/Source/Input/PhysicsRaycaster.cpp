@@ -24,6 +24,15 @@ namespace Celeste::Input
   std::vector<observer_ptr<GameObject>> PhysicsRaycaster::raycast()
   {
     std::vector<observer_ptr<GameObject>> hitGameObjects;
+    raycast(hitGameObjects);
+
+    return hitGameObjects;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsRaycaster::raycast(std::vector<observer_ptr<GameObject>>& hitGameObjects)
+  {
+    hitGameObjects.clear();
 
     Ray ray = Ray(Input::getMouse().getTransform().getWorldTranslation(), glm::vec3(0, 0, -1));
 
@@ -61,6 +70,5 @@ namespace Celeste::Input
       {
         return lhs->getTransform()->getWorldTranslation().z > rhs->getTransform()->getWorldTranslation().z;
       });
-    return hitGameObjects;
   }
 }
\ No newline at end of file
@@ -1,11 +1,34 @@
 #include "Maths/Transform.h"
 #include "Objects/GameObject.h"
 
+#include <cstring>
+
 
 namespace Celeste
 {
   CUSTOM_MEMORY_CREATION(Transform, 100);
 
+  namespace
+  {
+    constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    //------------------------------------------------------------------------------------------------
+    /// Mixes the exact bits of the inputted float into an FNV-1a hash, so even a one ulp difference changes it
+    inline uint64_t hashFloat(uint64_t hash, float value)
+    {
+      uint32_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+
+      for (int byte = 0; byte < 4; ++byte)
+      {
+        hash = (hash ^ ((bits >> (byte * 8)) & 0xFF)) * FNV_PRIME;
+      }
+
+      return hash;
+    }
+  }
+
   //------------------------------------------------------------------------------------------------
   Transform::Transform() :
     m_gameObject(nullptr),
@@ -143,4 +166,27 @@ namespace Celeste
   {
     return !hasParent() ? m_scale : m_parent->getWorldScale() * m_scale;
   }
+
+  //------------------------------------------------------------------------------------------------
+  uint64_t checksumTransforms()
+  {
+    uint64_t hash = FNV_OFFSET_BASIS;
+
+    // World values are derived from these and the hierarchy, so hashing the local values is enough
+    for (const Transform& transform : Transform::m_allocator)
+    {
+      const glm::vec3& translation = transform.getTranslation();
+      const glm::vec3& scale = transform.getScale();
+
+      hash = hashFloat(hash, translation.x);
+      hash = hashFloat(hash, translation.y);
+      hash = hashFloat(hash, translation.z);
+      hash = hashFloat(hash, transform.getRotation());
+      hash = hashFloat(hash, scale.x);
+      hash = hashFloat(hash, scale.y);
+      hash = hashFloat(hash, scale.z);
+    }
+
+    return hash;
+  }
 }
\ No newline at end of file
@@ -1,11 +1,36 @@
 #include "Memory/Allocators/AlignedAllocator.h"
+#include "Assert/Assert.h"
 
-#include <assert.h>
-#include <memory>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#if _DEBUG
+#include <mutex>
+#include <unordered_set>
+#endif
 
 
 namespace Celeste
 {
+#if _DEBUG
+  namespace
+  {
+    // Tracks every live aligned allocation so that double frees and leaks can be detected in debug builds
+    std::mutex& getLiveAllocationsLock()
+    {
+      static std::mutex lock;
+      return lock;
+    }
+
+    std::unordered_set<void*>& getLiveAllocations()
+    {
+      static std::unordered_set<void*> liveAllocations;
+      return liveAllocations;
+    }
+  }
+#endif
+
   //------------------------------------------------------------------------------------------------
   AlignedAllocator::AlignedAllocator()
   {
@@ -22,21 +47,41 @@ namespace Celeste
     return malloc(numberOfBytes);
   }
 
+  //------------------------------------------------------------------------------------------------
+  void AlignedAllocator::freeUnaligned(void* memory) const
+  {
+    free(memory);
+  }
+
   //------------------------------------------------------------------------------------------------
   void* AlignedAllocator::allocateAligned(size_t numberOfBytes, size_t alignment) const
   {
-    // Clients must call allocateUnaligned and freeAligned if alignment is 1
-    assert(alignment > 1);
+    ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    // We always need room before the aligned address to store the adjustment, so never align to less than that
+    alignment = std::max(alignment, sizeof(size_t));
+
+    if (numberOfBytes > std::numeric_limits<size_t>::max() - alignment)
+    {
+      // The room needed to align the allocation would overflow
+      ASSERT_FAIL();
+      return nullptr;
+    }
 
     // Work out the total number of bytes to allocate
     size_t expandedSize = numberOfBytes + alignment;
 
     // Allocate an unaligned block using this expanded size and then
     // return the raw value of the address
-    size_t rawAddress = (size_t)allocateUnaligned(expandedSize);
+    size_t rawAddress = reinterpret_cast<size_t>(allocateUnaligned(expandedSize));
+    if (rawAddress == 0)
+    {
+      ASSERT_FAIL();
+      return nullptr;
+    }
 
     // Calculate adjustment by working out how far our last digit is away from a multiple of alignment
-    // Rounding up using a mask
+    // Rounding up using a mask.  If we are already aligned we shift up by a whole alignment to make room for the adjustment
     size_t mask = (alignment - 1);
     size_t misalignment = (rawAddress & mask);
     size_t adjustment = alignment - misalignment;
@@ -44,11 +89,54 @@ namespace Celeste
     // Calculate the adjusted aligned address and return as a pointer
     size_t alignedAddress = rawAddress + adjustment;
 
-    // Store the adjustment in the four bytes immediately
-    // preceding the adjusted address that were returning.
-    size_t* pAdjustment = (size_t*)(alignedAddress - sizeof(size_t));
+    // Store the adjustment in the bytes immediately preceding the adjusted address that we are returning
+    size_t* pAdjustment = reinterpret_cast<size_t*>(alignedAddress - sizeof(size_t));
     *pAdjustment = adjustment;
 
-    return (void*)alignedAddress;
+#if _DEBUG
+    {
+      std::lock_guard<std::mutex> guard(getLiveAllocationsLock());
+      getLiveAllocations().insert(reinterpret_cast<void*>(alignedAddress));
+    }
+#endif
+
+    return reinterpret_cast<void*>(alignedAddress);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void AlignedAllocator::freeAligned(void* memory) const
+  {
+    if (memory == nullptr)
+    {
+      return;
+    }
+
+#if _DEBUG
+    {
+      std::lock_guard<std::mutex> guard(getLiveAllocationsLock());
+      if (getLiveAllocations().erase(memory) == 0)
+      {
+        // Either a double free or memory which did not come from allocateAligned
+        ASSERT_FAIL();
+        return;
+      }
+    }
+#endif
+
+    size_t alignedAddress = reinterpret_cast<size_t>(memory);
+    size_t adjustment = *reinterpret_cast<size_t*>(alignedAddress - sizeof(size_t));
+
+    freeUnaligned(reinterpret_cast<void*>(alignedAddress - adjustment));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t AlignedAllocator::getLiveAllocationCount()
+  {
+#if _DEBUG
+    std::lock_guard<std::mutex> guard(getLiveAllocationsLock());
+    return getLiveAllocations().size();
+#else
+    return 0;
+#endif
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,136 @@
+#include "Memory/AllocatorRegistry.h"
+#include "FileSystem/File.h"
+
+#include <map>
+#include <sstream>
+#include <iomanip>
+
+
+namespace Celeste
+{
+  namespace Internals
+  {
+    struct RegisteredAllocator
+    {
+      AllocatorRegistry::StatsFunction m_getStats;
+      AllocatorRegistry::ReserveFunction m_reserve;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    std::map<std::string, RegisteredAllocator>& getAllocators()
+    {
+      // Function local so that it is constructed before any static allocator tries to register itself
+      static std::map<std::string, RegisteredAllocator> allocators;
+      return allocators;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool AllocatorRegistry::registerAllocator(const std::string& name, const StatsFunction& getStats, const ReserveFunction& reserve)
+  {
+    return Internals::getAllocators().insert_or_assign(name, Internals::RegisteredAllocator{ getStats, reserve }).second;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool AllocatorRegistry::deregisterAllocator(const std::string& name)
+  {
+    return Internals::getAllocators().erase(name) > 0;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool AllocatorRegistry::isRegistered(const std::string& name)
+  {
+    return Internals::getAllocators().find(name) != Internals::getAllocators().end();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t AllocatorRegistry::getAllocatorCount()
+  {
+    return Internals::getAllocators().size();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  AllocatorStats AllocatorRegistry::getStats(const std::string& name)
+  {
+    auto allocatorIt = Internals::getAllocators().find(name);
+    if (allocatorIt == Internals::getAllocators().end())
+    {
+      return AllocatorStats();
+    }
+
+    AllocatorStats stats = allocatorIt->second.m_getStats();
+    stats.m_name = name;
+
+    return stats;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  std::vector<AllocatorStats> AllocatorRegistry::getAllStats()
+  {
+    std::vector<AllocatorStats> allStats;
+    allStats.reserve(getAllocatorCount());
+
+    for (const auto& allocatorPair : Internals::getAllocators())
+    {
+      allStats.push_back(allocatorPair.second.m_getStats());
+      allStats.back().m_name = allocatorPair.first;
+    }
+
+    return allStats;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool AllocatorRegistry::reserve(const std::string& name, size_t capacity)
+  {
+    auto allocatorIt = Internals::getAllocators().find(name);
+    if (allocatorIt == Internals::getAllocators().end() || !allocatorIt->second.m_reserve)
+    {
+      return false;
+    }
+
+    allocatorIt->second.m_reserve(capacity);
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void AllocatorRegistry::prewarm(const CapacityHints& capacityHints)
+  {
+    for (const auto& hintPair : capacityHints)
+    {
+      if (isRegistered(hintPair.first))
+      {
+        reserve(hintPair.first, getStats(hintPair.first).m_liveCount + hintPair.second);
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void AllocatorRegistry::dump(const Path& path)
+  {
+    std::ostringstream output;
+    output << std::left << std::setw(40) << "Allocator" << std::right
+           << std::setw(12) << "Capacity"
+           << std::setw(12) << "Live"
+           << std::setw(16) << "High Water Mark"
+           << std::setw(8) << "Grows"
+           << std::setw(10) << "Reserves"
+           << std::setw(14) << "Allocations"
+           << std::setw(20) << "Allocation Time (ms)" << '\n';
+
+    for (const AllocatorStats& stats : getAllStats())
+    {
+      output << std::left << std::setw(40) << stats.m_name << std::right
+             << std::setw(12) << stats.m_capacity
+             << std::setw(12) << stats.m_liveCount
+             << std::setw(16) << stats.m_highWaterMark
+             << std::setw(8) << stats.m_growCount
+             << std::setw(10) << stats.m_reserveCount
+             << std::setw(14) << stats.m_allocationCount
+             << std::setw(20) << std::fixed << std::setprecision(3) << stats.m_allocationTimeNs / 1000000.0 << '\n';
+    }
+
+    File file(path);
+    file.create();
+    file.append(output.str());
+  }
+}
@@ -0,0 +1,70 @@
+#include "Memory/Allocators/FrameAllocator.h"
+#include "Assert/Assert.h"
+
+#include <algorithm>
+
+
+namespace Celeste
+{
+  //------------------------------------------------------------------------------------------------
+  FrameAllocator::FrameAllocator(size_t capacity) :
+    m_buffer(new char[capacity]),
+    m_capacity(capacity),
+    m_offset(0),
+    m_overflowBlocks(),
+    m_overflowBytes(0),
+    m_highWaterMark(0)
+  {
+  }
+
+  //------------------------------------------------------------------------------------------------
+  FrameAllocator::~FrameAllocator() = default;
+
+  //------------------------------------------------------------------------------------------------
+  void* FrameAllocator::allocate(size_t numberOfBytes, size_t alignment)
+  {
+    ASSERT((alignment & (alignment - 1)) == 0);
+
+    size_t address = reinterpret_cast<size_t>(m_buffer.get()) + m_offset;
+    size_t adjustment = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+    if (m_offset + adjustment + numberOfBytes > m_capacity)
+    {
+      return allocateOverflow(numberOfBytes, alignment);
+    }
+
+    m_offset += adjustment + numberOfBytes;
+    m_highWaterMark = std::max(m_highWaterMark, getUsed());
+
+    return reinterpret_cast<void*>(address + adjustment);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void* FrameAllocator::allocateOverflow(size_t numberOfBytes, size_t alignment)
+  {
+    size_t blockSize = numberOfBytes + alignment;
+    m_overflowBlocks.emplace_back(new char[blockSize]);
+    m_overflowBytes += blockSize;
+    m_highWaterMark = std::max(m_highWaterMark, getUsed());
+
+    size_t address = reinterpret_cast<size_t>(m_overflowBlocks.back().get());
+    size_t adjustment = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+    return reinterpret_cast<void*>(address + adjustment);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void FrameAllocator::reset()
+  {
+    if (!m_overflowBlocks.empty())
+    {
+      // We ran out of room this frame, so grow to the high-water mark to avoid overflowing again
+      m_overflowBlocks.clear();
+      m_capacity = std::max(m_capacity * 2, m_highWaterMark);
+      m_buffer.reset(new char[m_capacity]);
+    }
+
+    m_offset = 0;
+    m_overflowBytes = 0;
+  }
+}
\ No newline at end of file
@@ -11,6 +11,14 @@ namespace Celeste
   {
   }
 
+  //------------------------------------------------------------------------------------------------
+  Component::Component(Component&& other) noexcept :
+    Inherited(other),
+    m_gameObject(other.m_gameObject)
+  {
+    m_gameObject.relocateComponent(other, *this);
+  }
+
   //------------------------------------------------------------------------------------------------
   Component::~Component()
   {
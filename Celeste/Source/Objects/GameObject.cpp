@@ -2,6 +2,7 @@
 #include "Rendering/SpriteBatch.h"
 #include "Rendering/SpriteRenderer.h"
 #include "Rendering/TextRenderer.h"
+#include "Physics/RigidBody2D.h"
 
 
 namespace Celeste
@@ -12,7 +13,8 @@ namespace Celeste
   GameObject::GameObject() :
     m_transform(new Transform(*this)),
     m_name(0),
-    m_tag(0)
+    m_tag(0),
+    m_rigidBody(nullptr)
   {
   }
 
@@ -192,11 +194,40 @@ namespace Celeste
   }
 
   //------------------------------------------------------------------------------------------------
-  void GameObject::render(Rendering::SpriteBatch& spriteBatch, float /*lag*/)
+  void GameObject::render(Rendering::SpriteBatch& spriteBatch, float lag)
   {
     glm::vec3 worldTranslation = getTransform()->getWorldTranslation();
     float worldRotation = getTransform()->getWorldRotation();
     const glm::vec3& worldScale = getTransform()->getWorldScale();
+    glm::mat4 extrapolation = glm::identity<glm::mat4>();
+
+    // Physics runs in fixed steps, so it is up to lag seconds behind real time
+    // Move bodies on by how far they would have travelled in that time so they do not visibly stutter
+    // Children are carried along by every body above them too, orbiting each one's origin as it turns
+    if (lag > 0)
+    {
+      for (const Transform* transform = getTransform(); transform != nullptr; transform = transform->getParent())
+      {
+        const GameObject* gameObject = transform->getGameObject();
+        const Physics::RigidBody2D* rigidBody = gameObject != nullptr ? gameObject->m_rigidBody : nullptr;
+
+        if (rigidBody != nullptr && rigidBody->isActive())
+        {
+          glm::vec3 origin = transform->getWorldTranslation();
+          float rotation = rigidBody->getAngularVelocity() * lag;
+
+          // Rotations are clockwise, matching createMatrix
+          glm::mat4 bodyExtrapolation = glm::translate(glm::identity<glm::mat4>(), origin + glm::vec3(rigidBody->getLinearVelocity() * lag, 0));
+          bodyExtrapolation = glm::rotate(bodyExtrapolation, -rotation, glm::vec3(0, 0, 1));
+          bodyExtrapolation = glm::translate(bodyExtrapolation, -origin);
+
+          extrapolation = bodyExtrapolation * extrapolation;
+          worldRotation += rotation;
+        }
+      }
+
+      worldTranslation = glm::vec3(extrapolation * glm::vec4(worldTranslation, 1));
+    }
 
     // Render Sprites
     {
@@ -257,6 +288,11 @@ namespace Celeste
       return;
     }
 #endif
+
+    if (component == m_rigidBody)
+    {
+      m_rigidBody = nullptr;
+    }
     
     if (auto componentIt = std::find(m_managedComponents.begin(), m_managedComponents.end(), component); componentIt != m_managedComponents.end())
     {
@@ -275,4 +311,22 @@ namespace Celeste
     }
 #endif
   }
+
+  //------------------------------------------------------------------------------------------------
+  void GameObject::relocateComponent(const Component& from, Component& to)
+  {
+    if (&from == m_rigidBody)
+    {
+      m_rigidBody = static_cast<Physics::RigidBody2D*>(&to);
+    }
+
+    if (auto componentIt = std::find(m_managedComponents.begin(), m_managedComponents.end(), &from); componentIt != m_managedComponents.end())
+    {
+      m_managedComponents.insert(componentIt, &to);
+    }
+    else if (componentIt = std::find(m_unmanagedComponents.begin(), m_unmanagedComponents.end(), &from); componentIt != m_unmanagedComponents.end())
+    {
+      m_unmanagedComponents.insert(componentIt, &to);
+    }
+  }
 }
\ No newline at end of file
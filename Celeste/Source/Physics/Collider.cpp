@@ -1,32 +1,42 @@
 #include "Physics/Collider.h"
-#include "Physics/RectangleCollider.h"
-#include "Physics/EllipseCollider.h"
-#include "Maths/Ray.h"
 
 
 namespace Celeste::Physics
 {
+  namespace
+  {
+    size_t activeChangeCount = 0;
+  }
+
   //------------------------------------------------------------------------------------------------
   Collider::Collider(GameObject& gameObject) :
     Inherited(gameObject),
     m_colliderType(ColliderType::kCollider),
-    m_offset()
+    m_offset(),
+    m_sleeping(false)
   {
   }
 
   //------------------------------------------------------------------------------------------------
-  bool Collider::intersects(const Collider& collider) const
+  size_t Collider::getActiveChangeCount()
   {
-    if (const RectangleCollider* rectangleCollider = dynamic_cast<const RectangleCollider*>(&collider); rectangleCollider != nullptr)
-    {
-      return intersects(rectangleCollider->getRectangle());
-    }
-    else if (const EllipseCollider* ellipseCollider = dynamic_cast<const EllipseCollider*>(&collider); ellipseCollider != nullptr)
+    return activeChangeCount;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void Collider::setActive(bool isActive)
+  {
+    if (isActive != this->isActive())
     {
-      return intersects(ellipseCollider->getEllipse());
+      ++activeChangeCount;
     }
 
-    ASSERT_FAIL();
-    return false;
+    Inherited::setActive(isActive);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool Collider::intersects(const Collider& collider) const
+  {
+    return Physics::intersects(getShape(), collider.getShape());
   }
 }
\ No newline at end of file
@@ -0,0 +1,471 @@
+#include "Physics/CollisionShape.h"
+
+#include <cmath>
+#include <algorithm>
+
+
+namespace Celeste::Physics
+{
+  namespace
+  {
+    constexpr int MAX_GJK_ITERATIONS = 32;
+    /// Sweeps give up on exact stepping past this many steps and take longer ones, so a tiny fast shape cannot stall a frame
+    constexpr int MAX_SWEEP_STEPS = 4096;
+    constexpr int SWEEP_BISECTIONS = 16;
+
+    //------------------------------------------------------------------------------------------------
+    CollisionShape createShape(ShapeType type, const glm::vec2& centre, const glm::vec2& extents, float rotation)
+    {
+      CollisionShape shape;
+      shape.m_type = type;
+      shape.m_centre = centre;
+      shape.m_extents = glm::abs(extents);
+
+      if (rotation == 0)
+      {
+        // By far the most common case, so skip the trig
+        shape.m_axisX = glm::vec2(1, 0);
+        shape.m_axisY = glm::vec2(0, 1);
+      }
+      else
+      {
+        float cosine = std::cos(rotation);
+        float sine = std::sin(rotation);
+        shape.m_axisX = glm::vec2(cosine, -sine);
+        shape.m_axisY = glm::vec2(sine, cosine);
+      }
+
+      return shape;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    inline float cross(const glm::vec2& a, const glm::vec2& b)
+    {
+      return a.x * b.y - a.y * b.x;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// Returns the perpendicular of edge which points towards towards
+    inline glm::vec2 perpendicularTowards(const glm::vec2& edge, const glm::vec2& towards)
+    {
+      glm::vec2 perpendicular(-edge.y, edge.x);
+      return glm::dot(perpendicular, towards) >= 0 ? perpendicular : -perpendicular;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// Half the length of a box's projection onto the inputted axis
+    inline float projectedRadius(const CollisionShape& box, const glm::vec2& axis)
+    {
+      return box.m_extents.x * std::abs(glm::dot(box.m_axisX, axis)) + box.m_extents.y * std::abs(glm::dot(box.m_axisY, axis));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    bool boxIntersectsBox(const CollisionShape& a, const CollisionShape& b)
+    {
+      // Two convex polygons are separate if and only if their projections are separate on one of their edge normals
+      // For boxes, those are just the two local axes of each
+      glm::vec2 offset = b.m_centre - a.m_centre;
+      const glm::vec2 axes[4] = { a.m_axisX, a.m_axisY, b.m_axisX, b.m_axisY };
+
+      for (const glm::vec2& axis : axes)
+      {
+        if (std::abs(glm::dot(offset, axis)) >= projectedRadius(a, axis) + projectedRadius(b, axis))
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// Support point of the Minkowski difference a - b, which contains the origin if and only if a and b overlap
+    inline glm::vec2 minkowskiSupport(const CollisionShape& a, const CollisionShape& b, const glm::vec2& direction)
+    {
+      return a.support(direction) - b.support(-direction);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    bool gjkIntersects(const CollisionShape& a, const CollisionShape& b)
+    {
+      glm::vec2 direction = b.m_centre - a.m_centre;
+      if (direction == glm::vec2())
+      {
+        direction = glm::vec2(1, 0);
+      }
+
+      // The simplex is a point, line or triangle, with the most recently added point last
+      glm::vec2 simplex[3];
+      int simplexSize = 1;
+      simplex[0] = minkowskiSupport(a, b, direction);
+      direction = -simplex[0];
+
+      for (int iteration = 0; iteration < MAX_GJK_ITERATIONS; ++iteration)
+      {
+        glm::vec2 point = minkowskiSupport(a, b, direction);
+        if (glm::dot(point, direction) <= 0)
+        {
+          // Nothing in the Minkowski difference lies past the origin in this direction, so it cannot contain it
+          return false;
+        }
+
+        simplex[simplexSize++] = point;
+
+        if (simplexSize == 2)
+        {
+          // Line - search perpendicular to it, towards the origin
+          glm::vec2 edge = simplex[0] - simplex[1];
+          glm::vec2 toOrigin = -simplex[1];
+
+          if (cross(edge, toOrigin) == 0)
+          {
+            // The origin lies on the line, so it is only strictly inside if the difference extends to both sides of it
+            glm::vec2 perpendicular(-edge.y, edge.x);
+            if (glm::dot(minkowskiSupport(a, b, -perpendicular), -perpendicular) <= 0)
+            {
+              return false;
+            }
+
+            direction = perpendicular;
+          }
+          else
+          {
+            direction = perpendicularTowards(edge, toOrigin);
+          }
+        }
+        else
+        {
+          // Triangle - either the origin is inside it, or it is outside one of the two edges touching the newest point
+          glm::vec2 newest = simplex[2];
+          glm::vec2 toOrigin = -newest;
+          glm::vec2 edgeToFirst = simplex[0] - newest;
+          glm::vec2 edgeToSecond = simplex[1] - newest;
+
+          glm::vec2 firstNormal = perpendicularTowards(edgeToFirst, -edgeToSecond);
+          glm::vec2 secondNormal = perpendicularTowards(edgeToSecond, -edgeToFirst);
+
+          // Origins lying exactly on an edge are handled like those outside it - the next support point
+          // tells us whether the difference extends past that edge, and so whether the shapes are only touching
+          if (glm::dot(firstNormal, toOrigin) >= 0)
+          {
+            // Outside the edge to the first point, so drop the second
+            simplex[1] = newest;
+            simplexSize = 2;
+            direction = firstNormal;
+          }
+          else if (glm::dot(secondNormal, toOrigin) >= 0)
+          {
+            // Outside the edge to the second point, so drop the first
+            simplex[0] = simplex[1];
+            simplex[1] = newest;
+            simplexSize = 2;
+            direction = secondNormal;
+          }
+          else
+          {
+            // The origin is strictly inside the triangle
+            return true;
+          }
+        }
+      }
+
+      // Curved shapes which are only just touching can fail to converge, in which case they are not overlapping
+      return false;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// Returns the unit normal pointing out of shape at the point on its boundary nearest the inputted point
+    /// Exact for ellipses only at points on the boundary, which is all a sweep needs
+    glm::vec2 outwardNormal(const CollisionShape& shape, const glm::vec2& point)
+    {
+      glm::vec2 local = shape.toLocal(point);
+      glm::vec2 localNormal;
+
+      if (shape.m_type == ShapeType::kBox)
+      {
+        // Whichever face the point is furthest out past, relative to the box's size
+        if (std::abs(local.x) * shape.m_extents.y >= std::abs(local.y) * shape.m_extents.x)
+        {
+          localNormal = glm::vec2(local.x >= 0 ? 1.0f : -1.0f, 0);
+        }
+        else
+        {
+          localNormal = glm::vec2(0, local.y >= 0 ? 1.0f : -1.0f);
+        }
+      }
+      else
+      {
+        // The gradient of (x / a)^2 + (y / b)^2, multiplied through by (ab)^2 so flat ellipses do not divide by zero
+        float a = shape.m_extents.x;
+        float b = shape.m_extents.y;
+        localNormal = glm::vec2(local.x * b * b, local.y * a * a);
+      }
+
+      glm::vec2 normal = shape.m_axisX * localNormal.x + shape.m_axisY * localNormal.y;
+      float length = glm::length(normal);
+      return length > 0 ? normal / length : glm::vec2();
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  CollisionShape CollisionShape::box(const glm::vec2& centre, const glm::vec2& halfExtents, float rotation)
+  {
+    return createShape(ShapeType::kBox, centre, halfExtents, rotation);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  CollisionShape CollisionShape::ellipse(const glm::vec2& centre, const glm::vec2& semiAxes, float rotation)
+  {
+    return createShape(ShapeType::kEllipse, centre, semiAxes, rotation);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  AABB CollisionShape::getBounds() const
+  {
+    glm::vec2 halfExtents;
+
+    if (m_type == ShapeType::kBox)
+    {
+      halfExtents = glm::abs(m_axisX) * m_extents.x + glm::abs(m_axisY) * m_extents.y;
+    }
+    else
+    {
+      glm::vec2 scaledX = m_axisX * m_extents.x;
+      glm::vec2 scaledY = m_axisY * m_extents.y;
+      halfExtents = glm::vec2(
+        std::sqrt(scaledX.x * scaledX.x + scaledY.x * scaledY.x),
+        std::sqrt(scaledX.y * scaledX.y + scaledY.y * scaledY.y));
+    }
+
+    return AABB(m_centre - halfExtents, m_centre + halfExtents);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  glm::vec2 CollisionShape::support(const glm::vec2& direction) const
+  {
+    glm::vec2 localDirection(glm::dot(direction, m_axisX), glm::dot(direction, m_axisY));
+    glm::vec2 localSupport;
+
+    if (m_type == ShapeType::kBox)
+    {
+      localSupport = glm::vec2(
+        localDirection.x >= 0 ? m_extents.x : -m_extents.x,
+        localDirection.y >= 0 ? m_extents.y : -m_extents.y);
+    }
+    else
+    {
+      // The ellipse is a unit circle scaled by the extents, so map the direction into circle space, normalise and map back
+      glm::vec2 scaledDirection = localDirection * m_extents;
+      float length = glm::length(scaledDirection);
+      localSupport = length > 0 ? (scaledDirection * m_extents) / length : glm::vec2();
+    }
+
+    return m_centre + m_axisX * localSupport.x + m_axisY * localSupport.y;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool contains(const CollisionShape& shape, const glm::vec2& point)
+  {
+    if (shape.isDegenerate())
+    {
+      return false;
+    }
+
+    glm::vec2 local = shape.toLocal(point);
+
+    if (shape.m_type == ShapeType::kBox)
+    {
+      return std::abs(local.x) < shape.m_extents.x && std::abs(local.y) < shape.m_extents.y;
+    }
+
+    // (x / a)^2 + (y / b)^2 < 1, multiplied through so flat ellipses do not divide by zero
+    float a = shape.m_extents.x;
+    float b = shape.m_extents.y;
+    return b * b * local.x * local.x + a * a * local.y * local.y < a * a * b * b;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool raycast(const CollisionShape& shape, const glm::vec2& start, const glm::vec2& end, float& fraction)
+  {
+    if (shape.isDegenerate())
+    {
+      // Nothing can pass into a shape with no area
+      return false;
+    }
+
+    glm::vec2 localStart = shape.toLocal(start);
+    glm::vec2 localDelta = shape.toLocal(end) - localStart;
+
+    if (shape.m_type == ShapeType::kBox)
+    {
+      // Slab test - the segment is inside the box between entering the last slab and leaving the first
+      float entryFraction = 0;
+      float exitFraction = 1;
+
+      for (int axis = 0; axis < 2; ++axis)
+      {
+        if (localDelta[axis] == 0)
+        {
+          if (std::abs(localStart[axis]) >= shape.m_extents[axis])
+          {
+            return false;
+          }
+
+          continue;
+        }
+
+        float inverseDelta = 1 / localDelta[axis];
+        float slabEntry = (-shape.m_extents[axis] - localStart[axis]) * inverseDelta;
+        float slabExit = (shape.m_extents[axis] - localStart[axis]) * inverseDelta;
+
+        entryFraction = std::max(entryFraction, std::min(slabEntry, slabExit));
+        exitFraction = std::min(exitFraction, std::max(slabEntry, slabExit));
+
+        if (entryFraction >= exitFraction)
+        {
+          return false;
+        }
+      }
+
+      fraction = entryFraction;
+      return true;
+    }
+
+    // Scale the ellipse into a unit circle and solve |start + t * delta| = 1
+    glm::vec2 circleStart = localStart / shape.m_extents;
+    glm::vec2 circleDelta = localDelta / shape.m_extents;
+
+    float a = glm::dot(circleDelta, circleDelta);
+    float b = glm::dot(circleStart, circleDelta);
+    float c = glm::dot(circleStart, circleStart) - 1;
+
+    if (c < 0)
+    {
+      fraction = 0;
+      return true;
+    }
+
+    float discriminant = b * b - a * c;
+    if (a == 0 || discriminant <= 0)
+    {
+      return false;
+    }
+
+    float t = (-b - std::sqrt(discriminant)) / a;
+    if (t < 0 || t > 1)
+    {
+      return false;
+    }
+
+    fraction = t;
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool intersects(const CollisionShape& a, const CollisionShape& b)
+  {
+    if (a.isDegenerate() || b.isDegenerate())
+    {
+      return false;
+    }
+
+    if (a.m_type == ShapeType::kBox && b.m_type == ShapeType::kBox)
+    {
+      return boxIntersectsBox(a, b);
+    }
+
+    return gjkIntersects(a, b);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool sweep(const CollisionShape& shape, const glm::vec2& displacement, const CollisionShape& target, float& timeOfImpact, glm::vec2& normal)
+  {
+    if (shape.isDegenerate() || target.isDegenerate() || displacement == glm::vec2() || intersects(shape, target))
+    {
+      return false;
+    }
+
+    // Neither shape reaches outside its bounding box, so they cannot meet before the boxes do
+    AABB bounds = shape.getBounds();
+    AABB targetBounds = target.getBounds();
+    float start = 0;
+
+    if (!bounds.overlaps(targetBounds))
+    {
+      glm::vec2 boundsNormal;
+      if (!bounds.sweep(displacement, targetBounds, start, boundsNormal))
+      {
+        return false;
+      }
+    }
+
+    // Stepping no further than shape's smallest extent means it cannot skip over anything it would have struck square on
+    float stepLength = std::min(shape.m_extents.x, shape.m_extents.y);
+    float distance = glm::length(displacement) * (1 - start);
+    int stepCount = std::clamp(static_cast<int>(std::ceil(distance / stepLength)), 1, MAX_SWEEP_STEPS);
+    float stepTime = (1 - start) / stepCount;
+
+    CollisionShape moved = shape;
+    float clearTime = start;
+    float hitTime = -1;
+
+    for (int step = 1; step <= stepCount; ++step)
+    {
+      float time = step == stepCount ? 1 : start + step * stepTime;
+      glm::vec2 offset = displacement * time;
+      moved.m_centre = shape.m_centre + offset;
+
+      if (intersects(moved, target))
+      {
+        hitTime = time;
+        break;
+      }
+
+      if (!AABB(bounds.m_min + offset, bounds.m_max + offset).overlaps(targetBounds))
+      {
+        // Moved out past the far side of target's box, so it can no longer be struck
+        return false;
+      }
+
+      clearTime = time;
+    }
+
+    if (hitTime < 0)
+    {
+      return false;
+    }
+
+    for (int bisection = 0; bisection < SWEEP_BISECTIONS; ++bisection)
+    {
+      float time = (clearTime + hitTime) * 0.5f;
+      moved.m_centre = shape.m_centre + displacement * time;
+
+      if (intersects(moved, target))
+      {
+        hitTime = time;
+      }
+      else
+      {
+        clearTime = time;
+      }
+    }
+
+    // Stop just short of overlapping, as the shapes are open sets and only touching is not a collision
+    timeOfImpact = clearTime;
+    moved.m_centre = shape.m_centre + displacement * clearTime;
+
+    // The shapes are as good as touching, so the point of shape deepest towards target is where they meet
+    glm::vec2 approximateNormal = outwardNormal(target, moved.m_centre);
+    normal = outwardNormal(target, moved.support(-approximateNormal));
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void intersects(const CollisionShape& shape, const CollisionShape* others, const size_t* indices, size_t count, uint8_t* results)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      results[i] = intersects(shape, others[indices[i]]) ? 1 : 0;
+    }
+  }
+}
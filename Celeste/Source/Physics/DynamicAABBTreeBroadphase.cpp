@@ -0,0 +1,380 @@
+#include "Physics/DynamicAABBTreeBroadphase.h"
+#include "Assert/Assert.h"
+
+
+namespace Celeste::Physics
+{
+  //------------------------------------------------------------------------------------------------
+  DynamicAABBTreeBroadphase::DynamicAABBTreeBroadphase(float margin) :
+    m_margin(margin),
+    m_bounds(),
+    m_nodes(),
+    m_root(NULL_NODE),
+    m_freeList(NULL_NODE),
+    m_leaves(),
+    m_previousLeaves(),
+    m_keyLeaves(),
+    m_movedCount(0)
+  {
+    ASSERT(margin >= 0);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  int32_t DynamicAABBTreeBroadphase::allocateNode()
+  {
+    int32_t node = m_freeList;
+
+    if (node == NULL_NODE)
+    {
+      node = static_cast<int32_t>(m_nodes.size());
+      m_nodes.emplace_back();
+    }
+    else
+    {
+      m_freeList = m_nodes[node].m_parent;
+    }
+
+    Node& newNode = m_nodes[node];
+    newNode.m_parent = NULL_NODE;
+    newNode.m_left = NULL_NODE;
+    newNode.m_right = NULL_NODE;
+    newNode.m_height = 0;
+    newNode.m_entry = NO_ENTRY;
+    newNode.m_key = 0;
+
+    return node;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void DynamicAABBTreeBroadphase::freeNode(int32_t node)
+  {
+    m_nodes[node].m_parent = m_freeList;
+    m_nodes[node].m_height = -1;
+    m_freeList = node;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void DynamicAABBTreeBroadphase::update(const std::vector<AABB>& bounds, const std::vector<uint64_t>& keys)
+  {
+    ASSERT(keys.size() == bounds.size());
+
+    m_movedCount = 0;
+    m_bounds.assign(bounds.begin(), bounds.end());
+
+    // Hand each existing leaf over to whichever entry now has its key, wherever that entry has ended up in the list
+    for (int32_t leaf : m_leaves)
+    {
+      m_nodes[leaf].m_entry = NO_ENTRY;
+    }
+
+    m_previousLeaves.swap(m_leaves);
+    m_leaves.assign(bounds.size(), NULL_NODE);
+
+    for (size_t i = 0, n = bounds.size(); i < n; ++i)
+    {
+      if (auto it = m_keyLeaves.find(keys[i]); it != m_keyLeaves.end())
+      {
+        ASSERT(m_nodes[it->second].m_entry == NO_ENTRY);
+        m_nodes[it->second].m_entry = i;
+        m_leaves[i] = it->second;
+      }
+    }
+
+    // Leaves nobody claimed belong to entries which have gone since the last update
+    for (int32_t leaf : m_previousLeaves)
+    {
+      if (m_nodes[leaf].m_entry == NO_ENTRY)
+      {
+        removeLeaf(leaf);
+        m_keyLeaves.erase(m_nodes[leaf].m_key);
+        freeNode(leaf);
+      }
+    }
+
+    for (size_t i = 0, n = bounds.size(); i < n; ++i)
+    {
+      int32_t leaf = m_leaves[i];
+
+      if (leaf == NULL_NODE)
+      {
+        leaf = allocateNode();
+        m_nodes[leaf].m_bounds = bounds[i].expanded(m_margin);
+        m_nodes[leaf].m_entry = i;
+        m_nodes[leaf].m_key = keys[i];
+        insertLeaf(leaf);
+        m_keyLeaves.emplace(keys[i], leaf);
+        m_leaves[i] = leaf;
+        ++m_movedCount;
+        continue;
+      }
+
+      const AABB& fatBounds = m_nodes[leaf].m_bounds;
+
+      // Also reinsert entries which have shrunk a lot, otherwise they would keep their old fat bounds forever
+      if (fatBounds.contains(bounds[i]) && fatBounds.getPerimeter() <= 4 * bounds[i].expanded(m_margin).getPerimeter())
+      {
+        continue;
+      }
+
+      removeLeaf(leaf);
+      m_nodes[leaf].m_bounds = bounds[i].expanded(m_margin);
+      insertLeaf(leaf);
+      ++m_movedCount;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void DynamicAABBTreeBroadphase::query(const AABB& bounds, std::vector<size_t>& results) const
+  {
+    if (m_root == NULL_NODE)
+    {
+      return;
+    }
+
+    // A balanced tree is only ever around 1.44 * log2(n) high, so this is plenty
+    // It lives on the stack so that queries never allocate and can run on several threads at once
+    int32_t stack[MAX_QUERY_DEPTH];
+    size_t stackSize = 0;
+    stack[stackSize++] = m_root;
+
+    while (stackSize > 0)
+    {
+      const Node& node = m_nodes[stack[--stackSize]];
+
+      if (!node.m_bounds.overlaps(bounds))
+      {
+        continue;
+      }
+
+      if (node.isLeaf())
+      {
+        // Leaves hold fattened bounds, so check against the real ones before reporting
+        if (m_bounds[node.m_entry].overlaps(bounds))
+        {
+          results.push_back(node.m_entry);
+        }
+      }
+      else
+      {
+        ASSERT(stackSize + 2 <= MAX_QUERY_DEPTH);
+        stack[stackSize++] = node.m_right;
+        stack[stackSize++] = node.m_left;
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void DynamicAABBTreeBroadphase::querySegment(const glm::vec2& start, const glm::vec2& end, std::vector<size_t>& results) const
+  {
+    if (m_root == NULL_NODE)
+    {
+      return;
+    }
+
+    int32_t stack[MAX_QUERY_DEPTH];
+    size_t stackSize = 0;
+    stack[stackSize++] = m_root;
+
+    while (stackSize > 0)
+    {
+      const Node& node = m_nodes[stack[--stackSize]];
+
+      if (!node.m_bounds.intersectsSegment(start, end))
+      {
+        continue;
+      }
+
+      if (node.isLeaf())
+      {
+        if (m_bounds[node.m_entry].intersectsSegment(start, end))
+        {
+          results.push_back(node.m_entry);
+        }
+      }
+      else
+      {
+        ASSERT(stackSize + 2 <= MAX_QUERY_DEPTH);
+        stack[stackSize++] = node.m_right;
+        stack[stackSize++] = node.m_left;
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t DynamicAABBTreeBroadphase::getHeight() const
+  {
+    return m_root == NULL_NODE ? 0 : static_cast<size_t>(m_nodes[m_root].m_height);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void DynamicAABBTreeBroadphase::replaceChild(int32_t parent, int32_t oldChild, int32_t newChild)
+  {
+    if (parent == NULL_NODE)
+    {
+      m_root = newChild;
+    }
+    else if (m_nodes[parent].m_left == oldChild)
+    {
+      m_nodes[parent].m_left = newChild;
+    }
+    else
+    {
+      ASSERT(m_nodes[parent].m_right == oldChild);
+      m_nodes[parent].m_right = newChild;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void DynamicAABBTreeBroadphase::refit(int32_t node)
+  {
+    // Walk back up to the root, rebalancing and recalculating bounds and heights as we go
+    while (node != NULL_NODE)
+    {
+      node = balance(node);
+
+      Node& current = m_nodes[node];
+      const Node& left = m_nodes[current.m_left];
+      const Node& right = m_nodes[current.m_right];
+
+      current.m_bounds = AABB::merge(left.m_bounds, right.m_bounds);
+      current.m_height = 1 + std::max(left.m_height, right.m_height);
+
+      node = current.m_parent;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void DynamicAABBTreeBroadphase::insertLeaf(int32_t leaf)
+  {
+    if (m_root == NULL_NODE)
+    {
+      m_root = leaf;
+      m_nodes[leaf].m_parent = NULL_NODE;
+      return;
+    }
+
+    // Find the best sibling by descending the tree, using the increase in perimeter as the cost of each choice
+    AABB leafBounds = m_nodes[leaf].m_bounds;
+    int32_t sibling = m_root;
+
+    while (!m_nodes[sibling].isLeaf())
+    {
+      const Node& current = m_nodes[sibling];
+      float perimeter = current.m_bounds.getPerimeter();
+      float combinedPerimeter = AABB::merge(current.m_bounds, leafBounds).getPerimeter();
+
+      // Cost of making a new parent for this node and the leaf
+      float cost = 2 * combinedPerimeter;
+
+      // Minimum cost of pushing the leaf further down the tree
+      float inheritanceCost = 2 * (combinedPerimeter - perimeter);
+
+      auto getChildCost = [this, &leafBounds, inheritanceCost](int32_t child)
+      {
+        const Node& childNode = m_nodes[child];
+        float mergedPerimeter = AABB::merge(childNode.m_bounds, leafBounds).getPerimeter();
+        return (childNode.isLeaf() ? mergedPerimeter : mergedPerimeter - childNode.m_bounds.getPerimeter()) + inheritanceCost;
+      };
+
+      float leftCost = getChildCost(current.m_left);
+      float rightCost = getChildCost(current.m_right);
+
+      if (cost < leftCost && cost < rightCost)
+      {
+        break;
+      }
+
+      sibling = leftCost < rightCost ? current.m_left : current.m_right;
+    }
+
+    // Create a new parent for the sibling and the leaf
+    int32_t oldParent = m_nodes[sibling].m_parent;
+    int32_t newParent = allocateNode();
+
+    Node& parentNode = m_nodes[newParent];
+    parentNode.m_parent = oldParent;
+    parentNode.m_bounds = AABB::merge(leafBounds, m_nodes[sibling].m_bounds);
+    parentNode.m_height = m_nodes[sibling].m_height + 1;
+    parentNode.m_left = sibling;
+    parentNode.m_right = leaf;
+
+    replaceChild(oldParent, sibling, newParent);
+    m_nodes[sibling].m_parent = newParent;
+    m_nodes[leaf].m_parent = newParent;
+
+    refit(newParent);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void DynamicAABBTreeBroadphase::removeLeaf(int32_t leaf)
+  {
+    if (leaf == m_root)
+    {
+      m_root = NULL_NODE;
+      return;
+    }
+
+    int32_t parent = m_nodes[leaf].m_parent;
+    int32_t grandParent = m_nodes[parent].m_parent;
+    int32_t sibling = m_nodes[parent].m_left == leaf ? m_nodes[parent].m_right : m_nodes[parent].m_left;
+
+    // The sibling takes the parent's place
+    replaceChild(grandParent, parent, sibling);
+    m_nodes[sibling].m_parent = grandParent;
+    freeNode(parent);
+
+    refit(grandParent);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  int32_t DynamicAABBTreeBroadphase::balance(int32_t a)
+  {
+    if (m_nodes[a].isLeaf() || m_nodes[a].m_height < 2)
+    {
+      return a;
+    }
+
+    int32_t b = m_nodes[a].m_left;
+    int32_t c = m_nodes[a].m_right;
+    int32_t heightDifference = m_nodes[c].m_height - m_nodes[b].m_height;
+
+    if (heightDifference > 1 || heightDifference < -1)
+    {
+      // Rotate the taller child up into a's place, and move its shorter child down under a
+      bool rotateRight = heightDifference > 1;
+      int32_t up = rotateRight ? c : b;
+      int32_t other = rotateRight ? b : c;
+      int32_t f = m_nodes[up].m_left;
+      int32_t g = m_nodes[up].m_right;
+
+      m_nodes[up].m_left = a;
+      m_nodes[up].m_parent = m_nodes[a].m_parent;
+      m_nodes[a].m_parent = up;
+      replaceChild(m_nodes[up].m_parent, a, up);
+
+      // Keep the taller grandchild up with the rotated node
+      int32_t keep = m_nodes[f].m_height > m_nodes[g].m_height ? f : g;
+      int32_t moved = keep == f ? g : f;
+
+      m_nodes[up].m_right = keep;
+      if (rotateRight)
+      {
+        m_nodes[a].m_right = moved;
+      }
+      else
+      {
+        m_nodes[a].m_left = moved;
+      }
+      m_nodes[moved].m_parent = a;
+
+      m_nodes[a].m_bounds = AABB::merge(m_nodes[other].m_bounds, m_nodes[moved].m_bounds);
+      m_nodes[a].m_height = 1 + std::max(m_nodes[other].m_height, m_nodes[moved].m_height);
+      m_nodes[up].m_bounds = AABB::merge(m_nodes[a].m_bounds, m_nodes[keep].m_bounds);
+      m_nodes[up].m_height = 1 + std::max(m_nodes[a].m_height, m_nodes[keep].m_height);
+
+      return up;
+    }
+
+    return a;
+  }
+}
@@ -12,7 +12,8 @@ namespace Celeste::Physics
   EllipseCollider::EllipseCollider(GameObject& gameObject) :
     Inherited(gameObject),
     m_unscaledDimensions(),
-    m_ellipse()
+    m_ellipse(),
+    m_rotation(0)
   {
     sync();
   }
@@ -62,6 +63,7 @@ namespace Celeste::Physics
 
     m_ellipse.m_centre = glm::vec2(transform->getWorldTranslation()) + getOffset();
     m_ellipse.m_dimensions = transform != nullptr ? (m_unscaledDimensions * glm::vec2(transform->getWorldScale())) : m_unscaledDimensions;
+    m_rotation = transform->getWorldRotation();
   }
 
   //------------------------------------------------------------------------------------------------
@@ -79,7 +81,6 @@ namespace Celeste::Physics
 
     // Calculate the point of intersection in the z plane our transform is on
     // For now we are assuming all textures are perpendicular to z
-    // We also do not handle rotation at the moment (should be ok - just rotate the dims vector
     glm::vec3 translation = transform->getWorldTranslation();
 
     float t = (translation.z - ray.m_origin.z) / ray.m_direction.z;
@@ -91,33 +92,18 @@ namespace Celeste::Physics
   //------------------------------------------------------------------------------------------------
   bool EllipseCollider::intersects(const glm::vec2& point) const
   {
-    // https://math.stackexchange.com/questions/76457/check-if-a-point-is-within-an-ellipse
-    glm::vec2 scaledDimensions = getDimensions();
-
-    return (scaledDimensions.y * scaledDimensions.y * (point.x - m_ellipse.m_centre.x) * (point.x - m_ellipse.m_centre.x) +
-      scaledDimensions.x * scaledDimensions.x * (point.y - m_ellipse.m_centre.y) * (point.y - m_ellipse.m_centre.y))
-      <=
-      scaledDimensions.x * scaledDimensions.x * scaledDimensions.y * scaledDimensions.y;
+    return contains(getShape(), point);
   }
 
   //------------------------------------------------------------------------------------------------
   bool EllipseCollider::intersects(const Maths::Rectangle& rectangle) const
   {
-    // First make a bounding rectangle for this ellipse to simplify calculations
-    Maths::Rectangle boundingRectangle(getCentre(), getDimensions());
-    if (boundingRectangle.intersects(rectangle))
-    {
-      return true;
-    }
-
-    // TODO proper ellipse collision - currently just rectangle <-> rectangle
-    return false;
+    return Physics::intersects(getShape(), CollisionShape::box(rectangle.getCentre(), rectangle.getDimensions() * 0.5f));
   }
 
   //------------------------------------------------------------------------------------------------
-  bool EllipseCollider::intersects(const Maths::Ellipse& /*ellipse*/) const
+  bool EllipseCollider::intersects(const Maths::Ellipse& ellipse) const
   {
-    // TODO
-    return false;
+    return Physics::intersects(getShape(), CollisionShape::ellipse(ellipse.m_centre, ellipse.m_dimensions));
   }
 }
\ No newline at end of file
@@ -3,8 +3,13 @@
 #include "Physics/RectangleCollider.h"
 #include "Physics/EllipseCollider.h"
 #include "Physics/Collider.h"
+#include "Physics/UniformGridBroadphase.h"
+#include "Physics/DynamicAABBTreeBroadphase.h"
 #include "Objects/GameObject.h"
 #include "Algorithm/Entity.h"
+#include "Threads/JobSystem.h"
+
+#include <numeric>
 
 
 namespace Celeste::Physics
@@ -12,7 +17,43 @@ namespace Celeste::Physics
   //------------------------------------------------------------------------------------------------
   PhysicsManager::PhysicsManager() :
     m_gravityScale(9.81f),
-    m_simulatedBodies()
+    m_simulatedBodies(),
+    m_broadphase(std::make_unique<UniformGridBroadphase>()),
+    m_sleepingBroadphase(std::make_unique<DynamicAABBTreeBroadphase>()),
+    m_broadphaseColliders(),
+    m_broadphaseHandles(),
+    m_broadphaseShapes(),
+    m_sleepingColliderCount(0),
+    m_sleepingChanged(false),
+    m_broadphaseChangeCount(0),
+    m_sleepingBounds(),
+    m_sleepingKeys(),
+    m_awakeBounds(),
+    m_awakeKeys(),
+    m_rectangleBroadphaseIndices(),
+    m_ellipseBroadphaseIndices(),
+    m_activeBodies(),
+    m_threadContacts(),
+    m_contacts(),
+    m_candidateCount(0),
+    m_integrator(),
+    m_integratorIndices(),
+    m_integratorHandles(),
+    m_bulletHits(),
+    m_sweepCandidates(),
+    m_sleepingEnabled(true),
+    m_sleepFrameCount(30),
+    m_sleepLinearVelocity(1),
+    m_sleepAngularVelocity(0.05f),
+    m_broadphaseBodyIndices(),
+    m_islandParents(),
+    m_islandAwake(),
+    m_islandSleepIds(),
+    m_nextIslandId(0),
+    m_queryCandidates(),
+    m_queryIntersections(),
+    m_deterministic(false),
+    m_updating(false)
   {
   }
 
@@ -27,29 +68,60 @@ namespace Celeste::Physics
   //------------------------------------------------------------------------------------------------
   void PhysicsManager::update(float elapsedGameTime)
   {
-    Algorithm::update(RectangleCollider::m_allocator);
-    Algorithm::update(EllipseCollider::m_allocator);
+    m_updating = true;
 
     if (!m_simulatedBodies.empty())
     {
+      // remove_if keeps the remaining bodies in the order they were added, which deterministic replays rely on
       m_simulatedBodies.erase(std::remove_if(m_simulatedBodies.begin(), m_simulatedBodies.end(), [](const SimulatedBody& body) -> bool
         {
           return body.m_collider == nullptr && body.m_rigidBody == nullptr;
         }), m_simulatedBodies.end());
     }
 
-    for (SimulatedBody& body : m_simulatedBodies)
+    // Wake anything disturbed first, so its collider is synced along with the rest of the awake ones
+    checkSleepingBodies();
+
+    // Nothing moves a sleeping body without waking it, so its collider is still where it was when it fell asleep
+    auto syncColliders = [](auto& allocator)
     {
-      // Gravity
-      if (body.m_rigidBody != nullptr && body.m_rigidBody->isActive() && m_gravityScale != 0)
+      for (auto& collider : allocator)
       {
-        // Acceleration due to gravity - DO multiply by time
-        body.m_rigidBody->incrementLinearVelocity(0, -m_gravityScale * elapsedGameTime * 40);
+        if (!collider.isSleeping())
+        {
+          collider.update();
+        }
+      }
+    };
+
+    syncColliders(RectangleCollider::m_allocator);
+    syncColliders(EllipseCollider::m_allocator);
+
+    updateBroadphase();
+    m_activeBodies.clear();
+    m_broadphaseBodyIndices.assign(m_broadphaseColliders.size(), NO_BODY);
+
+    for (size_t bodyIndex = 0, bodyCount = m_simulatedBodies.size(); bodyIndex < bodyCount; ++bodyIndex)
+    {
+      SimulatedBody& body = m_simulatedBodies[bodyIndex];
+
+      if (body.m_collider != nullptr)
+      {
+        if (size_t broadphaseIndex = findBroadphaseIndex(body.m_collider); broadphaseIndex != NO_COLLIDER)
+        {
+          m_broadphaseBodyIndices[broadphaseIndex] = bodyIndex;
+        }
+      }
+
+      if (body.m_sleeping)
+      {
+        // Sleeping bodies keep the collisions they had when they fell asleep, ready for when they wake
+        // Anything awake can still hit them, as their colliders stay in the broadphase
+        continue;
       }
 
       // Update the last frame collisions
-      body.m_collidersLastFrame.assign(body.m_collidersThisFrame.begin(), body.m_collidersThisFrame.end());
-      body.m_collidersThisFrame.clear();
+      body.beginFrame();
 
       if (body.m_collider == nullptr || !body.m_collider->isActive())
       {
@@ -57,23 +129,594 @@ namespace Celeste::Physics
         continue;
       }
 
-      // Possible improvement here - go through all colliders once before iterating over bodies and quad tree them
-      // Then this narrows down the colliders we have to search through to check for intersection
-      // But can use last frames collisions to work out exits/entries too
-      // Will avoid quadratic algorithm
+      m_activeBodies.push_back(bodyIndex);
+    }
+
+    findContacts();
+    dispatchContacts();
+
+    integrateRigidBodies(elapsedGameTime);
+    updateIslands();
+
+    m_updating = false;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool PhysicsManager::canSleep(const SimulatedBody& body)
+  {
+    return body.m_rigidBody != nullptr && body.m_rigidBody->isActive() && body.m_rigidBody->getTransform() != nullptr;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::checkSleepingBodies()
+  {
+    for (SimulatedBody& body : m_simulatedBodies)
+    {
+      if (!body.m_sleeping)
+      {
+        continue;
+      }
+
+      if (!m_sleepingEnabled || !canSleep(body))
+      {
+        wake(body);
+        continue;
+      }
+
+      const RigidBody2D& rigidBody = *body.m_rigidBody;
+      const Transform& transform = *rigidBody.getTransform();
+
+      // Deactivated colliders must come out of the sleeping broadphase, which only happens when something wakes
+      if (rigidBody.isAwake() ||
+          (body.m_collider != nullptr && !body.m_collider->isActive()) ||
+          rigidBody.getLinearVelocity() != glm::zero<glm::vec2>() ||
+          rigidBody.getAngularVelocity() != 0 ||
+          transform.getWorldTranslation() != body.m_sleepTranslation ||
+          transform.getWorldRotation() != body.m_sleepRotation)
+      {
+        wakeIsland(body.m_islandId);
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t PhysicsManager::findIsland(size_t bodyIndex)
+  {
+    while (m_islandParents[bodyIndex] != bodyIndex)
+    {
+      // Path halving keeps the trees flat without needing any recursion
+      m_islandParents[bodyIndex] = m_islandParents[m_islandParents[bodyIndex]];
+      bodyIndex = m_islandParents[bodyIndex];
+    }
+
+    return bodyIndex;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::updateIslands()
+  {
+    if (!m_sleepingEnabled)
+    {
+      return;
+    }
+
+    size_t bodyCount = m_simulatedBodies.size();
+    m_islandParents.resize(bodyCount);
+    std::iota(m_islandParents.begin(), m_islandParents.end(), static_cast<size_t>(0));
+
+    // Bodies resting on one another form an island, so a whole stack only sleeps once all of it has settled,
+    // and anything disturbing one body in it wakes the rest
+    // Triggers and bodies without rigid bodies do not join islands, or one floor would join every stack standing on it
+    for (const Contact& contact : m_contacts)
+    {
+      size_t otherIndex = m_broadphaseBodyIndices[contact.m_colliderIndex];
+      observer_ptr<Collider> collider = resolveBroadphaseCollider(contact.m_colliderIndex);
+
+      if (!contact.m_intersecting || otherIndex == NO_BODY || collider == nullptr || collider->getColliderType() == ColliderType::kTrigger)
+      {
+        continue;
+      }
+
+      const SimulatedBody& body = m_simulatedBodies[contact.m_bodyIndex];
+      if (!canSleep(body) || !canSleep(m_simulatedBodies[otherIndex]) || body.m_collider->getColliderType() == ColliderType::kTrigger)
+      {
+        continue;
+      }
+
+      m_islandParents[findIsland(contact.m_bodyIndex)] = findIsland(otherIndex);
+    }
+
+    // An island stays awake if any of its awake bodies moved this frame or has not been idle for long enough
+    m_islandAwake.assign(bodyCount, 0);
+
+    for (size_t bodyIndex = 0; bodyIndex < bodyCount; ++bodyIndex)
+    {
+      const SimulatedBody& body = m_simulatedBodies[bodyIndex];
+
+      if (canSleep(body) && !body.m_sleeping && (body.m_idleFrameCount == 0 || body.m_idleFrameCount < m_sleepFrameCount))
+      {
+        m_islandAwake[findIsland(bodyIndex)] = 1;
+      }
+    }
+
+    // Bodies coming to rest against sleeping ones join their island rather than starting a new one,
+    // so disturbing any of them later wakes them all
+    m_islandSleepIds.assign(bodyCount, NO_ISLAND);
+
+    for (size_t bodyIndex = 0; bodyIndex < bodyCount; ++bodyIndex)
+    {
+      const SimulatedBody& body = m_simulatedBodies[bodyIndex];
+      if (!canSleep(body) || !body.m_sleeping)
+      {
+        continue;
+      }
+
+      size_t island = findIsland(bodyIndex);
+      size_t& islandSleepId = m_islandSleepIds[island];
+
+      if (islandSleepId == NO_ISLAND)
+      {
+        islandSleepId = body.m_islandId;
+      }
+      else if (islandSleepId != body.m_islandId && m_islandAwake[island] == 0)
+      {
+        // Something has come to rest touching bodies from two sleeping islands, so they are now one
+        mergeIslands(body.m_islandId, islandSleepId);
+      }
+    }
+
+    for (size_t bodyIndex = 0; bodyIndex < bodyCount; ++bodyIndex)
+    {
+      SimulatedBody& body = m_simulatedBodies[bodyIndex];
+      if (!canSleep(body))
+      {
+        continue;
+      }
+
+      size_t island = findIsland(bodyIndex);
+
+      if (m_islandAwake[island] == 0 && !body.m_sleeping)
+      {
+        sleep(body, m_islandSleepIds[island] != NO_ISLAND ? m_islandSleepIds[island] : m_nextIslandId + island);
+      }
+      else if (m_islandAwake[island] != 0 && body.m_sleeping)
+      {
+        // Something moving is touching this sleeping body
+        wakeIsland(body.m_islandId);
+      }
+    }
+
+    // Keep island ids unique across frames, so waking one island never wakes an unrelated one which fell asleep earlier
+    m_nextIslandId += bodyCount;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::sleep(SimulatedBody& body, size_t islandId)
+  {
+    body.m_rigidBody->setAwake(false);
+    body.m_sleeping = true;
+    body.m_islandId = islandId;
+
+    if (body.m_collider != nullptr)
+    {
+      body.m_collider->setSleeping(true);
+      m_sleepingChanged = true;
+    }
+
+    const Transform& transform = *body.m_rigidBody->getTransform();
+    body.m_sleepTranslation = transform.getWorldTranslation();
+    body.m_sleepRotation = transform.getWorldRotation();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::wake(SimulatedBody& body)
+  {
+    body.m_sleeping = false;
+    body.m_idleFrameCount = 0;
+
+    if (body.m_rigidBody != nullptr)
+    {
+      body.m_rigidBody->setAwake(true);
+    }
+
+    if (body.m_collider != nullptr && body.m_collider->isSleeping())
+    {
+      body.m_collider->setSleeping(false);
+      m_sleepingChanged = true;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::wakeIsland(size_t islandId)
+  {
+    // Waking is rare compared to sleeping, so a scan is cheaper overall than keeping lists of each island's bodies
+    for (SimulatedBody& body : m_simulatedBodies)
+    {
+      if (body.m_sleeping && body.m_islandId == islandId)
+      {
+        wake(body);
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::mergeIslands(size_t fromIslandId, size_t toIslandId)
+  {
+    for (SimulatedBody& body : m_simulatedBodies)
+    {
+      if (body.m_sleeping && body.m_islandId == fromIslandId)
+      {
+        body.m_islandId = toIslandId;
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::sweepBullets(float elapsedGameTime)
+  {
+    m_bulletHits.clear();
+
+    // Collision callbacks may add bodies, which can move every body in memory, so iterate by index
+    // and never hold on to a body across a callback
+    for (size_t bodyIndex = 0; bodyIndex < m_simulatedBodies.size(); ++bodyIndex)
+    {
+      observer_ptr<Collider> bulletCollider = m_simulatedBodies[bodyIndex].m_collider;
+      observer_ptr<RigidBody2D> rigidBody = m_simulatedBodies[bodyIndex].m_rigidBody;
+
+      if (rigidBody == nullptr || !rigidBody->isBullet() || !rigidBody->isActive() ||
+          bulletCollider == nullptr || !bulletCollider->isActive() || bulletCollider->getColliderType() == ColliderType::kTrigger)
+      {
+        continue;
+      }
+
+      observer_ptr<Transform> transform = rigidBody->getTransform();
+      glm::vec2 displacement = rigidBody->getLinearVelocity() * elapsedGameTime;
+
+      if (transform == nullptr || displacement == glm::zero<glm::vec2>())
+      {
+        continue;
+      }
+
+      // Only colliders within the box covering the whole path can possibly be hit
+      CollisionShape shape = bulletCollider->getShape();
+      m_sweepCandidates.clear();
+      queryBroadphase(shape.getBounds().swept(displacement), m_sweepCandidates);
+
+      // Lowest broadphase index wins ties, so the result does not depend on which broadphase is in use
+      std::sort(m_sweepCandidates.begin(), m_sweepCandidates.end());
+
+      observer_ptr<Collider> hitCollider = nullptr;
+      size_t hitIndex = 0;
+      float firstImpact = 1;
+      glm::vec2 hitNormal;
+
+      for (size_t candidate : m_sweepCandidates)
+      {
+        observer_ptr<Collider> collider = resolveBroadphaseCollider(candidate);
+        if (collider == nullptr || collider == bulletCollider || collider->getColliderType() == ColliderType::kTrigger)
+        {
+          continue;
+        }
+
+        // Swept against the exact shape, so bullets fly through the empty corners of ellipses' and rotated boxes' bounds
+        float timeOfImpact = 0;
+        glm::vec2 normal;
+
+        if (sweep(shape, displacement, m_broadphaseShapes[candidate], timeOfImpact, normal) && (hitCollider == nullptr || timeOfImpact < firstImpact))
+        {
+          hitCollider = collider;
+          hitIndex = candidate;
+          firstImpact = timeOfImpact;
+          hitNormal = normal;
+        }
+      }
+
+      if (hitCollider == nullptr)
+      {
+        continue;
+      }
+
+      // Stop the bullet moving any further into the collider, just as the narrowphase would have done had the bullet
+      // not gone straight through, and let it slide along the surface for the rest of the frame
+      glm::vec2 velocity = rigidBody->getLinearVelocity();
+      float approachSpeed = glm::dot(velocity, hitNormal);
 
-      for (RectangleCollider& collider : RectangleCollider::m_allocator)
+      if (approachSpeed < 0)
       {
-        doCollision(body, collider);
+        velocity -= hitNormal * approachSpeed;
+        rigidBody->setLinearVelocity(velocity);
       }
 
-      for (EllipseCollider& collider : EllipseCollider::m_allocator)
+      const glm::vec3& translation = transform->getTranslation();
+      glm::vec2 position = glm::vec2(translation.x, translation.y) + displacement * firstImpact + velocity * elapsedGameTime * (1 - firstImpact);
+      m_bulletHits.push_back(BulletHit{ rigidBody, position });
+
+      // Both sides hear about the collision, as they would from the narrowphase
+      // The collider hit only does if it is simulated, and so would have tested itself against the bullet
+      SimulatedBody& bulletBody = m_simulatedBodies[bodyIndex];
+      bulletBody.m_collidersThisFrame.push_back(hitCollider);
+      bool bulletWasTouching = bulletBody.wasTouching(hitCollider);
+
+      size_t hitBodyIndex = m_broadphaseBodyIndices[hitIndex];
+      size_t bulletIndex = findBroadphaseIndex(bulletCollider);
+      bool hitWasTouching = false;
+
+      if (hitBodyIndex != NO_BODY)
       {
-        doCollision(body, collider);
+        // Sleeping bodies keep the collisions they fell asleep with, so only awake ones record the bullet
+        SimulatedBody& hitBody = m_simulatedBodies[hitBodyIndex];
+        hitWasTouching = hitBody.wasTouching(bulletCollider);
+
+        if (!hitBody.m_sleeping)
+        {
+          hitBody.m_collidersThisFrame.push_back(bulletCollider);
+        }
+      }
+
+      if (!bulletWasTouching)
+      {
+        bulletCollider->getGameObject().collisionEnter(*hitCollider);
+      }
+
+      bulletCollider->getGameObject().collision(*hitCollider);
+
+      // The bullet's callbacks may have destroyed either collider
+      if (hitBodyIndex == NO_BODY || bulletIndex == NO_COLLIDER ||
+          resolveBroadphaseCollider(hitIndex) == nullptr || resolveBroadphaseCollider(bulletIndex) == nullptr)
+      {
+        continue;
       }
+
+      if (!hitWasTouching)
+      {
+        hitCollider->getGameObject().collisionEnter(*bulletCollider);
+      }
+
+      hitCollider->getGameObject().collision(*bulletCollider);
     }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::integrateRigidBodies(float elapsedGameTime)
+  {
+    sweepBullets(elapsedGameTime);
+
+    // Gather after the collision callbacks, as they are free to change velocities and transforms
+    syncIntegrator();
 
-    Algorithm::update(RigidBody2D::m_allocator, elapsedGameTime);
+    // Acceleration due to gravity - DO multiply by time
+    // This is applied after moving, so it takes effect next frame once the collision callbacks have had a chance to respond
+    glm::vec2 gravityDelta(0, -m_gravityScale * elapsedGameTime * 40);
+
+    for (SimulatedBody& body : m_simulatedBodies)
+    {
+      if (body.m_rigidBody == nullptr || !body.m_rigidBody->isActive() || !body.m_rigidBody->isAwake())
+      {
+        continue;
+      }
+
+      // Judge idleness on the velocities we are about to move by, after the collision callbacks have responded
+      const RigidBody2D& rigidBody = *body.m_rigidBody;
+      bool idle = glm::length(rigidBody.getLinearVelocity()) <= m_sleepLinearVelocity && std::abs(rigidBody.getAngularVelocity()) <= m_sleepAngularVelocity;
+      body.m_idleFrameCount = idle ? body.m_idleFrameCount + 1 : 0;
+
+      if (m_gravityScale != 0)
+      {
+        if (size_t index = findIntegratorIndex(*body.m_rigidBody); index != NO_BODY)
+        {
+          m_integrator.setAffectedByGravity(index);
+        }
+        else
+        {
+          // Not one of ours to move, but it should still feel gravity
+          body.m_rigidBody->incrementLinearVelocity(gravityDelta);
+        }
+      }
+    }
+
+    m_integrator.integrate(elapsedGameTime, gravityDelta);
+
+    for (const BulletHit& bulletHit : m_bulletHits)
+    {
+      if (size_t index = findIntegratorIndex(*bulletHit.m_rigidBody); index != NO_BODY)
+      {
+        m_integrator.setPosition(index, bulletHit.m_position);
+      }
+    }
+
+    m_integrator.scatter();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::syncIntegrator()
+  {
+    for (size_t index = m_integrator.size(); index-- > 0;)
+    {
+      observer_ptr<RigidBody2D> rigidBody = RigidBody2D::resolve(m_integratorHandles[index]);
+      if (rigidBody == nullptr || !rigidBody->isAwake())
+      {
+        removeFromIntegrator(index);
+      }
+    }
+
+    m_integratorIndices.resize(RigidBody2D::m_allocator.capacity(), NO_BODY);
+
+    for (RigidBody2D& rigidBody : RigidBody2D::m_allocator)
+    {
+      if (!rigidBody.isAwake())
+      {
+        continue;
+      }
+
+      Handle<RigidBody2D> handle = rigidBody.handle();
+      size_t& index = m_integratorIndices[handle.getIndex()];
+
+      if (index != NO_BODY)
+      {
+        m_integrator.gather(index);
+      }
+      else if (size_t added = m_integrator.add(rigidBody); added < m_integrator.size())
+      {
+        index = added;
+        m_integratorHandles.push_back(handle);
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::removeFromIntegrator(size_t index)
+  {
+    // The integrator moves its last body into the removed one's place, so follow it
+    size_t last = m_integrator.size() - 1;
+    m_integratorIndices[m_integratorHandles[index].getIndex()] = NO_BODY;
+
+    if (index != last)
+    {
+      m_integratorHandles[index] = m_integratorHandles[last];
+      m_integratorIndices[m_integratorHandles[index].getIndex()] = index;
+    }
+
+    m_integratorHandles.pop_back();
+    m_integrator.remove(index);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t PhysicsManager::findIntegratorIndex(const RigidBody2D& rigidBody) const
+  {
+    size_t slot = rigidBody.handle().getIndex();
+    return slot < m_integratorIndices.size() ? m_integratorIndices[slot] : NO_BODY;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::raycast(const RaycastQuery* rays, size_t rayCount, RaycastHit* hits, bool includeTriggers)
+  {
+    refreshBroadphase();
+
+    for (size_t rayIndex = 0; rayIndex < rayCount; ++rayIndex)
+    {
+      const RaycastQuery& ray = rays[rayIndex];
+      RaycastHit& hit = hits[rayIndex];
+      hit = RaycastHit();
+
+      m_queryCandidates.clear();
+      queryBroadphaseSegment(ray.m_start, ray.m_end, m_queryCandidates);
+
+      // Lowest broadphase index wins ties, so the result does not depend on which broadphase is in use
+      std::sort(m_queryCandidates.begin(), m_queryCandidates.end());
+
+      for (size_t candidate : m_queryCandidates)
+      {
+        observer_ptr<Collider> collider = resolveBroadphaseCollider(candidate);
+        float fraction = 0;
+
+        if (collider != nullptr && collider->isActive() &&
+            (includeTriggers || collider->getColliderType() != ColliderType::kTrigger) &&
+            Physics::raycast(m_broadphaseShapes[candidate], ray.m_start, ray.m_end, fraction) &&
+            (!hit.isHit() || fraction < hit.m_fraction))
+        {
+          hit.m_collider = collider;
+          hit.m_fraction = fraction;
+        }
+      }
+
+      if (hit.isHit())
+      {
+        hit.m_point = ray.m_start + (ray.m_end - ray.m_start) * hit.m_fraction;
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t PhysicsManager::overlapBoxes(const AABB* boxes, size_t boxCount, observer_ptr<Collider>* colliders, size_t capacity, size_t* counts, bool includeTriggers)
+  {
+    refreshBroadphase();
+    size_t written = 0;
+
+    for (size_t boxIndex = 0; boxIndex < boxCount; ++boxIndex)
+    {
+      const AABB& box = boxes[boxIndex];
+      CollisionShape shape = CollisionShape::box((box.m_min + box.m_max) * 0.5f, (box.m_max - box.m_min) * 0.5f);
+
+      counts[boxIndex] = overlap(shape, colliders + written, capacity - written, includeTriggers);
+      written += counts[boxIndex];
+    }
+
+    return written;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t PhysicsManager::overlapCircles(const CircleQuery* circles, size_t circleCount, observer_ptr<Collider>* colliders, size_t capacity, size_t* counts, bool includeTriggers)
+  {
+    refreshBroadphase();
+    size_t written = 0;
+
+    for (size_t circleIndex = 0; circleIndex < circleCount; ++circleIndex)
+    {
+      const CircleQuery& circle = circles[circleIndex];
+      CollisionShape shape = CollisionShape::ellipse(circle.m_centre, glm::vec2(circle.m_radius));
+
+      counts[circleIndex] = overlap(shape, colliders + written, capacity - written, includeTriggers);
+      written += counts[circleIndex];
+    }
+
+    return written;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t PhysicsManager::overlap(const CollisionShape& shape, observer_ptr<Collider>* colliders, size_t capacity, bool includeTriggers)
+  {
+    if (capacity == 0)
+    {
+      return 0;
+    }
+
+    m_queryCandidates.clear();
+    queryBroadphase(shape.getBounds(), m_queryCandidates);
+    std::sort(m_queryCandidates.begin(), m_queryCandidates.end());
+
+    m_queryIntersections.resize(m_queryCandidates.size());
+    intersects(shape, m_broadphaseShapes.data(), m_queryCandidates.data(), m_queryCandidates.size(), m_queryIntersections.data());
+
+    size_t written = 0;
+
+    for (size_t candidateIndex = 0, candidateCount = m_queryCandidates.size(); candidateIndex < candidateCount && written < capacity; ++candidateIndex)
+    {
+      if (m_queryIntersections[candidateIndex] == 0)
+      {
+        continue;
+      }
+
+      observer_ptr<Collider> collider = resolveBroadphaseCollider(m_queryCandidates[candidateIndex]);
+
+      if (collider != nullptr && collider->isActive() && (includeTriggers || collider->getColliderType() != ColliderType::kTrigger))
+      {
+        colliders[written++] = collider;
+      }
+    }
+
+    return written;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::clearSimulatedBodies()
+  {
+    m_simulatedBodies.clear();
+
+    // Nothing is left to wake these colliders, so they must go back to being synced every frame
+    auto wakeColliders = [this](auto& allocator)
+    {
+      for (auto& collider : allocator)
+      {
+        if (collider.isSleeping())
+        {
+          collider.setSleeping(false);
+          m_sleepingChanged = true;
+        }
+      }
+    };
+
+    wakeColliders(RectangleCollider::m_allocator);
+    wakeColliders(EllipseCollider::m_allocator);
   }
 
   //------------------------------------------------------------------------------------------------
@@ -98,15 +741,309 @@ namespace Celeste::Physics
   }
 
   //------------------------------------------------------------------------------------------------
-  void PhysicsManager::doCollision(SimulatedBody& body, Collider& collider)
+  void PhysicsManager::setDeterministic(bool deterministic)
+  {
+    m_deterministic = deterministic;
+    m_integrator.setVectorised(!deterministic);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::setBroadphase(std::unique_ptr<IBroadphase>&& broadphase)
   {
-    if (!collider.isActive() || body.m_collider == &collider)
+    ASSERT(broadphase != nullptr);
+    m_broadphase = std::move(broadphase);
+
+    // The awake entries are only handed over again when they move, so the new broadphase needs them all now
+    m_broadphase->update(m_awakeBounds, m_awakeKeys);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::updateBroadphase()
+  {
+    size_t changeCount = getColliderChangeCount();
+
+    if (m_sleepingChanged || m_broadphaseChangeCount != changeCount)
     {
-      // This collider is not active or is the same collider, so don't include it in simulation
+      m_broadphaseChangeCount = changeCount;
+      rebuildBroadphase();
       return;
     }
 
-    if (collider.intersects(*body.m_collider))
+    // Every entry is where it was last update, so only the awake colliders can have changed, and only those which moved
+    // need handing to the broadphase again
+    // Colliders are synced to their transforms at the start of each update, so these are their shapes as of the last one
+    bool moved = false;
+
+    for (size_t i = m_sleepingColliderCount, n = m_broadphaseColliders.size(); i < n; ++i)
+    {
+      CollisionShape& shape = m_broadphaseShapes[i];
+      shape = m_broadphaseColliders[i]->getShape();
+
+      AABB bounds = shape.getBounds();
+      AABB& awakeBounds = m_awakeBounds[i - m_sleepingColliderCount];
+
+      if (bounds.m_min != awakeBounds.m_min || bounds.m_max != awakeBounds.m_max)
+      {
+        awakeBounds = bounds;
+        moved = true;
+      }
+    }
+
+    if (moved)
+    {
+      m_broadphase->update(m_awakeBounds, m_awakeKeys);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::rebuildBroadphase()
+  {
+    // Inactive colliders never take part in collisions, so leave them out entirely
+    auto addColliders = [this](auto& allocator, auto handleMember, std::vector<size_t>& slotIndices, bool sleeping, std::vector<AABB>& bounds, std::vector<uint64_t>& keys)
+    {
+      for (auto& collider : allocator)
+      {
+        if (collider.isActive() && collider.isSleeping() == sleeping)
+        {
+          ColliderHandle colliderHandle;
+          colliderHandle.*handleMember = collider.handle();
+          m_broadphaseHandles.push_back(colliderHandle);
+
+          slotIndices[(colliderHandle.*handleMember).getIndex()] = m_broadphaseColliders.size();
+          m_broadphaseColliders.push_back(&collider);
+          m_broadphaseShapes.push_back(collider.getShape());
+          bounds.push_back(m_broadphaseShapes.back().getBounds());
+
+          // Colliders never move in memory while they are alive, so their address identifies them from one update to the next
+          // A new collider reusing a destroyed one's slot just looks like the old collider having moved
+          keys.push_back(reinterpret_cast<uintptr_t>(&collider));
+        }
+      }
+    };
+
+    m_broadphaseColliders.clear();
+    m_broadphaseHandles.clear();
+    m_broadphaseShapes.clear();
+    m_rectangleBroadphaseIndices.assign(RectangleCollider::m_allocator.capacity(), NO_COLLIDER);
+    m_ellipseBroadphaseIndices.assign(EllipseCollider::m_allocator.capacity(), NO_COLLIDER);
+
+    // Sleeping colliders go first, so they keep their indices when only awake colliders change
+    m_sleepingBounds.clear();
+    m_sleepingKeys.clear();
+
+    addColliders(RectangleCollider::m_allocator, &ColliderHandle::m_rectangleCollider, m_rectangleBroadphaseIndices, true, m_sleepingBounds, m_sleepingKeys);
+    addColliders(EllipseCollider::m_allocator, &ColliderHandle::m_ellipseCollider, m_ellipseBroadphaseIndices, true, m_sleepingBounds, m_sleepingKeys);
+
+    m_sleepingColliderCount = m_broadphaseColliders.size();
+    m_sleepingBroadphase->update(m_sleepingBounds, m_sleepingKeys);
+    m_sleepingChanged = false;
+
+    m_awakeBounds.clear();
+    m_awakeKeys.clear();
+
+    addColliders(RectangleCollider::m_allocator, &ColliderHandle::m_rectangleCollider, m_rectangleBroadphaseIndices, false, m_awakeBounds, m_awakeKeys);
+    addColliders(EllipseCollider::m_allocator, &ColliderHandle::m_ellipseCollider, m_ellipseBroadphaseIndices, false, m_awakeBounds, m_awakeKeys);
+
+    m_broadphase->update(m_awakeBounds, m_awakeKeys);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::refreshBroadphase()
+  {
+    // Rebuilding partway through an update would change the broadphase indices the contacts refer to
+    if (!m_updating && m_broadphaseChangeCount != getColliderChangeCount())
+    {
+      updateBroadphase();
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  observer_ptr<Collider> PhysicsManager::resolveBroadphaseCollider(size_t index) const
+  {
+    const ColliderHandle& handle = m_broadphaseHandles[index];
+
+    if (!handle.m_rectangleCollider.isNull())
+    {
+      return RectangleCollider::resolve(handle.m_rectangleCollider);
+    }
+
+    return EllipseCollider::resolve(handle.m_ellipseCollider);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t PhysicsManager::findBroadphaseIndex(const Collider* collider) const
+  {
+    // Which allocator a collider came from is worked out from its address alone, as it may have been destroyed
+    auto find = [](const auto& allocator, const std::vector<size_t>& slotIndices, const auto* typedCollider) -> size_t
+    {
+      auto handle = allocator.getHandle(*typedCollider);
+      return !handle.isNull() && handle.getIndex() < slotIndices.size() ? slotIndices[handle.getIndex()] : NO_COLLIDER;
+    };
+
+    if (RectangleCollider::m_allocator.contains(*static_cast<const RectangleCollider*>(collider)))
+    {
+      return find(RectangleCollider::m_allocator, m_rectangleBroadphaseIndices, static_cast<const RectangleCollider*>(collider));
+    }
+
+    return find(EllipseCollider::m_allocator, m_ellipseBroadphaseIndices, static_cast<const EllipseCollider*>(collider));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::queryBroadphase(const AABB& bounds, std::vector<size_t>& results) const
+  {
+    m_sleepingBroadphase->query(bounds, results);
+
+    size_t firstAwake = results.size();
+    m_broadphase->query(bounds, results);
+
+    for (size_t i = firstAwake, n = results.size(); i < n; ++i)
+    {
+      results[i] += m_sleepingColliderCount;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::queryBroadphaseSegment(const glm::vec2& start, const glm::vec2& end, std::vector<size_t>& results) const
+  {
+    m_sleepingBroadphase->querySegment(start, end, results);
+
+    size_t firstAwake = results.size();
+    m_broadphase->querySegment(start, end, results);
+
+    for (size_t i = firstAwake, n = results.size(); i < n; ++i)
+    {
+      results[i] += m_sleepingColliderCount;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t PhysicsManager::getColliderChangeCount()
+  {
+    // Every allocation adds one to the allocation count, and every deallocation takes one from the live count
+    auto getChangeCount = [](const AllocatorStats& stats) { return 2 * stats.m_allocationCount - stats.m_liveCount; };
+    return getChangeCount(RectangleCollider::m_allocator.getStats()) + getChangeCount(EllipseCollider::m_allocator.getStats()) + Collider::getActiveChangeCount();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::findCandidates(const SimulatedBody& body, std::vector<size_t>& candidates) const
+  {
+    candidates.clear();
+    queryBroadphase(body.m_collider->getBounds(), candidates);
+
+    // Anything we touched last frame must be revisited, even if it is no longer nearby, so that its exit callback fires
+    // Colliders which are not in the broadphase have since been deactivated or destroyed, and never get exit callbacks
+    for (observer_ptr<Collider> collider : body.m_collidersLastFrame)
+    {
+      if (size_t broadphaseIndex = findBroadphaseIndex(collider); broadphaseIndex != NO_COLLIDER)
+      {
+        candidates.push_back(broadphaseIndex);
+      }
+    }
+
+    // Visit candidates in the order the colliders were added to the broadphase, so callbacks fire in the same order
+    // regardless of which broadphase is in use
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::findContacts()
+  {
+    JobSystem& jobSystem = getJobSystem();
+    m_threadContacts.resize(jobSystem.getThreadCount() + 1);
+
+    for (ThreadContacts& threadContacts : m_threadContacts)
+    {
+      threadContacts.m_contacts.clear();
+      threadContacts.m_candidateCount = 0;
+    }
+
+    // The intersection tests only read collider state, so each body can be tested against its candidates independently
+    // Results go into a buffer per thread, so no locking is needed
+    auto findBodyContacts = [this](size_t begin, size_t end, ThreadContacts& threadContacts)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        size_t bodyIndex = m_activeBodies[i];
+        const SimulatedBody& body = m_simulatedBodies[bodyIndex];
+
+        std::vector<size_t>& candidates = threadContacts.m_candidates;
+        findCandidates(body, candidates);
+        threadContacts.m_candidateCount += candidates.size();
+
+        // Test the body's shape against all of its candidates in one go, rather than going through the colliders one at a time
+        threadContacts.m_intersections.resize(candidates.size());
+        intersects(body.m_collider->getShape(), m_broadphaseShapes.data(), candidates.data(), candidates.size(), threadContacts.m_intersections.data());
+
+        for (size_t candidateIndex = 0, candidateCount = candidates.size(); candidateIndex < candidateCount; ++candidateIndex)
+        {
+          size_t candidate = candidates[candidateIndex];
+          const Collider& collider = *m_broadphaseColliders[candidate];
+
+          if (body.m_collider == &collider)
+          {
+            // Bodies never collide with themselves
+            continue;
+          }
+
+          bool intersecting = threadContacts.m_intersections[candidateIndex] != 0;
+          bool wasTouching = body.wasTouching(&collider);
+
+          // Non intersecting candidates only matter if they need an exit callback
+          if (intersecting || wasTouching)
+          {
+            threadContacts.m_contacts.push_back(Contact{ bodyIndex, candidate, intersecting, wasTouching });
+          }
+        }
+      }
+    };
+
+    if (m_deterministic)
+    {
+      findBodyContacts(0, m_activeBodies.size(), m_threadContacts[0]);
+    }
+    else
+    {
+      jobSystem.parallelFor(m_activeBodies.size(), NARROWPHASE_BATCH_SIZE, [this, &jobSystem, &findBodyContacts](size_t begin, size_t end)
+      {
+        findBodyContacts(begin, end, m_threadContacts[jobSystem.getCurrentThreadIndex()]);
+      });
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::dispatchContacts()
+  {
+    m_contacts.clear();
+    m_candidateCount = 0;
+
+    for (const ThreadContacts& threadContacts : m_threadContacts)
+    {
+      m_contacts.insert(m_contacts.end(), threadContacts.m_contacts.begin(), threadContacts.m_contacts.end());
+      m_candidateCount += threadContacts.m_candidateCount;
+    }
+
+    // Which thread found which contact varies from run to run, so put them back into body then broadphase order
+    // before calling anything, so callbacks always fire in the same order
+    std::sort(m_contacts.begin(), m_contacts.end(), [](const Contact& lhs, const Contact& rhs)
+    {
+      return lhs.m_bodyIndex != rhs.m_bodyIndex ? lhs.m_bodyIndex < rhs.m_bodyIndex : lhs.m_colliderIndex < rhs.m_colliderIndex;
+    });
+
+    for (const Contact& contact : m_contacts)
+    {
+      // An earlier callback may have destroyed this collider
+      if (observer_ptr<Collider> collider = resolveBroadphaseCollider(contact.m_colliderIndex); collider != nullptr)
+      {
+        doCollision(m_simulatedBodies[contact.m_bodyIndex], *collider, contact.m_intersecting, contact.m_wasTouching);
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void PhysicsManager::doCollision(SimulatedBody& body, Collider& collider, bool intersecting, bool wasTouching)
+  {
+    if (intersecting)
     {
       // Add this collider to the rigidbody's latest collisions
       body.m_collidersThisFrame.push_back(&collider);
@@ -115,7 +1052,7 @@ namespace Celeste::Physics
       if (collider.getColliderType() == ColliderType::kTrigger)
       {
         // Collider is a trigger, so we don't care about physics simulation
-        if (std::find(body.m_collidersLastFrame.begin(), body.m_collidersLastFrame.end(), &collider) == body.m_collidersLastFrame.end())
+        if (!wasTouching)
         {
           // Body hasn't collided before so we call the trigger enter function
           body.m_collider->getGameObject().triggerEnter(collider);
@@ -156,7 +1093,7 @@ namespace Celeste::Physics
           body.m_rigidBody->setLinearVelocity(newVelocity);
         }
 
-        if (std::find(body.m_collidersLastFrame.begin(), body.m_collidersLastFrame.end(), &collider) == body.m_collidersLastFrame.end())
+        if (!wasTouching)
         {
           body.m_collider->getGameObject().collisionEnter(collider);
         }
@@ -164,7 +1101,7 @@ namespace Celeste::Physics
 
       body.m_collider->getGameObject().collision(collider);
     }
-    else if (std::find(body.m_collidersLastFrame.begin(), body.m_collidersLastFrame.end(), &collider) != body.m_collidersLastFrame.end())
+    else if (wasTouching)
     {
       // Body intersected collider last frame so call exit based on collider type
       if (collider.getColliderType() == ColliderType::kTrigger)
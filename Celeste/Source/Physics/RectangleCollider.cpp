@@ -13,7 +13,8 @@ namespace Celeste::Physics
   RectangleCollider::RectangleCollider(GameObject& gameObject) :
     Inherited(gameObject),
     m_rectangle(),
-    m_dimensions()
+    m_dimensions(),
+    m_rotation(0)
   {
     sync();
   }
@@ -63,6 +64,7 @@ namespace Celeste::Physics
 
     m_rectangle.setCentre(glm::vec2(transform->getWorldTranslation()) + getOffset());
     m_rectangle.setDimensions(m_dimensions * glm::vec2(transform->getWorldScale()));
+    m_rotation = transform->getWorldRotation();
   }
 
   //------------------------------------------------------------------------------------------------
@@ -80,7 +82,6 @@ namespace Celeste::Physics
 
     // Calculate the point of intersection in the z plane our transform is on
     // For now we are assuming all textures are perpendicular to z
-    // We also do not handle rotation at the moment (should be ok - just rotate the dims vector
     glm::vec3 translation = transform->getWorldTranslation();
 
     float t = (translation.z - ray.m_origin.z) / ray.m_direction.z;
@@ -90,16 +91,20 @@ namespace Celeste::Physics
   }
 
   //------------------------------------------------------------------------------------------------
-  bool RectangleCollider::intersects(const Maths::Ellipse& ellipse) const
+  bool RectangleCollider::intersects(const glm::vec2& point) const
   {
-    // First make a bounding rectangle for this ellipse to simplify calculations
-    Maths::Rectangle boundingRectangle(ellipse.m_centre, ellipse.m_dimensions);
-    if (m_rectangle.intersects(boundingRectangle))
-    {
-      return true;
-    }
+    return contains(getShape(), point);
+  }
 
-    // TODO proper ellipse collision - currently just rectangle rectangle
-    return false;
+  //------------------------------------------------------------------------------------------------
+  bool RectangleCollider::intersects(const Maths::Rectangle& rectangle) const
+  {
+    return Physics::intersects(getShape(), CollisionShape::box(rectangle.getCentre(), rectangle.getDimensions() * 0.5f));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool RectangleCollider::intersects(const Maths::Ellipse& ellipse) const
+  {
+    return Physics::intersects(getShape(), CollisionShape::ellipse(ellipse.m_centre, ellipse.m_dimensions));
   }
 }
\ No newline at end of file
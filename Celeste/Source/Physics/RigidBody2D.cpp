@@ -14,7 +14,9 @@ namespace Celeste::Physics
     m_maxLinearVelocity(FLT_MAX, FLT_MAX),
     m_angularVelocity(0),
     m_minAngularVelocity(-FLT_MAX),
-    m_maxAngularVelocity(FLT_MAX)
+    m_maxAngularVelocity(FLT_MAX),
+    m_bullet(false),
+    m_awake(true)
   {
   }
 
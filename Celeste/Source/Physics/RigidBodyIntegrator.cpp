@@ -0,0 +1,228 @@
+#include "Physics/RigidBodyIntegrator.h"
+#include "Physics/RigidBody2D.h"
+#include "Maths/Transform.h"
+#include "Assert/Assert.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define CELESTE_INTEGRATOR_SSE 1
+#include <xmmintrin.h>
+#endif
+
+
+namespace Celeste::Physics
+{
+  namespace
+  {
+    constexpr size_t LANE_COUNT = 4;
+
+    //------------------------------------------------------------------------------------------------
+    size_t paddedSize(size_t count)
+    {
+      return (count + LANE_COUNT - 1) / LANE_COUNT * LANE_COUNT;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  RigidBodyIntegrator::RigidBodyIntegrator() :
+    m_rigidBodies(),
+    m_transforms(),
+    m_positionX(),
+    m_positionY(),
+    m_rotation(),
+    m_linearVelocityX(),
+    m_linearVelocityY(),
+    m_minLinearVelocityX(),
+    m_minLinearVelocityY(),
+    m_maxLinearVelocityX(),
+    m_maxLinearVelocityY(),
+    m_angularVelocity(),
+    m_affectedByGravity(),
+    m_moved(),
+    m_vectorised(true)
+  {
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void RigidBodyIntegrator::clear()
+  {
+    m_rigidBodies.clear();
+    m_transforms.clear();
+    resizeFields(0);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  RigidBodyIntegrator::Fields RigidBodyIntegrator::getFields()
+  {
+    return { &m_positionX, &m_positionY, &m_rotation, &m_linearVelocityX, &m_linearVelocityY,
+             &m_minLinearVelocityX, &m_minLinearVelocityY, &m_maxLinearVelocityX, &m_maxLinearVelocityY,
+             &m_angularVelocity, &m_affectedByGravity, &m_moved };
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void RigidBodyIntegrator::resizeFields(size_t count)
+  {
+    // New lanes are zeroed, so padding never moves and never feels gravity
+    for (AlignedVector<float>* field : getFields())
+    {
+      field->resize(paddedSize(count), 0);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t RigidBodyIntegrator::add(RigidBody2D& rigidBody)
+  {
+    observer_ptr<Transform> transform = rigidBody.getTransform();
+    if (transform == nullptr)
+    {
+      return size();
+    }
+
+    m_rigidBodies.push_back(&rigidBody);
+    m_transforms.push_back(transform);
+    resizeFields(size());
+
+    size_t index = size() - 1;
+    gather(index);
+
+    return index;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void RigidBodyIntegrator::remove(size_t index)
+  {
+    ASSERT(index < size());
+    size_t last = size() - 1;
+
+    if (index != last)
+    {
+      m_rigidBodies[index] = m_rigidBodies[last];
+      m_transforms[index] = m_transforms[last];
+
+      for (AlignedVector<float>* field : getFields())
+      {
+        (*field)[index] = (*field)[last];
+      }
+    }
+
+    // The last lane becomes padding, so it must not move if its group of four is still integrated
+    for (AlignedVector<float>* field : getFields())
+    {
+      (*field)[last] = 0;
+    }
+
+    m_rigidBodies.pop_back();
+    m_transforms.pop_back();
+    resizeFields(size());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void RigidBodyIntegrator::gather(size_t index)
+  {
+    const RigidBody2D& rigidBody = *m_rigidBodies[index];
+    const Transform& transform = *m_transforms[index];
+
+    const glm::vec3& translation = transform.getTranslation();
+    m_positionX[index] = translation.x;
+    m_positionY[index] = translation.y;
+    m_rotation[index] = transform.getRotation();
+
+    m_linearVelocityX[index] = rigidBody.getLinearVelocity().x;
+    m_linearVelocityY[index] = rigidBody.getLinearVelocity().y;
+    m_minLinearVelocityX[index] = rigidBody.getMinLinearVelocity().x;
+    m_minLinearVelocityY[index] = rigidBody.getMinLinearVelocity().y;
+    m_maxLinearVelocityX[index] = rigidBody.getMaxLinearVelocity().x;
+    m_maxLinearVelocityY[index] = rigidBody.getMaxLinearVelocity().y;
+    m_angularVelocity[index] = rigidBody.getAngularVelocity();
+    m_affectedByGravity[index] = 0;
+    m_moved[index] = 0;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void RigidBodyIntegrator::integrate(float elapsedGameTime, const glm::vec2& gravityDelta)
+  {
+    size_t count = size();
+    size_t i = 0;
+
+    float* positionX = m_positionX.data();
+    float* positionY = m_positionY.data();
+    float* rotation = m_rotation.data();
+    float* linearVelocityX = m_linearVelocityX.data();
+    float* linearVelocityY = m_linearVelocityY.data();
+    const float* minLinearVelocityX = m_minLinearVelocityX.data();
+    const float* minLinearVelocityY = m_minLinearVelocityY.data();
+    const float* maxLinearVelocityX = m_maxLinearVelocityX.data();
+    const float* maxLinearVelocityY = m_maxLinearVelocityY.data();
+    const float* angularVelocity = m_angularVelocity.data();
+    const float* affectedByGravity = m_affectedByGravity.data();
+    float* moved = m_moved.data();
+
+#if CELESTE_INTEGRATOR_SSE
+    const __m128 dt = _mm_set1_ps(elapsedGameTime);
+    const __m128 gravityX = _mm_set1_ps(gravityDelta.x);
+    const __m128 gravityY = _mm_set1_ps(gravityDelta.y);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1);
+
+    // The fields are aligned and padded to a multiple of four, so this covers every body
+    for (; m_vectorised && i < count; i += LANE_COUNT)
+    {
+      __m128 velocityX = _mm_load_ps(linearVelocityX + i);
+      __m128 velocityY = _mm_load_ps(linearVelocityY + i);
+      __m128 spin = _mm_load_ps(angularVelocity + i);
+
+      _mm_store_ps(positionX + i, _mm_add_ps(_mm_load_ps(positionX + i), _mm_mul_ps(velocityX, dt)));
+      _mm_store_ps(positionY + i, _mm_add_ps(_mm_load_ps(positionY + i), _mm_mul_ps(velocityY, dt)));
+      _mm_store_ps(rotation + i, _mm_add_ps(_mm_load_ps(rotation + i), _mm_mul_ps(spin, dt)));
+
+      __m128 moving = _mm_or_ps(_mm_or_ps(_mm_cmpneq_ps(velocityX, zero), _mm_cmpneq_ps(velocityY, zero)), _mm_cmpneq_ps(spin, zero));
+      _mm_store_ps(moved + i, _mm_and_ps(moving, one));
+
+      // Accelerate and clamp the bodies affected by gravity, and leave the others exactly as they were
+      __m128 affected = _mm_cmpneq_ps(_mm_load_ps(affectedByGravity + i), zero);
+
+      __m128 acceleratedX = _mm_add_ps(velocityX, gravityX);
+      __m128 acceleratedY = _mm_add_ps(velocityY, gravityY);
+      acceleratedX = _mm_min_ps(_mm_max_ps(acceleratedX, _mm_load_ps(minLinearVelocityX + i)), _mm_load_ps(maxLinearVelocityX + i));
+      acceleratedY = _mm_min_ps(_mm_max_ps(acceleratedY, _mm_load_ps(minLinearVelocityY + i)), _mm_load_ps(maxLinearVelocityY + i));
+
+      _mm_store_ps(linearVelocityX + i, _mm_or_ps(_mm_and_ps(affected, acceleratedX), _mm_andnot_ps(affected, velocityX)));
+      _mm_store_ps(linearVelocityY + i, _mm_or_ps(_mm_and_ps(affected, acceleratedY), _mm_andnot_ps(affected, velocityY)));
+    }
+#endif
+
+    // Everything, when not vectorised or without SSE
+    for (; i < count; ++i)
+    {
+      positionX[i] += linearVelocityX[i] * elapsedGameTime;
+      positionY[i] += linearVelocityY[i] * elapsedGameTime;
+      rotation[i] += angularVelocity[i] * elapsedGameTime;
+      moved[i] = linearVelocityX[i] != 0 || linearVelocityY[i] != 0 || angularVelocity[i] != 0 ? 1.0f : 0.0f;
+
+      if (affectedByGravity[i] != 0)
+      {
+        linearVelocityX[i] = glm::clamp<float>(linearVelocityX[i] + gravityDelta.x, minLinearVelocityX[i], maxLinearVelocityX[i]);
+        linearVelocityY[i] = glm::clamp<float>(linearVelocityY[i] + gravityDelta.y, minLinearVelocityY[i], maxLinearVelocityY[i]);
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void RigidBodyIntegrator::scatter() const
+  {
+    for (size_t i = 0, count = size(); i < count; ++i)
+    {
+      // Bodies at rest are left alone, so anything which moved their transforms since they were gathered is respected
+      if (m_moved[i] != 0)
+      {
+        Transform& transform = *m_transforms[i];
+        transform.setTranslation(m_positionX[i], m_positionY[i], transform.getTranslation().z);
+        transform.setRotation(m_rotation[i]);
+      }
+
+      if (m_affectedByGravity[i] != 0)
+      {
+        m_rigidBodies[i]->setLinearVelocity(m_linearVelocityX[i], m_linearVelocityY[i]);
+      }
+    }
+  }
+}
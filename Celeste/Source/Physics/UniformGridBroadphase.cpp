@@ -0,0 +1,169 @@
+#include "Physics/UniformGridBroadphase.h"
+#include "Assert/Assert.h"
+
+#include <cmath>
+
+
+namespace Celeste::Physics
+{
+  //------------------------------------------------------------------------------------------------
+  UniformGridBroadphase::UniformGridBroadphase(float cellSize) :
+    m_cellSize(cellSize),
+    m_inverseCellSize(1 / cellSize),
+    m_bounds(),
+    m_oversizedEntries(),
+    m_entries(),
+    m_bucketStarts(1, 0),
+    m_bucketMask(0)
+  {
+    ASSERT(cellSize > 0);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool UniformGridBroadphase::getCellRange(const AABB& bounds, CellRange& cellRange) const
+  {
+    float minX = std::floor(bounds.m_min.x * m_inverseCellSize);
+    float minY = std::floor(bounds.m_min.y * m_inverseCellSize);
+    float maxX = std::floor(bounds.m_max.x * m_inverseCellSize);
+    float maxY = std::floor(bounds.m_max.y * m_inverseCellSize);
+
+    // Written so that infinite or NaN bounds also fail the check
+    if (!((maxX - minX + 1) * (maxY - minY + 1) <= MAX_CELLS_PER_ENTRY))
+    {
+      return false;
+    }
+
+    cellRange.m_minX = static_cast<int64_t>(minX);
+    cellRange.m_minY = static_cast<int64_t>(minY);
+    cellRange.m_maxX = static_cast<int64_t>(maxX);
+    cellRange.m_maxY = static_cast<int64_t>(maxY);
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t UniformGridBroadphase::getBucket(int64_t x, int64_t y) const
+  {
+    uint64_t hash = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full;
+    return static_cast<size_t>(hash ^ (hash >> 32)) & m_bucketMask;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void UniformGridBroadphase::update(const std::vector<AABB>& bounds, const std::vector<uint64_t>& /*keys*/)
+  {
+    // The grid is rebuilt from scratch every update, so there is nothing to carry over between entries with the same key
+    m_bounds.assign(bounds.begin(), bounds.end());
+    m_oversizedEntries.clear();
+
+    size_t cellCount = 0;
+    CellRange cellRange;
+
+    for (size_t i = 0, n = m_bounds.size(); i < n; ++i)
+    {
+      if (getCellRange(m_bounds[i], cellRange))
+      {
+        cellCount += static_cast<size_t>((cellRange.m_maxX - cellRange.m_minX + 1) * (cellRange.m_maxY - cellRange.m_minY + 1));
+      }
+      else
+      {
+        m_oversizedEntries.push_back(i);
+      }
+    }
+
+    // Roughly one bucket per occupied cell keeps chains short without wasting memory on empty buckets
+    size_t bucketCount = 16;
+    while (bucketCount < cellCount)
+    {
+      bucketCount <<= 1;
+    }
+
+    m_bucketMask = bucketCount - 1;
+    m_bucketStarts.assign(bucketCount + 1, 0);
+    m_entries.resize(cellCount);
+
+    // Counting sort the entries into their buckets - first count, then turn the counts into start offsets, then fill
+    auto forEachCell = [this, &cellRange](const auto& function)
+    {
+      for (size_t i = 0, n = m_bounds.size(); i < n; ++i)
+      {
+        if (!getCellRange(m_bounds[i], cellRange))
+        {
+          continue;
+        }
+
+        for (int64_t y = cellRange.m_minY; y <= cellRange.m_maxY; ++y)
+        {
+          for (int64_t x = cellRange.m_minX; x <= cellRange.m_maxX; ++x)
+          {
+            function(i, getBucket(x, y));
+          }
+        }
+      }
+    };
+
+    forEachCell([this](size_t, size_t bucket) { ++m_bucketStarts[bucket + 1]; });
+
+    for (size_t i = 1; i <= bucketCount; ++i)
+    {
+      m_bucketStarts[i] += m_bucketStarts[i - 1];
+    }
+
+    forEachCell([this](size_t entry, size_t bucket) { m_entries[m_bucketStarts[bucket]++] = entry; });
+
+    // Filling advanced every start to the start of the next bucket, so shift them back down
+    for (size_t i = bucketCount; i > 0; --i)
+    {
+      m_bucketStarts[i] = m_bucketStarts[i - 1];
+    }
+    m_bucketStarts[0] = 0;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void UniformGridBroadphase::query(const AABB& bounds, std::vector<size_t>& results) const
+  {
+    size_t firstResult = results.size();
+    CellRange cellRange;
+
+    if (!getCellRange(bounds, cellRange))
+    {
+      // The query covers so many cells that it is quicker just to test everything
+      for (size_t i = 0, n = m_bounds.size(); i < n; ++i)
+      {
+        if (m_bounds[i].overlaps(bounds))
+        {
+          results.push_back(i);
+        }
+      }
+
+      return;
+    }
+
+    for (int64_t y = cellRange.m_minY; y <= cellRange.m_maxY; ++y)
+    {
+      for (int64_t x = cellRange.m_minX; x <= cellRange.m_maxX; ++x)
+      {
+        size_t bucket = getBucket(x, y);
+
+        // Buckets can contain entries from other cells which hashed to the same place, but the bounds test filters those out
+        for (size_t i = m_bucketStarts[bucket], end = m_bucketStarts[bucket + 1]; i < end; ++i)
+        {
+          if (m_bounds[m_entries[i]].overlaps(bounds))
+          {
+            results.push_back(m_entries[i]);
+          }
+        }
+      }
+    }
+
+    for (size_t entry : m_oversizedEntries)
+    {
+      if (m_bounds[entry].overlaps(bounds))
+      {
+        results.push_back(entry);
+      }
+    }
+
+    // Entries spanning several cells will have been found once per cell
+    std::sort(results.begin() + firstResult, results.end());
+    results.erase(std::unique(results.begin() + firstResult, results.end()), results.end());
+  }
+}
@@ -6,8 +6,14 @@
 
 namespace Celeste::Rendering
 {
+  namespace
+  {
+    constexpr size_t FRAME_ALLOCATOR_CAPACITY = 4 * 1024;
+  }
+
   //------------------------------------------------------------------------------------------------
-  RenderManager::RenderManager()
+  RenderManager::RenderManager() :
+    m_frameAllocator(FRAME_ALLOCATOR_CAPACITY)
   {
   }
 
@@ -26,7 +32,9 @@ namespace Celeste::Rendering
   //------------------------------------------------------------------------------------------------
   void RenderManager::render(float lag)
   {
-    std::vector<std::reference_wrapper<Canvas>> canvasses;
+    m_frameAllocator.reset();
+
+    FrameVector<std::reference_wrapper<Canvas>> canvasses(m_frameAllocator);
     for (Canvas& renderer : Canvas::m_allocator)
     {
       if (renderer.isActive())
@@ -9,7 +9,8 @@ namespace Celeste::Rendering
     Inherited(gameObject),
     m_origin(0.5f),
     m_colour(1, 1, 1, 1),
-    m_scissorRectangle()
+    m_scissorRectangle(),
+    m_sortingLayer(0)
   {
   }
 
@@ -2,9 +2,15 @@
 #include "Resources/ResourceManager.h"
 #include "Rendering/SpriteRenderer.h"
 #include "Rendering/TextRenderer.h"
+#include "Resources/2D/Texture2D.h"
 #include "UtilityHeaders/ComponentHeaders.h"
 #include "OpenGL/GL.h"
 #include "OpenGL/ManagedGLBuffer.h"
+#include "Utils/RadixSort.h"
+
+#include <cstddef>
+#include <algorithm>
+#include <cstring>
 
 
 namespace Celeste::Rendering
@@ -13,8 +19,19 @@ namespace Celeste::Rendering
   SpriteBatch::SpriteBatch() :
     m_cameraProjectionMatrix(),
     m_cameraViewMatrix(),
+    m_renderers(),
+    m_renderMatrices(),
+    m_commands(),
+    m_sortScratch(),
+    m_sortingByState(false),
+    m_instances(),
+    m_drawCalls(),
     m_program(),
-    m_vao(static_cast<GLuint>(0))
+    m_vao(static_cast<GLuint>(0)),
+    m_instancedProgram(),
+    m_instancedVao(static_cast<GLuint>(0)),
+    m_instanceBuffer(static_cast<GLuint>(0)),
+    m_instanceBufferCapacity(0)
   {
   }
 
@@ -36,10 +53,11 @@ namespace Celeste::Rendering
         \n \
         uniform mat4 projection; \n \
         uniform mat4 view_model; \n \
+        uniform vec4 uv_rectangle; \n \
         \n \
         void main() \n \
         { \n \
-          TexCoord = texCoord; \n \
+          TexCoord = mix(uv_rectangle.xy, uv_rectangle.zw, texCoord); \n \
           gl_Position = projection * view_model * vec4(position.xy, 0.0f, 1.0f); \n \
         }");
 
@@ -60,6 +78,44 @@ namespace Celeste::Rendering
 
     m_program.createFromCode(spriteVertexShaderCode, spriteFragmentShaderCode);
 
+    // Everything which varies per sprite is streamed per instance, so a whole run of sprites is one draw call
+    std::string instancedVertexShaderCode(
+      "#version 140 \n \
+        attribute vec2 position; \n \
+        attribute vec2 texCoord; \n \
+        attribute mat4 instance_view_model; \n \
+        attribute vec4 instance_uv_rectangle; \n \
+        attribute vec4 instance_colour; \n \
+        \n \
+        out vec2 TexCoord; \n \
+        out vec4 Colour; \n \
+        \n \
+        uniform mat4 projection; \n \
+        \n \
+        void main() \n \
+        { \n \
+          TexCoord = mix(instance_uv_rectangle.xy, instance_uv_rectangle.zw, texCoord); \n \
+          Colour = instance_colour; \n \
+          gl_Position = projection * instance_view_model * vec4(position.xy, 0.0f, 1.0f); \n \
+        }");
+
+    std::string instancedFragmentShaderCode(
+      "#version 140 \n \
+        in vec2 TexCoord; \n \
+        in vec4 Colour; \n \
+        \n \
+        out vec4 color; \n \
+        \n \
+        // Texture samplers \n \
+        uniform sampler2D sprite; \n \
+        \n \
+        void main() \n \
+        { \n \
+          color = Colour * texture(sprite, TexCoord); \n \
+        }");
+
+    m_instancedProgram.createFromCode(instancedVertexShaderCode, instancedFragmentShaderCode);
+
     GLfloat vertices[24] = {
       0, 0, 0, 1,
       0, 1, 0, 0,
@@ -96,6 +152,44 @@ namespace Celeste::Rendering
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     unbindVertexArray();
+
+    // The instanced vertex array shares the quad, but sources its per instance attributes from a buffer we keep
+    if (!GL::genVertexArray(m_instancedVao) || !GL::genBuffer(m_instanceBuffer))
+    {
+      ASSERT_FAIL();
+      return;
+    }
+
+    glBindVertexArray(m_instancedVao);
+    glBindBuffer(GL_ARRAY_BUFFER, managedVBO.getBuffer());
+
+    GLuint position = static_cast<GLuint>(m_instancedProgram.getAttributeLocation("position"));
+    glEnableVertexAttribArray(position);
+    glVertexAttribPointer(position, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
+
+    GLuint texCoord = static_cast<GLuint>(m_instancedProgram.getAttributeLocation("texCoord"));
+    glEnableVertexAttribArray(texCoord);
+    glVertexAttribPointer(texCoord, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (GLvoid*)(2 * sizeof(GLfloat)));
+
+    // A mat4 attribute takes four consecutive locations, one per column
+    GLuint viewModel = static_cast<GLuint>(m_instancedProgram.getAttributeLocation("instance_view_model"));
+    for (GLuint column = 0; column < 4; ++column)
+    {
+      glEnableVertexAttribArray(viewModel + column);
+      glVertexAttribDivisor(viewModel + column, 1);
+    }
+
+    GLuint uvRectangle = static_cast<GLuint>(m_instancedProgram.getAttributeLocation("instance_uv_rectangle"));
+    glEnableVertexAttribArray(uvRectangle);
+    glVertexAttribDivisor(uvRectangle, 1);
+
+    GLuint colour = static_cast<GLuint>(m_instancedProgram.getAttributeLocation("instance_colour"));
+    glEnableVertexAttribArray(colour);
+    glVertexAttribDivisor(colour, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glCheckError();
   }
 
   //------------------------------------------------------------------------------------------------
@@ -106,8 +200,22 @@ namespace Celeste::Rendering
       GL::deleteVertexArray(m_vao);
     }
 
+    if (GL::isVertexArray(m_instancedVao))
+    {
+      GL::deleteVertexArray(m_instancedVao);
+    }
+
+    if (GL::isBuffer(m_instanceBuffer))
+    {
+      GL::deleteBuffer(m_instanceBuffer);
+    }
+
     m_vao = 0;
+    m_instancedVao = 0;
+    m_instanceBuffer = 0;
+    m_instanceBufferCapacity = 0;
     m_program.destroy();
+    m_instancedProgram.destroy();
   }
 
   //------------------------------------------------------------------------------------------------
@@ -120,36 +228,167 @@ namespace Celeste::Rendering
   //------------------------------------------------------------------------------------------------
   void SpriteBatch::end()
   {
+    buildDrawCalls();
+
     if (GL::isVertexArray(m_vao))
     {
-      m_program.bind();
-      m_program.setMatrix4("projection", m_cameraProjectionMatrix);
+      submitDrawCalls();
+    }
+
+    m_renderers.clear();
+    m_renderMatrices.clear();
+    m_commands.clear();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void SpriteBatch::addInstance(const Resources::Texture2D& texture, const SpriteInstance& instance)
+  {
+    // Only a run of consecutive quads can be merged - reordering around other textures would change what draws on top
+    if (m_drawCalls.empty() || m_drawCalls.back().m_texture != &texture)
+    {
+      m_drawCalls.push_back(DrawCall{ &texture, m_instances.size(), 0, nullptr, glm::mat4() });
+    }
+
+    m_instances.push_back(instance);
+    ++m_drawCalls.back().m_instanceCount;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void SpriteBatch::buildDrawCalls()
+  {
+    m_instances.clear();
+    m_drawCalls.clear();
+
+    radixSort(m_commands, m_sortScratch, [](const RenderCommand& command) { return command.m_sortKey; });
+
+    for (const RenderCommand& command : m_commands)
+    {
+      observer_ptr<Renderer> renderer = m_renderers[command.m_renderIndex];
+      glm::mat4 viewModelMatrix = m_cameraViewMatrix * m_renderMatrices[command.m_renderIndex];
 
-      glActiveTexture(GL_TEXTURE0);
-      bindVertexArray();
+      if (!renderer->addInstances(*this, viewModelMatrix))
+      {
+        m_drawCalls.push_back(DrawCall{ nullptr, 0, 0, renderer, viewModelMatrix });
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void SpriteBatch::submitDrawCalls()
+  {
+    if (!m_instances.empty())
+    {
+      // Orphan the old contents so we never wait on the GPU still reading last frame's instances
+      size_t requiredBytes = m_instances.size() * sizeof(SpriteInstance);
+      if (requiredBytes > m_instanceBufferCapacity)
+      {
+        m_instanceBufferCapacity = (std::max)(requiredBytes, 2 * m_instanceBufferCapacity);
+      }
+
+      glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+      glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_instanceBufferCapacity), nullptr, GL_STREAM_DRAW);
+      glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(requiredBytes), m_instances.data());
+      glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // Uniforms are kept per program, so the projection only needs setting once on each
+    m_program.bind();
+    m_program.setMatrix4("projection", m_cameraProjectionMatrix);
+    m_program.setVector4f("uv_rectangle", 0, 0, 1, 1);
+    m_instancedProgram.bind();
+    m_instancedProgram.setMatrix4("projection", m_cameraProjectionMatrix);
+
+    glActiveTexture(GL_TEXTURE0);
+
+    for (const DrawCall& drawCall : m_drawCalls)
+    {
+      if (drawCall.m_renderer != nullptr)
+      {
+        m_program.bind();
+        bindVertexArray();
 
-      for (const RenderPair& renderPair : m_renderers)
+        drawCall.m_renderer->render(m_program, drawCall.m_viewModelMatrix);
+      }
+      else
       {
-        renderPair.first->render(m_program, m_cameraViewMatrix * renderPair.second);
+        m_instancedProgram.bind();
+        glBindVertexArray(m_instancedVao);
+        setInstanceAttributes(drawCall.m_firstInstance);
+
+        drawCall.m_texture->bind();
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(drawCall.m_instanceCount));
       }
+    }
+
+    unbindVertexArray();
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_instancedProgram.unbind();
+    glCheckError();
+  }
 
-      unbindVertexArray();
-      glBindTexture(GL_TEXTURE_2D, 0);
+  //------------------------------------------------------------------------------------------------
+  void SpriteBatch::setInstanceAttributes(size_t firstInstance) const
+  {
+    const GLsizei stride = static_cast<GLsizei>(sizeof(SpriteInstance));
+    const size_t instanceOffset = firstInstance * sizeof(SpriteInstance);
 
-      m_renderers.clear();
-      m_program.unbind();
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+    GLuint viewModel = static_cast<GLuint>(m_instancedProgram.getAttributeLocation("instance_view_model"));
+    for (GLuint column = 0; column < 4; ++column)
+    {
+      size_t offset = instanceOffset + offsetof(SpriteInstance, m_viewModelMatrix) + column * sizeof(glm::vec4);
+      glVertexAttribPointer(viewModel + column, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offset);
     }
+
+    GLuint uvRectangle = static_cast<GLuint>(m_instancedProgram.getAttributeLocation("instance_uv_rectangle"));
+    glVertexAttribPointer(uvRectangle, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(instanceOffset + offsetof(SpriteInstance, m_uvRectangle)));
+
+    GLuint colour = static_cast<GLuint>(m_instancedProgram.getAttributeLocation("instance_colour"));
+    glVertexAttribPointer(colour, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(instanceOffset + offsetof(SpriteInstance, m_colour)));
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  uint64_t SpriteBatch::createSortKey(const Renderer& renderer, const glm::mat4& renderMatrix) const
+  {
+    // Adding zero turns -0 into +0, so the two compare equal as they did as floats
+    float depth = renderMatrix[3].z + 0.0f;
+    uint32_t depthBits = 0;
+    std::memcpy(&depthBits, &depth, sizeof(float));
+
+    // Flipping the sign bit of positive floats and every bit of negative ones makes them order as unsigned integers
+    depthBits = (depthBits & 0x80000000u) != 0 ? ~depthBits : depthBits | 0x80000000u;
+
+    uint64_t sortKey = (static_cast<uint64_t>(renderer.getSortingLayer()) << 56) | (static_cast<uint64_t>(depthBits) << 24);
+
+    if (m_sortingByState)
+    {
+      // Instances draw with our instanced program, everything else with the original one
+      const Resources::Texture2D* texture = renderer.getInstanceTexture();
+      uint64_t program = texture != nullptr ? 0 : 1;
+
+      // Textures only need telling apart, so their addresses will do - a collision only costs a draw call
+      uint64_t textureId = (reinterpret_cast<uintptr_t>(texture) >> 4) & 0xFFFFF;
+
+      sortKey |= (program << 20) | textureId;
+    }
+
+    return sortKey;
   }
 
   //------------------------------------------------------------------------------------------------
   void SpriteBatch::render(Renderer& renderer, const glm::mat4& renderMatrix)
   {
-    m_renderers.insert(std::make_pair(&renderer, renderMatrix));
+    m_commands.push_back(RenderCommand{ createSortKey(renderer, renderMatrix), static_cast<uint32_t>(m_renderers.size()) });
+    m_renderers.push_back(&renderer);
+    m_renderMatrices.push_back(renderMatrix);
   }
 
   //------------------------------------------------------------------------------------------------
   void SpriteBatch::render(Renderer& renderer, const glm::vec3& translation, float rotation, const glm::vec3& scale)
   {
-    m_renderers.insert(std::make_pair(&renderer, createMatrix(translation, rotation, scale)));
+    render(renderer, createMatrix(translation, rotation, scale));
   }
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "Rendering/SpriteRenderer.h"
+#include "Rendering/SpriteBatch.h"
+#include "Resources/2D/TextureAtlas.h"
 #include "Resources/ResourceManager.h"
 #include "UtilityHeaders/ComponentHeaders.h"
 
@@ -13,6 +15,7 @@ namespace Celeste::Rendering
   SpriteRenderer::SpriteRenderer(GameObject& gameObject) :
     Inherited(gameObject),
     m_texture(nullptr),
+    m_uvRectangle(0, 0, 1, 1),
     m_dimensions(),
     m_preserveAspectRatio(false)
   {
@@ -40,15 +43,43 @@ namespace Celeste::Rendering
     }
 
     shaderProgram.setVector4f("colour", getColour());
+    shaderProgram.setVector4f("uv_rectangle", m_uvRectangle);
     shaderProgram.setMatrix4("view_model", viewModelMatrix * glm::translate(glm::identity<glm::mat4>(), glm::vec3(-getOrigin(), 0)));
 
     m_texture->bind();
     glDrawArrays(GL_TRIANGLES, 0, 6);
     m_texture->unbind();
 
+    // Other renderers sharing the program expect the whole texture
+    shaderProgram.setVector4f("uv_rectangle", 0, 0, 1, 1);
+
     glDisable(GL_SCISSOR_TEST);
   }
 
+  //------------------------------------------------------------------------------------------------
+  bool SpriteRenderer::addInstances(SpriteBatch& spriteBatch, const glm::mat4& viewModelMatrix) const
+  {
+    if (getInstanceTexture() == nullptr)
+    {
+      return false;
+    }
+
+    SpriteInstance instance;
+    instance.m_viewModelMatrix = viewModelMatrix * glm::translate(glm::identity<glm::mat4>(), glm::vec3(-getOrigin(), 0));
+    instance.m_uvRectangle = m_uvRectangle;
+    instance.m_colour = getColour();
+
+    spriteBatch.addInstance(*m_texture, instance);
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  const Texture2D* SpriteRenderer::getInstanceTexture() const
+  {
+    // Scissoring is per draw call, so has to go through render
+    return getScissorRectangle().getDimensions() == glm::vec2() ? m_texture : nullptr;
+  }
+
   //------------------------------------------------------------------------------------------------
   void SpriteRenderer::setTexture(const Path& textureRelativeString)
   {
@@ -59,21 +90,20 @@ namespace Celeste::Rendering
   void SpriteRenderer::setTexture(Texture2D* texture)
   {
     m_texture = texture;
+    m_uvRectangle = glm::vec4(0, 0, 1, 1);
 
-    if (m_texture == nullptr)
+    if (m_texture != nullptr)
     {
-      return;
+      updateDimensionsForImage(m_texture->getDimensions());
     }
+  }
 
-    if (glm::zero<glm::vec2>() == m_dimensions)
-    {
-      // Don't have dimensions specified
-      m_dimensions = m_texture->getDimensions();
-    }
-    else if (m_preserveAspectRatio)
-    {
-      updateDimensionsForAspectRatio(m_texture->getDimensions());
-    }
+  //------------------------------------------------------------------------------------------------
+  void SpriteRenderer::setTexture(TextureAtlas& textureAtlas, const std::string& regionName)
+  {
+    m_texture = &textureAtlas.getTexture();
+    m_uvRectangle = textureAtlas.getUVRectangle(regionName);
+    updateDimensionsForImage(textureAtlas.getRegionDimensions(regionName));
   }
 
   //------------------------------------------------------------------------------------------------
@@ -83,7 +113,23 @@ namespace Celeste::Rendering
 
     if (m_texture != nullptr && m_preserveAspectRatio)
     {
-      updateDimensionsForAspectRatio(m_texture->getDimensions());
+      // Only the part of the texture inside the uv rectangle is shown, which for an atlas is just one region
+      glm::vec2 uvDimensions(m_uvRectangle.z - m_uvRectangle.x, m_uvRectangle.w - m_uvRectangle.y);
+      updateDimensionsForAspectRatio(m_texture->getDimensions() * uvDimensions);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void SpriteRenderer::updateDimensionsForImage(const glm::vec2& imageDimensions)
+  {
+    if (glm::zero<glm::vec2>() == m_dimensions)
+    {
+      // Don't have dimensions specified
+      m_dimensions = imageDimensions;
+    }
+    else if (m_preserveAspectRatio)
+    {
+      updateDimensionsForAspectRatio(imageDimensions);
     }
   }
 
@@ -1,8 +1,11 @@
 #include "Rendering/TextRenderer.h"
+#include "Rendering/SpriteBatch.h"
 #include "UtilityHeaders/ComponentHeaders.h"
 #include "Resources/ResourceManager.h"
 #include "Input/InputManager.h"
-#include "Utils/StringUtils.h"
+#include "OpenGL/GL.h"
+
+#include <cstddef>
 
 using namespace Celeste::Resources;
 
@@ -15,122 +18,292 @@ namespace Celeste::Rendering
   TextRenderer::TextRenderer(GameObject& gameObject) :
     Inherited(gameObject),
     m_font(),
-    m_text(),
-    m_dimensions()
+    m_glyphQuads(),
+    m_lines(),
+    m_placedGlyphs(),
+    m_glyphVertices(),
+    m_vertexArray(0),
+    m_vertexBuffer(0),
+    m_wrapBreaks(),
+    m_layoutKey(),
+    m_dimensions(),
+    m_text()
   {
     setFont(Path("Fonts", "Arial.ttf"));
   }
 
+  //------------------------------------------------------------------------------------------------
+  TextRenderer::~TextRenderer()
+  {
+    if (GL::isVertexArray(m_vertexArray))
+    {
+      GL::deleteVertexArray(m_vertexArray);
+    }
+
+    if (GL::isBuffer(m_vertexBuffer))
+    {
+      GL::deleteBuffer(m_vertexBuffer);
+    }
+  }
+
   //------------------------------------------------------------------------------------------------
   void TextRenderer::render(const Program& shaderProgram, const glm::mat4& viewModelMatrix) const
   {
+    observer_ptr<const Texture2D> atlas = m_font.getAtlas();
+    if (atlas == nullptr || m_placedGlyphs.empty() || !GL::isVertexArray(m_vertexArray))
+    {
+      return;
+    }
+
+    // The glyphs are already placed relative to the text's origin, so rotating the text turns them all about that one point
     shaderProgram.setVector4f("colour", getColour());
+    shaderProgram.setMatrix4("view_model", viewModelMatrix);
+    shaderProgram.setVector4f("uv_rectangle", 0, 0, 1, 1);
+
+    // The program is only known now, so point its attributes at our vertices here rather than when they are uploaded
+    glBindVertexArray(m_vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
 
-    glm::vec2 halfTextSize = getDimensions() * 0.5f;
-    const FontInstance& font = getFont();
-    float fontHeight = font.getHeight();
+    GLuint position = static_cast<GLuint>(shaderProgram.getAttributeLocation("position"));
+    glEnableVertexAttribArray(position);
+    glVertexAttribPointer(position, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex), (GLvoid*)offsetof(GlyphVertex, m_position));
 
-    // Cache this location here so it's not evaluated for every letter
-    GLint viewModelLocation = shaderProgram.getUniformLocation("view_model");
-    
-    std::vector<std::string> lines;
-    split(m_text, lines);
+    GLuint texCoord = static_cast<GLuint>(shaderProgram.getAttributeLocation("texCoord"));
+    glEnableVertexAttribArray(texCoord);
+    glVertexAttribPointer(texCoord, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex), (GLvoid*)offsetof(GlyphVertex, m_texCoord));
 
-    for (size_t i = 0; i < lines.size(); ++i)
+    // Every glyph lives in the one atlas, so the whole text is one draw
+    atlas->bind();
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_glyphVertices.size()));
+    atlas->unbind();
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool TextRenderer::addInstances(SpriteBatch& spriteBatch, const glm::mat4& viewModelMatrix) const
+  {
+    observer_ptr<const Texture2D> atlas = m_font.getAtlas();
+    if (atlas == nullptr)
     {
-      const std::string& line = lines[i];
-      const glm::vec2& halfLineSize = font.measureString(line) * 0.5f;
+      return false;
+    }
 
-      glm::mat4 letterRenderMatrix = glm::identity<glm::mat4>();
-      letterRenderMatrix[3].x = getXPosition(halfLineSize.x);
-      letterRenderMatrix[3].y = getYPosition(halfTextSize.y) - (i + 0.75f) * fontHeight; // Go down the screen - first text at the top
+    SpriteInstance instance;
+    instance.m_colour = getColour();
 
-      for (char letter : line)
-      {
-        const Character* character = font.getCharacter(letter);
-        if (!character)
-        {
-          ASSERT_FAIL();
-          continue;
-        }
+    for (const PlacedGlyph& placedGlyph : m_placedGlyphs)
+    {
+      // The same as viewModelMatrix * translate(position) * scale(size), without building either matrix
+      instance.m_viewModelMatrix[0] = viewModelMatrix[0] * placedGlyph.m_size.x;
+      instance.m_viewModelMatrix[1] = viewModelMatrix[1] * placedGlyph.m_size.y;
+      instance.m_viewModelMatrix[2] = viewModelMatrix[2];
+      instance.m_viewModelMatrix[3] = viewModelMatrix * placedGlyph.m_position;
+      instance.m_uvRectangle = placedGlyph.m_uvRectangle;
+
+      spriteBatch.addInstance(*atlas, instance);
+    }
+
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void TextRenderer::setFont(const std::string& relativePathToFont, float height)
+  {
+    observer_ptr<Font> font = getResourceManager().load<Font>(relativePathToFont);
+    if (font == nullptr)
+    {
+      ASSERT_FAIL();
+      return;
+    }
+
+    m_font = font->createInstance(height);
+
+    // The line breaks and glyphs were worked out with the old font's measurements
+    updateLayout(false);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  std::string TextRenderer::getLine(size_t lineIndex) const
+  {
+    ASSERT(lineIndex < m_lines.size());
+    const TextLine& line = m_lines[lineIndex];
+    return m_text.substr(line.m_textBegin, line.m_textEnd - line.m_textBegin);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TextRenderer::LayoutKey TextRenderer::getLayoutKey() const
+  {
+    LayoutKey layoutKey;
+    layoutKey.m_fontName = m_font.getFontName();
+    layoutKey.m_fontHeight = m_font.getHeight();
+    layoutKey.m_wrapWidth = m_horizontalWrapMode == UI::HorizontalWrapMode::kWrap && m_maxWidth > 0 ? m_maxWidth : 0;
+
+    return layoutKey;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void TextRenderer::updateLayout(bool textChanged)
+  {
+    LayoutKey layoutKey = getLayoutKey();
+    if (!textChanged && layoutKey == m_layoutKey)
+    {
+      return;
+    }
+
+    m_layoutKey = layoutKey;
+    findWrapBreaks();
+    layoutGlyphs();
+    placeGlyphs();
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void TextRenderer::layoutGlyphs()
+  {
+    m_glyphQuads.clear();
+    m_lines.clear();
+    m_dimensions = glm::vec2();
+
+    if (m_text.empty())
+    {
+      return;
+    }
 
-        // Add on the character's bearing from the cursor
-        letterRenderMatrix[3].x += character->m_bearing.x;
+    float lineWidth = 0;
+    size_t lineBegin = 0;
+    auto nextWrapBreak = m_wrapBreaks.begin();
 
-        if (character->m_size.x == 0 ||
-          character->m_size.y == 0)
+    for (size_t i = 0; i < m_text.size(); ++i)
+    {
+      char letter = m_text[i];
+
+      if (letter == '\n' || (nextWrapBreak != m_wrapBreaks.end() && *nextWrapBreak == i))
+      {
+        // The new line or wrapped space ends this line and is not part of either
+        m_lines.push_back(TextLine{ m_glyphQuads.size(), lineWidth, lineBegin, i });
+        lineWidth = 0;
+        lineBegin = i + 1;
+
+        if (letter != '\n')
         {
-          letterRenderMatrix[3].x += character->m_advance;
-          continue;
+          ++nextWrapBreak;
         }
 
-        letterRenderMatrix[0] *= static_cast<float>(character->m_size.x);
-        letterRenderMatrix[1] *= static_cast<float>(character->m_size.y);
+        continue;
+      }
 
-        //Shift down by the amount the letter lies underneath the line - bearing = amount above line and size = total height
-        letterRenderMatrix[3].y += (character->m_bearing.y - character->m_size.y);
+      const Character* character = m_font.getCharacter(letter);
+      if (!character)
+      {
+        ASSERT_FAIL();
+        continue;
+      }
 
-        //Render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, character->m_textureId);
+      if (character->m_size.x > 0 && character->m_size.y > 0)
+      {
+        // Add on the character's bearing from the cursor and shift down by the amount the letter lies underneath the line
+        // Bearing = amount above line and size = total height
+        glm::vec2 position(lineWidth + character->m_bearing.x, static_cast<float>(character->m_bearing.y - character->m_size.y));
+        m_glyphQuads.push_back(GlyphQuad{ position, glm::vec2(character->m_size), character->m_uvRectangle });
+      }
 
-        //Render quad
-        //We have to perform the letter render matrix first before applying the world space matrix, so that if there is a rotation
-        //All of the text will rotate around one point rather than all the individual quads rotating
-        shaderProgram.setMatrix4(viewModelLocation, viewModelMatrix * letterRenderMatrix);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+      // Advance the cursor
+      lineWidth += character->m_advance;
+    }
 
-        // Advance the cursor
-        letterRenderMatrix[3].x += (character->m_advance - character->m_bearing.x);
+    m_lines.push_back(TextLine{ m_glyphQuads.size(), lineWidth, lineBegin, m_text.size() });
 
-        // Undo the character specific changes we made to our matrix
-        letterRenderMatrix[3].y -= (character->m_bearing.y - character->m_size.y);
-        letterRenderMatrix[0] /= (float)character->m_size.x; // Reset the scale
-        letterRenderMatrix[1] /= (float)character->m_size.y; // Reset the scale
-      }
+    m_dimensions.y = m_lines.size() * m_font.getHeight();
+
+    for (const TextLine& line : m_lines)
+    {
+      m_dimensions.x = (std::max)(m_dimensions.x, line.m_width);
     }
   }
 
   //------------------------------------------------------------------------------------------------
-  void TextRenderer::setFont(const std::string& relativePathToFont, float height)
+  void TextRenderer::placeGlyphs()
   {
-    observer_ptr<Font> font = getResourceManager().load<Font>(relativePathToFont);
-    if (font == nullptr)
+    m_placedGlyphs.clear();
+    m_glyphVertices.clear();
+
+    // The corners of the unit quad in the order the sprite batch draws them, with y flipped for the texture coordinates
+    static constexpr float corners[6][2] = { { 0, 0 }, { 0, 1 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, { 1, 0 } };
+
+    size_t glyphIndex = 0;
+    for (size_t lineIndex = 0; lineIndex < m_lines.size(); ++lineIndex)
+    {
+      glm::vec2 lineOrigin = getLineOrigin(lineIndex);
+
+      for (; glyphIndex < m_lines[lineIndex].m_glyphsEnd; ++glyphIndex)
+      {
+        const GlyphQuad& glyphQuad = m_glyphQuads[glyphIndex];
+        glm::vec2 position = lineOrigin + glyphQuad.m_position;
+        m_placedGlyphs.push_back(PlacedGlyph{ glm::vec4(position, 0, 1), glyphQuad.m_size, glyphQuad.m_uvRectangle });
+
+        const glm::vec4& uvRectangle = glyphQuad.m_uvRectangle;
+        for (const float* corner : corners)
+        {
+          glm::vec2 texCoord = glm::mix(glm::vec2(uvRectangle.x, uvRectangle.y), glm::vec2(uvRectangle.z, uvRectangle.w), glm::vec2(corner[0], 1 - corner[1]));
+          m_glyphVertices.push_back(GlyphVertex{ position + glm::vec2(corner[0], corner[1]) * glyphQuad.m_size, texCoord });
+        }
+      }
+    }
+
+    if (!GL::isInitialized() || m_glyphVertices.empty())
+    {
+      return;
+    }
+
+    if (!GL::isVertexArray(m_vertexArray) && (!GL::genVertexArray(m_vertexArray) || !GL::genBuffer(m_vertexBuffer)))
     {
       ASSERT_FAIL();
       return;
     }
 
-    m_font = font->createInstance(height);
-    recalculateDimensions();
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_glyphVertices.size() * sizeof(GlyphVertex)), m_glyphVertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glCheckError();
   }
 
   //------------------------------------------------------------------------------------------------
-  void TextRenderer::recalculateDimensions()
+  glm::vec2 TextRenderer::getLineOrigin(size_t lineIndex) const
   {
-    std::vector<std::string> lines;
-    split(m_text, lines);
+    // Go down the screen - first text at the top
+    return glm::vec2(
+      getXPosition(m_lines[lineIndex].m_width * 0.5f),
+      getYPosition(m_dimensions.y * 0.5f) - (lineIndex + 0.75f) * m_font.getHeight());
+  }
 
-    m_dimensions.x = 0;
-    m_dimensions.y = lines.size() * m_font.getHeight();
+#pragma region Text Manipulation Functions
 
-    for (const std::string& line : lines)
+  //------------------------------------------------------------------------------------------------
+  void TextRenderer::setHorizontalAlignment(UI::HorizontalAlignment horizontalAlignment)
+  {
+    if (m_horizontalAlignment != horizontalAlignment)
     {
-      m_dimensions.x = (std::max)(m_dimensions.x, m_font.measureString(line).x);
+      m_horizontalAlignment = horizontalAlignment;
+      placeGlyphs();
     }
   }
 
-#pragma region Text Manipulation Functions
+  //------------------------------------------------------------------------------------------------
+  void TextRenderer::setVerticalAlignment(UI::VerticalAlignment verticalAlignment)
+  {
+    if (m_verticalAlignment != verticalAlignment)
+    {
+      m_verticalAlignment = verticalAlignment;
+      placeGlyphs();
+    }
+  }
 
   //------------------------------------------------------------------------------------------------
   void TextRenderer::setHorizontalWrapMode(UI::HorizontalWrapMode horizontalWrapMode)
   { 
     m_horizontalWrapMode = horizontalWrapMode;
-
-    if (m_horizontalWrapMode == UI::HorizontalWrapMode::kWrap && m_maxWidth > 0)
-    {
-      layoutText();
-      recalculateDimensions();
-    }
+    updateLayout(false);
   }
 
   //------------------------------------------------------------------------------------------------
@@ -138,50 +311,56 @@ namespace Celeste::Rendering
   {
     ASSERT(maxWidth > 0 || m_horizontalWrapMode != UI::HorizontalWrapMode::kWrap);
     m_maxWidth = maxWidth;
-
-    if (m_horizontalWrapMode == UI::HorizontalWrapMode::kWrap)
-    {
-      layoutText();
-      recalculateDimensions();
-    }
+    updateLayout(false);
   }
 
   //------------------------------------------------------------------------------------------------
-  void TextRenderer::layoutText()
+  void TextRenderer::findWrapBreaks()
   {
-    ASSERT(m_maxWidth > 0);
+    m_wrapBreaks.clear();
 
-    float currentWidth = 0;
-    size_t currentOffset = 0;
-    size_t nextOffset = m_text.find(' ');
-    
-    if (nextOffset == m_text.npos)
+    float wrapWidth = m_layoutKey.m_wrapWidth;
+    if (wrapWidth <= 0)
     {
-      // Early out optimization
       return;
     }
 
-    while (nextOffset < m_text.npos)
+    // Each word is measured along with the space in front of it, which is where it gets moved onto the next line
+    float currentWidth = 0;
+    float wordWidth = 0;
+    size_t wordOffset = 0;
+
+    for (size_t i = 0; i <= m_text.size(); ++i)
     {
-      float extraWidth = m_font.measureString(m_text.begin() + currentOffset, m_text.begin() + nextOffset).x;
-      
-      if (currentWidth + extraWidth > m_maxWidth)
+      char letter = i < m_text.size() ? m_text[i] : ' ';
+
+      if (letter == ' ')
+      {
+        if (m_text[wordOffset] == ' ' && currentWidth + wordWidth > wrapWidth)
+        {
+          // We have gone over our max width so we move the word to the next line
+          m_wrapBreaks.push_back(wordOffset);
+          currentWidth = 0;
+        }
+
+        currentWidth += wordWidth;
+        wordWidth = 0;
+        wordOffset = i;
+      }
+      else if (letter == '\n')
       {
-        // We have gone over our max width so we move the word to the next line
-        m_text[currentOffset] = '\n';
+        // The text already starts a new line here
         currentWidth = 0;
+        wordWidth = 0;
+        wordOffset = i;
+        continue;
       }
 
-      currentWidth += extraWidth;
-      currentOffset = nextOffset;
-      nextOffset = m_text.find(' ', currentOffset + 1);
-    }
-
-    // Finally, have to check the last word
-    if (currentWidth + m_font.measureString(m_text.begin() + currentOffset, m_text.end()).x > m_maxWidth)
-    {
-      // We have gone over our max width so we move the word to the next line
-      m_text[currentOffset] = '\n';
+      if (i < m_text.size())
+      {
+        const Character* character = m_font.getCharacter(letter);
+        wordWidth += character != nullptr ? character->m_advance : 0;
+      }
     }
   }
 
@@ -191,13 +370,7 @@ namespace Celeste::Rendering
     if (m_text != text)
     {
       m_text.assign(text);
-
-      if (m_horizontalWrapMode == UI::HorizontalWrapMode::kWrap && m_maxWidth > 0)
-      {
-        layoutText();
-      }
-
-      recalculateDimensions();
+      updateLayout(true);
     }
   }
 
@@ -0,0 +1,205 @@
+#include "SOIL2/SOIL2.h"
+#include "Resources/2D/AtlasBuilder.h"
+#include "Resources/2D/RawImageLoader.h"
+#include "Resources/2D/SkylinePacker.h"
+#include "Resources/2D/TextureAtlas.h"
+#include "XML/tinyxml2_ext.h"
+#include "FileSystem/Path.h"
+#include "Assert/Assert.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+
+namespace Celeste::Resources
+{
+  //------------------------------------------------------------------------------------------------
+  AtlasBuilder::AtlasBuilder() :
+    m_images(),
+    m_width(0),
+    m_height(0),
+    m_pixels(),
+    m_regions()
+  {
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void AtlasBuilder::addImage(const std::string& name, uint32_t width, uint32_t height, const unsigned char* rgbaPixels)
+  {
+    Image& image = m_images.emplace_back();
+    image.m_name = name;
+    image.m_width = width;
+    image.m_height = height;
+    image.m_pixels.assign(rgbaPixels, rgbaPixels + static_cast<size_t>(width) * height * 4);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool AtlasBuilder::addImage(const std::string& name, const Path& imageFullPath)
+  {
+    RawImageLoader loader(imageFullPath);
+    if (loader.getData() == nullptr)
+    {
+      return false;
+    }
+
+    addImage(name, static_cast<uint32_t>(loader.getWidth()), static_cast<uint32_t>(loader.getHeight()), loader.getData());
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool AtlasBuilder::build(uint32_t maxDimension, uint32_t padding)
+  {
+    m_width = 0;
+    m_height = 0;
+    m_pixels.clear();
+    m_regions.clear();
+
+    if (m_images.empty())
+    {
+      return false;
+    }
+
+    // Tallest first keeps the skyline flat, which wastes the least space
+    std::vector<size_t> packingOrder(m_images.size());
+    std::iota(packingOrder.begin(), packingOrder.end(), static_cast<size_t>(0));
+    std::stable_sort(packingOrder.begin(), packingOrder.end(), [this](size_t lhs, size_t rhs)
+    {
+      const Image& lhsImage = m_images[lhs];
+      const Image& rhsImage = m_images[rhs];
+      return lhsImage.m_height != rhsImage.m_height ? lhsImage.m_height > rhsImage.m_height : lhsImage.m_width > rhsImage.m_width;
+    });
+
+    uint64_t totalArea = 0;
+    uint32_t largestDimension = 0;
+    for (const Image& image : m_images)
+    {
+      totalArea += static_cast<uint64_t>(image.m_width + padding) * (image.m_height + padding);
+      largestDimension = (std::max)(largestDimension, (std::max)(image.m_width, image.m_height));
+    }
+
+    // Start from the smallest square which could possibly hold everything, then grow one side at a time
+    // A side which would grow past maxDimension is clamped to it instead, so maxDimension need not be a power of two
+    uint32_t width = 1;
+    while (width < maxDimension && (width < largestDimension || static_cast<uint64_t>(width) * width < totalArea))
+    {
+      width *= 2;
+    }
+
+    width = (std::min)(width, maxDimension);
+    uint32_t height = width;
+
+    auto grow = [maxDimension](uint32_t dimension)
+    {
+      return static_cast<uint32_t>((std::min)(static_cast<uint64_t>(dimension) * 2, static_cast<uint64_t>(maxDimension)));
+    };
+
+    while (true)
+    {
+      if (tryPack(packingOrder, width, height, padding))
+      {
+        return true;
+      }
+
+      if (width == maxDimension && height == maxDimension)
+      {
+        break;
+      }
+
+      if (height == maxDimension || (width <= height && width < maxDimension))
+      {
+        width = grow(width);
+      }
+      else
+      {
+        height = grow(height);
+      }
+    }
+
+    m_regions.clear();
+    return false;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool AtlasBuilder::tryPack(const std::vector<size_t>& packingOrder, uint32_t width, uint32_t height, uint32_t padding)
+  {
+    // The right and bottom images can let their padding hang off the edge
+    SkylinePacker packer(width + padding, height + padding);
+    m_regions.clear();
+
+    for (size_t imageIndex : packingOrder)
+    {
+      const Image& image = m_images[imageIndex];
+
+      glm::uvec2 position;
+      if (!packer.pack(image.m_width + padding, image.m_height + padding, position))
+      {
+        return false;
+      }
+
+      m_regions.push_back(AtlasRegion{ image.m_name, position, glm::uvec2(image.m_width, image.m_height) });
+    }
+
+    m_width = width;
+    m_height = height;
+    m_pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+
+    for (size_t regionIndex = 0; regionIndex < m_regions.size(); ++regionIndex)
+    {
+      const Image& image = m_images[packingOrder[regionIndex]];
+      const glm::uvec2& position = m_regions[regionIndex].m_position;
+      const size_t rowBytes = static_cast<size_t>(image.m_width) * 4;
+
+      for (uint32_t row = 0; row < image.m_height; ++row)
+      {
+        std::memcpy(
+          m_pixels.data() + ((static_cast<size_t>(position.y) + row) * width + position.x) * 4,
+          image.m_pixels.data() + row * rowBytes,
+          rowBytes);
+      }
+    }
+
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool AtlasBuilder::save(const Path& directoryFullPath, const std::string& atlasName) const
+  {
+    if (m_pixels.empty())
+    {
+      ASSERT_FAIL();
+      return false;
+    }
+
+    std::string textureName = atlasName + ".png";
+    Path texturePath(directoryFullPath, textureName);
+
+    if (SOIL_save_image(texturePath.c_str(), SOIL_SAVE_TYPE_PNG, static_cast<int>(m_width), static_cast<int>(m_height), 4, m_pixels.data()) == 0)
+    {
+      return false;
+    }
+
+    tinyxml2::XMLDocument document;
+    document.InsertFirstChild(document.NewDeclaration());
+
+    tinyxml2::XMLElement* root = document.NewElement(TextureAtlas::MANIFEST_ELEMENT_NAME);
+    root->SetAttribute(TextureAtlas::TEXTURE_ATTRIBUTE_NAME, textureName.c_str());
+    root->SetAttribute(TextureAtlas::WIDTH_ATTRIBUTE_NAME, m_width);
+    root->SetAttribute(TextureAtlas::HEIGHT_ATTRIBUTE_NAME, m_height);
+    document.InsertEndChild(root);
+
+    for (const AtlasRegion& region : m_regions)
+    {
+      tinyxml2::XMLElement* regionElement = document.NewElement(TextureAtlas::REGION_ELEMENT_NAME);
+      regionElement->SetAttribute(TextureAtlas::NAME_ATTRIBUTE_NAME, region.m_name.c_str());
+      regionElement->SetAttribute(TextureAtlas::X_ATTRIBUTE_NAME, region.m_position.x);
+      regionElement->SetAttribute(TextureAtlas::Y_ATTRIBUTE_NAME, region.m_position.y);
+      regionElement->SetAttribute(TextureAtlas::WIDTH_ATTRIBUTE_NAME, region.m_dimensions.x);
+      regionElement->SetAttribute(TextureAtlas::HEIGHT_ATTRIBUTE_NAME, region.m_dimensions.y);
+      root->InsertEndChild(regionElement);
+    }
+
+    Path manifestPath(directoryFullPath, atlasName + TextureAtlas::FILE_EXTENSION);
+    return document.SaveFile(manifestPath.c_str()) == tinyxml2::XML_SUCCESS;
+  }
+}
@@ -0,0 +1,140 @@
+#include "Resources/2D/SkylinePacker.h"
+
+#include <algorithm>
+#include <limits>
+
+
+namespace Celeste::Resources
+{
+  //------------------------------------------------------------------------------------------------
+  SkylinePacker::SkylinePacker(uint32_t width, uint32_t height) :
+    m_width(0),
+    m_height(0),
+    m_usedArea(0),
+    m_skyline()
+  {
+    reset(width, height);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void SkylinePacker::reset(uint32_t width, uint32_t height)
+  {
+    m_width = width;
+    m_height = height;
+    m_usedArea = 0;
+    m_skyline.clear();
+
+    if (width > 0)
+    {
+      m_skyline.push_back(Segment{ 0, 0, width });
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool SkylinePacker::pack(uint32_t width, uint32_t height, glm::uvec2& outputPosition)
+  {
+    if (width == 0 || height == 0)
+    {
+      return false;
+    }
+
+    size_t bestIndex = m_skyline.size();
+    uint32_t bestTop = std::numeric_limits<uint32_t>::max();
+    uint32_t bestY = 0;
+
+    for (size_t segmentIndex = 0; segmentIndex < m_skyline.size(); ++segmentIndex)
+    {
+      uint32_t y = 0;
+
+      // Strictly lower only, so ties go to the leftmost position and the skyline fills from one side
+      if (fits(segmentIndex, width, height, y) && y + height < bestTop)
+      {
+        bestIndex = segmentIndex;
+        bestTop = y + height;
+        bestY = y;
+      }
+    }
+
+    if (bestIndex == m_skyline.size())
+    {
+      return false;
+    }
+
+    outputPosition = glm::uvec2(m_skyline[bestIndex].m_x, bestY);
+    addSegment(bestIndex, m_skyline[bestIndex].m_x, bestY, width, height);
+    m_usedArea += static_cast<uint64_t>(width) * height;
+
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool SkylinePacker::fits(size_t segmentIndex, uint32_t width, uint32_t height, uint32_t& outputY) const
+  {
+    const Segment& first = m_skyline[segmentIndex];
+    if (first.m_x + width > m_width)
+    {
+      return false;
+    }
+
+    // The rectangle has to sit on the highest segment it spans
+    uint32_t y = 0;
+    uint32_t widthLeft = width;
+
+    for (size_t i = segmentIndex; widthLeft > 0; ++i)
+    {
+      const Segment& segment = m_skyline[i];
+      y = (std::max)(y, segment.m_y);
+
+      if (y + height > m_height)
+      {
+        return false;
+      }
+
+      widthLeft -= (std::min)(widthLeft, segment.m_width);
+    }
+
+    outputY = y;
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void SkylinePacker::addSegment(size_t segmentIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+  {
+    m_skyline.insert(m_skyline.begin() + segmentIndex, Segment{ x, y + height, width });
+
+    // Trim or remove the segments now underneath the new one
+    const uint32_t right = x + width;
+    size_t i = segmentIndex + 1;
+
+    while (i < m_skyline.size() && m_skyline[i].m_x < right)
+    {
+      Segment& segment = m_skyline[i];
+      uint32_t overlap = right - segment.m_x;
+
+      if (segment.m_width <= overlap)
+      {
+        m_skyline.erase(m_skyline.begin() + i);
+      }
+      else
+      {
+        segment.m_x += overlap;
+        segment.m_width -= overlap;
+        break;
+      }
+    }
+
+    // Neighbouring segments at the same height are one segment
+    for (size_t j = 0; j + 1 < m_skyline.size();)
+    {
+      if (m_skyline[j].m_y == m_skyline[j + 1].m_y)
+      {
+        m_skyline[j].m_width += m_skyline[j + 1].m_width;
+        m_skyline.erase(m_skyline.begin() + j + 1);
+      }
+      else
+      {
+        ++j;
+      }
+    }
+  }
+}
@@ -89,6 +89,12 @@ namespace Celeste::Resources
     glTextureSubImage2DEXT(m_textureHandle, GL_TEXTURE_2D, 0, x, y, 1, 1, m_imageFormat, GL_UNSIGNED_BYTE, data);
   }
 
+  //------------------------------------------------------------------------------------------------
+  void Texture2D::setPixels(GLint x, GLint y, GLsizei width, GLsizei height, const unsigned char* data)
+  {
+    glTextureSubImage2DEXT(m_textureHandle, GL_TEXTURE_2D, 0, x, y, width, height, m_imageFormat, GL_UNSIGNED_BYTE, data);
+  }
+
   //------------------------------------------------------------------------------------------------
   void Texture2D::bind() const
   {
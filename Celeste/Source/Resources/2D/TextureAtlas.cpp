@@ -0,0 +1,207 @@
+#include "Resources/2D/TextureAtlas.h"
+#include "Resources/2D/RawImageLoader.h"
+#include "XML/tinyxml2_ext.h"
+#include "XML/ChildXMLElementWalker.h"
+#include "OpenGL/GL.h"
+
+#include <cstring>
+
+
+namespace Celeste::Resources
+{
+  namespace
+  {
+    // Keeps regions packed at runtime a pixel apart so that filtering never bleeds one into its neighbours
+    constexpr uint32_t REGION_PADDING = 1;
+  }
+
+  const char* const TextureAtlas::FILE_EXTENSION = ".atlas";
+  const char* const TextureAtlas::MANIFEST_ELEMENT_NAME = "TextureAtlas";
+  const char* const TextureAtlas::REGION_ELEMENT_NAME = "Region";
+  const char* const TextureAtlas::TEXTURE_ATTRIBUTE_NAME = "texture";
+  const char* const TextureAtlas::NAME_ATTRIBUTE_NAME = "name";
+  const char* const TextureAtlas::X_ATTRIBUTE_NAME = "x";
+  const char* const TextureAtlas::Y_ATTRIBUTE_NAME = "y";
+  const char* const TextureAtlas::WIDTH_ATTRIBUTE_NAME = "width";
+  const char* const TextureAtlas::HEIGHT_ATTRIBUTE_NAME = "height";
+
+  //------------------------------------------------------------------------------------------------
+  TextureAtlas::TextureAtlas() :
+    m_texture(),
+    m_packer(0, 0),
+    m_regions(),
+    m_width(0),
+    m_height(0)
+  {
+    // Regions sit right up against the edges of the atlas, so sampling must not wrap around to the other side
+    m_texture.setWrapS(GL_CLAMP_TO_EDGE);
+    m_texture.setWrapT(GL_CLAMP_TO_EDGE);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool TextureAtlas::doLoadFromFile(const Path& path)
+  {
+    tinyxml2::XMLDocument document;
+    if (document.LoadFile(path.c_str()) != tinyxml2::XML_SUCCESS)
+    {
+      return false;
+    }
+
+    const tinyxml2::XMLElement* root = document.RootElement();
+    if (root == nullptr || std::strcmp(root->Name(), MANIFEST_ELEMENT_NAME) != 0)
+    {
+      ASSERT_FAIL();
+      return false;
+    }
+
+    std::string textureName;
+    unsigned int width = 0;
+    unsigned int height = 0;
+
+    if (XML::getAttributeData(root, TEXTURE_ATTRIBUTE_NAME, textureName) != XML::XMLValueError::kSuccess ||
+        XML::getAttributeData(root, WIDTH_ATTRIBUTE_NAME, width) != XML::XMLValueError::kSuccess ||
+        XML::getAttributeData(root, HEIGHT_ATTRIBUTE_NAME, height) != XML::XMLValueError::kSuccess)
+    {
+      ASSERT_FAIL();
+      return false;
+    }
+
+    if (!m_texture.loadFromFile(Path(path.getParentDirectory(), textureName)))
+    {
+      return false;
+    }
+
+    // The manifest's size rather than the texture's, so texture coordinates do not depend on a GL context
+    m_width = width;
+    m_height = height;
+
+    for (const tinyxml2::XMLElement* regionElement : XML::children(root, REGION_ELEMENT_NAME))
+    {
+      std::string name;
+      unsigned int x = 0, y = 0, regionWidth = 0, regionHeight = 0;
+
+      if (XML::getAttributeData(regionElement, NAME_ATTRIBUTE_NAME, name) != XML::XMLValueError::kSuccess ||
+          XML::getAttributeData(regionElement, X_ATTRIBUTE_NAME, x) != XML::XMLValueError::kSuccess ||
+          XML::getAttributeData(regionElement, Y_ATTRIBUTE_NAME, y) != XML::XMLValueError::kSuccess ||
+          XML::getAttributeData(regionElement, WIDTH_ATTRIBUTE_NAME, regionWidth) != XML::XMLValueError::kSuccess ||
+          XML::getAttributeData(regionElement, HEIGHT_ATTRIBUTE_NAME, regionHeight) != XML::XMLValueError::kSuccess)
+      {
+        ASSERT_FAIL();
+        continue;
+      }
+
+      insertRegion(name, x, y, regionWidth, regionHeight);
+    }
+
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void TextureAtlas::doUnload()
+  {
+    m_texture.unload();
+    m_regions.clear();
+    m_packer.reset(0, 0);
+    m_width = 0;
+    m_height = 0;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void TextureAtlas::create(uint32_t width, uint32_t height)
+  {
+    doUnload();
+
+    m_width = width;
+    m_height = height;
+
+    // The right and bottom regions can let their padding hang off the edge
+    m_packer.reset(width + REGION_PADDING, height + REGION_PADDING);
+
+    if (GL::isInitialized())
+    {
+      // Start fully transparent so that padding samples as nothing
+      std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4, 0);
+      m_texture.generate(width, height, pixels.data());
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool TextureAtlas::addRegion(const std::string& name, uint32_t width, uint32_t height, const unsigned char* rgbaPixels)
+  {
+    if (hasRegion(name))
+    {
+      ASSERT_FAIL();
+      return false;
+    }
+
+    glm::uvec2 position;
+    if (!m_packer.pack(width + REGION_PADDING, height + REGION_PADDING, position))
+    {
+      return false;
+    }
+
+    if (GL::isInitialized() && m_texture.getDimensions() != glm::vec2())
+    {
+      m_texture.setPixels(
+        static_cast<GLint>(position.x),
+        static_cast<GLint>(position.y),
+        static_cast<GLsizei>(width),
+        static_cast<GLsizei>(height),
+        rgbaPixels);
+    }
+
+    insertRegion(name, position.x, position.y, width, height);
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool TextureAtlas::addRegion(const std::string& name, const Path& imageFullPath)
+  {
+    RawImageLoader loader(imageFullPath);
+    if (loader.getData() == nullptr)
+    {
+      return false;
+    }
+
+    return addRegion(name, static_cast<uint32_t>(loader.getWidth()), static_cast<uint32_t>(loader.getHeight()), loader.getData());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  glm::vec4 TextureAtlas::getUVRectangle(const std::string& name) const
+  {
+    auto regionIt = m_regions.find(name);
+    if (regionIt == m_regions.end())
+    {
+      ASSERT_FAIL();
+      return glm::vec4(0, 0, 1, 1);
+    }
+
+    return regionIt->second.m_uvRectangle;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  glm::vec2 TextureAtlas::getRegionDimensions(const std::string& name) const
+  {
+    auto regionIt = m_regions.find(name);
+    if (regionIt == m_regions.end())
+    {
+      ASSERT_FAIL();
+      return glm::vec2();
+    }
+
+    return regionIt->second.m_dimensions;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void TextureAtlas::insertRegion(const std::string& name, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+  {
+    ASSERT(m_width > 0 && m_height > 0);
+
+    const float atlasWidth = static_cast<float>(m_width);
+    const float atlasHeight = static_cast<float>(m_height);
+
+    Region& region = m_regions[name];
+    region.m_uvRectangle = glm::vec4(x / atlasWidth, y / atlasHeight, (x + width) / atlasWidth, (y + height) / atlasHeight);
+    region.m_dimensions = glm::vec2(static_cast<float>(width), static_cast<float>(height));
+  }
+}
@@ -1,22 +1,28 @@
 #include "Resources/Fonts/Font.h"
+#include "Resources/2D/SkylinePacker.h"
 #include "Utils/StringUtils.h"
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
 
 namespace Celeste::Resources
 {
+  namespace
+  {
+    // Keeps glyphs a pixel apart so that linear filtering never bleeds one into its neighbours
+    constexpr uint32_t GLYPH_PADDING = 1;
+    constexpr uint32_t MAX_ATLAS_DIMENSION = 8192;
+  }
+
   //------------------------------------------------------------------------------------------------
   void Font::doUnload()
   {
     // Delete any existing textures
-    for (const auto& characterPair : m_charactersLookup)
+    for (auto& glyphAtlasPair : m_charactersLookup)
     {
-      for (const std::pair<char, Character>& characters : characterPair.second)
-      {
-        if (glIsTexture(characters.second.m_textureId))
-        {
-          glDeleteTextures(1, &characters.second.m_textureId);
-        }
-      }
+      glyphAtlasPair.second.m_texture.unload();
     }
 
     // Clear character arrays
@@ -30,14 +36,15 @@ namespace Celeste::Resources
       getResourceId() == (StringId)0)
     {
       ASSERT_FAIL();
-      return FontInstance(Characters(), 0, getResourceId());
+      return FontInstance(Characters(), nullptr, 0, getResourceId());
     }
 
     loadCharacters(height);
 
     // Ensure the characters have been loaded
     ASSERT(m_charactersLookup.find(height) != m_charactersLookup.end());
-    return FontInstance(m_charactersLookup.at(height), height, getResourceId());
+    const GlyphAtlas& glyphAtlas = m_charactersLookup.at(height);
+    return FontInstance(glyphAtlas.m_characters, &glyphAtlas.m_texture, height, getResourceId());
   }
 
   //------------------------------------------------------------------------------------------------
@@ -79,11 +86,13 @@ namespace Celeste::Resources
     }
 
     FT_Set_Pixel_Sizes(face, 0, static_cast<FT_UInt>(height));
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
 
     Characters characters;
 
-    for (GLubyte c = 0; c < 128; c++)
+    // FreeType renders every glyph into the same slot, so each bitmap is copied out before loading the next
+    std::vector<std::vector<unsigned char>> bitmaps(FontInstance::CHARACTER_COUNT);
+
+    for (GLubyte c = 0; c < FontInstance::CHARACTER_COUNT; c++)
     {
       // Load character glyph 
       if (FT_Load_Char(face, c, FT_LOAD_RENDER))
@@ -93,38 +102,19 @@ namespace Celeste::Resources
         continue;
       }
 
-      // Generate texture
-      GLuint texture;
-      glGenTextures(1, &texture);
-      glBindTexture(GL_TEXTURE_2D, texture);
-      glTexImage2D(
-        GL_TEXTURE_2D,
-        0,
-        GL_RED,
-        face->glyph->bitmap.width,
-        face->glyph->bitmap.rows,
-        0,
-        GL_RED,
-        GL_UNSIGNED_BYTE,
-        face->glyph->bitmap.buffer
-      );
-
-      // Set texture options
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-      // Since we only have one channel's worth of data we have to store it in the red component
-      // However, we can fake the data to be read as the alpha channel by samplers in the shader
-      // This allows us to render text and sprites using the same shaders
-      GLint swizzleMask[] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
-      glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzleMask);
-
-      // Now store character for later use
+      const FT_Bitmap& bitmap = face->glyph->bitmap;
+      std::vector<unsigned char>& glyphBitmap = bitmaps[c];
+      glyphBitmap.resize(static_cast<size_t>(bitmap.width) * bitmap.rows);
+
+      for (unsigned int row = 0; row < bitmap.rows; ++row)
+      {
+        std::memcpy(glyphBitmap.data() + static_cast<size_t>(row) * bitmap.width, bitmap.buffer + row * bitmap.pitch, bitmap.width);
+      }
+
+      // Now store character for later use - its texture coordinates are filled in once the atlas is packed
       Character character = {
-        texture,
-        glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
+        glm::vec4(),
+        glm::ivec2(bitmap.width, bitmap.rows),
         glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
         // Advance is stored in 1/64 (0.015625) of pixels so divide
         face->glyph->advance.x * 0.015625f
@@ -132,11 +122,117 @@ namespace Celeste::Resources
       characters.insert(std::pair<GLchar, Character>(c, character));
     }
 
-    m_charactersLookup.insert(std::make_pair(height, characters));
-
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
 
+    // Tallest first keeps the skyline flat, which wastes the least space
+    std::vector<GLubyte> packingOrder;
+    uint64_t totalArea = 0;
+    uint32_t largestDimension = 0;
+
+    for (const std::pair<const char, Character>& characterPair : characters)
+    {
+      const glm::ivec2& size = characterPair.second.m_size;
+      if (size.x > 0 && size.y > 0)
+      {
+        packingOrder.push_back(static_cast<GLubyte>(characterPair.first));
+        totalArea += static_cast<uint64_t>(size.x + GLYPH_PADDING) * (size.y + GLYPH_PADDING);
+        largestDimension = (std::max)(largestDimension, static_cast<uint32_t>((std::max)(size.x, size.y)));
+      }
+    }
+
+    std::sort(packingOrder.begin(), packingOrder.end(), [&characters](GLubyte lhs, GLubyte rhs)
+    {
+      const glm::ivec2& lhsSize = characters.at(lhs).m_size;
+      const glm::ivec2& rhsSize = characters.at(rhs).m_size;
+      return lhsSize.y != rhsSize.y ? lhsSize.y > rhsSize.y : lhs < rhs;
+    });
+
+    // Start from the smallest square which could possibly hold every glyph, then grow one side at a time
+    uint32_t atlasWidth = 1;
+    while (atlasWidth < largestDimension || static_cast<uint64_t>(atlasWidth) * atlasWidth < totalArea)
+    {
+      atlasWidth *= 2;
+    }
+
+    uint32_t atlasHeight = atlasWidth;
+    std::vector<glm::uvec2> positions(packingOrder.size());
+    bool packed = false;
+
+    while (atlasWidth <= MAX_ATLAS_DIMENSION && atlasHeight <= MAX_ATLAS_DIMENSION)
+    {
+      // The right and bottom glyphs can let their padding hang off the edge
+      SkylinePacker packer(atlasWidth + GLYPH_PADDING, atlasHeight + GLYPH_PADDING);
+      packed = true;
+
+      for (size_t i = 0; i < packingOrder.size() && packed; ++i)
+      {
+        const glm::ivec2& size = characters.at(packingOrder[i]).m_size;
+        packed = packer.pack(size.x + GLYPH_PADDING, size.y + GLYPH_PADDING, positions[i]);
+      }
+
+      if (packed)
+      {
+        break;
+      }
+
+      if (atlasWidth <= atlasHeight)
+      {
+        atlasWidth *= 2;
+      }
+      else
+      {
+        atlasHeight *= 2;
+      }
+    }
+
+    if (!packed)
+    {
+      ASSERT_FAIL();
+      return;
+    }
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(atlasWidth) * atlasHeight, 0);
+    glm::vec2 atlasDimensions(atlasWidth, atlasHeight);
+
+    for (size_t i = 0; i < packingOrder.size(); ++i)
+    {
+      Character& character = characters.at(packingOrder[i]);
+      const std::vector<unsigned char>& glyphBitmap = bitmaps[packingOrder[i]];
+      const glm::uvec2& position = positions[i];
+
+      for (int row = 0; row < character.m_size.y; ++row)
+      {
+        std::memcpy(
+          pixels.data() + (static_cast<size_t>(position.y) + row) * atlasWidth + position.x,
+          glyphBitmap.data() + static_cast<size_t>(row) * character.m_size.x,
+          character.m_size.x);
+      }
+
+      glm::vec2 topLeft = glm::vec2(position) / atlasDimensions;
+      glm::vec2 bottomRight = (glm::vec2(position) + glm::vec2(character.m_size)) / atlasDimensions;
+      character.m_uvRectangle = glm::vec4(topLeft, bottomRight);
+    }
+
+    GlyphAtlas& glyphAtlas = m_charactersLookup[height];
+    glyphAtlas.m_characters = std::move(characters);
+
+    // Since we only have one channel's worth of data we have to store it in the red component
+    Texture2D& texture = glyphAtlas.m_texture;
+    texture.setInternalFormat(GL_RED);
+    texture.setImageFormat(GL_RED);
+    texture.setWrapS(GL_CLAMP_TO_EDGE);
+    texture.setWrapT(GL_CLAMP_TO_EDGE);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
+    texture.generate(atlasWidth, atlasHeight, pixels.data());
     glPixelStorei(GL_UNPACK_ALIGNMENT, 4); // Enable byte-alignment restriction
+
+    // However, we can fake the data to be read as the alpha channel by samplers in the shader
+    // This allows us to render text and sprites using the same shaders
+    GLint swizzleMask[] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+    texture.bind();
+    glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzleMask);
+    texture.unbind();
   }
 }
\ No newline at end of file
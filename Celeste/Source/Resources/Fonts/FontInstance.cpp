@@ -9,23 +9,37 @@ namespace Celeste
     //------------------------------------------------------------------------------------------------
     FontInstance::FontInstance() :
       m_characters(),
+      m_loadedCharacters(),
+      m_atlas(nullptr),
       m_height(0),
       m_fontName(0)
     {
     }
 
     //------------------------------------------------------------------------------------------------
-    FontInstance::FontInstance(const Characters& fontCharacters, float height, StringId fontName) :
-      m_characters(fontCharacters),
+    FontInstance::FontInstance(const Characters& fontCharacters, observer_ptr<const Texture2D> atlas, float height, StringId fontName) :
+      m_characters(),
+      m_loadedCharacters(),
+      m_atlas(atlas),
       m_height(height),
       m_fontName(fontName)
     {
+      for (const std::pair<const GLchar, Character>& characterPair : fontCharacters)
+      {
+        size_t index = static_cast<unsigned char>(characterPair.first);
+        if (index < CHARACTER_COUNT)
+        {
+          m_characters[index] = characterPair.second;
+          m_loadedCharacters.set(index);
+        }
+      }
     }
 
     //------------------------------------------------------------------------------------------------
     void FontInstance::reset()
     {
-      m_characters.clear();
+      m_loadedCharacters.reset();
+      m_atlas = nullptr;
       m_height = 0;
       m_fontName = 0;
     }
@@ -33,14 +47,14 @@ namespace Celeste
     //------------------------------------------------------------------------------------------------
     const Character* FontInstance::getCharacter(GLchar character) const
     {
-      auto it = m_characters.find(character);
-      if (it == m_characters.end())
+      size_t index = static_cast<unsigned char>(character);
+      if (index >= CHARACTER_COUNT || !m_loadedCharacters.test(index))
       {
         ASSERT_FAIL();
         return nullptr;
       }
 
-      return &((*it).second);
+      return &m_characters[index];
     }
 
     //------------------------------------------------------------------------------------------------
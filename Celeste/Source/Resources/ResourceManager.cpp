@@ -9,6 +9,7 @@ namespace Celeste::Resources
     m_vertexShaders(10, resourceDirectory),
     m_fragmentShaders(10, resourceDirectory),
     m_textures(100, resourceDirectory),
+    m_textureAtlases(10, resourceDirectory),
     m_fonts(10, resourceDirectory),
     m_sounds(20, resourceDirectory),
     m_data(150, resourceDirectory),
@@ -30,6 +31,7 @@ namespace Celeste::Resources
     m_vertexShaders.unloadAllResources();
     m_fragmentShaders.unloadAllResources();
     m_textures.unloadAllResources();
+    m_textureAtlases.unloadAllResources();
     m_fonts.unloadAllResources();
     m_sounds.unloadAllResources();
     m_data.unloadAllResources();
@@ -44,6 +46,7 @@ namespace Celeste::Resources
     m_vertexShaders.setResourceDirectoryPath(resourcesDirectory);
     m_fragmentShaders.setResourceDirectoryPath(resourcesDirectory);
     m_textures.setResourceDirectoryPath(resourcesDirectory);
+    m_textureAtlases.setResourceDirectoryPath(resourcesDirectory);
     m_fonts.setResourceDirectoryPath(resourcesDirectory);
     m_sounds.setResourceDirectoryPath(resourcesDirectory);
     m_data.setResourceDirectoryPath(resourcesDirectory);
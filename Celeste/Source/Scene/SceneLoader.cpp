@@ -11,7 +11,7 @@ using namespace Celeste::Resources;
 namespace Celeste::SceneLoader
 {
   //------------------------------------------------------------------------------------------------
-  std::tuple<bool, std::vector<GameObject*>> load(const Path& relativePathToLevelFile)
+  std::tuple<bool, std::vector<GameObject*>> load(const Path& relativePathToLevelFile, const AllocatorRegistry::CapacityHints& capacityHints)
   {
     std::tuple<bool, std::vector<GameObject*>> result = std::make_tuple(false, std::vector<GameObject*>());
 
@@ -36,6 +36,11 @@ namespace Celeste::SceneLoader
       return result;
     }
 
+    for (const auto& hintPair : capacityHints)
+    {
+      screenData.addRuntimeCapacity(hintPair.first, hintPair.second);
+    }
+
     return std::make_tuple(true, screenData.instantiate());
   }
 }
\ No newline at end of file
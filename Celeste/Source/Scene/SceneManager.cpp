@@ -4,8 +4,29 @@
 
 namespace Celeste
 {
+  namespace
+  {
+    constexpr size_t FRAME_ALLOCATOR_CAPACITY = 16 * 1024;
+
+    //------------------------------------------------------------------------------------------------
+    template <typename TGameObject, typename TRootGameObjects>
+    void addRootGameObjects(TRootGameObjects& rootGameObjects)
+    {
+      for (TGameObject& gameObject : GameObject::m_allocator)
+      {
+        if (gameObject.getParentTransform() == nullptr)
+        {
+          rootGameObjects.emplace_back(gameObject);
+        }
+      }
+    }
+  }
+
   //------------------------------------------------------------------------------------------------
-  SceneManager::SceneManager() = default;
+  SceneManager::SceneManager() :
+    m_frameAllocator(FRAME_ALLOCATOR_CAPACITY)
+  {
+  }
 
   //------------------------------------------------------------------------------------------------
   SceneManager::~SceneManager()
@@ -16,7 +37,12 @@ namespace Celeste
   //------------------------------------------------------------------------------------------------
   void SceneManager::update(float /*elapsedGameTime*/)
   {
-    for (GameObject& gameObject : getRootGameObjects())
+    // Gather the roots up front, as updating game objects can create more of them
+    m_frameAllocator.reset();
+    FrameVector<std::reference_wrapper<GameObject>> rootGameObjects(m_frameAllocator);
+    addRootGameObjects<GameObject>(rootGameObjects);
+
+    for (GameObject& gameObject : rootGameObjects)
     {
       updateGameObjectHierarchy(gameObject);
     }
@@ -72,14 +98,7 @@ namespace Celeste
   std::vector<std::reference_wrapper<GameObject>> SceneManager::getRootGameObjects()
   {
     std::vector<std::reference_wrapper<GameObject>> rootGameObjects;
-
-    for (GameObject& gameObject : GameObject::m_allocator)
-    {
-      if (gameObject.getParentTransform() == nullptr)
-      {
-        rootGameObjects.emplace_back(gameObject);
-      }
-    }
+    addRootGameObjects<GameObject>(rootGameObjects);
 
     return rootGameObjects;
   }
@@ -88,14 +107,7 @@ namespace Celeste
   std::vector<std::reference_wrapper<const GameObject>> SceneManager::getRootGameObjects() const
   {
     std::vector<std::reference_wrapper<const GameObject>> rootGameObjects;
-
-    for (const GameObject& gameObject : GameObject::m_allocator)
-    {
-      if (gameObject.getParentTransform() == nullptr)
-      {
-        rootGameObjects.emplace_back(gameObject);
-      }
-    }
+    addRootGameObjects<const GameObject>(rootGameObjects);
 
     return rootGameObjects;
   }
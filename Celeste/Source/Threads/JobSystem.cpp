@@ -0,0 +1,361 @@
+#include "Threads/JobSystem.h"
+#include "Game/Game.h"
+
+
+namespace Celeste
+{
+  namespace Internals
+  {
+    // Which JobSystem (if any) the current thread is a worker of, and its index in that JobSystem
+    // Only worker threads set these - they belong to exactly one JobSystem for their whole life, whereas
+    // the creating thread may go on to create others, so it is recognised by its thread id instead
+    thread_local const JobSystem* t_jobSystem = nullptr;
+    thread_local size_t t_threadIndex = 0;
+
+    // Per thread state for picking which thread to steal from - xorshift is plenty random enough for this
+    thread_local uint32_t t_stealSeed = 0x9E3779B9u;
+
+    //------------------------------------------------------------------------------------------------
+    size_t nextStealIndex(size_t threadCount)
+    {
+      t_stealSeed ^= t_stealSeed << 13;
+      t_stealSeed ^= t_stealSeed >> 17;
+      t_stealSeed ^= t_stealSeed << 5;
+      return t_stealSeed % threadCount;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  WorkStealingQueue::WorkStealingQueue() :
+    m_top(0),
+    m_bottom(0),
+    m_jobs(new std::atomic<Job*>[CAPACITY])
+  {
+    for (size_t i = 0; i < CAPACITY; ++i)
+    {
+      m_jobs[i].store(nullptr);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  bool WorkStealingQueue::push(Job* job)
+  {
+    int64_t bottom = m_bottom.load();
+    int64_t top = m_top.load();
+
+    if (bottom - top >= static_cast<int64_t>(CAPACITY))
+    {
+      return false;
+    }
+
+    m_jobs[bottom & MASK].store(job);
+    m_bottom.store(bottom + 1);
+
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  Job* WorkStealingQueue::pop()
+  {
+    // Reserve the bottom job before looking at the top, so a concurrent steal sees the reservation
+    int64_t bottom = m_bottom.load() - 1;
+    m_bottom.store(bottom);
+    int64_t top = m_top.load();
+
+    if (top > bottom)
+    {
+      // The queue was already empty
+      m_bottom.store(bottom + 1);
+      return nullptr;
+    }
+
+    Job* job = m_jobs[bottom & MASK].load();
+
+    if (top == bottom)
+    {
+      // This is the last job, so we are racing any thieves for it
+      if (!m_top.compare_exchange_strong(top, top + 1))
+      {
+        job = nullptr;
+      }
+
+      m_bottom.store(bottom + 1);
+    }
+
+    return job;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  Job* WorkStealingQueue::steal()
+  {
+    int64_t top = m_top.load();
+    int64_t bottom = m_bottom.load();
+
+    if (top >= bottom)
+    {
+      return nullptr;
+    }
+
+    Job* job = m_jobs[top & MASK].load();
+
+    // Another thief or the owner may have taken this job since we read top
+    if (!m_top.compare_exchange_strong(top, top + 1))
+    {
+      return nullptr;
+    }
+
+    return job;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  JobSystem::JobSystem(size_t workerThreadCount) :
+    m_threadData(),
+    m_workerThreads(),
+    m_threadCount(workerThreadCount + 1),
+    m_creatingThread(std::this_thread::get_id()),
+    m_externalThreadLock(),
+    m_running(true),
+    m_queuedJobCount(0),
+    m_sleepingWorkerCount(0),
+    m_sleepLock(),
+    m_wakeCondition()
+  {
+    // Index 0 is the creating thread, 1 to workerThreadCount are the workers
+    // and the extra one at the end is shared by any other threads which use the job system
+    for (size_t i = 0; i < m_threadCount + 1; ++i)
+    {
+      m_threadData.push_back(std::make_unique<ThreadData>());
+      m_threadData.back()->m_jobs.reset(new Job[JOBS_PER_THREAD]());
+    }
+
+    m_workerThreads.reserve(workerThreadCount);
+    for (size_t i = 1; i <= workerThreadCount; ++i)
+    {
+      m_workerThreads.emplace_back(&JobSystem::workerMain, this, i);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  JobSystem::~JobSystem()
+  {
+    m_running.store(false);
+
+    {
+      std::lock_guard<std::mutex> lock(m_sleepLock);
+      m_wakeCondition.notify_all();
+    }
+
+    for (std::thread& workerThread : m_workerThreads)
+    {
+      workerThread.join();
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t JobSystem::getDefaultWorkerThreadCount()
+  {
+    // Leave a core for the thread which created us
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t JobSystem::getCurrentThreadIndex() const
+  {
+    if (Internals::t_jobSystem == this)
+    {
+      return Internals::t_threadIndex;
+    }
+
+    return std::this_thread::get_id() == m_creatingThread ? 0 : m_threadCount;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  Job* JobSystem::allocateJob()
+  {
+    size_t threadIndex = getCurrentThreadIndex();
+    ThreadData& threadData = *m_threadData[threadIndex];
+
+    std::unique_lock<std::mutex> lock(m_externalThreadLock, std::defer_lock);
+    if (threadIndex == m_threadCount)
+    {
+      lock.lock();
+    }
+
+    // Jobs are handed out round robin - by the time we wrap around, the job we are reusing should long since have finished
+    Job* job = &threadData.m_jobs[threadData.m_allocatedJobCount++ % JOBS_PER_THREAD];
+    ASSERT_MSG(isFinished(job), "Too many jobs in flight on one thread");
+
+    return job;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void JobSystem::run(Job* job)
+  {
+    size_t threadIndex = getCurrentThreadIndex();
+    bool pushed = false;
+
+    if (threadIndex == m_threadCount)
+    {
+      std::lock_guard<std::mutex> lock(m_externalThreadLock);
+      pushed = m_threadData[threadIndex]->m_queue.push(job);
+    }
+    else
+    {
+      pushed = m_threadData[threadIndex]->m_queue.push(job);
+    }
+
+    if (!pushed)
+    {
+      // Our queue is full, so there is plenty of work around - just do this one ourselves
+      execute(job);
+      return;
+    }
+
+    m_queuedJobCount.fetch_add(1);
+
+    if (m_sleepingWorkerCount.load() > 0)
+    {
+      // Notifying under the lock means a worker cannot miss this between checking for jobs and going to sleep
+      std::lock_guard<std::mutex> lock(m_sleepLock);
+      m_wakeCondition.notify_one();
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void JobSystem::addContinuation(Job* job, Job* continuation)
+  {
+    int32_t index = job->m_continuationCount.fetch_add(1);
+    ASSERT_MSG(index < static_cast<int32_t>(Job::MAX_CONTINUATIONS), "Too many continuations added to job");
+
+    if (index < static_cast<int32_t>(Job::MAX_CONTINUATIONS))
+    {
+      job->m_continuations[index] = continuation;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void JobSystem::wait(const Job* job)
+  {
+    size_t threadIndex = getCurrentThreadIndex();
+
+    while (!isFinished(job))
+    {
+      Job* nextJob = getJob(threadIndex);
+      if (nextJob != nullptr)
+      {
+        execute(nextJob);
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  Job* JobSystem::getJob(size_t threadIndex)
+  {
+    Job* job = nullptr;
+
+    if (threadIndex == m_threadCount)
+    {
+      std::lock_guard<std::mutex> lock(m_externalThreadLock);
+      job = m_threadData[threadIndex]->m_queue.pop();
+    }
+    else
+    {
+      job = m_threadData[threadIndex]->m_queue.pop();
+    }
+
+    if (job == nullptr)
+    {
+      // Try everyone else, starting from a random thread so we don't all pile onto the same victim
+      size_t queueCount = m_threadData.size();
+      size_t start = Internals::nextStealIndex(queueCount);
+
+      for (size_t i = 0; i < queueCount && job == nullptr; ++i)
+      {
+        size_t victim = (start + i) % queueCount;
+        if (victim != threadIndex)
+        {
+          job = m_threadData[victim]->m_queue.steal();
+        }
+      }
+    }
+
+    if (job != nullptr)
+    {
+      m_queuedJobCount.fetch_sub(1);
+    }
+
+    return job;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void JobSystem::execute(Job* job)
+  {
+    job->m_function(*job);
+    finish(job);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void JobSystem::finish(Job* job)
+  {
+    // Once the count hits zero the job may be reused, so read everything we need from it beforehand
+    Job* parent = job->m_parent;
+    int32_t continuationCount = std::min(job->m_continuationCount.load(), static_cast<int32_t>(Job::MAX_CONTINUATIONS));
+    Job* continuations[Job::MAX_CONTINUATIONS];
+    std::copy(job->m_continuations, job->m_continuations + continuationCount, continuations);
+
+    if (job->m_unfinishedJobs.fetch_sub(1) != 1)
+    {
+      // Still waiting on children
+      return;
+    }
+
+    for (int32_t i = 0; i < continuationCount; ++i)
+    {
+      run(continuations[i]);
+    }
+
+    if (parent != nullptr)
+    {
+      finish(parent);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  void JobSystem::workerMain(size_t threadIndex)
+  {
+    Internals::t_jobSystem = this;
+    Internals::t_threadIndex = threadIndex;
+    Internals::t_stealSeed ^= static_cast<uint32_t>(threadIndex * 2654435761u);
+
+    while (m_running.load())
+    {
+      Job* job = getJob(threadIndex);
+      if (job != nullptr)
+      {
+        execute(job);
+        continue;
+      }
+
+      // Nothing to do, so sleep until more jobs are queued
+      // We count ourselves as sleeping before checking for jobs, so run either sees us and notifies, or queued its job before we check
+      std::unique_lock<std::mutex> lock(m_sleepLock);
+      m_sleepingWorkerCount.fetch_add(1);
+      m_wakeCondition.wait(lock, [this]()
+      {
+        return m_queuedJobCount.load() > 0 || !m_running.load();
+      });
+      m_sleepingWorkerCount.fetch_sub(1);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  JobSystem& getJobSystem()
+  {
+    return Game::current().getJobSystem();
+  }
+}
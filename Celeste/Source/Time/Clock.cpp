@@ -1,5 +1,7 @@
 #include "Time/Clock.h"
 
+#include <cmath>
+
 
 namespace Celeste
 {
@@ -10,6 +12,8 @@ namespace Celeste
     m_previous(0.0f),
     m_timeScale(1.0f),  // Default to unscaled
     m_targetSecondsPerFrame(1.0f / targetFramesPerSecond),
+    m_lag(0.0f),
+    m_maxSubsteps(DEFAULT_MAX_SUBSTEPS),
     m_paused(false)   // Default to running
   {
   }
@@ -44,5 +48,34 @@ namespace Celeste
     m_cycles = 0;
     m_previous = 0;
     m_current = 0;
+    m_lag = 0;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  size_t Clock::consumeFixedSteps()
+  {
+    if (m_paused)
+    {
+      return 0;
+    }
+
+    m_lag += getElapsedDeltaTime();
+
+    size_t stepCount = static_cast<size_t>(m_lag / m_targetSecondsPerFrame);
+    if (stepCount > m_maxSubsteps)
+    {
+      // We have fallen too far behind to catch up, so just drop the time we cannot simulate
+      stepCount = m_maxSubsteps;
+      m_lag = std::fmod(m_lag, m_targetSecondsPerFrame);
+    }
+    else
+    {
+      m_lag -= stepCount * m_targetSecondsPerFrame;
+    }
+
+    // Guard against rounding leaving us a fraction over or under a whole step
+    m_lag = glm::clamp(m_lag, 0.0f, m_targetSecondsPerFrame);
+
+    return stepCount;
   }
 }
\ No newline at end of file
@@ -126,6 +126,14 @@ namespace TestCeleste
     Assert::AreEqual(std::numeric_limits<float>::max(), converter.getMaxAngularVelocity());
   }
 
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(RigidBody2DDataConverter_Constructor_SetsBullet_ToFalse)
+  {
+    RigidBody2DDataConverter converter;
+
+    Assert::IsFalse(converter.isBullet());
+  }
+
   //------------------------------------------------------------------------------------------------
   TEST_METHOD(RigidBody2DDataConverter_Constructor_AddsLinearVelocityAttribute)
   {
@@ -174,6 +182,14 @@ namespace TestCeleste
     Assert::IsNotNull(converter.findAttribute(RigidBody2DDataConverter::MAX_ANGULAR_VELOCITY_ATTRIBUTE_NAME));
   }
 
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(RigidBody2DDataConverter_Constructor_AddsBulletAttribute)
+  {
+    const MockRigidBody2DDataConverter converter;
+
+    Assert::IsNotNull(converter.findAttribute(RigidBody2DDataConverter::BULLET_ATTRIBUTE_NAME));
+  }
+
 #pragma endregion
 
 #pragma region Convert From XML Tests
@@ -505,6 +521,51 @@ namespace TestCeleste
 
 #pragma endregion
 
+#pragma region Convert Bullet Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(RigidBody2DDataConverter_ConvertFromXML_NoBulletAttribute_ReturnsTrue_DoesNothing)
+  {
+    RigidBody2DDataConverter converter;
+    XMLDocument document;
+    XMLElement* element = document.NewElement("RigidBody2D");
+
+    Assert::IsNull(static_cast<const XMLElement*>(element)->Attribute(RigidBody2DDataConverter::BULLET_ATTRIBUTE_NAME));
+    Assert::IsFalse(converter.isBullet());
+    Assert::IsTrue(converter.convertFromXML(element));
+    Assert::IsFalse(converter.isBullet());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(RigidBody2DDataConverter_ConvertFromXML_BulletAttribute_WithInvalidText_ReturnsFalse_DoesNothing)
+  {
+    RigidBody2DDataConverter converter;
+    XMLDocument document;
+    XMLElement* element = document.NewElement("RigidBody2D");
+    element->SetAttribute(RigidBody2DDataConverter::BULLET_ATTRIBUTE_NAME, "WubbaLubbaDubDub");
+
+    Assert::AreEqual("WubbaLubbaDubDub", static_cast<const XMLElement*>(element)->Attribute(RigidBody2DDataConverter::BULLET_ATTRIBUTE_NAME));
+    Assert::IsFalse(converter.isBullet());
+    Assert::IsFalse(converter.convertFromXML(element));
+    Assert::IsFalse(converter.isBullet());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(RigidBody2DDataConverter_ConvertFromXML_BulletAttribute_WithValidText_ReturnsTrue_SetsBulletToCorrectValue)
+  {
+    RigidBody2DDataConverter converter;
+    XMLDocument document;
+    XMLElement* element = document.NewElement("RigidBody2D");
+    element->SetAttribute(RigidBody2DDataConverter::BULLET_ATTRIBUTE_NAME, "true");
+
+    Assert::AreEqual("true", static_cast<const XMLElement*>(element)->Attribute(RigidBody2DDataConverter::BULLET_ATTRIBUTE_NAME));
+    Assert::IsFalse(converter.isBullet());
+    Assert::IsTrue(converter.convertFromXML(element));
+    Assert::IsTrue(converter.isBullet());
+  }
+
+#pragma endregion
+
 #pragma region Set Values Tests
 
   //------------------------------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #include "TestUtils/Utils/GameObjectXMLUtils.h"
 #include "Scene/SceneManager.h"
 #include "TestUtils/Assert/AssertCel.h"
+#include "Maths/Transform.h"
 
 #include <numeric>
 
@@ -1652,6 +1653,123 @@ namespace TestCeleste
 
 #pragma endregion
 
+#pragma region Capacity Hints Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ScreenDataConverter_ConvertFromXML_InputtingCapacityElements_AddsDeclaredCapacityHints)
+  {
+    SceneDataConverter converter("Screen");
+    XMLDocument document;
+    XMLElement* element = document.NewElement("Test");
+    XMLElement* capacities = document.NewElement(SceneDataConverter::CAPACITIES_ELEMENT_NAME);
+    XMLElement* capacity = document.NewElement(SceneDataConverter::CAPACITY_ELEMENT_NAME);
+    capacity->SetAttribute(SceneDataConverter::CAPACITY_TYPE_ATTRIBUTE_NAME, "RigidBody2D");
+    capacity->SetAttribute(SceneDataConverter::CAPACITY_COUNT_ATTRIBUTE_NAME, 200);
+    element->InsertFirstChild(capacities);
+    capacities->InsertFirstChild(capacity);
+
+    Assert::IsTrue(converter.convertFromXML(element));
+
+    SceneDataConverter::CapacityHints capacityHints = converter.getCapacityHints();
+
+    Assert::AreEqual(static_cast<size_t>(1), capacityHints.size());
+    Assert::AreEqual(static_cast<size_t>(200), capacityHints["RigidBody2D"]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ScreenDataConverter_ConvertFromXML_InputtingCapacityElementWithNoCount_ReturnsFalse)
+  {
+    SceneDataConverter converter("Screen");
+    XMLDocument document;
+    XMLElement* element = document.NewElement("Test");
+    XMLElement* capacities = document.NewElement(SceneDataConverter::CAPACITIES_ELEMENT_NAME);
+    XMLElement* capacity = document.NewElement(SceneDataConverter::CAPACITY_ELEMENT_NAME);
+    capacity->SetAttribute(SceneDataConverter::CAPACITY_TYPE_ATTRIBUTE_NAME, "RigidBody2D");
+    element->InsertFirstChild(capacities);
+    capacities->InsertFirstChild(capacity);
+
+    Assert::IsFalse(converter.convertFromXML(element));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ScreenDataConverter_GetCapacityHints_CountsGameObjectsAndTransforms)
+  {
+    SceneDataConverter converter("Screen");
+    XMLDocument document;
+    XMLElement* element = document.NewElement("Test");
+    XMLElement* gameObjects = createGameObjectsElement(document, element);
+    XMLElement* parent = createGameObjectElement(document, "Parent", gameObjects);
+    createGameObjectElement(document, "Child", createGameObjectsElement(document, parent));
+    createGameObjectElement(document, "Other", gameObjects);
+
+    Assert::IsTrue(converter.convertFromXML(element));
+
+    SceneDataConverter::CapacityHints capacityHints = converter.getCapacityHints();
+
+    Assert::AreEqual(static_cast<size_t>(3), capacityHints[GameObject::type_name()]);
+    Assert::AreEqual(static_cast<size_t>(3), capacityHints[Transform::type_name()]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ScreenDataConverter_GetCapacityHints_DeclaredCapacityLargerThanCounted_ReturnsDeclaredCapacity)
+  {
+    SceneDataConverter converter("Screen");
+    XMLDocument document;
+    XMLElement* element = document.NewElement("Test");
+    createGameObjectElement(document, "Child", createGameObjectsElement(document, element));
+
+    Assert::IsTrue(converter.convertFromXML(element));
+
+    converter.addCapacityHint(GameObject::type_name(), 50);
+    converter.addCapacityHint(Transform::type_name(), 0);
+
+    SceneDataConverter::CapacityHints capacityHints = converter.getCapacityHints();
+
+    Assert::AreEqual(static_cast<size_t>(50), capacityHints[GameObject::type_name()]);
+    Assert::AreEqual(static_cast<size_t>(1), capacityHints[Transform::type_name()]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ScreenDataConverter_GetCapacityHints_RuntimeCapacity_AddsToCountedAndDeclaredCapacity)
+  {
+    SceneDataConverter converter("Screen");
+    XMLDocument document;
+    XMLElement* element = document.NewElement("Test");
+    createGameObjectElement(document, "Child", createGameObjectsElement(document, element));
+
+    Assert::IsTrue(converter.convertFromXML(element));
+
+    converter.addCapacityHint(GameObject::type_name(), 50);
+    converter.addRuntimeCapacity(GameObject::type_name(), 10);
+    converter.addRuntimeCapacity(Transform::type_name(), 10);
+    converter.addRuntimeCapacity(Transform::type_name(), 5);
+
+    SceneDataConverter::CapacityHints capacityHints = converter.getCapacityHints();
+
+    Assert::AreEqual(static_cast<size_t>(60), capacityHints[GameObject::type_name()]);
+    Assert::AreEqual(static_cast<size_t>(16), capacityHints[Transform::type_name()]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ScreenDataConverter_Instantiate_ReservesCapacityHintsInAllocators)
+  {
+    SceneDataConverter converter("Screen");
+    XMLDocument document;
+    XMLElement* element = document.NewElement("Test");
+    createGameObjectElement(document, "Child", createGameObjectsElement(document, element));
+
+    Assert::IsTrue(converter.convertFromXML(element));
+
+    size_t requiredCapacity = AllocatorRegistry::getStats(GameObject::type_name()).m_capacity + 500;
+    converter.addCapacityHint(GameObject::type_name(), requiredCapacity);
+
+    AutoDestroyer destroyer = converter.instantiate();
+
+    Assert::IsTrue(AllocatorRegistry::getStats(GameObject::type_name()).m_capacity >= requiredCapacity);
+  }
+
+#pragma endregion
+
 #pragma region Instantiate Tests
 
   //------------------------------------------------------------------------------------------------
@@ -218,6 +218,28 @@ namespace TestCeleste
     checkLogFile(expected);
   }
 
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(FileLogger_Log_MessageLargerThanBuffer_WritesMessageToFileAfterBufferedMessages)
+  {
+    std::string message(LOGGER_BUFFER_SIZE * 2, 'S');
+
+    FileLogger logger(logFilePath);
+    int line = LINE;
+
+    logger.log("Simple Log", Verbosity::kInfo, FUNCTION, FILENAME, line);
+
+    // Too large for either buffer, so this is written straight out after the message above
+    logger.log(message, Verbosity::kInfo, FUNCTION, FILENAME, line + 1);
+
+    std::string expected = getLogString(Verbosity::kInfo, "Simple Log", line, FUNCTION, FILENAME);
+    expected.push_back('\n');
+    expected.append(getLogString(Verbosity::kInfo, message, line + 1, FUNCTION, FILENAME));
+
+    Assert::AreEqual(expected + "\n", logger.getLog());
+
+    checkLogFile(expected);
+  }
+
   //------------------------------------------------------------------------------------------------
   TEST_METHOD(FileLogger_Log_ShouldFlushAfterEveryLog_WritesToFileWithEveryMessage)
   {
@@ -0,0 +1,276 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Input/InputRecorder.h"
+#include "Input/Keyboard.h"
+#include "Input/Mouse.h"
+#include "TestResources/TestResources.h"
+#include "TestUtils/Assert/AssertCel.h"
+
+#include <fstream>
+
+using namespace Celeste;
+using namespace Celeste::Input;
+
+
+namespace TestCeleste
+{
+  CELESTE_TEST_CLASS(TestInputRecorder)
+
+#pragma region Constructor Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_Constructor_HasNoFramesOrTicks)
+    {
+      InputRecorder recorder;
+
+      Assert::AreEqual(static_cast<size_t>(0), recorder.getFrameCount());
+      Assert::AreEqual(static_cast<size_t>(0), recorder.getTickCount());
+    }
+
+#pragma endregion
+
+#pragma region Record Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_Record_CapturesCurrentInputAndTiming)
+    {
+      Keyboard keyboard;
+      keyboard.setKeyPressed(GLFW_KEY_A);
+      keyboard.setKeyPressed(GLFW_KEY_SPACE);
+      keyboard.update();
+
+      Mouse mouse;
+      mouse.setButtonPressed(MouseButton::kRight);
+      mouse.update();
+      mouse.getTransform().setTranslation(10, 20);
+
+      InputRecorder recorder;
+      recorder.record(keyboard, mouse, 0.02f, 2);
+
+      Assert::AreEqual(static_cast<size_t>(1), recorder.getFrameCount());
+
+      const InputFrame& frame = recorder.getFrame(0);
+      Assert::AreEqual(0.02f, frame.m_elapsedGameTime);
+      Assert::AreEqual(static_cast<uint32_t>(2), frame.m_fixedStepCount);
+      Assert::IsTrue(isBitSet(frame.m_keys, GLFW_KEY_A));
+      Assert::IsTrue(isBitSet(frame.m_keys, GLFW_KEY_SPACE));
+      Assert::IsFalse(isBitSet(frame.m_keys, GLFW_KEY_B));
+      Assert::AreEqual(1u << static_cast<int>(MouseButton::kRight), frame.m_mouseButtons);
+      Assert::AreEqual(glm::vec2(10, 20), frame.m_mousePosition);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_Record_KeyOnlyBuffered_IsNotRecorded)
+    {
+      Keyboard keyboard;
+      keyboard.setKeyPressed(GLFW_KEY_A);
+      Mouse mouse;
+
+      InputRecorder recorder;
+      recorder.record(keyboard, mouse, 0.02f, 1);
+
+      Assert::IsFalse(isBitSet(recorder.getFrame(0).m_keys, GLFW_KEY_A));
+    }
+
+#pragma endregion
+
+#pragma region Apply Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_Apply_AfterUpdate_InputMatchesRecording)
+    {
+      Keyboard recordedKeyboard;
+      Mouse recordedMouse;
+      InputRecorder recorder;
+
+      recordedKeyboard.setKeyPressed(GLFW_KEY_A);
+      recordedMouse.setButtonPressed(MouseButton::kLeft);
+      recordedKeyboard.update();
+      recordedMouse.update();
+      recordedMouse.getTransform().setTranslation(5, 6);
+      recorder.record(recordedKeyboard, recordedMouse, 0.02f, 1);
+
+      recordedKeyboard.setKeyReleased(GLFW_KEY_A);
+      recordedKeyboard.setKeyPressed(GLFW_KEY_D);
+      recordedKeyboard.update();
+      recorder.record(recordedKeyboard, recordedMouse, 0.02f, 1);
+
+      Keyboard keyboard;
+      Mouse mouse;
+
+      recorder.apply(0, keyboard, mouse);
+      keyboard.update();
+      mouse.update();
+
+      Assert::IsTrue(keyboard.isKeyTapped(GLFW_KEY_A));
+      Assert::IsFalse(keyboard.isKeyPressed(GLFW_KEY_D));
+      Assert::IsTrue(mouse.isButtonClicked(MouseButton::kLeft));
+      Assert::AreEqual(glm::vec3(5, 6, 0), mouse.getTransform().getTranslation());
+
+      recorder.apply(1, keyboard, mouse);
+      keyboard.update();
+      mouse.update();
+
+      Assert::IsFalse(keyboard.isKeyPressed(GLFW_KEY_A));
+      Assert::IsTrue(keyboard.isKeyTapped(GLFW_KEY_D));
+      Assert::IsTrue(mouse.isButtonPressed(MouseButton::kLeft));
+      Assert::IsFalse(mouse.isButtonClicked(MouseButton::kLeft));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_Apply_OnlyFiresEventsForKeysWhichChange)
+    {
+      Keyboard recordedKeyboard;
+      Mouse recordedMouse;
+      InputRecorder recorder;
+
+      recordedKeyboard.setKeyPressed(GLFW_KEY_A);
+      recordedKeyboard.update();
+      recorder.record(recordedKeyboard, recordedMouse, 0.02f, 1);
+      recorder.record(recordedKeyboard, recordedMouse, 0.02f, 1);
+
+      Keyboard keyboard;
+      Mouse mouse;
+      int pressedCount = 0;
+      int releasedCount = 0;
+      keyboard.getKeyPressedEvent().subscribe([&pressedCount](int) { ++pressedCount; });
+      keyboard.getKeyReleasedEvent().subscribe([&releasedCount](int) { ++releasedCount; });
+
+      recorder.apply(0, keyboard, mouse);
+      keyboard.update();
+      recorder.apply(1, keyboard, mouse);
+      keyboard.update();
+
+      Assert::AreEqual(1, pressedCount);
+      Assert::AreEqual(0, releasedCount);
+    }
+
+#pragma endregion
+
+#pragma region Find Divergence Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_FindDivergence_ReturnsFirstMismatchedTick)
+    {
+      InputRecorder recorder;
+      recorder.recordTick(1);
+      recorder.recordTick(2);
+      recorder.recordTick(3);
+
+      Assert::AreEqual(static_cast<size_t>(1), recorder.findDivergence({ 1, 5, 3 }));
+      Assert::AreEqual(static_cast<size_t>(0), recorder.findDivergence({ 0 }));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_FindDivergence_AllMatching_ReturnsNumberOfTicksCompared)
+    {
+      InputRecorder recorder;
+      recorder.recordTick(1);
+      recorder.recordTick(2);
+
+      Assert::AreEqual(static_cast<size_t>(2), recorder.findDivergence({ 1, 2 }));
+      Assert::AreEqual(static_cast<size_t>(1), recorder.findDivergence({ 1 }));
+      Assert::AreEqual(static_cast<size_t>(2), recorder.findDivergence({ 1, 2, 7 }));
+    }
+
+#pragma endregion
+
+#pragma region Save Load Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_SaveThenLoad_RestoresFramesAndTicks)
+    {
+      Keyboard keyboard;
+      keyboard.setKeyPressed(GLFW_KEY_W);
+      keyboard.update();
+
+      Mouse mouse;
+      mouse.getTransform().setTranslation(3, 4);
+
+      InputRecorder recorder;
+      recorder.record(keyboard, mouse, 0.016f, 1);
+      recorder.record(keyboard, mouse, 0.033f, 2);
+      recorder.recordTick(11);
+      recorder.recordTick(22);
+      recorder.recordTick(33);
+
+      Path path(TempDirectory::getFullPath(), "Recording.input");
+      Assert::IsTrue(recorder.save(path));
+
+      InputRecorder loaded;
+      Assert::IsTrue(loaded.load(path));
+
+      Assert::AreEqual(static_cast<size_t>(2), loaded.getFrameCount());
+      Assert::AreEqual(0.033f, loaded.getFrame(1).m_elapsedGameTime);
+      Assert::AreEqual(static_cast<uint32_t>(2), loaded.getFrame(1).m_fixedStepCount);
+      Assert::IsTrue(isBitSet(loaded.getFrame(1).m_keys, GLFW_KEY_W));
+      Assert::AreEqual(glm::vec2(3, 4), loaded.getFrame(0).m_mousePosition);
+      Assert::AreEqual(static_cast<size_t>(3), loaded.findDivergence({ 11, 22, 33 }));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_Load_NonExistentFile_ReturnsFalse_AndClearsRecording)
+    {
+      InputRecorder recorder;
+      recorder.recordTick(1);
+
+      Assert::IsFalse(recorder.load(Path(TempDirectory::getFullPath(), "ThisRecordingDoesNotExist.input")));
+      Assert::AreEqual(static_cast<size_t>(0), recorder.getTickCount());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_Load_FrameCountLargerThanFile_ReturnsFalse_AndClearsRecording)
+    {
+      Keyboard keyboard;
+      Mouse mouse;
+
+      InputRecorder recorder;
+      recorder.record(keyboard, mouse, 0.016f, 1);
+      recorder.recordTick(1);
+
+      Path path(TempDirectory::getFullPath(), "CorruptFrameCount.input");
+      Assert::IsTrue(recorder.save(path));
+
+      // The frame count follows the 4 byte magic and 4 byte version
+      {
+        std::fstream file(path.as_string(), std::ios::binary | std::ios::in | std::ios::out);
+        uint64_t frameCount = static_cast<uint64_t>(-1) / 2;
+        file.seekp(8);
+        file.write(reinterpret_cast<const char*>(&frameCount), sizeof(frameCount));
+      }
+
+      Assert::IsFalse(recorder.load(path));
+      Assert::AreEqual(static_cast<size_t>(0), recorder.getFrameCount());
+      Assert::AreEqual(static_cast<size_t>(0), recorder.getTickCount());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(InputRecorder_Load_TickCountLargerThanFile_ReturnsFalse_AndClearsRecording)
+    {
+      Keyboard keyboard;
+      Mouse mouse;
+
+      InputRecorder recorder;
+      recorder.record(keyboard, mouse, 0.016f, 1);
+      recorder.recordTick(1);
+
+      Path path(TempDirectory::getFullPath(), "CorruptTickCount.input");
+      Assert::IsTrue(recorder.save(path));
+
+      // The tick count follows the magic, version and frame count
+      {
+        std::fstream file(path.as_string(), std::ios::binary | std::ios::in | std::ios::out);
+        uint64_t tickCount = 2;
+        file.seekp(16);
+        file.write(reinterpret_cast<const char*>(&tickCount), sizeof(tickCount));
+      }
+
+      Assert::IsFalse(recorder.load(path));
+      Assert::AreEqual(static_cast<size_t>(0), recorder.getFrameCount());
+      Assert::AreEqual(static_cast<size_t>(0), recorder.getTickCount());
+    }
+
+#pragma endregion
+
+  };
+}
\ No newline at end of file
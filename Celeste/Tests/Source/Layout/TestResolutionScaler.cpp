@@ -125,6 +125,68 @@ namespace TestCeleste::Layout
     Assert::IsFalse(scaler.needsRescale());
   }
 
+#pragma endregion
+
+#pragma region Dense Allocator Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResolutionScaler_Delete_LastScalerMovesIntoHoleAndKeepsItsGameObjectAndHandle)
+  {
+    GameObject gameObject1, gameObject2, gameObject3;
+    observer_ptr<ResolutionScaler> scaler1 = gameObject1.addComponent<ResolutionScaler>();
+    observer_ptr<ResolutionScaler> scaler2 = gameObject2.addComponent<ResolutionScaler>();
+    observer_ptr<ResolutionScaler> scaler3 = gameObject3.addComponent<ResolutionScaler>();
+    scaler2->setTargetResolution(glm::vec2(200, 100));
+    scaler3->setTargetResolution(glm::vec2(300, 100));
+
+    Handle<ResolutionScaler> handle1 = scaler1->handle();
+    Handle<ResolutionScaler> handle2 = scaler2->handle();
+    Handle<ResolutionScaler> handle3 = scaler3->handle();
+
+    delete scaler1;
+
+    Assert::IsNull(ResolutionScaler::resolve(handle1));
+    Assert::AreEqual((size_t)0, gameObject1.getComponentCount());
+
+    // The last scaler was moved into the deleted one's memory, and both its game object and handle followed it
+    observer_ptr<ResolutionScaler> movedScaler3 = ResolutionScaler::resolve(handle3);
+    Assert::IsTrue(movedScaler3 == scaler1);
+    Assert::IsTrue(movedScaler3 == gameObject3.findComponent<ResolutionScaler>());
+    Assert::IsTrue(&gameObject3 == &movedScaler3->getGameObject());
+    Assert::AreEqual((size_t)1, gameObject3.getComponentCount());
+    Assert::AreEqual(glm::vec2(300, 100), movedScaler3->getTargetResolution());
+
+    Assert::IsTrue(scaler2 == ResolutionScaler::resolve(handle2));
+    Assert::IsTrue(scaler2 == gameObject2.findComponent<ResolutionScaler>());
+    Assert::AreEqual(glm::vec2(200, 100), scaler2->getTargetResolution());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResolutionScaler_GameObjectDestroyed_DeletesItsScalerAndInvalidatesHandle)
+  {
+    GameObject gameObject;
+    Handle<ResolutionScaler> destroyedHandle, survivingHandle;
+
+    {
+      GameObject temporaryGameObject;
+      destroyedHandle = temporaryGameObject.addComponent<ResolutionScaler>()->handle();
+
+      observer_ptr<ResolutionScaler> scaler = gameObject.addComponent<ResolutionScaler>();
+      scaler->setTargetResolution(glm::vec2(400, 100));
+      survivingHandle = scaler->handle();
+
+      Assert::IsNotNull(ResolutionScaler::resolve(destroyedHandle));
+    }
+
+    Assert::IsNull(ResolutionScaler::resolve(destroyedHandle));
+
+    observer_ptr<ResolutionScaler> scaler = ResolutionScaler::resolve(survivingHandle);
+    Assert::IsNotNull(scaler);
+    Assert::IsTrue(scaler == gameObject.findComponent<ResolutionScaler>());
+    Assert::AreEqual(glm::vec2(400, 100), scaler->getTargetResolution());
+    Assert::AreEqual((size_t)1, gameObject.getComponentCount());
+  }
+
 #pragma endregion
 
   };
@@ -5,6 +5,8 @@
 #include "TestUtils/Assert/AssertCel.h"
 #include "TestUtils/Assert/AssertExt.h"
 
+#include <cmath>
+
 using namespace Celeste;
 
 
@@ -1116,6 +1118,41 @@ namespace TestCeleste
       Assert::AreEqual((size_t)0, parent.getChildCount());
     }
 
+#pragma endregion
+
+#pragma region Checksum Transforms Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(Transform_ChecksumTransforms_SameState_ReturnsSameValue)
+    {
+      GameObject gameObject;
+      gameObject.getTransform()->setTranslation(1, 2, 3);
+
+      Assert::AreEqual(checksumTransforms(), checksumTransforms());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(Transform_ChecksumTransforms_TinyChangeToAnyValue_ChangesValue)
+    {
+      GameObject gameObject;
+      gameObject.getTransform()->setTranslation(1, 2, 3);
+      uint64_t original = checksumTransforms();
+
+      gameObject.getTransform()->setTranslation(std::nextafter(1.0f, 2.0f), 2, 3);
+      Assert::AreNotEqual(original, checksumTransforms());
+
+      gameObject.getTransform()->setTranslation(1, 2, 3);
+      gameObject.getTransform()->setRotation(0.0001f);
+      Assert::AreNotEqual(original, checksumTransforms());
+
+      gameObject.getTransform()->setRotation(0);
+      gameObject.getTransform()->setScale(1, 2);
+      Assert::AreNotEqual(original, checksumTransforms());
+
+      gameObject.getTransform()->setScale(1, 1);
+      Assert::AreEqual(original, checksumTransforms());
+    }
+
 #pragma endregion
 
   };
@@ -0,0 +1,131 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Memory/Allocators/AlignedAllocator.h"
+
+#include "glm/glm.hpp"
+
+using namespace Celeste;
+
+
+namespace TestCeleste
+{
+  CELESTE_TEST_CLASS(TestAlignedAllocator)
+
+#pragma region Allocate Aligned Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AlignedAllocator_AllocateAligned_ReturnsMemoryAlignedToInputtedAlignment)
+  {
+    AlignedAllocator allocator;
+
+    for (size_t alignment : { 1, 2, 4, 8, 16, 32, 64, 128 })
+    {
+      void* memory = allocator.allocateAligned(7, alignment);
+
+      Assert::IsNotNull(memory);
+      Assert::AreEqual((size_t)0, reinterpret_cast<size_t>(memory) % alignment);
+
+      allocator.freeAligned(memory);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AlignedAllocator_AllocateAlignedTyped_DefaultsToSimdAlignment)
+  {
+    AlignedAllocator allocator;
+    float* memory = allocator.allocateAligned<float>(8);
+
+    Assert::IsNotNull(memory);
+    Assert::AreEqual((size_t)0, reinterpret_cast<size_t>(memory) % AlignedAllocator::SIMD_ALIGNMENT);
+
+    allocator.freeAligned(memory);
+  }
+
+#pragma endregion
+
+#pragma region Free Aligned Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AlignedAllocator_FreeAligned_InputtingNullptr_DoesNothing)
+  {
+    AlignedAllocator allocator;
+    size_t liveAllocations = AlignedAllocator::getLiveAllocationCount();
+
+    allocator.freeAligned(nullptr);
+
+    Assert::AreEqual(liveAllocations, AlignedAllocator::getLiveAllocationCount());
+  }
+
+#if _DEBUG
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AlignedAllocator_FreeAligned_TracksLiveAllocationsInDebug)
+  {
+    AlignedAllocator allocator;
+    size_t liveAllocations = AlignedAllocator::getLiveAllocationCount();
+
+    void* memory = allocator.allocateAligned(16, 32);
+
+    Assert::AreEqual(liveAllocations + 1, AlignedAllocator::getLiveAllocationCount());
+
+    allocator.freeAligned(memory);
+
+    Assert::AreEqual(liveAllocations, AlignedAllocator::getLiveAllocationCount());
+  }
+#endif
+
+#pragma endregion
+
+#pragma region Aligned Vector Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AlignedVector_Mat4_StorageIsSimdAligned)
+  {
+    AlignedVector<glm::mat4> matrices;
+
+    for (int i = 0; i < 100; ++i)
+    {
+      matrices.push_back(glm::mat4(static_cast<float>(i)));
+      Assert::AreEqual((size_t)0, reinterpret_cast<size_t>(matrices.data()) % AlignedAllocator::SIMD_ALIGNMENT);
+    }
+
+    Assert::AreEqual(99.0f, matrices.back()[0][0]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AlignedVector_WithCacheLineAlignment_StorageIsCacheLineAligned)
+  {
+    AlignedVector<float, AlignedAllocator::CACHE_LINE_ALIGNMENT> values(33, 1.0f);
+
+    Assert::AreEqual((size_t)0, reinterpret_cast<size_t>(values.data()) % AlignedAllocator::CACHE_LINE_ALIGNMENT);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AlignedStlAllocator_Allocate_SizeInBytesOverflows_ThrowsBadAlloc)
+  {
+    AlignedStlAllocator<glm::mat4> allocator;
+    bool threw = false;
+
+    try
+    {
+      allocator.allocate(std::numeric_limits<size_t>::max() / sizeof(glm::mat4) + 1);
+    }
+    catch (const std::bad_alloc&)
+    {
+      threw = true;
+    }
+
+    Assert::IsTrue(threw);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AlignedAllocator_TypedAllocateAligned_SizeInBytesOverflows_ReturnsNullptr)
+  {
+    AlignedAllocator allocator;
+
+    Assert::IsNull(allocator.allocateAligned<glm::mat4>(std::numeric_limits<size_t>::max() / sizeof(glm::mat4) + 1));
+  }
+
+#pragma endregion
+
+  };
+}
@@ -0,0 +1,174 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Memory/Allocators/ConcurrentDoubleBufferAllocator.h"
+
+#include <thread>
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+
+using namespace Celeste;
+
+
+namespace TestCeleste
+{
+  CELESTE_TEST_CLASS(TestConcurrentDoubleBufferAllocator)
+
+#pragma region Copy Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(ConcurrentDoubleBufferAllocator_Copy_PassingNullptr_ReturnsFalse)
+    {
+      ConcurrentDoubleBufferAllocator<int, 1024> allocator;
+
+      Assert::IsFalse(allocator.copy(5, nullptr));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(ConcurrentDoubleBufferAllocator_Copy_AllocatingSizeLargerThanBufferSize_ReturnsFalse)
+    {
+      ConcurrentDoubleBufferAllocator<int, 4> allocator;
+      int data[5] = { 0, 1, 2, 3, 4 };
+
+      Assert::IsFalse(allocator.copy(5, data));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(ConcurrentDoubleBufferAllocator_Copy_BufferFull_ReturnsFalse_IncrementsDroppedCount)
+    {
+      ConcurrentDoubleBufferAllocator<int, 4> allocator;
+      int data[3] = { 0, 1, 2 };
+
+      Assert::IsTrue(allocator.copy(3, data));
+      Assert::AreEqual(static_cast<size_t>(0), allocator.getDroppedCount());
+      Assert::IsFalse(allocator.copy(2, data));
+      Assert::AreEqual(static_cast<size_t>(2), allocator.getDroppedCount());
+    }
+
+#pragma endregion
+
+#pragma region Swap Buffers Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(ConcurrentDoubleBufferAllocator_SwapBuffers_ReturnsDataWrittenSinceLastSwap)
+    {
+      ConcurrentDoubleBufferAllocator<int, 8> allocator;
+      int first[3] = { 0, 1, 2 };
+      int second[2] = { 3, 4 };
+      const int* data = nullptr;
+
+      allocator.copy(3, first);
+      allocator.copy(2, second);
+
+      Assert::AreEqual(static_cast<size_t>(5), allocator.swapBuffers(&data));
+
+      for (int i = 0; i < 5; ++i)
+      {
+        Assert::AreEqual(i, data[i]);
+      }
+
+      Assert::AreEqual(static_cast<size_t>(0), allocator.swapBuffers(&data));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(ConcurrentDoubleBufferAllocator_SwapBuffers_AfterOverflow_ReturnsOnlyValidData)
+    {
+      ConcurrentDoubleBufferAllocator<int, 4> allocator;
+      int data[3] = { 0, 1, 2 };
+      const int* buffered = nullptr;
+
+      allocator.copy(3, data);
+      allocator.copy(3, data);
+
+      Assert::AreEqual(static_cast<size_t>(3), allocator.swapBuffers(&buffered));
+
+      // The next front buffer should have been reset, so the full amount should fit again
+      Assert::IsTrue(allocator.copy(3, data));
+      Assert::AreEqual(static_cast<size_t>(3), allocator.swapBuffers(&buffered));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(ConcurrentDoubleBufferAllocator_DeallocateAll_DiscardsBothBuffers)
+    {
+      ConcurrentDoubleBufferAllocator<int, 4> allocator;
+      int data[3] = { 0, 1, 2 };
+      const int* buffered = nullptr;
+
+      allocator.copy(3, data);
+      allocator.deallocateAll();
+
+      Assert::AreEqual(static_cast<size_t>(0), allocator.swapBuffers(&buffered));
+      Assert::AreEqual(static_cast<size_t>(0), allocator.swapBuffers(&buffered));
+    }
+
+#pragma endregion
+
+#pragma region Multi Producer Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(ConcurrentDoubleBufferAllocator_MultipleProducers_NoMessagesAreTornOrLost)
+    {
+      const size_t threadCount = 8;
+      const size_t messagesPerThread = 10000;
+      const std::string message = "message\n";
+
+      // Heap allocate as the buffers are too large for the stack
+      std::unique_ptr<ConcurrentDoubleBufferAllocator<char, 4096>> allocator(new ConcurrentDoubleBufferAllocator<char, 4096>());
+      std::atomic<bool> producersFinished(false);
+      size_t receivedCharacters = 0;
+      bool allMessagesIntact = true;
+
+      // Only the main thread asserts, as the test framework cannot report failures from other threads
+
+      std::thread consumer([&]()
+      {
+        while (true)
+        {
+          bool finished = producersFinished.load();
+          const char* data = nullptr;
+          size_t count = allocator->swapBuffers(&data);
+
+          allMessagesIntact &= count % message.size() == 0;
+          for (size_t i = 0; i < count; i += message.size())
+          {
+            allMessagesIntact &= std::string(data + i, message.size()) == message;
+          }
+
+          receivedCharacters += count;
+
+          if (finished)
+          {
+            break;
+          }
+        }
+      });
+
+      std::vector<std::thread> producers;
+      for (size_t i = 0; i < threadCount; ++i)
+      {
+        producers.emplace_back([&]()
+        {
+          for (size_t j = 0; j < messagesPerThread; ++j)
+          {
+            allocator->copy(message.size(), message.data());
+          }
+        });
+      }
+
+      for (std::thread& producer : producers)
+      {
+        producer.join();
+      }
+
+      producersFinished.store(true);
+      consumer.join();
+
+      Assert::IsTrue(allMessagesIntact);
+      Assert::AreEqual(threadCount * messagesPerThread * message.size(), receivedCharacters + allocator->getDroppedCount());
+    }
+
+#pragma endregion
+
+  };
+}
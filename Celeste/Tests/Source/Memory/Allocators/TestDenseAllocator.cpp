@@ -0,0 +1,425 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+#include "UtilityMacros/Unused.h"
+
+#include "Memory/Allocators/DenseAllocator.h"
+
+#include <algorithm>
+
+using namespace Celeste;
+
+
+namespace TestCeleste
+{
+  namespace
+  {
+    struct DenseObject
+    {
+      int m_value;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    DenseObject& allocateObject(DenseAllocator<DenseObject>& allocator, int value)
+    {
+      return *new (allocator.allocate()) DenseObject{ value };
+    }
+  }
+
+  CELESTE_TEST_CLASS(TestDenseAllocator)
+
+#pragma region Is Allocated Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_IsAllocated_InputtingAllocatedObject_ShouldReturnTrue)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+    DenseObject& object = allocateObject(allocator, 1);
+
+    Assert::AreEqual((size_t)1, allocator.size());
+    Assert::IsTrue(allocator.isAllocated(object));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_IsAllocated_InputtingDeallocatedObject_ShouldReturnFalse)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+    DenseObject& object = allocateObject(allocator, 1);
+    allocator.deallocate(object);
+
+    Assert::AreEqual((size_t)0, allocator.size());
+    Assert::IsFalse(allocator.isAllocated(object));
+    Assert::IsTrue(allocator.contains(object));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_IsAllocated_InputtingObjectNotFromAllocator_ShouldReturnFalse)
+  {
+    DenseObject object{ 1 };
+    DenseAllocator<DenseObject> allocator(10);
+
+    Assert::IsFalse(allocator.contains(object));
+    Assert::IsFalse(allocator.isAllocated(object));
+  }
+
+#pragma endregion
+
+#pragma region Allocate Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_Allocate_ReturnsNextPositionInPackedArray)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+    DenseObject& object = allocateObject(allocator, 1);
+    DenseObject& object2 = allocateObject(allocator, 2);
+
+    Assert::IsTrue(&object == &allocator[0]);
+    Assert::IsTrue(&object2 == &allocator[1]);
+    Assert::IsTrue(&object + 1 == &object2);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_Allocate_WithNotEnoughCapacity_DoublesCapacityAndMovesObjects)
+  {
+    DenseAllocator<DenseObject> allocator(1);
+    Handle<DenseObject> handle = allocator.getHandle(allocateObject(allocator, 1));
+    Handle<DenseObject> handle2 = allocator.getHandle(allocateObject(allocator, 2));
+    Handle<DenseObject> handle3 = allocator.getHandle(allocateObject(allocator, 3));
+
+    Assert::AreEqual((size_t)3, allocator.size());
+    Assert::AreEqual((size_t)4, allocator.capacity());
+
+    // Every object was moved into the new array, and the handles followed them
+    Assert::AreEqual(1, allocator[0].m_value);
+    Assert::AreEqual(2, allocator[1].m_value);
+    Assert::AreEqual(3, allocator[2].m_value);
+    Assert::IsTrue(&allocator[0] == allocator.resolve(handle));
+    Assert::IsTrue(&allocator[1] == allocator.resolve(handle2));
+    Assert::IsTrue(&allocator[2] == allocator.resolve(handle3));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_Allocate_PreviouslyDeallocatedObject_ObjectReallocated)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+    DenseObject& object = allocateObject(allocator, 1);
+    allocator.deallocate(object);
+
+    observer_ptr<DenseObject> object2 = allocator.allocate();
+
+    Assert::IsTrue(&object == object2);
+    Assert::IsTrue(allocator.isAllocated(object));
+  }
+
+#pragma endregion
+
+#pragma region Deallocate Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_Deallocate_InputtingAlreadyDeallocatedObject_ReturnsFalse)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+    DenseObject& object = allocateObject(allocator, 1);
+
+    Assert::IsTrue(allocator.deallocate(object));
+    Assert::IsFalse(allocator.deallocate(object));
+    Assert::AreEqual((size_t)0, allocator.size());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_Deallocate_InputtingObjectNotFromAllocator_ReturnsFalse)
+  {
+    DenseObject object{ 1 };
+    DenseAllocator<DenseObject> allocator(10);
+
+    Assert::IsFalse(allocator.deallocate(object));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_Deallocate_MovesLastObjectIntoHole)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+    Handle<DenseObject> first = allocator.getHandle(allocateObject(allocator, 1));
+    Handle<DenseObject> second = allocator.getHandle(allocateObject(allocator, 2));
+    Handle<DenseObject> third = allocator.getHandle(allocateObject(allocator, 3));
+
+    allocator.deallocate(allocator[0]);
+
+    Assert::AreEqual((size_t)2, allocator.size());
+    Assert::AreEqual(3, allocator[0].m_value);
+    Assert::AreEqual(2, allocator[1].m_value);
+    Assert::IsNull(allocator.resolve(first));
+    Assert::IsTrue(&allocator[1] == allocator.resolve(second));
+    Assert::IsTrue(&allocator[0] == allocator.resolve(third));
+
+    // The moved object must still be tracked correctly
+    Assert::IsTrue(allocator.deallocate(*allocator.resolve(third)));
+    Assert::AreEqual(2, allocator[0].m_value);
+    Assert::IsTrue(&allocator[0] == allocator.resolve(second));
+    Assert::AreEqual((size_t)1, allocator.size());
+  }
+
+#pragma endregion
+
+#pragma region Deallocate All Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_DeallocateAll_DeallocatesAllObjectsAndInvalidatesHandles)
+  {
+    DenseAllocator<DenseObject> allocator(1);
+    Handle<DenseObject> handle = allocator.getHandle(allocateObject(allocator, 1));
+    Handle<DenseObject> handle2 = allocator.getHandle(allocateObject(allocator, 2));
+
+    allocator.deallocateAll();
+
+    Assert::AreEqual((size_t)0, allocator.size());
+    Assert::IsFalse(allocator.isAllocated(allocator[0]));
+    Assert::IsNull(allocator.resolve(handle));
+    Assert::IsNull(allocator.resolve(handle2));
+    Assert::IsTrue(&allocator[0] == allocator.allocate());
+  }
+
+#pragma endregion
+
+#pragma region Foreach Iteration Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_ForeachIteration_WithNoAllocation_DoesNoIteration)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+
+    int count = 0;
+    for (DenseObject& item : allocator)
+    {
+      UNUSED(item);
+      count++;
+    }
+
+    Assert::AreEqual(0, count);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_ForeachIteration_OnlyIteratesOverAllocatedObjects)
+  {
+    DenseAllocator<DenseObject> allocator(2);
+    std::vector<Handle<DenseObject>> handles;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      handles.push_back(allocator.getHandle(allocateObject(allocator, i)));
+    }
+
+    allocator.deallocate(*allocator.resolve(handles[2]));
+    allocator.deallocate(*allocator.resolve(handles[7]));
+
+    int count = 0;
+    int sum = 0;
+    for (const DenseObject& item : static_cast<const DenseAllocator<DenseObject>&>(allocator))
+    {
+      Assert::IsTrue(allocator.isAllocated(item));
+      sum += item.m_value;
+      count++;
+    }
+
+    Assert::AreEqual(8, count);
+    Assert::AreEqual(45 - 2 - 7, sum);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_ForeachIteration_DeallocatingCurrentObject_DoesNotRunOffEnd)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+    allocateObject(allocator, 0);
+    allocateObject(allocator, 1);
+    allocateObject(allocator, 2);
+
+    int count = 0;
+    for (DenseObject& item : allocator)
+    {
+      allocator.deallocate(item);
+      count++;
+    }
+
+    // Iteration walks backwards, so the object moved into the current position has already been visited
+    Assert::AreEqual(3, count);
+    Assert::AreEqual((size_t)0, allocator.size());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_ForeachIteration_DeallocatingCurrentObject_VisitsEveryOtherObjectOnce)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+
+    for (int i = 0; i < 6; ++i)
+    {
+      allocateObject(allocator, i);
+    }
+
+    std::vector<int> visited;
+    for (DenseObject& item : allocator)
+    {
+      visited.push_back(item.m_value);
+
+      if (item.m_value == 2)
+      {
+        allocator.deallocate(item);
+      }
+    }
+
+    Assert::AreEqual((size_t)6, visited.size());
+    Assert::AreEqual((size_t)5, allocator.size());
+
+    for (int i = 0; i < 6; ++i)
+    {
+      Assert::AreEqual((std::ptrdiff_t)1, std::count(visited.begin(), visited.end(), i));
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_ForeachIteration_DeallocateAllMidIteration_EndsIteration)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+    allocateObject(allocator, 0);
+    allocateObject(allocator, 1);
+    allocateObject(allocator, 2);
+
+    int count = 0;
+    for (DenseObject& item : allocator)
+    {
+      UNUSED(item);
+      allocator.deallocateAll();
+      count++;
+    }
+
+    Assert::AreEqual(1, count);
+  }
+
+#pragma endregion
+
+#pragma region Handle Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_Resolve_InputtingHandleToReallocatedSlot_ReturnsNullptr)
+  {
+    DenseAllocator<DenseObject> allocator(1);
+    allocateObject(allocator, 0);
+    DenseObject& object = allocateObject(allocator, 1);
+    Handle<DenseObject> handle = allocator.getHandle(object);
+
+    Assert::IsTrue(&object == allocator.resolve(handle));
+
+    allocator.deallocate(object);
+
+    Assert::IsTrue(&object == allocator.allocate());
+    Assert::IsNull(allocator.resolve(handle));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_GetHandle_InputtingObjectNotFromAllocator_ReturnsNullHandle)
+  {
+    DenseObject object{ 1 };
+    DenseAllocator<DenseObject> allocator(10);
+
+    Assert::IsTrue(allocator.getHandle(object).isNull());
+  }
+
+#pragma endregion
+
+#pragma region Find Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_Find_ReturnsFirstMatchingObject)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+    allocateObject(allocator, 0);
+    DenseObject& object = allocateObject(allocator, 1);
+
+    Assert::IsTrue(&object == allocator.find([](const DenseObject& item) { return item.m_value == 1; }));
+    Assert::IsNull(allocator.find([](const DenseObject&) { return false; }));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_FindAll_ReturnsAllMatchingObjects)
+  {
+    DenseAllocator<DenseObject> allocator(10);
+    allocateObject(allocator, 0);
+    allocateObject(allocator, 1);
+
+    std::vector<std::reference_wrapper<DenseObject>> foundObjects;
+    allocator.findAll([](const DenseObject&) { return true; }, foundObjects);
+
+    Assert::AreEqual((size_t)2, foundObjects.size());
+  }
+
+#pragma endregion
+
+#pragma region Reserve Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_Reserve_InputtingCapacityGreaterThanCurrent_GrowsToThatCapacity)
+  {
+    DenseAllocator<DenseObject> allocator(2);
+    allocateObject(allocator, 7);
+    allocator.reserve(10);
+
+    Assert::AreEqual((size_t)10, allocator.capacity());
+    Assert::AreEqual((size_t)1, allocator.getStats().m_reserveCount);
+    Assert::AreEqual(7, allocator[0].m_value);
+
+    for (size_t i = 1; i < 10; ++i)
+    {
+      allocator.allocate();
+    }
+
+    // Reserving is not running out of space, so filling the reserved capacity never counts as growing
+    Assert::AreEqual((size_t)0, allocator.getStats().m_growCount);
+    Assert::AreEqual((size_t)1, allocator.getStats().m_reserveCount);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_Reserve_InputtingCapacityLessThanCurrent_DoesNothing)
+  {
+    DenseAllocator<DenseObject> allocator(4);
+    allocator.reserve(2);
+
+    Assert::AreEqual((size_t)4, allocator.capacity());
+    Assert::AreEqual((size_t)0, allocator.getStats().m_growCount);
+    Assert::AreEqual((size_t)0, allocator.getStats().m_reserveCount);
+  }
+
+#pragma endregion
+
+#pragma region Stats Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_GetStats_TracksLiveCountAndHighWaterMark)
+  {
+    DenseAllocator<DenseObject> allocator(4);
+    DenseObject& first = allocateObject(allocator, 0);
+    allocateObject(allocator, 1);
+    allocator.deallocate(first);
+
+    AllocatorStats stats = allocator.getStats();
+
+    Assert::AreEqual((size_t)4, stats.m_capacity);
+    Assert::AreEqual((size_t)1, stats.m_liveCount);
+    Assert::AreEqual((size_t)2, stats.m_highWaterMark);
+    Assert::AreEqual((size_t)2, stats.m_allocationCount);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(DenseAllocator_GetStats_Grown_IncrementsGrowCount)
+  {
+    DenseAllocator<DenseObject> allocator(1);
+    allocator.allocate();
+
+    Assert::AreEqual((size_t)0, allocator.getStats().m_growCount);
+
+    allocator.allocate();
+
+    Assert::AreEqual((size_t)1, allocator.getStats().m_growCount);
+    Assert::AreEqual((size_t)2, allocator.getStats().m_capacity);
+  }
+
+#pragma endregion
+
+  };
+}
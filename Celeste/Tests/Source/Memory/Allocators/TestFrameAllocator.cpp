@@ -0,0 +1,146 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Memory/Allocators/FrameAllocator.h"
+
+#include <unordered_set>
+
+using namespace Celeste;
+
+
+namespace TestCeleste
+{
+  CELESTE_TEST_CLASS(TestFrameAllocator)
+
+#pragma region Constructor Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(FrameAllocator_Constructor_SetsCapacityAndNothingUsed)
+  {
+    FrameAllocator allocator(1024);
+
+    Assert::AreEqual((size_t)1024, allocator.getCapacity());
+    Assert::AreEqual((size_t)0, allocator.getUsed());
+    Assert::AreEqual((size_t)0, allocator.getHighWaterMark());
+  }
+
+#pragma endregion
+
+#pragma region Allocate Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(FrameAllocator_Allocate_ReturnsAlignedMemory)
+  {
+    FrameAllocator allocator(1024);
+    allocator.allocate(1, 1);
+
+    for (size_t alignment : { 2, 4, 8, 16, 32, 64 })
+    {
+      void* memory = allocator.allocate(3, alignment);
+
+      Assert::IsNotNull(memory);
+      Assert::AreEqual((size_t)0, reinterpret_cast<size_t>(memory) % alignment);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(FrameAllocator_Allocate_ReturnsDistinctNonOverlappingMemory)
+  {
+    FrameAllocator allocator(1024);
+    char* first = static_cast<char*>(allocator.allocate(16, 1));
+    char* second = static_cast<char*>(allocator.allocate(16, 1));
+
+    Assert::IsTrue(second >= first + 16);
+    Assert::AreEqual((size_t)32, allocator.getUsed());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(FrameAllocator_Allocate_MoreThanCapacity_StillReturnsMemory)
+  {
+    FrameAllocator allocator(16);
+
+    Assert::IsNotNull(allocator.allocate(8, 1));
+    Assert::IsNotNull(allocator.allocate(64, 1));
+    Assert::IsTrue(allocator.getUsed() > 16);
+  }
+
+#pragma endregion
+
+#pragma region Reset Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(FrameAllocator_Reset_ReusesMemoryAndKeepsHighWaterMark)
+  {
+    FrameAllocator allocator(1024);
+    void* first = allocator.allocate(100, 1);
+    allocator.allocate(100, 1);
+
+    allocator.reset();
+
+    Assert::AreEqual((size_t)0, allocator.getUsed());
+    Assert::AreEqual((size_t)200, allocator.getHighWaterMark());
+    Assert::IsTrue(first == allocator.allocate(100, 1));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(FrameAllocator_Reset_AfterOverflowing_GrowsCapacityToHighWaterMark)
+  {
+    FrameAllocator allocator(16);
+    allocator.allocate(8, 1);
+    allocator.allocate(100, 1);
+
+    allocator.reset();
+
+    Assert::IsTrue(allocator.getCapacity() >= allocator.getHighWaterMark());
+    Assert::IsTrue(allocator.getCapacity() >= 108);
+  }
+
+#pragma endregion
+
+#pragma region Stl Adaptor Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(FrameStlAllocator_FrameVector_AllocatesFromInputtedFrameAllocator)
+  {
+    FrameAllocator allocator(1024);
+
+    FrameVector<int> vector(allocator);
+    vector.reserve(100);
+    
+    for (int i = 0; i < 100; ++i)
+    {
+      vector.push_back(i);
+    }
+
+    Assert::AreEqual((size_t)100, vector.size());
+    Assert::AreEqual(99, vector.back());
+    Assert::IsTrue(allocator.getUsed() >= 100 * sizeof(int));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(FrameStlAllocator_CanBeUsedWithNodeBasedContainers)
+  {
+    FrameAllocator allocator(1024);
+
+    std::unordered_set<int, std::hash<int>, std::equal_to<int>, FrameStlAllocator<int>> set(allocator);
+    set.insert(1);
+    set.insert(2);
+    set.insert(1);
+
+    Assert::AreEqual((size_t)2, set.size());
+    Assert::IsTrue(allocator.getUsed() > 0);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(FrameStlAllocator_Equality_ComparesFrameAllocators)
+  {
+    FrameAllocator first(16);
+    FrameAllocator second(16);
+
+    Assert::IsTrue(FrameStlAllocator<int>(first) == FrameStlAllocator<float>(first));
+    Assert::IsTrue(FrameStlAllocator<int>(first) != FrameStlAllocator<int>(second));
+  }
+
+#pragma endregion
+
+  };
+}
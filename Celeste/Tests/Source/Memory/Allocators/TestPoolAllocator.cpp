@@ -7,6 +7,8 @@
 #include "UtilityMacros/Unused.h"
 
 #include <vector>
+#include <chrono>
+#include <string>
 
 using namespace Celeste;
 
@@ -277,6 +279,140 @@ namespace TestCeleste
       Assert::AreEqual(500, count);
     }
 
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocator_IterateSlotRange_WithUnalignedLastSlot_OnlyIteratesOverSlotsInRange)
+    {
+      PoolAllocator<MockComponent> pool(256);
+      std::vector<observer_ptr<MockComponent>> objects;
+
+      for (int i = 0; i < 200; ++i)
+      {
+        objects.push_back(pool.allocate());
+      }
+
+      int count = 0;
+      for (auto it = pool.begin(64, 100), endIt = pool.end(100); it != endIt; ++it)
+      {
+        Assert::IsTrue(objects[64 + count] == &*it);
+        count++;
+      }
+
+      // Slots 100 to 127 share the last word of the range and are allocated, but must not be visited
+      Assert::AreEqual(36, count);
+    }
+
+#pragma endregion
+
+#pragma region Handle Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocator_GetHandle_InputtingUnallocatedObject_ReturnsNullHandle)
+    {
+      GameObject gameObject;
+      MockComponent object(gameObject);
+      PoolAllocator<MockComponent> pool(1024);
+
+      Assert::IsTrue(pool.getHandle(object).isNull());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocator_Resolve_InputtingHandleToAllocatedObject_ReturnsObject)
+    {
+      PoolAllocator<MockComponent> pool(1024);
+      pool.allocate();
+      observer_ptr<MockComponent> object = pool.allocate();
+
+      Handle<MockComponent> handle = pool.getHandle(*object);
+
+      Assert::IsFalse(handle.isNull());
+      Assert::AreEqual(object, pool.resolve(handle));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocator_Resolve_InputtingHandleToReallocatedSlot_ReturnsNullptr)
+    {
+      PoolAllocator<MockComponent> pool(1024);
+      observer_ptr<MockComponent> object = pool.allocate();
+      Handle<MockComponent> handle = pool.getHandle(*object);
+
+      pool.deallocate(*object);
+
+      Assert::IsNull(pool.resolve(handle));
+
+      // The slot is reused, but the old handle must not resolve to the new object
+      Assert::AreEqual(object, pool.allocate());
+      Assert::IsNull(pool.resolve(handle));
+      Assert::AreEqual(object, pool.resolve(pool.getHandle(*object)));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocator_Resolve_AfterDeallocateAll_ReturnsNullptr)
+    {
+      PoolAllocator<MockComponent> pool(1024);
+      Handle<MockComponent> handle = pool.getHandle(*pool.allocate());
+
+      pool.deallocateAll();
+      pool.allocate();
+
+      Assert::IsNull(pool.resolve(handle));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocator_Resolve_InputtingNullHandle_ReturnsNullptr)
+    {
+      PoolAllocator<MockComponent> pool(1024);
+      pool.allocate();
+
+      Assert::IsNull(pool.resolve(Handle<MockComponent>()));
+    }
+
+#pragma endregion
+
+#pragma region Benchmark Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocator_Benchmark_SpawnAndDestroy100kObjects)
+    {
+      const size_t objectCount = 100000;
+      PoolAllocator<MockComponent> pool(objectCount);
+      std::vector<MockComponent*> objects;
+      objects.reserve(objectCount);
+
+      auto start = std::chrono::high_resolution_clock::now();
+
+      for (size_t i = 0; i < objectCount; ++i)
+      {
+        objects.push_back(pool.allocate());
+      }
+
+      Assert::AreEqual(objectCount, pool.size());
+
+      // Destroy every other object, then respawn into the holes so the free list is exercised out of order
+      for (size_t i = 0; i < objectCount; i += 2)
+      {
+        Assert::IsTrue(pool.deallocate(*objects[i]));
+      }
+
+      for (size_t i = 0; i < objectCount; i += 2)
+      {
+        objects[i] = pool.allocate();
+        Assert::IsNotNull(objects[i]);
+      }
+
+      Assert::AreEqual(objectCount, pool.size());
+      Assert::IsNull(pool.allocate());
+
+      for (MockComponent* object : objects)
+      {
+        Assert::IsTrue(pool.deallocate(*object));
+      }
+
+      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+      Assert::AreEqual((size_t)0, pool.size());
+      Logger::WriteMessage(("Spawned and destroyed 100k objects in " + std::to_string(elapsed.count()) + "ms").c_str());
+    }
+
 #pragma endregion
 
   };
@@ -960,6 +960,51 @@ namespace TestCeleste
 
 #pragma endregion
 
+#pragma region Handle Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResizeableAllocator_Resolve_InputtingHandleToObjectInLaterPool_ReturnsObject)
+  {
+    ResizeableAllocator<MockComponent> allocator(2);
+    allocator.allocate();
+    allocator.allocate();
+    observer_ptr<MockComponent> object = allocator.allocate();
+
+    Handle<MockComponent> handle = allocator.getHandle(*object);
+
+    Assert::IsFalse(handle.isNull());
+    Assert::AreEqual((size_t)2, handle.getIndex());
+    Assert::AreEqual(object, allocator.resolve(handle));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResizeableAllocator_Resolve_InputtingHandleToReallocatedSlot_ReturnsNullptr)
+  {
+    ResizeableAllocator<MockComponent> allocator(2);
+    allocator.allocate();
+    allocator.allocate();
+    observer_ptr<MockComponent> object = allocator.allocate();
+    Handle<MockComponent> handle = allocator.getHandle(*object);
+
+    allocator.deallocate(*object);
+
+    Assert::IsNull(allocator.resolve(handle));
+    Assert::AreEqual(object, allocator.allocate());
+    Assert::IsNull(allocator.resolve(handle));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResizeableAllocator_Resolve_InputtingHandleOutsideOfPools_ReturnsNullptr)
+  {
+    ResizeableAllocator<MockComponent> allocator(2);
+    allocator.allocate();
+
+    Assert::IsNull(allocator.resolve(Handle<MockComponent>(100, 0)));
+    Assert::IsNull(allocator.resolve(Handle<MockComponent>()));
+  }
+
+#pragma endregion
+
 #pragma region Deallocate All Tests
 
   //------------------------------------------------------------------------------------------------
@@ -1016,6 +1061,119 @@ namespace TestCeleste
     Assert::IsFalse(allocator.isAllocated(*ptr3));
   }
 
+#pragma endregion
+
+#pragma region Reserve Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResizeableAllocator_Reserve_InputtingCapacityLessThanCurrent_DoesNothing)
+  {
+    ResizeableAllocator<MockComponent> allocator(4);
+    allocator.reserve(2);
+
+    Assert::AreEqual((size_t)4, allocator.capacity());
+    Assert::AreEqual((size_t)0, allocator.getStats().m_growCount);
+    Assert::AreEqual((size_t)0, allocator.getStats().m_reserveCount);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResizeableAllocator_Reserve_InputtingCapacityGreaterThanCurrent_AddsSinglePoolForShortfall)
+  {
+    ResizeableAllocator<MockComponent> allocator(2);
+    allocator.reserve(10);
+
+    Assert::AreEqual((size_t)10, allocator.capacity());
+    Assert::AreEqual((size_t)1, allocator.getStats().m_reserveCount);
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+      allocator.allocate();
+    }
+
+    // Reserving is not running out of space, so filling the reserved capacity never counts as growing
+    Assert::AreEqual((size_t)0, allocator.getStats().m_growCount);
+    Assert::AreEqual((size_t)1, allocator.getStats().m_reserveCount);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResizeableAllocator_Reserve_HandlesToObjectsInReservedPool_Resolve)
+  {
+    ResizeableAllocator<MockComponent> allocator(2);
+    allocator.reserve(10);
+
+    observer_ptr<MockComponent> object = nullptr;
+    for (size_t i = 0; i < 6; ++i)
+    {
+      object = allocator.allocate();
+    }
+
+    // Objects allocated after the reserved pool should still resolve correctly
+    allocator.reserve(12);
+    observer_ptr<MockComponent> laterObject = nullptr;
+    for (size_t i = 0; i < 5; ++i)
+    {
+      laterObject = allocator.allocate();
+    }
+
+    Handle<MockComponent> handle = allocator.getHandle(*object);
+    Handle<MockComponent> laterHandle = allocator.getHandle(*laterObject);
+
+    Assert::AreEqual((size_t)5, handle.getIndex());
+    Assert::AreEqual((size_t)10, laterHandle.getIndex());
+    Assert::AreEqual(object, allocator.resolve(handle));
+    Assert::AreEqual(laterObject, allocator.resolve(laterHandle));
+  }
+
+#pragma endregion
+
+#pragma region Stats Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResizeableAllocator_GetStats_TracksLiveCountAndHighWaterMark)
+  {
+    ResizeableAllocator<MockComponent> allocator(4);
+    observer_ptr<MockComponent> first = allocator.allocate();
+    allocator.allocate();
+    allocator.allocate();
+    allocator.deallocate(*first);
+
+    AllocatorStats stats = allocator.getStats();
+
+    Assert::AreEqual((size_t)4, stats.m_capacity);
+    Assert::AreEqual((size_t)2, stats.m_liveCount);
+    Assert::AreEqual((size_t)3, stats.m_highWaterMark);
+    Assert::AreEqual((size_t)3, stats.m_allocationCount);
+    Assert::AreEqual((size_t)0, stats.m_growCount);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResizeableAllocator_GetStats_ResizeOccurred_IncrementsGrowCount)
+  {
+    ResizeableAllocator<MockComponent> allocator(1);
+    allocator.allocate();
+    allocator.allocate();
+    allocator.allocate();
+
+    AllocatorStats stats = allocator.getStats();
+
+    Assert::AreEqual((size_t)3, stats.m_capacity);
+    Assert::AreEqual((size_t)2, stats.m_growCount);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(ResizeableAllocator_GetStats_AfterDeallocateAll_KeepsHighWaterMark)
+  {
+    ResizeableAllocator<MockComponent> allocator(2);
+    allocator.allocate();
+    allocator.allocate();
+    allocator.deallocateAll();
+
+    AllocatorStats stats = allocator.getStats();
+
+    Assert::AreEqual((size_t)0, stats.m_liveCount);
+    Assert::AreEqual((size_t)2, stats.m_highWaterMark);
+  }
+
 #pragma endregion
 
   };
@@ -2,8 +2,14 @@
 
 #include "Memory/Allocators/PoolAllocator.h"
 #include "Memory/Iterators/PoolAllocatorIterator.h"
+#include "UtilityMacros/Unused.h"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
 
 using namespace Celeste;
 
@@ -18,9 +24,9 @@ namespace TestCeleste
   TEST_METHOD(PoolAllocatorIterator_SkipsDeallocatedObjects)
   {
     std::array<int, 3> objects;
-    std::array<bool, 3> allocated{ true, false, true };
+    uint64_t allocated = 0b101;
 
-    PoolAllocatorIterator<const int> it(objects.data(), allocated.data(), 3);
+    PoolAllocatorIterator<const int> it(objects.data(), &allocated, 3);
       
     Assert::AreSame(*it, objects[0]);
 
@@ -33,9 +39,9 @@ namespace TestCeleste
   TEST_METHOD(PoolAllocatorIterator_IteratesOverObjects)
   {
     std::array<int, 3> objects;
-    std::array<bool, 3> allocated{ true, true, true };
+    uint64_t allocated = 0b111;
 
-    PoolAllocatorIterator<const int> it(objects.data(), allocated.data(), 3);
+    PoolAllocatorIterator<const int> it(objects.data(), &allocated, 3);
 
     // Iterate with 3 allocated objects should stop at the last one
     {
@@ -63,11 +69,11 @@ namespace TestCeleste
     TEST_METHOD(PoolAllocatorIterator_EqualityOperator_ShouldReturnTrue)
     {
       std::array<int, 3> objects;
-      std::array<bool, 3> allocated{ true, true, true };
+      uint64_t allocated = 0b111;
 
-      PoolAllocatorIterator<const int> it(objects.data() + 1, allocated.data(), 3);
-      PoolAllocatorIterator<const int> it2(objects.data() + 1, allocated.data(), 3);
-      PoolAllocatorIterator<const int> it3(objects.data(), allocated.data(), 3);
+      PoolAllocatorIterator<const int> it(objects.data() + 1, &allocated, 3);
+      PoolAllocatorIterator<const int> it2(objects.data() + 1, &allocated, 3);
+      PoolAllocatorIterator<const int> it3(objects.data(), &allocated, 3);
       ++it3;
 
       Assert::IsTrue(it == it2);
@@ -78,11 +84,11 @@ namespace TestCeleste
     TEST_METHOD(PoolAllocatorIterator_EqualityOperator_ShouldReturnFalse)
     {
       std::array<int, 3> objects;
-      std::array<bool, 3> allocated{ true, true, true };
+      uint64_t allocated = 0b111;
 
-      PoolAllocatorIterator<const int> it(objects.data(), allocated.data(), 3);
-      PoolAllocatorIterator<const int> it2(objects.data() + 1, allocated.data(), 3);
-      PoolAllocatorIterator<const int> it3(objects.data(), allocated.data(), 3);
+      PoolAllocatorIterator<const int> it(objects.data(), &allocated, 3);
+      PoolAllocatorIterator<const int> it2(objects.data() + 1, &allocated, 3);
+      PoolAllocatorIterator<const int> it3(objects.data(), &allocated, 3);
       ++it3;
 
       Assert::IsFalse(it == it2);
@@ -93,9 +99,9 @@ namespace TestCeleste
     TEST_METHOD(PoolAllocatorIterator_EqualityOperator_Reflexivity_ShouldReturnTrue)
     {
       std::array<int, 3> objects;
-      std::array<bool, 3> allocated{ true, true, true };
+      uint64_t allocated = 0b111;
 
-      PoolAllocatorIterator<const int> it(objects.data(), allocated.data(), 3);
+      PoolAllocatorIterator<const int> it(objects.data(), &allocated, 3);
 
       Assert::IsTrue(it == it);
     }
@@ -104,10 +110,10 @@ namespace TestCeleste
     TEST_METHOD(PoolAllocatorIterator_EqualityOperator_IsSymmetric)
     {
       std::array<int, 3> objects;
-      std::array<bool, 3> allocated{ true, true, true };
+      uint64_t allocated = 0b111;
 
-      PoolAllocatorIterator<const int> it(objects.data(), allocated.data(), 3);
-      PoolAllocatorIterator<const int> it2(objects.data(), allocated.data(), 3);
+      PoolAllocatorIterator<const int> it(objects.data(), &allocated, 3);
+      PoolAllocatorIterator<const int> it2(objects.data(), &allocated, 3);
 
       Assert::IsTrue(it == it2);
       Assert::IsTrue(it2 == it);
@@ -117,11 +123,11 @@ namespace TestCeleste
     TEST_METHOD(PoolAllocatorIterator_EqualityOperator_IsTransitive)
     {
       std::array<int, 3> objects;
-      std::array<bool, 3> allocated{ true, true, true };
+      uint64_t allocated = 0b111;
 
-      PoolAllocatorIterator<const int> it(objects.data() + 1, allocated.data(), 3);
-      PoolAllocatorIterator<const int> it2(objects.data() + 1, allocated.data(), 3);
-      PoolAllocatorIterator<const int> it3(objects.data(), allocated.data(), 3);
+      PoolAllocatorIterator<const int> it(objects.data() + 1, &allocated, 3);
+      PoolAllocatorIterator<const int> it2(objects.data() + 1, &allocated, 3);
+      PoolAllocatorIterator<const int> it3(objects.data(), &allocated, 3);
       ++it3;
 
       // a == b
@@ -142,11 +148,11 @@ namespace TestCeleste
     TEST_METHOD(PoolAllocatorIterator_InequalityOperator_ShouldReturnTrue)
     {
       std::array<int, 3> objects;
-      std::array<bool, 3> allocated{ true, true, true };
+      uint64_t allocated = 0b111;
 
-      PoolAllocatorIterator<const int> it(objects.data(), allocated.data(), 3);
-      PoolAllocatorIterator<const int> it2(objects.data() + 1, allocated.data(), 3);
-      PoolAllocatorIterator<const int> it3(objects.data(), allocated.data(), 3);
+      PoolAllocatorIterator<const int> it(objects.data(), &allocated, 3);
+      PoolAllocatorIterator<const int> it2(objects.data() + 1, &allocated, 3);
+      PoolAllocatorIterator<const int> it3(objects.data(), &allocated, 3);
       ++it3;
 
       Assert::IsTrue(it != it2);
@@ -157,11 +163,11 @@ namespace TestCeleste
     TEST_METHOD(PoolAllocatorIterator_InequalityOperator_ShouldReturnFalse)
     {
       std::array<int, 3> objects;
-      std::array<bool, 3> allocated{ true, true, true };
+      uint64_t allocated = 0b111;
 
-      PoolAllocatorIterator<const int> it(objects.data() + 1, allocated.data(), 3);
-      PoolAllocatorIterator<const int> it2(objects.data() + 1, allocated.data(), 3);
-      PoolAllocatorIterator<const int> it3(objects.data(), allocated.data(), 3);
+      PoolAllocatorIterator<const int> it(objects.data() + 1, &allocated, 3);
+      PoolAllocatorIterator<const int> it2(objects.data() + 1, &allocated, 3);
+      PoolAllocatorIterator<const int> it3(objects.data(), &allocated, 3);
       ++it3;
 
       Assert::IsFalse(it != it2);
@@ -172,9 +178,9 @@ namespace TestCeleste
     TEST_METHOD(PoolAllocatorIterator_InequalityOperator_Reflexivity_ShouldReturnFalse)
     {
       std::array<int, 3> objects;
-      std::array<bool, 3> allocated{ true, true, true };
+      uint64_t allocated = 0b111;
 
-      PoolAllocatorIterator<const int> it(objects.data() + 1, allocated.data(), 3);
+      PoolAllocatorIterator<const int> it(objects.data() + 1, &allocated, 3);
       
       Assert::IsFalse(it != it);
     }
@@ -183,10 +189,10 @@ namespace TestCeleste
     TEST_METHOD(PoolAllocatorIterator_InequalityOperator_IsSymmetric)
     {
       std::array<int, 3> objects;
-      std::array<bool, 3> allocated{ true, true, true };
+      uint64_t allocated = 0b111;
 
-      PoolAllocatorIterator<const int> it(objects.data(), allocated.data(), 3);
-      PoolAllocatorIterator<const int> it2(objects.data() + 1, allocated.data(), 3);
+      PoolAllocatorIterator<const int> it(objects.data(), &allocated, 3);
+      PoolAllocatorIterator<const int> it2(objects.data() + 1, &allocated, 3);
       
       Assert::IsTrue(it != it2);
       Assert::IsTrue(it2 != it);
@@ -194,6 +200,108 @@ namespace TestCeleste
 
     // Inequality operator is not transitive
 
+#pragma endregion
+
+#pragma region Word Skipping Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocatorIterator_SkipsEmptyWords)
+    {
+      std::array<int, 200> objects;
+      std::array<uint64_t, 4> allocated{ 0, 0, static_cast<uint64_t>(1) << 5, 0 };
+
+      PoolAllocatorIterator<const int> it(objects.data(), allocated.data(), 200);
+
+      Assert::AreSame(*it, objects[133]);
+
+      ++it;
+
+      Assert::IsTrue(it.get() == objects.data() + 200);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocatorIterator_WithNothingAllocated_StopsAtEndOfPartialLastWord)
+    {
+      std::array<int, 70> objects;
+      std::array<uint64_t, 2> allocated{ 0, 0 };
+
+      PoolAllocatorIterator<const int> it(objects.data(), allocated.data(), 70);
+
+      Assert::IsTrue(it.get() == objects.data() + 70);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocatorIterator_WithBitsSetPastSize_StopsAtSize)
+    {
+      std::array<int, 128> objects;
+      std::array<uint64_t, 2> allocated{ 0, 0b1011 | (static_cast<uint64_t>(1) << 63) };
+
+      // Only the first slot of the second word is in range, the rest belong to somebody else
+      PoolAllocatorIterator<const int> it(objects.data(), allocated.data(), 65);
+
+      Assert::AreSame(*it, objects[64]);
+
+      ++it;
+
+      Assert::IsTrue(it.get() == objects.data() + 65);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocatorIterator_WithOnlyBitsSetPastSize_DoesNoIteration)
+    {
+      std::array<int, 64> objects;
+      uint64_t allocated = 0b11000;
+
+      PoolAllocatorIterator<const int> it(objects.data(), &allocated, 3);
+
+      Assert::IsTrue(it.get() == objects.data() + 3);
+    }
+
+#pragma endregion
+
+#pragma region Benchmark Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(PoolAllocatorIterator_Benchmark_IterateAt10_50_90PercentOccupancy)
+    {
+      const size_t capacity = 100000;
+      std::mt19937 generator(0);
+
+      for (size_t occupancy : { 10, 50, 90 })
+      {
+        PoolAllocator<int> pool(capacity);
+        std::vector<int*> objects;
+        objects.reserve(capacity);
+
+        for (size_t i = 0; i < capacity; ++i)
+        {
+          objects.push_back(pool.allocate());
+        }
+
+        std::shuffle(objects.begin(), objects.end(), generator);
+
+        size_t expectedCount = (capacity * occupancy) / 100;
+        for (size_t i = expectedCount; i < capacity; ++i)
+        {
+          pool.deallocate(*objects[i]);
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        size_t count = 0;
+        for (int& item : pool)
+        {
+          UNUSED(item);
+          ++count;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+
+        Assert::AreEqual(expectedCount, count);
+        Logger::WriteMessage(("Iterated pool at " + std::to_string(occupancy) + "% occupancy in " + std::to_string(elapsed.count()) + "us").c_str());
+      }
+    }
+
 #pragma endregion
 
   };
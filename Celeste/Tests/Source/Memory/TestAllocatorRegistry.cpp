@@ -0,0 +1,170 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Memory/AllocatorRegistry.h"
+#include "FileSystem/Directory.h"
+#include "FileSystem/File.h"
+
+using namespace Celeste;
+
+
+namespace TestCeleste
+{
+  static const std::string testAllocatorName("TestAllocatorRegistryAllocator");
+
+  CELESTE_TEST_CLASS(TestAllocatorRegistry)
+
+  //------------------------------------------------------------------------------------------------
+  void testCleanup()
+  {
+    AllocatorRegistry::deregisterAllocator(testAllocatorName);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  AllocatorStats createTestStats()
+  {
+    AllocatorStats stats;
+    stats.m_capacity = 10;
+    stats.m_liveCount = 5;
+    stats.m_highWaterMark = 7;
+    stats.m_growCount = 1;
+    stats.m_reserveCount = 2;
+
+    return stats;
+  }
+
+#pragma region Register Allocator Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_CustomMemoryCreation_RegistersAllocatorForType)
+  {
+    Assert::IsTrue(AllocatorRegistry::isRegistered("GameObject"));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_RegisterAllocator_NameNotRegistered_AddsAllocator_ReturnsTrue)
+  {
+    size_t count = AllocatorRegistry::getAllocatorCount();
+
+    Assert::IsTrue(AllocatorRegistry::registerAllocator(testAllocatorName, &createTestStats));
+    Assert::IsTrue(AllocatorRegistry::isRegistered(testAllocatorName));
+    Assert::AreEqual(count + 1, AllocatorRegistry::getAllocatorCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_RegisterAllocator_NameAlreadyRegistered_ReplacesAllocator_ReturnsFalse)
+  {
+    AllocatorRegistry::registerAllocator(testAllocatorName, []() { return AllocatorStats(); });
+    size_t count = AllocatorRegistry::getAllocatorCount();
+
+    Assert::IsFalse(AllocatorRegistry::registerAllocator(testAllocatorName, &createTestStats));
+    Assert::AreEqual(count, AllocatorRegistry::getAllocatorCount());
+    Assert::AreEqual((size_t)10, AllocatorRegistry::getStats(testAllocatorName).m_capacity);
+  }
+
+#pragma endregion
+
+#pragma region Get Stats Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_GetStats_NameNotRegistered_ReturnsEmptyStats)
+  {
+    AllocatorStats stats = AllocatorRegistry::getStats(testAllocatorName);
+
+    Assert::IsTrue(stats.m_name.empty());
+    Assert::AreEqual((size_t)0, stats.m_capacity);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_GetStats_NameRegistered_ReturnsAllocatorStats_WithName)
+  {
+    AllocatorRegistry::registerAllocator(testAllocatorName, &createTestStats);
+
+    AllocatorStats stats = AllocatorRegistry::getStats(testAllocatorName);
+
+    Assert::AreEqual(testAllocatorName, stats.m_name);
+    Assert::AreEqual((size_t)10, stats.m_capacity);
+    Assert::AreEqual((size_t)5, stats.m_liveCount);
+    Assert::AreEqual((size_t)7, stats.m_highWaterMark);
+    Assert::AreEqual((size_t)1, stats.m_growCount);
+    Assert::AreEqual((size_t)2, stats.m_reserveCount);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_GetAllStats_ReturnsStatsForEveryAllocator_OrderedByName)
+  {
+    AllocatorRegistry::registerAllocator(testAllocatorName, &createTestStats);
+
+    std::vector<AllocatorStats> allStats = AllocatorRegistry::getAllStats();
+
+    Assert::AreEqual(AllocatorRegistry::getAllocatorCount(), allStats.size());
+    Assert::IsTrue(std::is_sorted(allStats.begin(), allStats.end(),
+      [](const AllocatorStats& lhs, const AllocatorStats& rhs) { return lhs.m_name < rhs.m_name; }));
+    Assert::IsTrue(std::any_of(allStats.begin(), allStats.end(),
+      [](const AllocatorStats& stats) { return stats.m_name == testAllocatorName; }));
+  }
+
+#pragma endregion
+
+#pragma region Reserve Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_Reserve_NameNotRegistered_ReturnsFalse)
+  {
+    Assert::IsFalse(AllocatorRegistry::reserve(testAllocatorName, 10));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_Reserve_NameRegisteredWithoutReserveFunction_ReturnsFalse)
+  {
+    AllocatorRegistry::registerAllocator(testAllocatorName, &createTestStats);
+
+    Assert::IsFalse(AllocatorRegistry::reserve(testAllocatorName, 10));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_Reserve_NameRegistered_CallsReserveFunction_ReturnsTrue)
+  {
+    size_t reservedCapacity = 0;
+    AllocatorRegistry::registerAllocator(testAllocatorName, &createTestStats, [&reservedCapacity](size_t capacity) { reservedCapacity = capacity; });
+
+    Assert::IsTrue(AllocatorRegistry::reserve(testAllocatorName, 10));
+    Assert::AreEqual((size_t)10, reservedCapacity);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_Prewarm_ReservesHintOnTopOfLiveCount)
+  {
+    size_t reservedCapacity = 0;
+    AllocatorRegistry::registerAllocator(testAllocatorName, &createTestStats, [&reservedCapacity](size_t capacity) { reservedCapacity = capacity; });
+
+    AllocatorRegistry::prewarm({ { testAllocatorName, 20 }, { "WubbaLubbaDubDub", 5 } });
+
+    // The test stats have 5 live objects
+    Assert::AreEqual((size_t)25, reservedCapacity);
+  }
+
+#pragma endregion
+
+#pragma region Dump Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(AllocatorRegistry_Dump_WritesRowForEveryAllocator)
+  {
+    AllocatorRegistry::registerAllocator(testAllocatorName, &createTestStats);
+    Path dumpPath(Directory::getExecutingAppDirectory(), "AllocatorStats.txt");
+
+    AllocatorRegistry::dump(dumpPath);
+
+    std::string contents;
+    File(dumpPath).read(contents);
+
+    Assert::IsTrue(contents.find("High Water Mark") != std::string::npos);
+    Assert::IsTrue(contents.find("Reserves") != std::string::npos);
+    Assert::IsTrue(contents.find(testAllocatorName) != std::string::npos);
+    Assert::IsTrue(contents.find("GameObject") != std::string::npos);
+  }
+
+#pragma endregion
+
+  };
+}
@@ -8,7 +8,9 @@
 #include "Mocks/Rendering/MockSpriteBatch.h"
 #include "Mocks/Rendering/MockSpriteRenderer.h"
 #include "Mocks/Rendering/MockTextRenderer.h"
+#include "Physics/RigidBody2D.h"
 #include "TestUtils/Assert/AssertCel.h"
+#include "TestUtils/Assert/AssertExt.h"
 
 using namespace Celeste;
 
@@ -1109,6 +1111,77 @@ namespace TestCeleste
     Assert::AreEqual((size_t)0, spriteBatch.renderers_size_Public());
   }
 
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(GameObject_Render_WithRigidBodyAndLag_MovesOnByVelocity)
+  {
+    GameObject gameObject;
+    gameObject.getTransform()->setTranslation(1, 2);
+    gameObject.addComponent<MockSpriteRenderer>();
+    gameObject.addComponent<Physics::RigidBody2D>()->setLinearVelocity(10, 20);
+    MockSpriteBatch spriteBatch;
+    spriteBatch.initialize();
+
+    gameObject.render(spriteBatch, 0.5f);
+
+    const glm::mat4& renderMatrix = spriteBatch.getRenderMatrix_Public(0);
+    Assert::AreEqual(6.0f, renderMatrix[3].x);
+    Assert::AreEqual(12.0f, renderMatrix[3].y);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(GameObject_Render_ChildOfRigidBodyWithLag_MovesOnWithParent)
+  {
+    GameObject parent;
+    parent.addComponent<MockSpriteRenderer>();
+    observer_ptr<Physics::RigidBody2D> rigidBody = parent.addComponent<Physics::RigidBody2D>();
+    rigidBody->setLinearVelocity(10, 20);
+    rigidBody->setAngularVelocity(1);
+
+    GameObject child;
+    child.setParent(&parent);
+    child.getTransform()->setTranslation(5, 0);
+    child.addComponent<MockSpriteRenderer>();
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.initialize();
+
+    parent.render(spriteBatch, 0.5f);
+    child.render(spriteBatch, 0.5f);
+
+    const glm::mat4& parentMatrix = spriteBatch.getRenderMatrix_Public(0);
+    const glm::mat4& childMatrix = spriteBatch.getRenderMatrix_Public(1);
+
+    // The child is carried along with its parent and orbits the parent's origin by the half radian it turns (clockwise)
+    Assert::AreEqual(5.0f, parentMatrix[3].x);
+    Assert::AreEqual(10.0f, parentMatrix[3].y);
+    AssertExt::AreAlmostEqual(5 + 5 * std::cos(0.5f), childMatrix[3].x);
+    AssertExt::AreAlmostEqual(10 - 5 * std::sin(0.5f), childMatrix[3].y);
+
+    // Both sprites are the same size, so they only have the same axes if they were rotated by the same amount
+    Assert::IsTrue(parentMatrix[0] == childMatrix[0]);
+    Assert::IsTrue(parentMatrix[1] == childMatrix[1]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(GameObject_Render_RigidBodyRemovedWithLag_DoesNotMoveOn)
+  {
+    GameObject gameObject;
+    gameObject.getTransform()->setTranslation(1, 2);
+    gameObject.addComponent<MockSpriteRenderer>();
+    observer_ptr<Physics::RigidBody2D> rigidBody = gameObject.addComponent<Physics::RigidBody2D>();
+    rigidBody->setLinearVelocity(10, 20);
+    delete rigidBody;
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.initialize();
+
+    gameObject.render(spriteBatch, 0.5f);
+
+    const glm::mat4& renderMatrix = spriteBatch.getRenderMatrix_Public(0);
+    Assert::AreEqual(1.0f, renderMatrix[3].x);
+    Assert::AreEqual(2.0f, renderMatrix[3].y);
+  }
+
 #pragma endregion
 
   };
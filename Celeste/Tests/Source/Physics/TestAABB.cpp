@@ -0,0 +1,137 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Physics/AABB.h"
+
+using namespace Celeste;
+using namespace Celeste::Physics;
+
+
+namespace TestCeleste
+{
+  CELESTE_TEST_CLASS(TestAABB)
+
+#pragma region Swept Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(AABB_Swept_CoversStartAndEndBoxes)
+    {
+      AABB swept = AABB(glm::vec2(0, 0), glm::vec2(2, 2)).swept(glm::vec2(10, -5));
+
+      Assert::AreEqual(glm::vec2(0, -5), swept.m_min);
+      Assert::AreEqual(glm::vec2(12, 2), swept.m_max);
+    }
+
+#pragma endregion
+
+#pragma region Sweep Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(AABB_Sweep_MovingThroughThinTarget_ReturnsTrue_WithTimeOfImpactAndNormal)
+    {
+      AABB moving(glm::vec2(0, 0), glm::vec2(2, 2));
+      AABB target(glm::vec2(50, -10), glm::vec2(51, 10));
+      float timeOfImpact = -1;
+      glm::vec2 normal;
+
+      Assert::IsTrue(moving.sweep(glm::vec2(100, 0), target, timeOfImpact, normal));
+      Assert::AreEqual(0.48f, timeOfImpact, 0.0001f);
+      Assert::AreEqual(glm::vec2(-1, 0), normal);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(AABB_Sweep_MovingDownOntoTarget_ReturnsUpwardsNormal)
+    {
+      AABB moving(glm::vec2(0, 10), glm::vec2(2, 12));
+      AABB target(glm::vec2(-10, -1), glm::vec2(10, 0));
+      float timeOfImpact = -1;
+      glm::vec2 normal;
+
+      Assert::IsTrue(moving.sweep(glm::vec2(0, -20), target, timeOfImpact, normal));
+      Assert::AreEqual(0.5f, timeOfImpact, 0.0001f);
+      Assert::AreEqual(glm::vec2(0, 1), normal);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(AABB_Sweep_TargetOutOfReach_ReturnsFalse)
+    {
+      AABB moving(glm::vec2(0, 0), glm::vec2(2, 2));
+      AABB target(glm::vec2(50, -10), glm::vec2(51, 10));
+      float timeOfImpact = -1;
+      glm::vec2 normal;
+
+      Assert::IsFalse(moving.sweep(glm::vec2(40, 0), target, timeOfImpact, normal));
+      Assert::IsFalse(moving.sweep(glm::vec2(-100, 0), target, timeOfImpact, normal));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(AABB_Sweep_PassingAlongsideTarget_ReturnsFalse)
+    {
+      AABB moving(glm::vec2(0, 0), glm::vec2(2, 2));
+      AABB target(glm::vec2(50, 2), glm::vec2(51, 10));
+      float timeOfImpact = -1;
+      glm::vec2 normal;
+
+      // Sliding exactly along the bottom face only touches it, which is not a collision
+      Assert::IsFalse(moving.sweep(glm::vec2(100, 0), target, timeOfImpact, normal));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(AABB_Sweep_AlreadyOverlapping_ReturnsFalse)
+    {
+      AABB moving(glm::vec2(0, 0), glm::vec2(2, 2));
+      AABB target(glm::vec2(1, 1), glm::vec2(3, 3));
+      float timeOfImpact = -1;
+      glm::vec2 normal;
+
+      Assert::IsFalse(moving.sweep(glm::vec2(100, 0), target, timeOfImpact, normal));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(AABB_Sweep_TouchingAndMovingInto_ReturnsTrue_WithZeroTimeOfImpact)
+    {
+      AABB moving(glm::vec2(0, 0), glm::vec2(2, 2));
+      AABB target(glm::vec2(2, 0), glm::vec2(4, 2));
+      float timeOfImpact = -1;
+      glm::vec2 normal;
+
+      Assert::IsTrue(moving.sweep(glm::vec2(5, 0), target, timeOfImpact, normal));
+      Assert::AreEqual(0.0f, timeOfImpact);
+      Assert::AreEqual(glm::vec2(-1, 0), normal);
+
+      Assert::IsFalse(moving.sweep(glm::vec2(-5, 0), target, timeOfImpact, normal));
+    }
+
+#pragma endregion
+
+#pragma region Intersects Segment Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(AABB_IntersectsSegment_SegmentThroughBox_ReturnsTrue)
+    {
+      AABB box(glm::vec2(0, 0), glm::vec2(10, 10));
+
+      Assert::IsTrue(box.intersectsSegment(glm::vec2(-5, 5), glm::vec2(15, 5)));
+      Assert::IsTrue(box.intersectsSegment(glm::vec2(-5, -5), glm::vec2(15, 15)));
+      Assert::IsTrue(box.intersectsSegment(glm::vec2(2, 2), glm::vec2(3, 3)));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(AABB_IntersectsSegment_SegmentMissesBox_ReturnsFalse)
+    {
+      AABB box(glm::vec2(0, 0), glm::vec2(10, 10));
+
+      // Inside the box around the segment, but passing the corner
+      Assert::IsFalse(box.intersectsSegment(glm::vec2(8, 20), glm::vec2(20, 8)));
+      Assert::IsFalse(box.intersectsSegment(glm::vec2(-5, 5), glm::vec2(-1, 5)));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(AABB_IntersectsSegment_SegmentTouchingEdge_ReturnsTrue)
+    {
+      Assert::IsTrue(AABB(glm::vec2(0, 0), glm::vec2(10, 10)).intersectsSegment(glm::vec2(-5, 10), glm::vec2(15, 10)));
+    }
+
+#pragma endregion
+
+  };
+}
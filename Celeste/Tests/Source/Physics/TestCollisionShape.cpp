@@ -0,0 +1,369 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Physics/CollisionShape.h"
+
+#include <cmath>
+
+using namespace Celeste;
+using namespace Celeste::Physics;
+
+
+namespace TestCeleste
+{
+  static const float QUARTER_PI = 0.785398163f;
+
+  CELESTE_TEST_CLASS(TestCollisionShape)
+
+#pragma region Bounds Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_GetBounds_AxisAlignedBox_ReturnsBox)
+    {
+      AABB bounds = CollisionShape::box(glm::vec2(1, 2), glm::vec2(3, 4)).getBounds();
+
+      Assert::AreEqual(glm::vec2(-2, -2), bounds.m_min);
+      Assert::AreEqual(glm::vec2(4, 6), bounds.m_max);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_GetBounds_RotatedBox_EnclosesCorners)
+    {
+      AABB bounds = CollisionShape::box(glm::vec2(), glm::vec2(1, 1), QUARTER_PI).getBounds();
+
+      Assert::AreEqual(-std::sqrt(2.0f), bounds.m_min.x, 0.0001f);
+      Assert::AreEqual(-std::sqrt(2.0f), bounds.m_min.y, 0.0001f);
+      Assert::AreEqual(std::sqrt(2.0f), bounds.m_max.x, 0.0001f);
+      Assert::AreEqual(std::sqrt(2.0f), bounds.m_max.y, 0.0001f);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_GetBounds_RotatedEllipse_IsTight)
+    {
+      // An ellipse with semi-axes (2, 1) turned a quarter turn is just an ellipse with semi-axes (1, 2)
+      AABB bounds = CollisionShape::ellipse(glm::vec2(), glm::vec2(2, 1), 2 * QUARTER_PI).getBounds();
+
+      Assert::AreEqual(-1.0f, bounds.m_min.x, 0.0001f);
+      Assert::AreEqual(-2.0f, bounds.m_min.y, 0.0001f);
+      Assert::AreEqual(1.0f, bounds.m_max.x, 0.0001f);
+      Assert::AreEqual(2.0f, bounds.m_max.y, 0.0001f);
+    }
+
+#pragma endregion
+
+#pragma region Contains Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Contains_RotatedBox_UsesRotatedEdges)
+    {
+      CollisionShape shape = CollisionShape::box(glm::vec2(), glm::vec2(1, 1), QUARTER_PI);
+
+      Assert::IsTrue(contains(shape, glm::vec2(1.3f, 0)));
+      Assert::IsFalse(contains(shape, glm::vec2(0.9f, 0.9f)));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Contains_Ellipse_ExcludesBoundingBoxCorners)
+    {
+      CollisionShape shape = CollisionShape::ellipse(glm::vec2(), glm::vec2(2, 1));
+
+      Assert::IsTrue(contains(shape, glm::vec2(1.9f, 0)));
+      Assert::IsFalse(contains(shape, glm::vec2(1.9f, 0.9f)));
+      Assert::IsFalse(contains(shape, glm::vec2(2, 0)));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Contains_DegenerateShape_ReturnsFalse)
+    {
+      Assert::IsFalse(contains(CollisionShape::box(glm::vec2(), glm::vec2()), glm::vec2()));
+      Assert::IsFalse(contains(CollisionShape::ellipse(glm::vec2(), glm::vec2()), glm::vec2()));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Contains_ZeroWidthShape_ReturnsFalse)
+    {
+      Assert::IsFalse(contains(CollisionShape::box(glm::vec2(), glm::vec2(0, 1)), glm::vec2()));
+      Assert::IsFalse(contains(CollisionShape::ellipse(glm::vec2(), glm::vec2(1, 0)), glm::vec2()));
+    }
+
+#pragma endregion
+
+#pragma region Box Box Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsBoxBox_Overlapping_ReturnsTrue)
+    {
+      Assert::IsTrue(intersects(CollisionShape::box(glm::vec2(), glm::vec2(1, 1)), CollisionShape::box(glm::vec2(1.5f, 0), glm::vec2(1, 1))));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsBoxBox_Touching_ReturnsFalse)
+    {
+      Assert::IsFalse(intersects(CollisionShape::box(glm::vec2(), glm::vec2(1, 1)), CollisionShape::box(glm::vec2(2, 0), glm::vec2(1, 1))));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsBoxBox_RotatedBoxInBoundsGap_ReturnsFalse)
+    {
+      // The diamond's bounds overlap the square, but its tip stops short of it
+      CollisionShape square = CollisionShape::box(glm::vec2(), glm::vec2(1, 1));
+      CollisionShape diamond = CollisionShape::box(glm::vec2(2.2f, 2.2f), glm::vec2(1, 1), QUARTER_PI);
+
+      Assert::IsTrue(square.getBounds().overlaps(diamond.getBounds()));
+      Assert::IsFalse(intersects(square, diamond));
+      Assert::IsFalse(intersects(diamond, square));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsBoxBox_RotatedBoxCornerInside_ReturnsTrue)
+    {
+      CollisionShape square = CollisionShape::box(glm::vec2(), glm::vec2(1, 1));
+      CollisionShape diamond = CollisionShape::box(glm::vec2(2.2f, 0), glm::vec2(1, 1), QUARTER_PI);
+
+      Assert::IsTrue(intersects(square, diamond));
+      Assert::IsTrue(intersects(diamond, square));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsBoxBox_Degenerate_ReturnsFalse)
+    {
+      Assert::IsFalse(intersects(CollisionShape::box(glm::vec2(), glm::vec2(1, 1)), CollisionShape::box(glm::vec2(), glm::vec2())));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsBoxBox_ZeroWidthBoxThroughMiddle_ReturnsFalse)
+    {
+      // A line through the middle of the box would be found by SAT, but has no area to overlap with
+      CollisionShape square = CollisionShape::box(glm::vec2(), glm::vec2(1, 1));
+      CollisionShape line = CollisionShape::box(glm::vec2(), glm::vec2(0, 5));
+
+      Assert::IsTrue(line.isDegenerate());
+      Assert::IsFalse(intersects(square, line));
+      Assert::IsFalse(intersects(line, square));
+      Assert::IsFalse(intersects(CollisionShape::ellipse(glm::vec2(), glm::vec2(1, 1)), CollisionShape::ellipse(glm::vec2(), glm::vec2(5, 0))));
+    }
+
+#pragma endregion
+
+#pragma region Ellipse Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsEllipseBox_BoxInBoundsCorner_ReturnsFalse)
+    {
+      // The old bounding rectangle approximation reported a hit here
+      CollisionShape circle = CollisionShape::ellipse(glm::vec2(), glm::vec2(1, 1));
+      CollisionShape box = CollisionShape::box(glm::vec2(1.1f, 1.1f), glm::vec2(0.25f, 0.25f));
+
+      Assert::IsFalse(intersects(circle, box));
+      Assert::IsFalse(intersects(box, circle));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsEllipseBox_Overlapping_ReturnsTrue)
+    {
+      CollisionShape circle = CollisionShape::ellipse(glm::vec2(), glm::vec2(1, 1));
+      CollisionShape box = CollisionShape::box(glm::vec2(0.8f, 0.8f), glm::vec2(0.25f, 0.25f));
+
+      Assert::IsTrue(intersects(circle, box));
+      Assert::IsTrue(intersects(box, circle));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsEllipseBox_Touching_ReturnsFalse)
+    {
+      CollisionShape circle = CollisionShape::ellipse(glm::vec2(), glm::vec2(1, 1));
+      CollisionShape box = CollisionShape::box(glm::vec2(2, 0), glm::vec2(1, 1));
+
+      Assert::IsFalse(intersects(circle, box));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsEllipseEllipse_Overlapping_ReturnsTrue)
+    {
+      CollisionShape a = CollisionShape::ellipse(glm::vec2(), glm::vec2(1, 1));
+      CollisionShape b = CollisionShape::ellipse(glm::vec2(0, 1.5f), glm::vec2(1, 1));
+
+      Assert::IsTrue(intersects(a, b));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsEllipseEllipse_Touching_ReturnsFalse)
+    {
+      CollisionShape a = CollisionShape::ellipse(glm::vec2(), glm::vec2(1, 1));
+      CollisionShape b = CollisionShape::ellipse(glm::vec2(0, 2), glm::vec2(1, 1));
+
+      Assert::IsFalse(intersects(a, b));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsEllipseEllipse_RotationMatters)
+    {
+      // A long thin ellipse only reaches the circle once it is turned to point at it
+      CollisionShape circle = CollisionShape::ellipse(glm::vec2(4, 0), glm::vec2(1, 1));
+
+      Assert::IsFalse(intersects(CollisionShape::ellipse(glm::vec2(), glm::vec2(0.5f, 3.5f)), circle));
+      Assert::IsTrue(intersects(CollisionShape::ellipse(glm::vec2(), glm::vec2(0.5f, 3.5f), 2 * QUARTER_PI), circle));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsEllipse_Contained_ReturnsTrue)
+    {
+      CollisionShape outer = CollisionShape::ellipse(glm::vec2(), glm::vec2(5, 5));
+
+      Assert::IsTrue(intersects(outer, CollisionShape::ellipse(glm::vec2(1, 0), glm::vec2(0.5f, 0.5f))));
+      Assert::IsTrue(intersects(outer, CollisionShape::box(glm::vec2(0, 1), glm::vec2(0.5f, 0.5f), QUARTER_PI)));
+    }
+
+#pragma endregion
+
+#pragma region Raycast Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Raycast_Box_ReturnsEntryFraction)
+    {
+      float fraction = -1;
+
+      Assert::IsTrue(raycast(CollisionShape::box(glm::vec2(), glm::vec2(1, 1)), glm::vec2(-5, 0), glm::vec2(5, 0), fraction));
+      Assert::AreEqual(0.4f, fraction, 0.0001f);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Raycast_RotatedBox_HitsRotatedEdge)
+    {
+      float fraction = -1;
+
+      // The diamond's tip is sqrt(2) from its centre
+      Assert::IsTrue(raycast(CollisionShape::box(glm::vec2(), glm::vec2(1, 1), QUARTER_PI), glm::vec2(-5, 0), glm::vec2(5, 0), fraction));
+      Assert::AreEqual((5 - std::sqrt(2.0f)) / 10, fraction, 0.0001f);
+      Assert::IsFalse(raycast(CollisionShape::box(glm::vec2(), glm::vec2(1, 1), QUARTER_PI), glm::vec2(-5, 1.3f), glm::vec2(-0.2f, 1.3f), fraction));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Raycast_Ellipse_ReturnsEntryFraction)
+    {
+      float fraction = -1;
+
+      Assert::IsTrue(raycast(CollisionShape::ellipse(glm::vec2(), glm::vec2(2, 1)), glm::vec2(-10, 0), glm::vec2(10, 0), fraction));
+      Assert::AreEqual(0.4f, fraction, 0.0001f);
+
+      // Passes through the ellipse's bounding box, but not the ellipse
+      Assert::IsFalse(raycast(CollisionShape::ellipse(glm::vec2(), glm::vec2(2, 1)), glm::vec2(-10, 0.95f), glm::vec2(-1.5f, 0.95f), fraction));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Raycast_StartingInside_HitsAtZero)
+    {
+      float fraction = -1;
+
+      Assert::IsTrue(raycast(CollisionShape::ellipse(glm::vec2(), glm::vec2(2, 1)), glm::vec2(), glm::vec2(10, 0), fraction));
+      Assert::AreEqual(0.0f, fraction);
+
+      fraction = -1;
+      Assert::IsTrue(raycast(CollisionShape::box(glm::vec2(), glm::vec2(2, 1)), glm::vec2(), glm::vec2(10, 0), fraction));
+      Assert::AreEqual(0.0f, fraction);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Raycast_EndingBeforeShapeOrGrazing_ReturnsFalse)
+    {
+      float fraction = -1;
+      CollisionShape box = CollisionShape::box(glm::vec2(), glm::vec2(1, 1));
+
+      Assert::IsFalse(raycast(box, glm::vec2(-5, 0), glm::vec2(-1, 0), fraction));
+      Assert::IsFalse(raycast(box, glm::vec2(-5, 1), glm::vec2(5, 1), fraction));
+      Assert::IsFalse(raycast(CollisionShape::box(glm::vec2(), glm::vec2()), glm::vec2(-5, 0), glm::vec2(5, 0), fraction));
+    }
+
+#pragma endregion
+
+#pragma region Sweep Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Sweep_BoxIntoBox_ReturnsTimeOfImpactAndFaceNormal)
+    {
+      float timeOfImpact = 0;
+      glm::vec2 normal;
+
+      Assert::IsTrue(sweep(CollisionShape::box(glm::vec2(), glm::vec2(0.5f, 0.5f)), glm::vec2(10, 0), CollisionShape::box(glm::vec2(5, 0), glm::vec2(0.5f, 2)), timeOfImpact, normal));
+      Assert::AreEqual(0.4f, timeOfImpact, 0.0001f);
+      Assert::AreEqual(-1.0f, normal.x, 0.0001f);
+      Assert::AreEqual(0.0f, normal.y, 0.0001f);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Sweep_ThroughThinBox_ReturnsHit)
+    {
+      float timeOfImpact = 0;
+      glm::vec2 normal;
+
+      Assert::IsTrue(sweep(CollisionShape::box(glm::vec2(), glm::vec2(0.1f, 0.1f)), glm::vec2(100, 0), CollisionShape::box(glm::vec2(50, 0), glm::vec2(0.01f, 5)), timeOfImpact, normal));
+      Assert::AreEqual(0.4989f, timeOfImpact, 0.0001f);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Sweep_ThroughEmptyCornerOfEllipseBounds_ReturnsFalse)
+    {
+      CollisionShape shape = CollisionShape::box(glm::vec2(-3, 6.4f), glm::vec2(0.05f, 0.05f));
+      CollisionShape ellipse = CollisionShape::ellipse(glm::vec2(), glm::vec2(2, 2));
+      float timeOfImpact = 0;
+      glm::vec2 normal;
+
+      // The bounding boxes do meet, but the path passes outside the circle
+      Assert::IsTrue(shape.getBounds().sweep(glm::vec2(8, -8), ellipse.getBounds(), timeOfImpact, normal));
+      Assert::IsFalse(sweep(shape, glm::vec2(8, -8), ellipse, timeOfImpact, normal));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Sweep_OntoEllipse_ReturnsNormalAtPointOfImpact)
+    {
+      float timeOfImpact = 0;
+      glm::vec2 normal;
+
+      Assert::IsTrue(sweep(CollisionShape::box(glm::vec2(1, 5), glm::vec2(0.1f, 0.1f)), glm::vec2(0, -10), CollisionShape::ellipse(glm::vec2(), glm::vec2(2, 2)), timeOfImpact, normal));
+
+      // The bottom left corner at (0.9, y) meets the circle first
+      float contactY = std::sqrt(4 - 0.81f);
+      Assert::AreEqual((5 - (contactY + 0.1f)) / 10, timeOfImpact, 0.0001f);
+      Assert::AreEqual(0.45f, normal.x, 0.001f);
+      Assert::AreEqual(contactY * 0.5f, normal.y, 0.001f);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_Sweep_AlreadyOverlapping_ReturnsFalse)
+    {
+      float timeOfImpact = 0;
+      glm::vec2 normal;
+
+      Assert::IsFalse(sweep(CollisionShape::box(glm::vec2(), glm::vec2(1, 1)), glm::vec2(1, 0), CollisionShape::box(glm::vec2(0.5f, 0), glm::vec2(1, 1)), timeOfImpact, normal));
+    }
+
+#pragma endregion
+
+#pragma region Batched Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(CollisionShape_IntersectsBatched_MatchesSingleTests_InIndexOrder)
+    {
+      CollisionShape shape = CollisionShape::ellipse(glm::vec2(), glm::vec2(1, 1));
+      CollisionShape others[] =
+      {
+        CollisionShape::box(glm::vec2(1.1f, 1.1f), glm::vec2(0.25f, 0.25f)),
+        CollisionShape::box(glm::vec2(0.8f, 0.8f), glm::vec2(0.25f, 0.25f)),
+        CollisionShape::ellipse(glm::vec2(0, 1.5f), glm::vec2(1, 1)),
+        CollisionShape::ellipse(glm::vec2(0, 2), glm::vec2(1, 1)),
+      };
+      size_t indices[] = { 3, 1, 2, 0, 1 };
+      uint8_t results[5] = { 2, 2, 2, 2, 2 };
+
+      intersects(shape, others, indices, 5, results);
+
+      Assert::AreEqual(0, static_cast<int>(results[0]));
+      Assert::AreEqual(1, static_cast<int>(results[1]));
+      Assert::AreEqual(1, static_cast<int>(results[2]));
+      Assert::AreEqual(0, static_cast<int>(results[3]));
+      Assert::AreEqual(1, static_cast<int>(results[4]));
+    }
+
+#pragma endregion
+
+  };
+}
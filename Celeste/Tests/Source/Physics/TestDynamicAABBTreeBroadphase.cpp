@@ -0,0 +1,402 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Physics/DynamicAABBTreeBroadphase.h"
+
+#include <random>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <numeric>
+
+using namespace Celeste;
+using namespace Celeste::Physics;
+
+
+namespace TestCeleste
+{
+  namespace
+  {
+    //------------------------------------------------------------------------------------------------
+    std::vector<AABB> createRandomBounds(size_t count, float worldSize, float maxSize, unsigned int seed)
+    {
+      std::mt19937 generator(seed);
+      std::uniform_real_distribution<float> position(-worldSize * 0.5f, worldSize * 0.5f);
+      std::uniform_real_distribution<float> size(1, maxSize);
+
+      std::vector<AABB> bounds;
+      bounds.reserve(count);
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        bounds.push_back(AABB::fromCentre(glm::vec2(position(generator), position(generator)), glm::vec2(size(generator), size(generator))));
+      }
+
+      return bounds;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    std::vector<size_t> bruteForceQuery(const std::vector<AABB>& bounds, const AABB& queryBounds)
+    {
+      std::vector<size_t> results;
+
+      for (size_t i = 0; i < bounds.size(); ++i)
+      {
+        if (bounds[i].overlaps(queryBounds))
+        {
+          results.push_back(i);
+        }
+      }
+
+      return results;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    std::vector<size_t> sortedQuery(const IBroadphase& broadphase, const AABB& queryBounds)
+    {
+      std::vector<size_t> results;
+      broadphase.query(queryBounds, results);
+      std::sort(results.begin(), results.end());
+
+      return results;
+    }
+  }
+
+  CELESTE_TEST_CLASS(TestDynamicAABBTreeBroadphase)
+
+#pragma region Update Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Update_SetsSizeToNumberOfBounds)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+
+      Assert::AreEqual(static_cast<size_t>(0), broadphase.size());
+
+      broadphase.update(createRandomBounds(100, 1000, 50, 1));
+
+      Assert::AreEqual(static_cast<size_t>(100), broadphase.size());
+
+      broadphase.update(createRandomBounds(20, 1000, 50, 2));
+
+      Assert::AreEqual(static_cast<size_t>(20), broadphase.size());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Update_EmptyBounds_QueryReturnsNothing)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      broadphase.update(createRandomBounds(100, 1000, 50, 1));
+      broadphase.update(std::vector<AABB>());
+
+      std::vector<size_t> results;
+      broadphase.query(AABB(glm::vec2(-1000), glm::vec2(1000)), results);
+
+      Assert::IsTrue(results.empty());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Update_BoundsMoved_QueryUsesNewBounds)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      std::vector<AABB> bounds{ AABB(glm::vec2(0), glm::vec2(10)) };
+      broadphase.update(bounds);
+
+      Assert::AreEqual(static_cast<size_t>(1), sortedQuery(broadphase, AABB(glm::vec2(5), glm::vec2(6))).size());
+
+      bounds[0] = AABB(glm::vec2(1000), glm::vec2(1010));
+      broadphase.update(bounds);
+
+      Assert::IsTrue(sortedQuery(broadphase, AABB(glm::vec2(5), glm::vec2(6))).empty());
+      Assert::AreEqual(static_cast<size_t>(1), sortedQuery(broadphase, AABB(glm::vec2(1005), glm::vec2(1006))).size());
+    }
+
+#pragma endregion
+
+#pragma region Query Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Query_AppendsToExistingResults)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      broadphase.update(std::vector<AABB>{ AABB(glm::vec2(0), glm::vec2(10)) });
+
+      std::vector<size_t> results{ 100 };
+      broadphase.query(AABB(glm::vec2(5), glm::vec2(6)), results);
+
+      Assert::AreEqual(static_cast<size_t>(2), results.size());
+      Assert::AreEqual(static_cast<size_t>(100), results[0]);
+      Assert::AreEqual(static_cast<size_t>(0), results[1]);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Query_TouchingEdges_CountsAsOverlapping)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      broadphase.update(std::vector<AABB>{ AABB(glm::vec2(0), glm::vec2(10)) });
+
+      Assert::AreEqual(static_cast<size_t>(1), sortedQuery(broadphase, AABB(glm::vec2(10, 0), glm::vec2(20, 10))).size());
+      Assert::IsTrue(sortedQuery(broadphase, AABB(glm::vec2(10.5f, 0), glm::vec2(20, 10))).empty());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Query_InfiniteBounds_FindsEverything)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      std::vector<AABB> bounds = createRandomBounds(100, 1000, 50, 3);
+      bounds.push_back(AABB(glm::vec2(-std::numeric_limits<float>::infinity()), glm::vec2(std::numeric_limits<float>::infinity())));
+      broadphase.update(bounds);
+
+      Assert::AreEqual(bounds.size(), sortedQuery(broadphase, AABB(glm::vec2(-1000), glm::vec2(1000))).size());
+      Assert::AreEqual(static_cast<size_t>(1), sortedQuery(broadphase, AABB(glm::vec2(5000), glm::vec2(5001))).size());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Query_MatchesBruteForce_OverSeveralFramesOfMovement)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      std::vector<AABB> bounds = createRandomBounds(500, 2000, 300, 4);
+      std::mt19937 generator(5);
+      std::uniform_real_distribution<float> movement(-20, 20);
+
+      for (int frame = 0; frame < 10; ++frame)
+      {
+        broadphase.update(bounds);
+
+        for (const AABB& queryBounds : bounds)
+        {
+          Assert::IsTrue(bruteForceQuery(bounds, queryBounds) == sortedQuery(broadphase, queryBounds));
+        }
+
+        for (AABB& entry : bounds)
+        {
+          glm::vec2 offset(movement(generator), movement(generator));
+          entry = AABB(entry.m_min + offset, entry.m_max + offset);
+        }
+      }
+    }
+
+#pragma endregion
+
+#pragma region Query Segment Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_QuerySegment_MatchesBruteForce)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      std::vector<AABB> bounds = createRandomBounds(500, 2000, 100, 6);
+      broadphase.update(bounds);
+
+      std::mt19937 generator(7);
+      std::uniform_real_distribution<float> position(-1000, 1000);
+
+      for (int ray = 0; ray < 100; ++ray)
+      {
+        glm::vec2 start(position(generator), position(generator));
+        glm::vec2 end(position(generator), position(generator));
+
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < bounds.size(); ++i)
+        {
+          if (bounds[i].intersectsSegment(start, end))
+          {
+            expected.push_back(i);
+          }
+        }
+
+        std::vector<size_t> results;
+        broadphase.querySegment(start, end, results);
+        std::sort(results.begin(), results.end());
+
+        Assert::IsTrue(expected == results);
+      }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_QuerySegment_DiagonalSegment_SkipsBoxesItOnlyBoundsAround)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      broadphase.update({ AABB(glm::vec2(80, 0), glm::vec2(100, 20)), AABB(glm::vec2(45, 45), glm::vec2(55, 55)) });
+
+      std::vector<size_t> results;
+      broadphase.querySegment(glm::vec2(0, 0), glm::vec2(100, 100), results);
+
+      Assert::AreEqual(static_cast<size_t>(1), results.size());
+      Assert::AreEqual(static_cast<size_t>(1), results[0]);
+    }
+
+#pragma endregion
+
+#pragma region Constructor Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Constructor_SetsMargin)
+    {
+      DynamicAABBTreeBroadphase broadphase(8);
+
+      Assert::AreEqual(8.0f, broadphase.getMargin());
+      Assert::AreEqual(static_cast<size_t>(0), broadphase.size());
+      Assert::AreEqual(static_cast<size_t>(0), broadphase.getHeight());
+    }
+
+#pragma endregion
+
+#pragma region Incremental Update Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Update_MovementWithinMargin_DoesNotMoveLeaves)
+    {
+      DynamicAABBTreeBroadphase broadphase(4);
+      std::vector<AABB> bounds = createRandomBounds(100, 1000, 50, 6);
+      broadphase.update(bounds);
+
+      Assert::AreEqual(static_cast<size_t>(100), broadphase.getMovedCount());
+
+      for (AABB& entry : bounds)
+      {
+        entry = AABB(entry.m_min + glm::vec2(2), entry.m_max + glm::vec2(2));
+      }
+      broadphase.update(bounds);
+
+      Assert::AreEqual(static_cast<size_t>(0), broadphase.getMovedCount());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Update_MovementOutsideMargin_MovesOnlyThoseLeaves)
+    {
+      DynamicAABBTreeBroadphase broadphase(4);
+      std::vector<AABB> bounds = createRandomBounds(100, 1000, 50, 7);
+      broadphase.update(bounds);
+
+      bounds[10] = AABB(bounds[10].m_min + glm::vec2(100), bounds[10].m_max + glm::vec2(100));
+      bounds[20] = AABB(bounds[20].m_min - glm::vec2(100), bounds[20].m_max - glm::vec2(100));
+      broadphase.update(bounds);
+
+      Assert::AreEqual(static_cast<size_t>(2), broadphase.getMovedCount());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Update_KeepsTreeBalanced)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      std::vector<AABB> bounds;
+
+      // Inserting in sorted order is the worst case for an unbalanced tree
+      for (int i = 0; i < 1024; ++i)
+      {
+        bounds.push_back(AABB(glm::vec2(i * 20.0f, 0), glm::vec2(i * 20.0f + 10, 10)));
+      }
+      broadphase.update(bounds);
+
+      Assert::IsTrue(broadphase.getHeight() <= 20);
+    }
+
+#pragma endregion
+
+#pragma region Keyed Update Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Update_EarlierEntryRemoved_DoesNotMoveLaterLeaves)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      std::vector<AABB> bounds = createRandomBounds(100, 1000, 50, 9);
+      std::vector<uint64_t> keys(bounds.size());
+      std::iota(keys.begin(), keys.end(), static_cast<uint64_t>(1000));
+      broadphase.update(bounds, keys);
+
+      // Every entry after the first now has a different index, but the same key and bounds
+      bounds.erase(bounds.begin());
+      keys.erase(keys.begin());
+      broadphase.update(bounds, keys);
+
+      Assert::AreEqual(static_cast<size_t>(99), broadphase.size());
+      Assert::AreEqual(static_cast<size_t>(0), broadphase.getMovedCount());
+      Assert::IsTrue(bruteForceQuery(bounds, AABB(glm::vec2(-100), glm::vec2(100))) == sortedQuery(broadphase, AABB(glm::vec2(-100), glm::vec2(100))));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Update_EntriesReordered_QueryReturnsNewIndices)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      std::vector<AABB> bounds{ AABB(glm::vec2(0), glm::vec2(10)), AABB(glm::vec2(100), glm::vec2(110)) };
+      broadphase.update(bounds, { 7, 3 });
+
+      std::swap(bounds[0], bounds[1]);
+      broadphase.update(bounds, { 3, 7 });
+
+      Assert::AreEqual(static_cast<size_t>(0), broadphase.getMovedCount());
+      Assert::IsTrue(std::vector<size_t>{ 1 } == sortedQuery(broadphase, AABB(glm::vec2(-1), glm::vec2(1))));
+      Assert::IsTrue(std::vector<size_t>{ 0 } == sortedQuery(broadphase, AABB(glm::vec2(99), glm::vec2(101))));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Update_KeyReplaced_InsertsNewLeafAndRemovesOld)
+    {
+      DynamicAABBTreeBroadphase broadphase;
+      broadphase.update({ AABB(glm::vec2(0), glm::vec2(10)), AABB(glm::vec2(100), glm::vec2(110)) }, { 1, 2 });
+      broadphase.update({ AABB(glm::vec2(0), glm::vec2(10)), AABB(glm::vec2(500), glm::vec2(510)) }, { 1, 3 });
+
+      Assert::AreEqual(static_cast<size_t>(2), broadphase.size());
+      Assert::AreEqual(static_cast<size_t>(1), broadphase.getMovedCount());
+      Assert::IsTrue(sortedQuery(broadphase, AABB(glm::vec2(99), glm::vec2(111))).empty());
+      Assert::IsTrue(std::vector<size_t>{ 1 } == sortedQuery(broadphase, AABB(glm::vec2(499), glm::vec2(501))));
+    }
+
+#pragma endregion
+
+#pragma region Benchmark Tests
+
+    //------------------------------------------------------------------------------------------------
+    void benchmark(size_t colliderCount)
+    {
+      // Keep the density of colliders the same as the count grows, as it would be in a bigger level
+      float worldSize = std::sqrt(static_cast<float>(colliderCount)) * 50;
+      std::vector<AABB> bounds = createRandomBounds(colliderCount, worldSize, 40, 8);
+      DynamicAABBTreeBroadphase broadphase;
+      std::vector<size_t> results;
+      size_t candidateCount = 0;
+
+      auto start = std::chrono::high_resolution_clock::now();
+
+      for (int frame = 0; frame < 10; ++frame)
+      {
+        for (AABB& entry : bounds)
+        {
+          entry = AABB(entry.m_min + glm::vec2(1, -1), entry.m_max + glm::vec2(1, -1));
+        }
+
+        broadphase.update(bounds);
+
+        for (const AABB& queryBounds : bounds)
+        {
+          results.clear();
+          broadphase.query(queryBounds, results);
+          candidateCount += results.size();
+        }
+      }
+
+      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+      // Every collider always overlaps itself
+      Assert::IsTrue(candidateCount >= colliderCount * 10);
+      Logger::WriteMessage(("Broadphase of " + std::to_string(colliderCount) + " colliders over 10 frames took " + std::to_string(elapsed.count()) +
+        "ms, " + std::to_string(candidateCount / 10) + " candidates per frame vs " + std::to_string(colliderCount * colliderCount) + " brute force tests").c_str());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Benchmark_1kColliders)
+    {
+      benchmark(1000);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(DynamicAABBTreeBroadphase_Benchmark_10kColliders)
+    {
+      benchmark(10000);
+    }
+
+#pragma endregion
+
+  };
+}
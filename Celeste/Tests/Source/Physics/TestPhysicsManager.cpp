@@ -3,7 +3,10 @@
 #include "Physics/PhysicsManager.h"
 #include "Game/Game.h"
 #include "Physics/RectangleCollider.h"
+#include "Physics/EllipseCollider.h"
 #include "Physics/RigidBody2D.h"
+#include "Physics/DynamicAABBTreeBroadphase.h"
+#include "Physics/UniformGridBroadphase.h"
 #include "Mocks/Physics/CollisionDetector.h"
 #include "TestUtils/Assert/AssertCel.h"
 
@@ -172,6 +175,41 @@ namespace TestCeleste
     Assert::AreNotEqual(0.0f, rigidBody.getLinearVelocity().y);
   }
 
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_AllocatedRigidBody_MovesThenAppliesGravityForNextFrame)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(1);
+    GameObject gameObject;
+    observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+    rigidBody->setLinearVelocity(10, 0);
+    physicsManager.addSimulatedBody(*rigidBody);
+
+    physicsManager.update(1);
+
+    Assert::AreEqual(glm::vec3(10, 0, 0), gameObject.getTransform()->getTranslation());
+    Assert::AreEqual(glm::vec2(10, -40), rigidBody->getLinearVelocity());
+
+    physicsManager.update(1);
+
+    Assert::AreEqual(glm::vec3(20, -40, 0), gameObject.getTransform()->getTranslation());
+    Assert::AreEqual(glm::vec2(10, -80), rigidBody->getLinearVelocity());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_AllocatedRigidBodyNotSimulated_MovesWithoutGravity)
+  {
+    PhysicsManager physicsManager;
+    GameObject gameObject;
+    observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+    rigidBody->setLinearVelocity(0, 5);
+
+    physicsManager.update(2);
+
+    Assert::AreEqual(glm::vec3(0, 10, 0), gameObject.getTransform()->getTranslation());
+    Assert::AreEqual(glm::vec2(0, 5), rigidBody->getLinearVelocity());
+  }
+
   //------------------------------------------------------------------------------------------------
   TEST_METHOD(PhysicsManager_Update_SimulatedBodyWithInactiveCollider_DoesNotPerformCollisions)
   {
@@ -946,6 +984,1050 @@ namespace TestCeleste
     Assert::IsFalse(detector->collisionExitCalled());
   }
 
+#pragma endregion
+
+#pragma region Broadphase Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Constructor_UsesUniformGridBroadphase)
+  {
+    PhysicsManager physicsManager;
+
+    Assert::IsNotNull(dynamic_cast<const UniformGridBroadphase*>(&physicsManager.getBroadphase()));
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_SetBroadphase_ReplacesBroadphase)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setBroadphase(std::make_unique<DynamicAABBTreeBroadphase>(2.0f));
+
+    const DynamicAABBTreeBroadphase* broadphase = dynamic_cast<const DynamicAABBTreeBroadphase*>(&physicsManager.getBroadphase());
+
+    Assert::IsNotNull(broadphase);
+    Assert::AreEqual(2.0f, broadphase->getMargin());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_DistantColliders_AreNotPassedToNarrowphase)
+  {
+    PhysicsManager physicsManager;
+    GameObject gameObject;
+    observer_ptr<CollisionDetector> detector = gameObject.addComponent<CollisionDetector>();
+    observer_ptr<RectangleCollider> rectangleCollider = gameObject.addComponent<RectangleCollider>();
+    rectangleCollider->setDimensions(100, 200);
+
+    // Add scripts & components
+    gameObject.update();
+
+    GameObject nearby;
+    nearby.addComponent<RectangleCollider>()->setDimensions(50, 50);
+
+    GameObject distant;
+    distant.getTransform()->setTranslation(5000, 5000);
+    distant.addComponent<RectangleCollider>()->setDimensions(50, 50);
+
+    physicsManager.addSimulatedBody(*rectangleCollider);
+    physicsManager.update(0.1f);
+
+    // The body itself and the nearby collider
+    Assert::AreEqual(static_cast<size_t>(2), physicsManager.getCandidateCount());
+    Assert::AreEqual(static_cast<size_t>(1), detector->collisionCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_DynamicAABBTreeBroadphase_DidCollideLastFrame_CallsCollisionExit)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setBroadphase(std::make_unique<DynamicAABBTreeBroadphase>());
+
+    GameObject gameObject;
+    observer_ptr<CollisionDetector> detector = gameObject.addComponent<CollisionDetector>();
+    observer_ptr<RectangleCollider> rectangleCollider = gameObject.addComponent<RectangleCollider>();
+    rectangleCollider->setDimensions(100, 200);
+
+    // Add scripts & components
+    gameObject.update();
+
+    GameObject other;
+    other.addComponent<RectangleCollider>()->setDimensions(50, 50);
+
+    physicsManager.addSimulatedBody(*rectangleCollider);
+    physicsManager.update(0.1f);
+
+    Assert::IsTrue(detector->collisionEnterCalled());
+
+    detector->reset();
+    gameObject.getTransform()->setTranslation(5000, 5000);
+    physicsManager.update(0.1f);
+
+    Assert::IsTrue(detector->collisionExitCalled());
+    Assert::IsFalse(detector->collisionCalled());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_DynamicAABBTreeBroadphase_DeactivatingEarlyCollider_DoesNotMoveOtherLeaves)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setBroadphase(std::make_unique<DynamicAABBTreeBroadphase>());
+    const DynamicAABBTreeBroadphase& broadphase = static_cast<const DynamicAABBTreeBroadphase&>(physicsManager.getBroadphase());
+
+    std::vector<std::unique_ptr<GameObject>> gameObjects;
+    std::vector<observer_ptr<RectangleCollider>> colliders;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      gameObjects.push_back(std::make_unique<GameObject>());
+      gameObjects.back()->getTransform()->setTranslation(i * 100.0f, 0);
+
+      colliders.push_back(gameObjects.back()->addComponent<RectangleCollider>());
+      colliders.back()->setDimensions(50, 50);
+      gameObjects.back()->update();
+    }
+
+    physicsManager.update(0.1f);
+
+    Assert::AreEqual(static_cast<size_t>(10), broadphase.size());
+    Assert::AreEqual(static_cast<size_t>(10), broadphase.getMovedCount());
+
+    // Every other collider now sits one place earlier in the broadphase, but has not moved
+    colliders[0]->setActive(false);
+    physicsManager.update(0.1f);
+
+    Assert::AreEqual(static_cast<size_t>(9), broadphase.size());
+    Assert::AreEqual(static_cast<size_t>(0), broadphase.getMovedCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_DynamicAABBTreeBroadphase_OneColliderMoved_OnlyUpdatesThatCollider)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setBroadphase(std::make_unique<DynamicAABBTreeBroadphase>());
+    const DynamicAABBTreeBroadphase& broadphase = static_cast<const DynamicAABBTreeBroadphase&>(physicsManager.getBroadphase());
+
+    std::vector<std::unique_ptr<GameObject>> gameObjects;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      gameObjects.push_back(std::make_unique<GameObject>());
+      gameObjects.back()->getTransform()->setTranslation(i * 100.0f, 0);
+      gameObjects.back()->addComponent<RectangleCollider>()->setDimensions(50, 50);
+      gameObjects.back()->update();
+    }
+
+    physicsManager.update(0.1f);
+
+    Assert::AreEqual(static_cast<size_t>(10), broadphase.getMovedCount());
+
+    gameObjects[3]->getTransform()->setTranslation(300, 5000);
+    physicsManager.update(0.1f);
+
+    Assert::AreEqual(static_cast<size_t>(10), broadphase.size());
+    Assert::AreEqual(static_cast<size_t>(1), broadphase.getMovedCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_ColliderDeactivatedThenReactivated_IsOnlyFoundWhileActive)
+  {
+    PhysicsManager physicsManager;
+
+    GameObject gameObject;
+    observer_ptr<RectangleCollider> collider = gameObject.addComponent<RectangleCollider>();
+    collider->setDimensions(10, 10);
+    gameObject.update();
+
+    AABB box(glm::vec2(-1), glm::vec2(1));
+    observer_ptr<Collider> colliders[1] = {};
+    size_t count = 0;
+
+    physicsManager.update(0.1f);
+
+    Assert::AreEqual(static_cast<size_t>(1), physicsManager.overlapBoxes(&box, 1, colliders, 1, &count));
+
+    collider->setActive(false);
+    physicsManager.update(0.1f);
+
+    Assert::AreEqual(static_cast<size_t>(0), physicsManager.overlapBoxes(&box, 1, colliders, 1, &count));
+
+    collider->setActive(true);
+    physicsManager.update(0.1f);
+
+    Assert::AreEqual(static_cast<size_t>(1), physicsManager.overlapBoxes(&box, 1, colliders, 1, &count));
+    Assert::IsTrue(collider == colliders[0]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_MoreBodiesThanOneNarrowphaseBatch_CallsCollisionForEveryBody)
+  {
+    PhysicsManager physicsManager;
+    std::vector<std::unique_ptr<GameObject>> gameObjects;
+    std::vector<observer_ptr<CollisionDetector>> detectors;
+
+    // Pairs of overlapping bodies, spaced out so that each pair only touches itself
+    for (int i = 0; i < 100; ++i)
+    {
+      for (int j = 0; j < 2; ++j)
+      {
+        gameObjects.push_back(std::make_unique<GameObject>());
+        gameObjects.back()->getTransform()->setTranslation(i * 1000.0f + j * 10.0f, 0);
+        detectors.push_back(gameObjects.back()->addComponent<CollisionDetector>());
+
+        observer_ptr<RectangleCollider> collider = gameObjects.back()->addComponent<RectangleCollider>();
+        collider->setDimensions(50, 50);
+        gameObjects.back()->update();
+
+        physicsManager.addSimulatedBody(*collider);
+      }
+    }
+
+    physicsManager.update(0.1f);
+
+    for (observer_ptr<CollisionDetector> detector : detectors)
+    {
+      Assert::AreEqual(static_cast<size_t>(1), detector->collisionEnterCount());
+      Assert::AreEqual(static_cast<size_t>(1), detector->collisionCount());
+    }
+  }
+
+#pragma endregion
+
+#pragma region Collision State Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_BodyRestingAgainstManyTriggers_CallsTriggerEnterOncePerTrigger)
+  {
+    PhysicsManager physicsManager;
+    GameObject gameObject;
+    observer_ptr<CollisionDetector> detector = gameObject.addComponent<CollisionDetector>();
+    observer_ptr<RectangleCollider> rectangleCollider = gameObject.addComponent<RectangleCollider>();
+    rectangleCollider->setDimensions(100, 200);
+
+    // Add scripts & components
+    gameObject.update();
+
+    std::vector<std::unique_ptr<GameObject>> triggers;
+    for (int i = 0; i < 50; ++i)
+    {
+      triggers.push_back(std::make_unique<GameObject>());
+      observer_ptr<RectangleCollider> trigger = triggers.back()->addComponent<RectangleCollider>();
+      trigger->setDimensions(10, 10);
+      trigger->setColliderType(Physics::ColliderType::kTrigger);
+    }
+
+    physicsManager.addSimulatedBody(*rectangleCollider);
+    physicsManager.update(0.1f);
+
+    Assert::AreEqual(static_cast<size_t>(50), detector->triggerEnterCount());
+    Assert::AreEqual(static_cast<size_t>(50), detector->triggerCount());
+
+    detector->reset();
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+      physicsManager.update(0.1f);
+    }
+
+    Assert::AreEqual(static_cast<size_t>(0), detector->triggerEnterCount());
+    Assert::AreEqual(static_cast<size_t>(150), detector->triggerCount());
+    Assert::AreEqual(static_cast<size_t>(0), detector->triggerExitCount());
+
+    // Moving away from half of them should exit exactly those
+    for (int i = 0; i < 25; ++i)
+    {
+      triggers[i]->getTransform()->setTranslation(5000, 5000);
+    }
+
+    detector->reset();
+    physicsManager.update(0.1f);
+
+    Assert::AreEqual(static_cast<size_t>(25), detector->triggerExitCount());
+    Assert::AreEqual(static_cast<size_t>(25), detector->triggerCount());
+    Assert::AreEqual(static_cast<size_t>(0), detector->triggerEnterCount());
+  }
+
+#pragma endregion
+
+#pragma region Bullet Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_FastNonBullet_PassesThroughThinCollider)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+
+    GameObject bullet;
+    observer_ptr<RigidBody2D> rigidBody = bullet.addComponent<RigidBody2D>();
+    rigidBody->setLinearVelocity(1000, 0);
+    observer_ptr<RectangleCollider> bulletCollider = bullet.addComponent<RectangleCollider>();
+    bulletCollider->setDimensions(2, 2);
+    physicsManager.addSimulatedBody(*bulletCollider, *rigidBody);
+
+    GameObject wall;
+    wall.getTransform()->setTranslation(100, 0);
+    wall.addComponent<RectangleCollider>()->setDimensions(2, 100);
+
+    physicsManager.update(1);
+
+    Assert::AreEqual(glm::vec3(1000, 0, 0), bullet.getTransform()->getTranslation());
+    Assert::AreEqual(glm::vec2(1000, 0), rigidBody->getLinearVelocity());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_FastBullet_StopsAtThinCollider_SlidesAlongIt_AndCallsCollisionEnter)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+
+    GameObject bullet;
+    observer_ptr<CollisionDetector> detector = bullet.addComponent<CollisionDetector>();
+    observer_ptr<RigidBody2D> rigidBody = bullet.addComponent<RigidBody2D>();
+    rigidBody->setLinearVelocity(1000, 5);
+    rigidBody->setBullet(true);
+    observer_ptr<RectangleCollider> bulletCollider = bullet.addComponent<RectangleCollider>();
+    bulletCollider->setDimensions(2, 2);
+    physicsManager.addSimulatedBody(*bulletCollider, *rigidBody);
+
+    // Add scripts & components
+    bullet.update();
+
+    GameObject wall;
+    wall.getTransform()->setTranslation(100, 0);
+    wall.addComponent<RectangleCollider>()->setDimensions(2, 100);
+
+    physicsManager.update(1);
+
+    // Bullet's right edge (x + 1) ends touching the wall's left edge (99), having moved 0.098 of the way,
+    // then slides up the wall for the rest of the frame
+    Assert::AreEqual(98.0f, bullet.getTransform()->getTranslation().x, 0.001f);
+    Assert::AreEqual(5.0f, bullet.getTransform()->getTranslation().y, 0.001f);
+    Assert::AreEqual(glm::vec2(0, 5), rigidBody->getLinearVelocity());
+    Assert::AreEqual(static_cast<size_t>(1), detector->collisionEnterCount());
+    Assert::AreEqual(static_cast<size_t>(1), detector->collisionCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_FastBullet_HitsSimulatedCollider_CallsCollisionEnterOnBothSides)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+
+    GameObject bullet;
+    observer_ptr<CollisionDetector> bulletDetector = bullet.addComponent<CollisionDetector>();
+    observer_ptr<RigidBody2D> rigidBody = bullet.addComponent<RigidBody2D>();
+    rigidBody->setLinearVelocity(1000, 0);
+    rigidBody->setBullet(true);
+    observer_ptr<RectangleCollider> bulletCollider = bullet.addComponent<RectangleCollider>();
+    bulletCollider->setDimensions(2, 2);
+    physicsManager.addSimulatedBody(*bulletCollider, *rigidBody);
+
+    GameObject wall;
+    observer_ptr<CollisionDetector> wallDetector = wall.addComponent<CollisionDetector>();
+    wall.getTransform()->setTranslation(100, 0);
+    observer_ptr<RectangleCollider> wallCollider = wall.addComponent<RectangleCollider>();
+    wallCollider->setDimensions(2, 100);
+    physicsManager.addSimulatedBody(*wallCollider);
+
+    // Add scripts & components
+    bullet.update();
+    wall.update();
+
+    physicsManager.update(1);
+
+    Assert::AreEqual(98.0f, bullet.getTransform()->getTranslation().x, 0.001f);
+    Assert::AreEqual(static_cast<size_t>(1), bulletDetector->collisionEnterCount());
+    Assert::AreEqual(static_cast<size_t>(1), bulletDetector->collisionCount());
+    Assert::AreEqual(static_cast<size_t>(1), wallDetector->collisionEnterCount());
+    Assert::AreEqual(static_cast<size_t>(1), wallDetector->collisionCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_FastBullet_PassesThroughEmptyCornerOfEllipseBounds)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+
+    GameObject bullet;
+    bullet.getTransform()->setTranslation(80, 54);
+    observer_ptr<RigidBody2D> rigidBody = bullet.addComponent<RigidBody2D>();
+    rigidBody->setLinearVelocity(60, -60);
+    rigidBody->setBullet(true);
+    observer_ptr<RectangleCollider> bulletCollider = bullet.addComponent<RectangleCollider>();
+    bulletCollider->setDimensions(2, 2);
+    physicsManager.addSimulatedBody(*bulletCollider, *rigidBody);
+
+    // The bullet's path crosses the circle's bounding box, but passes more than its radius from the centre
+    GameObject ball;
+    ball.getTransform()->setTranslation(100, 0);
+    ball.addComponent<EllipseCollider>()->setDimensions(20);
+
+    physicsManager.update(1);
+
+    Assert::AreEqual(140.0f, bullet.getTransform()->getTranslation().x, 0.001f);
+    Assert::AreEqual(-6.0f, bullet.getTransform()->getTranslation().y, 0.001f);
+    Assert::AreEqual(glm::vec2(60, -60), rigidBody->getLinearVelocity());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_FastBullet_StopsAtNearestOfSeveralColliders)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+
+    GameObject bullet;
+    observer_ptr<RigidBody2D> rigidBody = bullet.addComponent<RigidBody2D>();
+    rigidBody->setLinearVelocity(-1000, 0);
+    rigidBody->setBullet(true);
+    observer_ptr<RectangleCollider> bulletCollider = bullet.addComponent<RectangleCollider>();
+    bulletCollider->setDimensions(2, 2);
+    physicsManager.addSimulatedBody(*bulletCollider, *rigidBody);
+
+    std::vector<std::unique_ptr<GameObject>> walls;
+    for (float x : { -300.0f, -50.0f, -200.0f })
+    {
+      walls.push_back(std::make_unique<GameObject>());
+      walls.back()->getTransform()->setTranslation(x, 0);
+      walls.back()->addComponent<RectangleCollider>()->setDimensions(2, 100);
+    }
+
+    physicsManager.update(1);
+
+    Assert::AreEqual(-48.0f, bullet.getTransform()->getTranslation().x, 0.001f);
+    Assert::AreEqual(glm::vec2(0, 0), rigidBody->getLinearVelocity());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_FastBullet_PassesThroughTriggers)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+
+    GameObject bullet;
+    observer_ptr<RigidBody2D> rigidBody = bullet.addComponent<RigidBody2D>();
+    rigidBody->setLinearVelocity(1000, 0);
+    rigidBody->setBullet(true);
+    observer_ptr<RectangleCollider> bulletCollider = bullet.addComponent<RectangleCollider>();
+    bulletCollider->setDimensions(2, 2);
+    physicsManager.addSimulatedBody(*bulletCollider, *rigidBody);
+
+    GameObject trigger;
+    trigger.getTransform()->setTranslation(100, 0);
+    observer_ptr<RectangleCollider> triggerCollider = trigger.addComponent<RectangleCollider>();
+    triggerCollider->setDimensions(2, 100);
+    triggerCollider->setColliderType(ColliderType::kTrigger);
+
+    physicsManager.update(1);
+
+    Assert::AreEqual(glm::vec3(1000, 0, 0), bullet.getTransform()->getTranslation());
+  }
+
+#pragma endregion
+
+#pragma region Sleeping Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Constructor_EnablesSleeping)
+  {
+    PhysicsManager physicsManager;
+
+    Assert::IsTrue(physicsManager.isSleepingEnabled());
+    Assert::AreEqual(static_cast<size_t>(30), physicsManager.getSleepFrameCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_IdleBody_FallsAsleepAfterSleepFrameCount)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+    physicsManager.setSleepFrameCount(3);
+
+    GameObject gameObject;
+    observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+    observer_ptr<RectangleCollider> collider = gameObject.addComponent<RectangleCollider>();
+    collider->setDimensions(10, 10);
+    physicsManager.addSimulatedBody(*collider, *rigidBody);
+
+    physicsManager.update(0.1f);
+    physicsManager.update(0.1f);
+
+    Assert::IsTrue(rigidBody->isAwake());
+
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(rigidBody->isAwake());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_RigidBodyDestroyed_RemainingBodiesKeepMoving)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+
+    GameObject first, second;
+    observer_ptr<RigidBody2D> firstBody = first.addComponent<RigidBody2D>();
+    firstBody->setLinearVelocity(10, 0);
+    observer_ptr<RigidBody2D> secondBody = second.addComponent<RigidBody2D>();
+    secondBody->setLinearVelocity(0, 10);
+    physicsManager.addSimulatedBody(*firstBody);
+    physicsManager.addSimulatedBody(*secondBody);
+
+    physicsManager.update(0.1f);
+    physicsManager.clearSimulatedBodies();
+    delete firstBody;
+    physicsManager.update(0.1f);
+
+    Assert::AreEqual(2.0f, second.getTransform()->getTranslation().y, 0.001f);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_MovingBody_StaysAwake)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+    physicsManager.setSleepFrameCount(3);
+
+    GameObject gameObject;
+    observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+    rigidBody->setLinearVelocity(10, 0);
+    physicsManager.addSimulatedBody(*rigidBody);
+
+    for (int frame = 0; frame < 10; ++frame)
+    {
+      physicsManager.update(0.1f);
+    }
+
+    Assert::IsTrue(rigidBody->isAwake());
+    Assert::AreEqual(10.0f, gameObject.getTransform()->getTranslation().x, 0.001f);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_SleepingBody_IsNotMovedOrAffectedByGravity)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+    physicsManager.setSleepFrameCount(1);
+
+    GameObject gameObject;
+    observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+    physicsManager.addSimulatedBody(*rigidBody);
+
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(rigidBody->isAwake());
+
+    physicsManager.setGravityScale(9.81f);
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(rigidBody->isAwake());
+    Assert::AreEqual(glm::vec2(), rigidBody->getLinearVelocity());
+    Assert::AreEqual(glm::vec3(), gameObject.getTransform()->getTranslation());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_SleepingBody_TransformChanged_WakesBody)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+    physicsManager.setSleepFrameCount(1);
+
+    GameObject gameObject;
+    observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+    physicsManager.addSimulatedBody(*rigidBody);
+
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(rigidBody->isAwake());
+
+    // Stays awake for this frame, as it has not been idle for long enough since it woke
+    gameObject.getTransform()->setTranslation(100, 0);
+    physicsManager.setSleepFrameCount(2);
+    physicsManager.update(0.1f);
+
+    Assert::IsTrue(rigidBody->isAwake());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_SleepingBody_VelocitySet_WakesAndMovesBody)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+    physicsManager.setSleepFrameCount(1);
+
+    GameObject gameObject;
+    observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+    physicsManager.addSimulatedBody(*rigidBody);
+
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(rigidBody->isAwake());
+
+    rigidBody->setLinearVelocity(10, 0);
+    physicsManager.update(0.1f);
+
+    Assert::IsTrue(rigidBody->isAwake());
+    Assert::AreEqual(1.0f, gameObject.getTransform()->getTranslation().x, 0.001f);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_SleepingBody_HitByMovingBody_Wakes)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+    physicsManager.setSleepFrameCount(1);
+
+    GameObject sleeper;
+    observer_ptr<RigidBody2D> sleeperBody = sleeper.addComponent<RigidBody2D>();
+    observer_ptr<RectangleCollider> sleeperCollider = sleeper.addComponent<RectangleCollider>();
+    sleeperCollider->setDimensions(10, 10);
+    physicsManager.addSimulatedBody(*sleeperCollider, *sleeperBody);
+
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(sleeperBody->isAwake());
+
+    GameObject mover;
+    mover.getTransform()->setTranslation(3, 6);
+    observer_ptr<RigidBody2D> moverBody = mover.addComponent<RigidBody2D>();
+    moverBody->setLinearVelocity(10, 0);
+    observer_ptr<RectangleCollider> moverCollider = mover.addComponent<RectangleCollider>();
+    moverCollider->setDimensions(10, 10);
+    physicsManager.addSimulatedBody(*moverCollider, *moverBody);
+
+    physicsManager.update(0.1f);
+
+    Assert::IsTrue(sleeperBody->isAwake());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_TouchingBodies_SleepAndWakeAsIsland)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+    physicsManager.setSleepFrameCount(2);
+    physicsManager.setSleepLinearVelocity(0.1f);
+
+    GameObject bottom;
+    observer_ptr<RigidBody2D> bottomBody = bottom.addComponent<RigidBody2D>();
+    observer_ptr<RectangleCollider> bottomCollider = bottom.addComponent<RectangleCollider>();
+    bottomCollider->setDimensions(10, 10);
+    physicsManager.addSimulatedBody(*bottomCollider, *bottomBody);
+
+    GameObject top;
+    top.getTransform()->setTranslation(1, 9);
+    observer_ptr<RigidBody2D> topBody = top.addComponent<RigidBody2D>();
+    topBody->setLinearVelocity(0.5f, 0);
+    observer_ptr<RectangleCollider> topCollider = top.addComponent<RectangleCollider>();
+    topCollider->setDimensions(10, 10);
+    physicsManager.addSimulatedBody(*topCollider, *topBody);
+
+    for (int frame = 0; frame < 5; ++frame)
+    {
+      physicsManager.update(0.1f);
+    }
+
+    // The bottom body is idle, but is kept awake by the moving body resting on it
+    Assert::IsTrue(bottomBody->isAwake());
+    Assert::IsTrue(topBody->isAwake());
+
+    topBody->setLinearVelocity(0, 0);
+    physicsManager.update(0.1f);
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(bottomBody->isAwake());
+    Assert::IsFalse(topBody->isAwake());
+
+    // Disturbing either body wakes the whole island
+    bottomBody->setAwake(true);
+    physicsManager.update(0.1f);
+
+    Assert::IsTrue(bottomBody->isAwake());
+    Assert::IsTrue(topBody->isAwake());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_BodyFallsAsleepAgainstSleepingBody_WakesWithIt)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+    physicsManager.setSleepFrameCount(1);
+
+    GameObject first;
+    observer_ptr<RigidBody2D> firstBody = first.addComponent<RigidBody2D>();
+    observer_ptr<RectangleCollider> firstCollider = first.addComponent<RectangleCollider>();
+    firstCollider->setDimensions(10, 10);
+    physicsManager.addSimulatedBody(*firstCollider, *firstBody);
+
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(firstBody->isAwake());
+
+    GameObject second;
+    second.getTransform()->setTranslation(100, 0);
+    observer_ptr<RigidBody2D> secondBody = second.addComponent<RigidBody2D>();
+    observer_ptr<RectangleCollider> secondCollider = second.addComponent<RectangleCollider>();
+    secondCollider->setDimensions(10, 10);
+    physicsManager.addSimulatedBody(*secondCollider, *secondBody);
+    physicsManager.setSleepFrameCount(3);
+
+    physicsManager.update(0.1f);
+    physicsManager.update(0.1f);
+
+    Assert::IsTrue(secondBody->isAwake());
+
+    // Comes to rest against the sleeping body on the frame it has been idle for long enough
+    second.getTransform()->setTranslation(0, 9);
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(firstBody->isAwake());
+    Assert::IsFalse(secondBody->isAwake());
+
+    firstBody->setAwake(true);
+    physicsManager.update(0.1f);
+
+    Assert::IsTrue(firstBody->isAwake());
+    Assert::IsTrue(secondBody->isAwake());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_SleepingBody_ColliderNotSyncedOrRebroadphased)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+    physicsManager.setSleepFrameCount(1);
+
+    GameObject gameObject;
+    observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+    observer_ptr<RectangleCollider> collider = gameObject.addComponent<RectangleCollider>();
+    collider->setDimensions(10, 10);
+    physicsManager.addSimulatedBody(*collider, *rigidBody);
+
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(rigidBody->isAwake());
+    Assert::IsTrue(collider->isSleeping());
+
+    // Still found by queries while asleep
+    AABB box(glm::vec2(-1), glm::vec2(1));
+    observer_ptr<Collider> colliders[2] = {};
+    size_t count = 0;
+
+    Assert::AreEqual(static_cast<size_t>(1), physicsManager.overlapBoxes(&box, 1, colliders, 2, &count));
+    Assert::IsTrue(collider == colliders[0]);
+
+    physicsManager.setSleepFrameCount(2);
+    rigidBody->setAwake(true);
+    physicsManager.update(0.1f);
+
+    Assert::IsFalse(collider->isSleeping());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_SleepingDisabled_IdleBodyStaysAwake)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setGravityScale(0);
+    physicsManager.setSleepFrameCount(1);
+    physicsManager.setSleepingEnabled(false);
+
+    GameObject gameObject;
+    observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+    physicsManager.addSimulatedBody(*rigidBody);
+
+    physicsManager.update(0.1f);
+    physicsManager.update(0.1f);
+
+    Assert::IsTrue(rigidBody->isAwake());
+  }
+
+#pragma endregion
+
+#pragma region Query Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Raycast_ReturnsNearestHit_AndPoint)
+  {
+    PhysicsManager physicsManager;
+
+    GameObject farthest;
+    farthest.getTransform()->setTranslation(50, 0);
+    farthest.addComponent<RectangleCollider>()->setDimensions(2, 10);
+
+    GameObject nearest;
+    nearest.getTransform()->setTranslation(20, 0);
+    observer_ptr<RectangleCollider> nearestCollider = nearest.addComponent<RectangleCollider>();
+    nearestCollider->setDimensions(2, 10);
+
+    physicsManager.update(0);
+
+    RaycastQuery rays[2] = { { glm::vec2(0, 0), glm::vec2(100, 0) }, { glm::vec2(0, 20), glm::vec2(100, 20) } };
+    RaycastHit hits[2];
+    physicsManager.raycast(rays, 2, hits);
+
+    Assert::IsTrue(hits[0].isHit());
+    Assert::IsTrue(nearestCollider == hits[0].m_collider);
+    Assert::AreEqual(0.19f, hits[0].m_fraction, 0.0001f);
+    Assert::AreEqual(19.0f, hits[0].m_point.x, 0.001f);
+    Assert::AreEqual(0.0f, hits[0].m_point.y, 0.001f);
+    Assert::IsFalse(hits[1].isHit());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Raycast_IgnoresTriggers_UnlessIncluded)
+  {
+    PhysicsManager physicsManager;
+
+    GameObject trigger;
+    trigger.getTransform()->setTranslation(20, 0);
+    observer_ptr<RectangleCollider> triggerCollider = trigger.addComponent<RectangleCollider>();
+    triggerCollider->setDimensions(2, 10);
+    triggerCollider->setColliderType(ColliderType::kTrigger);
+
+    physicsManager.update(0);
+
+    RaycastQuery ray{ glm::vec2(0, 0), glm::vec2(100, 0) };
+    RaycastHit hit;
+
+    physicsManager.raycast(&ray, 1, &hit);
+    Assert::IsFalse(hit.isHit());
+
+    physicsManager.raycast(&ray, 1, &hit, true);
+    Assert::IsTrue(triggerCollider == hit.m_collider);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_OverlapBoxes_PacksResultsPerQuery)
+  {
+    PhysicsManager physicsManager;
+
+    GameObject left;
+    observer_ptr<RectangleCollider> leftCollider = left.addComponent<RectangleCollider>();
+    leftCollider->setDimensions(2, 2);
+
+    GameObject right;
+    right.getTransform()->setTranslation(10, 0);
+    observer_ptr<RectangleCollider> rightCollider = right.addComponent<RectangleCollider>();
+    rightCollider->setDimensions(2, 2);
+
+    physicsManager.update(0);
+
+    AABB boxes[3] = { AABB::fromCentre(glm::vec2(5, 0), glm::vec2(20, 4)), AABB::fromCentre(glm::vec2(100, 0), glm::vec2(2, 2)), AABB::fromCentre(glm::vec2(10, 0), glm::vec2(2, 2)) };
+    observer_ptr<Collider> colliders[8] = {};
+    size_t counts[3] = {};
+
+    Assert::AreEqual(static_cast<size_t>(3), physicsManager.overlapBoxes(boxes, 3, colliders, 8, counts));
+    Assert::AreEqual(static_cast<size_t>(2), counts[0]);
+    Assert::AreEqual(static_cast<size_t>(0), counts[1]);
+    Assert::AreEqual(static_cast<size_t>(1), counts[2]);
+    Assert::IsTrue(rightCollider == colliders[2]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_OverlapBoxes_StopsWritingAtCapacity)
+  {
+    PhysicsManager physicsManager;
+
+    GameObject left;
+    left.addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    GameObject right;
+    right.getTransform()->setTranslation(1, 0);
+    right.addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    physicsManager.update(0);
+
+    AABB boxes[2] = { AABB::fromCentre(glm::vec2(), glm::vec2(10, 10)), AABB::fromCentre(glm::vec2(), glm::vec2(10, 10)) };
+    observer_ptr<Collider> colliders[3] = {};
+    size_t counts[2] = {};
+
+    Assert::AreEqual(static_cast<size_t>(3), physicsManager.overlapBoxes(boxes, 2, colliders, 3, counts));
+    Assert::AreEqual(static_cast<size_t>(2), counts[0]);
+    Assert::AreEqual(static_cast<size_t>(1), counts[1]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_OverlapCircles_DoesNotReturnCollidersOnlyInsideCircleBounds)
+  {
+    PhysicsManager physicsManager;
+
+    // Inside the corner of the circle's bounding box, but outside the circle itself
+    GameObject corner;
+    corner.getTransform()->setTranslation(9, 9);
+    corner.addComponent<RectangleCollider>()->setDimensions(1, 1);
+
+    GameObject inside;
+    inside.getTransform()->setTranslation(5, 0);
+    observer_ptr<RectangleCollider> insideCollider = inside.addComponent<RectangleCollider>();
+    insideCollider->setDimensions(1, 1);
+
+    physicsManager.update(0);
+
+    CircleQuery circle{ glm::vec2(), 10 };
+    observer_ptr<Collider> colliders[4] = {};
+    size_t count = 0;
+
+    Assert::AreEqual(static_cast<size_t>(1), physicsManager.overlapCircles(&circle, 1, colliders, 4, &count));
+    Assert::IsTrue(insideCollider == colliders[0]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Raycast_ColliderDestroyedSinceUpdate_IsNotHit)
+  {
+    PhysicsManager physicsManager;
+
+    std::unique_ptr<GameObject> nearest = std::make_unique<GameObject>();
+    nearest->getTransform()->setTranslation(20, 0);
+    nearest->addComponent<RectangleCollider>()->setDimensions(2, 10);
+
+    GameObject farthest;
+    farthest.getTransform()->setTranslation(50, 0);
+    observer_ptr<RectangleCollider> farthestCollider = farthest.addComponent<RectangleCollider>();
+    farthestCollider->setDimensions(2, 10);
+
+    physicsManager.update(0);
+
+    // Destroyed in the same frame, before the next update rebuilds the broadphase
+    nearest.reset();
+
+    RaycastQuery ray{ glm::vec2(0, 0), glm::vec2(100, 0) };
+    RaycastHit hit;
+    physicsManager.raycast(&ray, 1, &hit);
+
+    Assert::IsTrue(farthestCollider == hit.m_collider);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_OverlapBoxes_ColliderDestroyedSinceUpdate_IsNotReturned)
+  {
+    PhysicsManager physicsManager;
+
+    std::unique_ptr<GameObject> destroyed = std::make_unique<GameObject>();
+    destroyed->addComponent<RectangleCollider>()->setDimensions(2, 2);
+
+    GameObject kept;
+    observer_ptr<RectangleCollider> keptCollider = kept.addComponent<RectangleCollider>();
+    keptCollider->setDimensions(2, 2);
+
+    physicsManager.update(0);
+    destroyed.reset();
+
+    AABB box = AABB::fromCentre(glm::vec2(), glm::vec2(10, 10));
+    observer_ptr<Collider> colliders[4] = {};
+    size_t count = 0;
+
+    Assert::AreEqual(static_cast<size_t>(1), physicsManager.overlapBoxes(&box, 1, colliders, 4, &count));
+    Assert::IsTrue(keptCollider == colliders[0]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_OverlapBoxes_ColliderCreatedSinceUpdate_IsReturned)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.update(0);
+
+    GameObject created;
+    observer_ptr<RectangleCollider> createdCollider = created.addComponent<RectangleCollider>();
+    createdCollider->setDimensions(2, 2);
+
+    AABB box = AABB::fromCentre(glm::vec2(), glm::vec2(10, 10));
+    observer_ptr<Collider> colliders[4] = {};
+    size_t count = 0;
+
+    Assert::AreEqual(static_cast<size_t>(1), physicsManager.overlapBoxes(&box, 1, colliders, 4, &count));
+    Assert::IsTrue(createdCollider == colliders[0]);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_OverlapCircles_ColliderDeactivatedSinceUpdate_IsNotReturned)
+  {
+    PhysicsManager physicsManager;
+
+    GameObject gameObject;
+    observer_ptr<RectangleCollider> collider = gameObject.addComponent<RectangleCollider>();
+    collider->setDimensions(2, 2);
+
+    physicsManager.update(0);
+    collider->setActive(false);
+
+    CircleQuery circle{ glm::vec2(), 10 };
+    observer_ptr<Collider> colliders[4] = {};
+    size_t count = 0;
+
+    Assert::AreEqual(static_cast<size_t>(0), physicsManager.overlapCircles(&circle, 1, colliders, 4, &count));
+  }
+
+#pragma endregion
+
+#pragma region Deterministic Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Constructor_IsNotDeterministic)
+  {
+    PhysicsManager physicsManager;
+
+    Assert::IsFalse(physicsManager.isDeterministic());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_Deterministic_CallsCollisionForEveryBody)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setDeterministic(true);
+
+    std::vector<std::unique_ptr<GameObject>> gameObjects;
+    std::vector<observer_ptr<CollisionDetector>> detectors;
+
+    // More bodies than one narrowphase batch, all of which must still be tested on the one thread
+    for (int i = 0; i < 40; ++i)
+    {
+      for (int j = 0; j < 2; ++j)
+      {
+        gameObjects.push_back(std::make_unique<GameObject>());
+        gameObjects.back()->getTransform()->setTranslation(i * 1000.0f + j * 10.0f, 0);
+        detectors.push_back(gameObjects.back()->addComponent<CollisionDetector>());
+
+        observer_ptr<RectangleCollider> collider = gameObjects.back()->addComponent<RectangleCollider>();
+        collider->setDimensions(50, 50);
+        gameObjects.back()->update();
+
+        physicsManager.addSimulatedBody(*collider);
+      }
+    }
+
+    physicsManager.update(0.1f);
+
+    for (observer_ptr<CollisionDetector> detector : detectors)
+    {
+      Assert::AreEqual(static_cast<size_t>(1), detector->collisionEnterCount());
+      Assert::AreEqual(static_cast<size_t>(1), detector->collisionCount());
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(PhysicsManager_Update_Deterministic_StillMovesBodiesAndAppliesGravity)
+  {
+    PhysicsManager physicsManager;
+    physicsManager.setDeterministic(true);
+    physicsManager.setSleepingEnabled(false);
+
+    std::vector<std::unique_ptr<GameObject>> gameObjects;
+    std::vector<observer_ptr<RigidBody2D>> rigidBodies;
+
+    for (int i = 0; i < 6; ++i)
+    {
+      gameObjects.push_back(std::make_unique<GameObject>());
+      rigidBodies.push_back(gameObjects.back()->addComponent<RigidBody2D>());
+      rigidBodies.back()->setLinearVelocity(static_cast<float>(i), 0);
+      physicsManager.addSimulatedBody(*rigidBodies.back());
+    }
+
+    physicsManager.update(1);
+
+    for (int i = 0; i < 6; ++i)
+    {
+      Assert::AreEqual(glm::vec3(static_cast<float>(i), 0, 0), gameObjects[i]->getTransform()->getTranslation());
+      Assert::AreEqual(-9.81f * 40, rigidBodies[i]->getLinearVelocity().y, 0.001f);
+    }
+  }
+
 #pragma endregion
 
   };
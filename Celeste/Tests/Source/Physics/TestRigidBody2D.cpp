@@ -51,6 +51,8 @@ namespace TestCeleste
       Assert::AreEqual(0.0f, rigidBody2D.getAngularVelocity());
       Assert::AreEqual(-FLT_MAX, rigidBody2D.getMinAngularVelocity());
       Assert::AreEqual(FLT_MAX, rigidBody2D.getMaxAngularVelocity());
+      Assert::IsFalse(rigidBody2D.isBullet());
+      Assert::IsTrue(rigidBody2D.isAwake());
     }
 
 #pragma endregion
@@ -371,6 +373,28 @@ namespace TestCeleste
       Assert::AreEqual(2.1f, rigidBody.getAngularVelocity());
     }
 
+#pragma endregion
+
+#pragma region Set Awake Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBody2D_SetAwake_False_ZeroesVelocities)
+    {
+      GameObject gameObject;
+      RigidBody2D rigidBody(gameObject);
+      rigidBody.setLinearVelocity(1, 2);
+      rigidBody.setAngularVelocity(3);
+      rigidBody.setAwake(false);
+
+      Assert::IsFalse(rigidBody.isAwake());
+      Assert::AreEqual(glm::vec2(), rigidBody.getLinearVelocity());
+      Assert::AreEqual(0.0f, rigidBody.getAngularVelocity());
+
+      rigidBody.setAwake(true);
+
+      Assert::IsTrue(rigidBody.isAwake());
+    }
+
 #pragma endregion
   };
 }
\ No newline at end of file
@@ -0,0 +1,377 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Objects/GameObject.h"
+#include "Physics/RigidBody2D.h"
+#include "Physics/RigidBodyIntegrator.h"
+#include "TestUtils/Assert/AssertExt.h"
+
+#include <chrono>
+
+using namespace Celeste;
+
+
+namespace TestCeleste
+{
+  using namespace Celeste::Physics;
+
+  CELESTE_TEST_CLASS(TestRigidBodyIntegrator)
+
+#pragma region Add Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Add_CopiesBodyAndTransformState)
+    {
+      GameObject gameObject;
+      gameObject.getTransform()->setTranslation(1, 2, 3);
+      gameObject.getTransform()->setRotation(0.5f);
+      observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+      rigidBody->setLinearVelocity(10, 20);
+
+      RigidBodyIntegrator integrator;
+      size_t index = integrator.add(*rigidBody);
+
+      Assert::AreEqual(static_cast<size_t>(0), index);
+      Assert::AreEqual(static_cast<size_t>(1), integrator.size());
+      Assert::AreEqual(glm::vec2(1, 2), integrator.getPosition(index));
+      Assert::AreEqual(0.5f, integrator.getRotation(index));
+      Assert::AreEqual(glm::vec2(10, 20), integrator.getLinearVelocity(index));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Clear_RemovesAllBodies)
+    {
+      GameObject gameObject;
+      observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+
+      RigidBodyIntegrator integrator;
+      integrator.add(*rigidBody);
+      integrator.clear();
+
+      Assert::AreEqual(static_cast<size_t>(0), integrator.size());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Remove_MovesLastBodyIntoItsPlace)
+    {
+      GameObject first, second, third;
+      third.getTransform()->setTranslation(5, 6);
+
+      RigidBodyIntegrator integrator;
+      integrator.add(*first.addComponent<RigidBody2D>());
+      integrator.add(*second.addComponent<RigidBody2D>());
+      integrator.add(*third.addComponent<RigidBody2D>());
+
+      integrator.remove(0);
+
+      Assert::AreEqual(static_cast<size_t>(2), integrator.size());
+      Assert::IsTrue(third.findComponent<RigidBody2D>() == &integrator.getRigidBody(0));
+      Assert::AreEqual(glm::vec2(5, 6), integrator.getPosition(0));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Remove_RemovedBodyIsNoLongerMoved)
+    {
+      const size_t count = 6;
+      std::vector<std::unique_ptr<GameObject>> gameObjects;
+      RigidBodyIntegrator integrator;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        gameObjects.push_back(std::make_unique<GameObject>());
+        observer_ptr<RigidBody2D> rigidBody = gameObjects.back()->addComponent<RigidBody2D>();
+        rigidBody->setLinearVelocity(1, 1);
+        integrator.add(*rigidBody);
+      }
+
+      integrator.remove(count - 1);
+      integrator.integrate(1, glm::vec2());
+      integrator.scatter();
+
+      Assert::AreEqual(glm::vec3(), gameObjects.back()->getTransform()->getTranslation());
+      Assert::AreEqual(glm::vec3(1, 1, 0), gameObjects.front()->getTransform()->getTranslation());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Gather_CopiesCurrentStateAndClearsGravity)
+    {
+      GameObject gameObject;
+      observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+
+      RigidBodyIntegrator integrator;
+      size_t index = integrator.add(*rigidBody);
+      integrator.setAffectedByGravity(index);
+
+      gameObject.getTransform()->setTranslation(3, 4);
+      rigidBody->setLinearVelocity(1, 2);
+      integrator.gather(index);
+      integrator.integrate(1, glm::vec2(0, -10));
+
+      Assert::AreEqual(glm::vec2(4, 6), integrator.getPosition(index));
+      Assert::AreEqual(glm::vec2(1, 2), integrator.getLinearVelocity(index));
+    }
+
+#pragma endregion
+
+#pragma region Integrate Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Integrate_MovesEveryBodyTheSameAsRigidBodyUpdate)
+    {
+      // Enough bodies to cover both the vectorised loop and the remainder
+      const size_t count = 11;
+      std::vector<std::unique_ptr<GameObject>> integrated, updated;
+      RigidBodyIntegrator integrator;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        float f = static_cast<float>(i);
+        integrated.push_back(std::make_unique<GameObject>());
+        updated.push_back(std::make_unique<GameObject>());
+
+        for (GameObject* gameObject : { integrated.back().get(), updated.back().get() })
+        {
+          gameObject->getTransform()->setTranslation(f, -f, 5);
+          observer_ptr<RigidBody2D> rigidBody = gameObject->addComponent<RigidBody2D>();
+          rigidBody->setLinearVelocity(f * 10, 100 - f);
+          rigidBody->setAngularVelocity(f * 0.1f);
+        }
+
+        integrator.add(*integrated.back()->findComponent<RigidBody2D>());
+        updated.back()->findComponent<RigidBody2D>()->update(0.5f);
+      }
+
+      integrator.integrate(0.5f, glm::vec2());
+      integrator.scatter();
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        AssertExt::AreAlmostEqual(updated[i]->getTransform()->getTranslation(), integrated[i]->getTransform()->getTranslation());
+        Assert::AreEqual(updated[i]->getTransform()->getRotation(), integrated[i]->getTransform()->getRotation(), 0.0001f);
+      }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Integrate_NotVectorised_GivesSameResultsAsVectorised)
+    {
+      const size_t count = 11;
+      std::vector<std::unique_ptr<GameObject>> gameObjects;
+      RigidBodyIntegrator vectorised, scalar;
+      scalar.setVectorised(false);
+
+      Assert::IsTrue(vectorised.isVectorised());
+      Assert::IsFalse(scalar.isVectorised());
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        float f = static_cast<float>(i);
+        gameObjects.push_back(std::make_unique<GameObject>());
+        gameObjects.back()->getTransform()->setTranslation(f, -f);
+        observer_ptr<RigidBody2D> rigidBody = gameObjects.back()->addComponent<RigidBody2D>();
+        rigidBody->setLinearVelocity(f * 10, 100 - f);
+        rigidBody->setAngularVelocity(f * 0.1f);
+
+        vectorised.setAffectedByGravity(vectorised.add(*rigidBody));
+        scalar.setAffectedByGravity(scalar.add(*rigidBody));
+      }
+
+      vectorised.integrate(0.5f, glm::vec2(0, -3));
+      scalar.integrate(0.5f, glm::vec2(0, -3));
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        Assert::AreEqual(vectorised.getPosition(i).x, scalar.getPosition(i).x, 0.0001f);
+        Assert::AreEqual(vectorised.getPosition(i).y, scalar.getPosition(i).y, 0.0001f);
+        Assert::AreEqual(vectorised.getLinearVelocity(i).y, scalar.getLinearVelocity(i).y, 0.0001f);
+        Assert::AreEqual(vectorised.getRotation(i), scalar.getRotation(i), 0.0001f);
+      }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Integrate_OnlyAcceleratesBodiesAffectedByGravity)
+    {
+      const size_t count = 6;
+      std::vector<std::unique_ptr<GameObject>> gameObjects;
+      RigidBodyIntegrator integrator;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        gameObjects.push_back(std::make_unique<GameObject>());
+        observer_ptr<RigidBody2D> rigidBody = gameObjects.back()->addComponent<RigidBody2D>();
+        rigidBody->setLinearVelocity(0, 10);
+
+        size_t index = integrator.add(*rigidBody);
+        if (i % 2 == 0)
+        {
+          integrator.setAffectedByGravity(index);
+        }
+      }
+
+      integrator.integrate(1, glm::vec2(0, -4));
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        // Gravity is applied after moving, so it only shows up in the position next frame
+        Assert::AreEqual(glm::vec2(0, 10), integrator.getPosition(i));
+        Assert::AreEqual(glm::vec2(0, i % 2 == 0 ? 6.0f : 10.0f), integrator.getLinearVelocity(i));
+      }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Integrate_ClampsAcceleratedVelocityToLimits)
+    {
+      const size_t count = 5;
+      std::vector<std::unique_ptr<GameObject>> gameObjects;
+      RigidBodyIntegrator integrator;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        gameObjects.push_back(std::make_unique<GameObject>());
+        observer_ptr<RigidBody2D> rigidBody = gameObjects.back()->addComponent<RigidBody2D>();
+        rigidBody->setMinLinearVelocity(glm::vec2(-1, -2));
+        rigidBody->setMaxLinearVelocity(glm::vec2(1, 2));
+
+        integrator.setAffectedByGravity(integrator.add(*rigidBody));
+      }
+
+      integrator.integrate(1, glm::vec2(100, -100));
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        Assert::AreEqual(glm::vec2(1, -2), integrator.getLinearVelocity(i));
+      }
+    }
+
+#pragma endregion
+
+#pragma region Scatter Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Scatter_WritesVelocityBackToBodiesAffectedByGravityOnly)
+    {
+      GameObject affected, unaffected;
+      observer_ptr<RigidBody2D> affectedBody = affected.addComponent<RigidBody2D>();
+      observer_ptr<RigidBody2D> unaffectedBody = unaffected.addComponent<RigidBody2D>();
+
+      RigidBodyIntegrator integrator;
+      integrator.setAffectedByGravity(integrator.add(*affectedBody));
+      integrator.add(*unaffectedBody);
+
+      integrator.integrate(1, glm::vec2(0, -5));
+
+      // Anything setting the velocity of an unaffected body between the integrate and scatter is respected
+      unaffectedBody->setLinearVelocity(3, 3);
+      integrator.scatter();
+
+      Assert::AreEqual(glm::vec2(0, -5), affectedBody->getLinearVelocity());
+      Assert::AreEqual(glm::vec2(3, 3), unaffectedBody->getLinearVelocity());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Scatter_PreservesTransformDepth)
+    {
+      GameObject gameObject;
+      gameObject.getTransform()->setTranslation(0, 0, 7);
+      observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+      rigidBody->setLinearVelocity(2, 4);
+
+      RigidBodyIntegrator integrator;
+      integrator.add(*rigidBody);
+      integrator.integrate(1, glm::vec2());
+      integrator.scatter();
+
+      Assert::AreEqual(glm::vec3(2, 4, 7), gameObject.getTransform()->getTranslation());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Scatter_BodyAtRest_LeavesTransformAlone)
+    {
+      GameObject gameObject;
+      observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+
+      RigidBodyIntegrator integrator;
+      integrator.add(*rigidBody);
+      integrator.integrate(1, glm::vec2());
+
+      // Only bodies which moved have their transforms written, so this is not overwritten with where the body was gathered
+      gameObject.getTransform()->setTranslation(8, 9);
+      integrator.scatter();
+
+      Assert::AreEqual(glm::vec3(8, 9, 0), gameObject.getTransform()->getTranslation());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Scatter_PositionSet_WritesTransformEvenAtRest)
+    {
+      GameObject gameObject;
+      observer_ptr<RigidBody2D> rigidBody = gameObject.addComponent<RigidBody2D>();
+
+      RigidBodyIntegrator integrator;
+      size_t index = integrator.add(*rigidBody);
+      integrator.integrate(1, glm::vec2());
+      integrator.setPosition(index, glm::vec2(2, 3));
+      integrator.scatter();
+
+      Assert::AreEqual(glm::vec3(2, 3, 0), gameObject.getTransform()->getTranslation());
+    }
+
+#pragma endregion
+
+#pragma region Benchmark Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(RigidBodyIntegrator_Benchmark_ComparedWithRigidBodyUpdate)
+    {
+      const size_t count = 10000;
+            std::vector<std::unique_ptr<GameObject>> gameObjects;
+      std::vector<observer_ptr<RigidBody2D>> rigidBodies;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        gameObjects.push_back(std::make_unique<GameObject>());
+        rigidBodies.push_back(gameObjects.back()->addComponent<RigidBody2D>());
+        rigidBodies.back()->setLinearVelocity(static_cast<float>(i % 100), 1);
+      }
+
+      auto start = std::chrono::high_resolution_clock::now();
+
+      for (size_t frame = 0; frame < 10; ++frame)
+      {
+        for (observer_ptr<RigidBody2D> rigidBody : rigidBodies)
+        {
+          rigidBody->incrementLinearVelocity(0, -1);
+          rigidBody->update(0.016f);
+        }
+      }
+
+      auto perBody = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+      RigidBodyIntegrator integrator;
+      start = std::chrono::high_resolution_clock::now();
+
+      for (observer_ptr<RigidBody2D> rigidBody : rigidBodies)
+      {
+        integrator.add(*rigidBody);
+      }
+
+      for (size_t frame = 0; frame < 10; ++frame)
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          integrator.gather(i);
+          integrator.setAffectedByGravity(i);
+        }
+
+        integrator.integrate(0.016f, glm::vec2(0, -1));
+        integrator.scatter();
+      }
+
+      auto batched = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+      Logger::WriteMessage(("Integrating " + std::to_string(count) + " bodies over 10 frames took " + std::to_string(perBody) +
+        "us one at a time vs " + std::to_string(batched) + "us in one pass").c_str());
+    }
+
+#pragma endregion
+
+  };
+}
@@ -0,0 +1,268 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Physics/UniformGridBroadphase.h"
+
+#include <random>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+using namespace Celeste;
+using namespace Celeste::Physics;
+
+
+namespace TestCeleste
+{
+  namespace
+  {
+    //------------------------------------------------------------------------------------------------
+    std::vector<AABB> createRandomBounds(size_t count, float worldSize, float maxSize, unsigned int seed)
+    {
+      std::mt19937 generator(seed);
+      std::uniform_real_distribution<float> position(-worldSize * 0.5f, worldSize * 0.5f);
+      std::uniform_real_distribution<float> size(1, maxSize);
+
+      std::vector<AABB> bounds;
+      bounds.reserve(count);
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        bounds.push_back(AABB::fromCentre(glm::vec2(position(generator), position(generator)), glm::vec2(size(generator), size(generator))));
+      }
+
+      return bounds;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    std::vector<size_t> bruteForceQuery(const std::vector<AABB>& bounds, const AABB& queryBounds)
+    {
+      std::vector<size_t> results;
+
+      for (size_t i = 0; i < bounds.size(); ++i)
+      {
+        if (bounds[i].overlaps(queryBounds))
+        {
+          results.push_back(i);
+        }
+      }
+
+      return results;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    std::vector<size_t> sortedQuery(const IBroadphase& broadphase, const AABB& queryBounds)
+    {
+      std::vector<size_t> results;
+      broadphase.query(queryBounds, results);
+      std::sort(results.begin(), results.end());
+
+      return results;
+    }
+  }
+
+  CELESTE_TEST_CLASS(TestUniformGridBroadphase)
+
+#pragma region Update Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Update_SetsSizeToNumberOfBounds)
+    {
+      UniformGridBroadphase broadphase;
+
+      Assert::AreEqual(static_cast<size_t>(0), broadphase.size());
+
+      broadphase.update(createRandomBounds(100, 1000, 50, 1));
+
+      Assert::AreEqual(static_cast<size_t>(100), broadphase.size());
+
+      broadphase.update(createRandomBounds(20, 1000, 50, 2));
+
+      Assert::AreEqual(static_cast<size_t>(20), broadphase.size());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Update_EmptyBounds_QueryReturnsNothing)
+    {
+      UniformGridBroadphase broadphase;
+      broadphase.update(createRandomBounds(100, 1000, 50, 1));
+      broadphase.update(std::vector<AABB>());
+
+      std::vector<size_t> results;
+      broadphase.query(AABB(glm::vec2(-1000), glm::vec2(1000)), results);
+
+      Assert::IsTrue(results.empty());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Update_BoundsMoved_QueryUsesNewBounds)
+    {
+      UniformGridBroadphase broadphase;
+      std::vector<AABB> bounds{ AABB(glm::vec2(0), glm::vec2(10)) };
+      broadphase.update(bounds);
+
+      Assert::AreEqual(static_cast<size_t>(1), sortedQuery(broadphase, AABB(glm::vec2(5), glm::vec2(6))).size());
+
+      bounds[0] = AABB(glm::vec2(1000), glm::vec2(1010));
+      broadphase.update(bounds);
+
+      Assert::IsTrue(sortedQuery(broadphase, AABB(glm::vec2(5), glm::vec2(6))).empty());
+      Assert::AreEqual(static_cast<size_t>(1), sortedQuery(broadphase, AABB(glm::vec2(1005), glm::vec2(1006))).size());
+    }
+
+#pragma endregion
+
+#pragma region Query Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Query_AppendsToExistingResults)
+    {
+      UniformGridBroadphase broadphase;
+      broadphase.update(std::vector<AABB>{ AABB(glm::vec2(0), glm::vec2(10)) });
+
+      std::vector<size_t> results{ 100 };
+      broadphase.query(AABB(glm::vec2(5), glm::vec2(6)), results);
+
+      Assert::AreEqual(static_cast<size_t>(2), results.size());
+      Assert::AreEqual(static_cast<size_t>(100), results[0]);
+      Assert::AreEqual(static_cast<size_t>(0), results[1]);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Query_TouchingEdges_CountsAsOverlapping)
+    {
+      UniformGridBroadphase broadphase;
+      broadphase.update(std::vector<AABB>{ AABB(glm::vec2(0), glm::vec2(10)) });
+
+      Assert::AreEqual(static_cast<size_t>(1), sortedQuery(broadphase, AABB(glm::vec2(10, 0), glm::vec2(20, 10))).size());
+      Assert::IsTrue(sortedQuery(broadphase, AABB(glm::vec2(10.5f, 0), glm::vec2(20, 10))).empty());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Query_InfiniteBounds_FindsEverything)
+    {
+      UniformGridBroadphase broadphase;
+      std::vector<AABB> bounds = createRandomBounds(100, 1000, 50, 3);
+      bounds.push_back(AABB(glm::vec2(-std::numeric_limits<float>::infinity()), glm::vec2(std::numeric_limits<float>::infinity())));
+      broadphase.update(bounds);
+
+      Assert::AreEqual(bounds.size(), sortedQuery(broadphase, AABB(glm::vec2(-1000), glm::vec2(1000))).size());
+      Assert::AreEqual(static_cast<size_t>(1), sortedQuery(broadphase, AABB(glm::vec2(5000), glm::vec2(5001))).size());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Query_MatchesBruteForce_OverSeveralFramesOfMovement)
+    {
+      UniformGridBroadphase broadphase;
+      std::vector<AABB> bounds = createRandomBounds(500, 2000, 300, 4);
+      std::mt19937 generator(5);
+      std::uniform_real_distribution<float> movement(-20, 20);
+
+      for (int frame = 0; frame < 10; ++frame)
+      {
+        broadphase.update(bounds);
+
+        for (const AABB& queryBounds : bounds)
+        {
+          Assert::IsTrue(bruteForceQuery(bounds, queryBounds) == sortedQuery(broadphase, queryBounds));
+        }
+
+        for (AABB& entry : bounds)
+        {
+          glm::vec2 offset(movement(generator), movement(generator));
+          entry = AABB(entry.m_min + offset, entry.m_max + offset);
+        }
+      }
+    }
+
+#pragma endregion
+
+#pragma region Constructor Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Constructor_SetsCellSize)
+    {
+      UniformGridBroadphase broadphase(32);
+
+      Assert::AreEqual(32.0f, broadphase.getCellSize());
+      Assert::AreEqual(static_cast<size_t>(0), broadphase.size());
+    }
+
+#pragma endregion
+
+#pragma region Oversized Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Update_BoundsCoveringTooManyCells_StoresAsOversized)
+    {
+      UniformGridBroadphase broadphase(10);
+      std::vector<AABB> bounds
+      {
+        AABB(glm::vec2(0), glm::vec2(5)),
+        AABB(glm::vec2(0), glm::vec2(1000)),
+      };
+      broadphase.update(bounds);
+
+      Assert::AreEqual(static_cast<size_t>(1), broadphase.getOversizedCount());
+      Assert::AreEqual(static_cast<size_t>(2), sortedQuery(broadphase, AABB(glm::vec2(1), glm::vec2(2))).size());
+      Assert::AreEqual(static_cast<size_t>(1), sortedQuery(broadphase, AABB(glm::vec2(500), glm::vec2(501))).size());
+    }
+
+#pragma endregion
+
+#pragma region Benchmark Tests
+
+    //------------------------------------------------------------------------------------------------
+    void benchmark(size_t colliderCount)
+    {
+      // Keep the density of colliders the same as the count grows, as it would be in a bigger level
+      float worldSize = std::sqrt(static_cast<float>(colliderCount)) * 50;
+      std::vector<AABB> bounds = createRandomBounds(colliderCount, worldSize, 40, 8);
+      UniformGridBroadphase broadphase;
+      std::vector<size_t> results;
+      size_t candidateCount = 0;
+
+      auto start = std::chrono::high_resolution_clock::now();
+
+      for (int frame = 0; frame < 10; ++frame)
+      {
+        for (AABB& entry : bounds)
+        {
+          entry = AABB(entry.m_min + glm::vec2(1, -1), entry.m_max + glm::vec2(1, -1));
+        }
+
+        broadphase.update(bounds);
+
+        for (const AABB& queryBounds : bounds)
+        {
+          results.clear();
+          broadphase.query(queryBounds, results);
+          candidateCount += results.size();
+        }
+      }
+
+      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+      // Every collider always overlaps itself
+      Assert::IsTrue(candidateCount >= colliderCount * 10);
+      Logger::WriteMessage(("Broadphase of " + std::to_string(colliderCount) + " colliders over 10 frames took " + std::to_string(elapsed.count()) +
+        "ms, " + std::to_string(candidateCount / 10) + " candidates per frame vs " + std::to_string(colliderCount * colliderCount) + " brute force tests").c_str());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Benchmark_1kColliders)
+    {
+      benchmark(1000);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(UniformGridBroadphase_Benchmark_10kColliders)
+    {
+      benchmark(10000);
+    }
+
+#pragma endregion
+
+  };
+}
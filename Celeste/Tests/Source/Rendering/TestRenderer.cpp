@@ -39,6 +39,15 @@ namespace TestCeleste
     Assert::AreEqual(glm::vec2(), renderer.getScissorRectangle().getCentre());
   }
 
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(Renderer_Constructor_SetsSortingLayerToZero)
+  {
+    GameObject gameObject;
+    MockRenderer renderer(gameObject);
+
+    Assert::AreEqual((uint8_t)0, renderer.getSortingLayer());
+  }
+
 #pragma endregion
 
 #pragma region Set Colour Tests
@@ -2,11 +2,15 @@
 
 #include "Mocks/Rendering/MockSpriteBatch.h"
 #include "Mocks/Rendering/MockRenderer.h"
+#include "Mocks/Rendering/MockSpriteRenderer.h"
+#include "Resources/2D/Texture2D.h"
+#include "Resources/2D/TextureAtlas.h"
 
 #include "Objects/GameObject.h"
 
 using namespace Celeste;
 using namespace Celeste::Rendering;
+using namespace Celeste::Resources;
 
 
 namespace TestCeleste
@@ -43,6 +47,272 @@ namespace TestCeleste
     Assert::AreEqual((size_t)1, spriteBatch.renderers_size_Public());
   }
 
+#pragma endregion
+
+#pragma region End Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_NoRenderers_IssuesNoDrawCalls)
+  {
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)0, spriteBatch.getDrawCallCount());
+    Assert::AreEqual((size_t)0, spriteBatch.getInstanceCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_SpritesSharingTexture_IssuesOneDrawCall)
+  {
+    Texture2D texture;
+    GameObject gameObject;
+    MockSpriteRenderer renderer1(gameObject), renderer2(gameObject), renderer3(gameObject);
+    renderer1.setTexture(&texture);
+    renderer2.setTexture(&texture);
+    renderer3.setTexture(&texture);
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer1, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.render(renderer2, glm::vec3(10, 0, 1), 0, glm::vec3(1));
+    spriteBatch.render(renderer3, glm::vec3(20, 0, 2), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)1, spriteBatch.getDrawCallCount());
+    Assert::AreEqual((size_t)3, spriteBatch.getInstanceCount());
+    Assert::AreEqual((size_t)0, spriteBatch.renderers_size_Public());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_TexturesInterleavedByDepth_IssuesOneDrawCallPerRun)
+  {
+    Texture2D texture1, texture2;
+    GameObject gameObject;
+    MockSpriteRenderer renderer1(gameObject), renderer2(gameObject), renderer3(gameObject), renderer4(gameObject);
+    renderer1.setTexture(&texture1);
+    renderer2.setTexture(&texture1);
+    renderer3.setTexture(&texture2);
+    renderer4.setTexture(&texture1);
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer4, glm::vec3(0, 0, 3), 0, glm::vec3(1));
+    spriteBatch.render(renderer3, glm::vec3(0, 0, 2), 0, glm::vec3(1));
+    spriteBatch.render(renderer2, glm::vec3(0, 0, 1), 0, glm::vec3(1));
+    spriteBatch.render(renderer1, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    // texture1 x 2, texture2, texture1 - merging the last sprite into the first run would draw it beneath texture2
+    Assert::AreEqual((size_t)3, spriteBatch.getDrawCallCount());
+    Assert::AreEqual((size_t)4, spriteBatch.getInstanceCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_SpritesFromDifferentRegionsOfOneAtlas_IssuesOneDrawCall)
+  {
+    std::vector<unsigned char> pixels(8 * 8 * 4, 255);
+    TextureAtlas atlas;
+    atlas.create(32, 32);
+    atlas.addRegion("First", 8, 8, pixels.data());
+    atlas.addRegion("Second", 8, 8, pixels.data());
+
+    GameObject gameObject;
+    MockSpriteRenderer renderer1(gameObject), renderer2(gameObject);
+    renderer1.setTexture(atlas, "First");
+    renderer2.setTexture(atlas, "Second");
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer1, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.render(renderer2, glm::vec3(0, 0, 1), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)1, spriteBatch.getDrawCallCount());
+    Assert::AreEqual((size_t)2, spriteBatch.getInstanceCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_NonInstancedRenderer_SplitsRunAndIssuesItsOwnDrawCall)
+  {
+    Texture2D texture;
+    GameObject gameObject;
+    MockSpriteRenderer renderer1(gameObject), renderer2(gameObject);
+    MockRenderer mockRenderer(gameObject);
+    renderer1.setTexture(&texture);
+    renderer2.setTexture(&texture);
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer1, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.render(mockRenderer, glm::vec3(0, 0, 1), 0, glm::vec3(1));
+    spriteBatch.render(renderer2, glm::vec3(0, 0, 2), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)3, spriteBatch.getDrawCallCount());
+    Assert::AreEqual((size_t)2, spriteBatch.getInstanceCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_SpriteWithScissorRectangle_IsNotInstanced)
+  {
+    Texture2D texture;
+    GameObject gameObject;
+    MockSpriteRenderer renderer1(gameObject), renderer2(gameObject);
+    renderer1.setTexture(&texture);
+    renderer2.setTexture(&texture);
+    renderer2.getScissorRectangle().setDimensions(glm::vec2(10, 10));
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer1, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.render(renderer2, glm::vec3(0, 0, 1), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)2, spriteBatch.getDrawCallCount());
+    Assert::AreEqual((size_t)1, spriteBatch.getInstanceCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_SpriteWithNoTexture_IsNotInstanced)
+  {
+    GameObject gameObject;
+    MockSpriteRenderer renderer(gameObject);
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer, glm::identity<glm::mat4>());
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)0, spriteBatch.getInstanceCount());
+  }
+
+#pragma endregion
+
+#pragma region Sorting By State Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_Constructor_IsNotSortingByState)
+  {
+    MockSpriteBatch spriteBatch;
+
+    Assert::IsFalse(spriteBatch.isSortingByState());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_NotSortingByState_TexturesAtSameDepth_DrawInOrderAdded)
+  {
+    Texture2D texture1, texture2;
+    GameObject gameObject;
+    MockSpriteRenderer renderer1(gameObject), renderer2(gameObject), renderer3(gameObject);
+    renderer1.setTexture(&texture1);
+    renderer2.setTexture(&texture2);
+    renderer3.setTexture(&texture1);
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer1, glm::identity<glm::mat4>());
+    spriteBatch.render(renderer2, glm::identity<glm::mat4>());
+    spriteBatch.render(renderer3, glm::identity<glm::mat4>());
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)3, spriteBatch.getDrawCallCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_SortingByState_TexturesAtSameDepth_AreGroupedIntoOneDrawCallEach)
+  {
+    Texture2D texture1, texture2;
+    GameObject gameObject;
+    MockSpriteRenderer renderer1(gameObject), renderer2(gameObject), renderer3(gameObject);
+    renderer1.setTexture(&texture1);
+    renderer2.setTexture(&texture2);
+    renderer3.setTexture(&texture1);
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.setSortingByState(true);
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer1, glm::identity<glm::mat4>());
+    spriteBatch.render(renderer2, glm::identity<glm::mat4>());
+    spriteBatch.render(renderer3, glm::identity<glm::mat4>());
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)2, spriteBatch.getDrawCallCount());
+    Assert::AreEqual((size_t)3, spriteBatch.getInstanceCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_SortingByState_StillOrdersByDepthFirst)
+  {
+    Texture2D texture1, texture2;
+    GameObject gameObject;
+    MockSpriteRenderer renderer1(gameObject), renderer2(gameObject), renderer3(gameObject);
+    renderer1.setTexture(&texture1);
+    renderer2.setTexture(&texture2);
+    renderer3.setTexture(&texture1);
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.setSortingByState(true);
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer1, glm::vec3(0, 0, -1), 0, glm::vec3(1));
+    spriteBatch.render(renderer2, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.render(renderer3, glm::vec3(0, 0, 1), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)3, spriteBatch.getDrawCallCount());
+  }
+
+#pragma endregion
+
+#pragma region Sorting Layer Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_HigherSortingLayer_DrawsAfterNearerDepthsOnLowerLayer)
+  {
+    Texture2D texture1, texture2;
+    GameObject gameObject;
+    MockSpriteRenderer renderer1(gameObject), renderer2(gameObject), renderer3(gameObject);
+    renderer1.setTexture(&texture1);
+    renderer2.setTexture(&texture2);
+    renderer3.setTexture(&texture1);
+    renderer1.setSortingLayer(1);
+    renderer3.setSortingLayer(1);
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer1, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.render(renderer2, glm::vec3(0, 0, 1), 0, glm::vec3(1));
+    spriteBatch.render(renderer3, glm::vec3(0, 0, 2), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    // renderer2 draws first, leaving the two sprites on the higher layer next to each other in one run
+    Assert::AreEqual((size_t)2, spriteBatch.getDrawCallCount());
+    Assert::AreEqual((size_t)3, spriteBatch.getInstanceCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteBatch_End_SameSortingLayer_OrdersByDepth)
+  {
+    Texture2D texture1, texture2;
+    GameObject gameObject;
+    MockSpriteRenderer renderer1(gameObject), renderer2(gameObject), renderer3(gameObject);
+    renderer1.setTexture(&texture1);
+    renderer2.setTexture(&texture2);
+    renderer3.setTexture(&texture1);
+    renderer1.setSortingLayer(3);
+    renderer2.setSortingLayer(3);
+    renderer3.setSortingLayer(3);
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer1, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.render(renderer2, glm::vec3(0, 0, 1), 0, glm::vec3(1));
+    spriteBatch.render(renderer3, glm::vec3(0, 0, 2), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)3, spriteBatch.getDrawCallCount());
+  }
+
 #pragma endregion
 
   };
@@ -4,6 +4,7 @@
 
 #include "Mocks/Rendering/MockSpriteRenderer.h"
 #include "Resources/ResourceManager.h"
+#include "Resources/2D/TextureAtlas.h"
 #include "TestResources/TestResources.h"
 #include "Registries/ComponentRegistry.h"
 #include "TestUtils/Assert/AssertCel.h"
@@ -189,6 +190,35 @@ namespace TestCeleste
     Assert::AreEqual(glm::vec2(400, 200), renderer.getDimensions());
   }
 
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteRenderer_SetTexture_InputtingAtlasRegion_SetsTextureUVRectangleAndDimensions)
+  {
+    std::vector<unsigned char> pixels(16 * 8 * 4, 255);
+    TextureAtlas atlas;
+    atlas.create(64, 32);
+    atlas.addRegion("Block", 16, 8, pixels.data());
+
+    GameObject gameObject;
+    MockSpriteRenderer renderer(gameObject);
+    renderer.setTexture(atlas, "Block");
+
+    Assert::IsTrue(&atlas.getTexture() == renderer.getTexture());
+    Assert::AreEqual(atlas.getUVRectangle("Block"), renderer.getUVRectangle());
+    Assert::AreEqual(glm::vec2(16, 8), renderer.getDimensions());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(SpriteRenderer_SetTexture_InputtingTexture_ResetsUVRectangleToWholeTexture)
+  {
+    GameObject gameObject;
+    MockSpriteRenderer renderer(gameObject);
+    renderer.setUVRectangle(glm::vec4(0.5f, 0.5f, 1, 1));
+
+    renderer.setTexture(nullptr);
+
+    Assert::AreEqual(glm::vec4(0, 0, 1, 1), renderer.getUVRectangle());
+  }
+
 #pragma endregion
 
 #pragma region Set Dimensions Tests
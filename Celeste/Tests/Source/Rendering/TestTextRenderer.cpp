@@ -1,6 +1,7 @@
 #include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
 
 #include "Mocks/Rendering/MockTextRenderer.h"
+#include "Mocks/Rendering/MockSpriteBatch.h"
 #include "Resources/ResourceManager.h"
 #include "TestResources/TestResources.h"
 #include "Registries/ComponentRegistry.h"
@@ -301,6 +302,27 @@ namespace TestCeleste
     Assert::AreEqual(textRenderer.getFont().getHeight(), textRenderer.getDimensions().y);
   }
 
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_SetFontHeight_Wrap_TextGreaterThanMaxWidthWithNewHeight_WrapsLinesCorrectly)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer(gameObject);
+    renderer.setHorizontalWrapMode(UI::HorizontalWrapMode::kWrap);
+    renderer.setText("Wubba Lubba Dub Dub");
+
+    float maxWidth = renderer.getFont().measureString("Wubba Lubba D").x;
+    renderer.setMaxWidth(maxWidth);
+
+    Assert::AreEqual((size_t)2, renderer.getLineCount());
+    Assert::AreEqual("Wubba Lubba", renderer.getLine(0).c_str());
+
+    renderer.setFontHeight(renderer.getFont().getHeight() * 2);
+
+    Assert::AreEqual("Wubba Lubba Dub Dub", renderer.getText().c_str());
+    Assert::AreEqual("Wubba", renderer.getLine(0).c_str());
+    Assert::IsTrue(renderer.getDimensions().x <= maxWidth);
+  }
+
 #pragma endregion
 
 #pragma region Horizontal Alignment Tests
@@ -537,7 +559,7 @@ namespace TestCeleste
   }
 
   //------------------------------------------------------------------------------------------------
-  TEST_METHOD(TextRenderer_SetText_InputtingNonEmptyString_Wrap_TextMoreThanMaxWidth_ChangesTextToWrapCorrectly)
+  TEST_METHOD(TextRenderer_SetText_InputtingNonEmptyString_Wrap_TextMoreThanMaxWidth_WrapsLinesCorrectly)
   {
     GameObject gameObject;
     MockTextRenderer renderer(gameObject);
@@ -545,7 +567,10 @@ namespace TestCeleste
     renderer.setMaxWidth(renderer.getFont().measureString("Wubba Lubba D").x);
     renderer.setText("Wubba Lubba Dub Dub");
 
-    Assert::AreEqual("Wubba Lubba\nDub Dub", renderer.getText().c_str());
+    Assert::AreEqual("Wubba Lubba Dub Dub", renderer.getText().c_str());
+    Assert::AreEqual((size_t)2, renderer.getLineCount());
+    Assert::AreEqual("Wubba Lubba", renderer.getLine(0).c_str());
+    Assert::AreEqual("Dub Dub", renderer.getLine(1).c_str());
   }
 
   //------------------------------------------------------------------------------------------------
@@ -589,7 +614,7 @@ namespace TestCeleste
   }
 
   //------------------------------------------------------------------------------------------------
-  TEST_METHOD(TextRenderer_SetMaxWidth_Wrap_TextGreaterThanMaxWidth_UpdatesTextToWrapCorrectly)
+  TEST_METHOD(TextRenderer_SetMaxWidth_Wrap_TextGreaterThanMaxWidth_WrapsLinesCorrectly)
   {
     GameObject gameObject;
     MockTextRenderer renderer(gameObject);
@@ -597,7 +622,10 @@ namespace TestCeleste
     renderer.setText("Wubba Lubba Dub Dub");
     renderer.setMaxWidth(renderer.getFont().measureString("Wubba Lubba D").x);
 
-    Assert::AreEqual("Wubba Lubba\nDub Dub", renderer.getText().c_str());
+    Assert::AreEqual("Wubba Lubba Dub Dub", renderer.getText().c_str());
+    Assert::AreEqual((size_t)2, renderer.getLineCount());
+    Assert::AreEqual("Wubba Lubba", renderer.getLine(0).c_str());
+    Assert::AreEqual("Dub Dub", renderer.getLine(1).c_str());
   }
 
   //------------------------------------------------------------------------------------------------
@@ -641,7 +669,7 @@ namespace TestCeleste
   }
 
   //------------------------------------------------------------------------------------------------
-  TEST_METHOD(TextRenderer_SetHorizontalWrapModeToWrap_TextGreaterThanMaxWidth_UpdatesTextToWrapCorrectly)
+  TEST_METHOD(TextRenderer_SetHorizontalWrapModeToWrap_TextGreaterThanMaxWidth_WrapsLinesCorrectly)
   {
     GameObject gameObject;
     MockTextRenderer renderer(gameObject);
@@ -649,7 +677,10 @@ namespace TestCeleste
     renderer.setMaxWidth(renderer.getFont().measureString("Wubba Lubba D").x);
     renderer.setHorizontalWrapMode(UI::HorizontalWrapMode::kWrap);
 
-    Assert::AreEqual("Wubba Lubba\nDub Dub", renderer.getText().c_str());
+    Assert::AreEqual("Wubba Lubba Dub Dub", renderer.getText().c_str());
+    Assert::AreEqual((size_t)2, renderer.getLineCount());
+    Assert::AreEqual("Wubba Lubba", renderer.getLine(0).c_str());
+    Assert::AreEqual("Dub Dub", renderer.getLine(1).c_str());
   }
 
   //------------------------------------------------------------------------------------------------
@@ -676,6 +707,173 @@ namespace TestCeleste
     Assert::AreEqual("Wubba Lubba Dub Dub", renderer.getText().c_str());
   }
 
+#pragma endregion
+
+#pragma region Glyph Layout Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_SetText_LaysOutOneGlyphPerVisibleCharacter)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer(gameObject);
+    renderer.setText("Hello World\nLine");
+
+    // Spaces and new lines have no quad
+    Assert::AreEqual((size_t)14, renderer.getGlyphCount());
+
+    renderer.setText("");
+
+    Assert::AreEqual((size_t)0, renderer.getGlyphCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_SetText_LaysOutOneLinePerNewLine)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer(gameObject);
+
+    Assert::AreEqual((size_t)0, renderer.getLineCount());
+
+    renderer.setText("Wubba\nLubba\nDub Dub");
+
+    Assert::AreEqual((size_t)3, renderer.getLineCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_SetMaxWidth_Wrap_LaysOutWrappedLines)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer(gameObject);
+    renderer.setHorizontalWrapMode(UI::HorizontalWrapMode::kWrap);
+    renderer.setText("Wubba Lubba Dub Dub");
+
+    Assert::AreEqual((size_t)1, renderer.getLineCount());
+
+    renderer.setMaxWidth(renderer.getFont().measureString("Wubba Lubba D").x);
+
+    Assert::AreEqual((size_t)2, renderer.getLineCount());
+    Assert::AreEqual((size_t)14, renderer.getGlyphCount());
+    Assert::AreEqual(renderer.getFont().measureString("Wubba Lubba\nDub Dub"), renderer.getDimensions());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_Wrap_FirstWordWiderThanMaxWidth_DoesNotChangeFirstWord)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer(gameObject);
+    renderer.setHorizontalWrapMode(UI::HorizontalWrapMode::kWrap);
+    renderer.setMaxWidth(renderer.getFont().measureString("Wub").x);
+    renderer.setText("Wubba Lubba");
+
+    Assert::AreEqual("Wubba Lubba", renderer.getText().c_str());
+    Assert::AreEqual((size_t)2, renderer.getLineCount());
+    Assert::AreEqual("Wubba", renderer.getLine(0).c_str());
+    Assert::AreEqual("Lubba", renderer.getLine(1).c_str());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_SetMaxWidth_Wrap_WidenedAfterWrapping_JoinsLinesBackTogether)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer(gameObject);
+    renderer.setHorizontalWrapMode(UI::HorizontalWrapMode::kWrap);
+    renderer.setText("Wubba Lubba Dub Dub");
+    renderer.setMaxWidth(renderer.getFont().measureString("Wub").x);
+
+    Assert::AreEqual((size_t)4, renderer.getLineCount());
+
+    renderer.setMaxWidth(100000000);
+
+    Assert::AreEqual("Wubba Lubba Dub Dub", renderer.getText().c_str());
+    Assert::AreEqual((size_t)1, renderer.getLineCount());
+    Assert::AreEqual("Wubba Lubba Dub Dub", renderer.getLine(0).c_str());
+    Assert::AreEqual(renderer.getFont().measureString("Wubba Lubba Dub Dub"), renderer.getDimensions());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_GetLine_NewLinesInText_ReturnsEachLineWithoutNewLine)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer(gameObject);
+    renderer.setText("Wubba\nLubba\nDub Dub");
+
+    Assert::AreEqual("Wubba", renderer.getLine(0).c_str());
+    Assert::AreEqual("Lubba", renderer.getLine(1).c_str());
+    Assert::AreEqual("Dub Dub", renderer.getLine(2).c_str());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_SetAlignment_DoesNotChangeLayout)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer(gameObject);
+    renderer.setText("Wubba\nLubba");
+
+    glm::vec2 dimensions = renderer.getDimensions();
+
+    renderer.setHorizontalAlignment(UI::HorizontalAlignment::kLeft);
+    renderer.setVerticalAlignment(UI::VerticalAlignment::kTop);
+
+    Assert::AreEqual(dimensions, renderer.getDimensions());
+    Assert::AreEqual((size_t)2, renderer.getLineCount());
+    Assert::AreEqual((size_t)10, renderer.getGlyphCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_GetInstanceTexture_ReturnsFontAtlas)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer(gameObject);
+
+    Assert::IsNotNull(renderer.getInstanceTexture());
+    Assert::IsTrue(renderer.getFont().getAtlas() == renderer.getInstanceTexture());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_AddInstances_TextInSameFont_IssuesOneDrawCall)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer1(gameObject), renderer2(gameObject);
+    renderer1.setText("Hello");
+    renderer2.setText("World");
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer1, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.render(renderer2, glm::vec3(0, 100, 1), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    Assert::AreEqual((size_t)1, spriteBatch.getDrawCallCount());
+    Assert::AreEqual((size_t)10, spriteBatch.getInstanceCount());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextRenderer_AddInstances_HorizontalAlignmentChanged_MovesGlyphsByLineWidth)
+  {
+    GameObject gameObject;
+    MockTextRenderer renderer(gameObject);
+    renderer.setText("Hello");
+    renderer.setHorizontalAlignment(UI::HorizontalAlignment::kLeft);
+
+    MockSpriteBatch spriteBatch;
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    glm::vec4 leftAligned = spriteBatch.getInstance_Public(0).m_viewModelMatrix[3];
+
+    renderer.setHorizontalAlignment(UI::HorizontalAlignment::kRight);
+
+    spriteBatch.begin(glm::identity<glm::mat4>(), glm::identity<glm::mat4>());
+    spriteBatch.render(renderer, glm::vec3(0, 0, 0), 0, glm::vec3(1));
+    spriteBatch.end();
+
+    glm::vec4 rightAligned = spriteBatch.getInstance_Public(0).m_viewModelMatrix[3];
+
+    Assert::AreEqual(leftAligned.x - renderer.getDimensions().x, rightAligned.x, 0.0001f);
+    Assert::AreEqual(leftAligned.y, rightAligned.y);
+  }
+
 #pragma endregion
 
   };
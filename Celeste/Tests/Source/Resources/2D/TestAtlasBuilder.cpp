@@ -0,0 +1,163 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Resources/2D/AtlasBuilder.h"
+#include "Resources/2D/TextureAtlas.h"
+#include "TestResources/TestResources.h"
+#include "FileSystem/File.h"
+
+using namespace Celeste;
+using namespace Celeste::Resources;
+
+
+namespace TestCeleste::Resources
+{
+  CELESTE_TEST_CLASS(TestAtlasBuilder)
+
+  //----------------------------------------------------------------------------------------------------------
+  static std::vector<unsigned char> createImage(uint32_t width, uint32_t height, unsigned char red)
+  {
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4, 255);
+    for (size_t i = 0; i < pixels.size(); i += 4)
+    {
+      pixels[i] = red;
+    }
+
+    return pixels;
+  }
+
+#pragma region Build Tests
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(AtlasBuilder_Build_NoImages_ReturnsFalse)
+  {
+    AtlasBuilder builder;
+
+    Assert::IsFalse(builder.build(1024));
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(AtlasBuilder_Build_PacksIntoSmallestPowerOfTwo)
+  {
+    std::vector<unsigned char> image = createImage(4, 3, 10);
+
+    AtlasBuilder builder;
+    builder.addImage("Small", 4, 3, image.data());
+
+    Assert::IsTrue(builder.build(1024, 0));
+    Assert::AreEqual(4u, builder.getWidth());
+    Assert::AreEqual(4u, builder.getHeight());
+    Assert::AreEqual(static_cast<size_t>(4 * 4 * 4), builder.getPixels().size());
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(AtlasBuilder_Build_CopiesEveryImageToItsRegion)
+  {
+    std::vector<unsigned char> first = createImage(5, 7, 10);
+    std::vector<unsigned char> second = createImage(9, 2, 20);
+    std::vector<unsigned char> third = createImage(3, 3, 30);
+
+    AtlasBuilder builder;
+    builder.addImage("First", 5, 7, first.data());
+    builder.addImage("Second", 9, 2, second.data());
+    builder.addImage("Third", 3, 3, third.data());
+
+    Assert::IsTrue(builder.build(1024));
+    Assert::AreEqual(static_cast<size_t>(3), builder.getRegions().size());
+
+    for (const AtlasRegion& region : builder.getRegions())
+    {
+      unsigned char expectedRed = region.m_name == "First" ? 10 : region.m_name == "Second" ? 20 : 30;
+
+      for (uint32_t y = 0; y < region.m_dimensions.y; ++y)
+      {
+        for (uint32_t x = 0; x < region.m_dimensions.x; ++x)
+        {
+          size_t pixel = (static_cast<size_t>(region.m_position.y + y) * builder.getWidth() + region.m_position.x + x) * 4;
+          Assert::AreEqual(static_cast<int>(expectedRed), static_cast<int>(builder.getPixels()[pixel]));
+        }
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(AtlasBuilder_Build_KeepsImagesPaddingApart)
+  {
+    std::vector<unsigned char> image = createImage(4, 4, 10);
+
+    AtlasBuilder builder;
+    builder.addImage("First", 4, 4, image.data());
+    builder.addImage("Second", 4, 4, image.data());
+
+    Assert::IsTrue(builder.build(1024, 2));
+
+    const AtlasRegion& first = builder.getRegions()[0];
+    const AtlasRegion& second = builder.getRegions()[1];
+    bool apartHorizontally = first.m_position.x + 4 + 2 <= second.m_position.x || second.m_position.x + 4 + 2 <= first.m_position.x;
+    bool apartVertically = first.m_position.y + 4 + 2 <= second.m_position.y || second.m_position.y + 4 + 2 <= first.m_position.y;
+
+    Assert::IsTrue(apartHorizontally || apartVertically);
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(AtlasBuilder_Build_MaxDimensionNotPowerOfTwo_ImagesFit_ClampsToMaxDimension)
+  {
+    std::vector<unsigned char> image = createImage(80, 80, 10);
+
+    AtlasBuilder builder;
+    builder.addImage("Large", 80, 80, image.data());
+
+    Assert::IsTrue(builder.build(96, 0));
+    Assert::AreEqual(96u, builder.getWidth());
+    Assert::AreEqual(96u, builder.getHeight());
+    Assert::AreEqual(static_cast<size_t>(1), builder.getRegions().size());
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(AtlasBuilder_Build_MaxDimensionNotPowerOfTwo_OnlyOneSideNeedsClamping_ClampsThatSide)
+  {
+    std::vector<unsigned char> image = createImage(40, 40, 10);
+
+    AtlasBuilder builder;
+    builder.addImage("First", 40, 40, image.data());
+    builder.addImage("Second", 40, 40, image.data());
+
+    Assert::IsTrue(builder.build(80, 0));
+    Assert::AreEqual(80u, builder.getWidth());
+    Assert::IsTrue(builder.getHeight() <= 80u);
+    Assert::AreEqual(static_cast<size_t>(2), builder.getRegions().size());
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(AtlasBuilder_Build_ImagesLargerThanMaxDimension_ReturnsFalse)
+  {
+    std::vector<unsigned char> image = createImage(100, 10, 10);
+
+    AtlasBuilder builder;
+    builder.addImage("Wide", 100, 10, image.data());
+
+    Assert::IsFalse(builder.build(64));
+    Assert::IsTrue(builder.getRegions().empty());
+  }
+
+#pragma endregion
+
+#pragma region Save Tests
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(AtlasBuilder_Save_WritesImageAndManifest)
+  {
+    std::vector<unsigned char> image = createImage(8, 8, 10);
+
+    AtlasBuilder builder;
+    builder.addImage("Block", 8, 8, image.data());
+    builder.build(1024);
+
+    Assert::IsTrue(builder.save(TempDirectory::getFullPath(), "TestAtlas"));
+    Assert::IsTrue(File::exists(Path(TempDirectory::getFullPath(), "TestAtlas.png")));
+    Assert::IsTrue(File::exists(Path(TempDirectory::getFullPath(), std::string("TestAtlas") + TextureAtlas::FILE_EXTENSION)));
+  }
+
+#pragma endregion
+
+  };
+}
@@ -0,0 +1,142 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Resources/2D/SkylinePacker.h"
+
+using namespace Celeste;
+using namespace Celeste::Resources;
+
+
+namespace TestCeleste::Resources
+{
+  CELESTE_TEST_CLASS(TestSkylinePacker)
+
+#pragma region Constructor Tests
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(SkylinePacker_Constructor_SetsDimensions_AndNothingIsUsed)
+  {
+    SkylinePacker packer(64, 32);
+
+    Assert::AreEqual(64u, packer.getWidth());
+    Assert::AreEqual(32u, packer.getHeight());
+    Assert::AreEqual(static_cast<uint64_t>(0), packer.getUsedArea());
+  }
+
+#pragma endregion
+
+#pragma region Pack Tests
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(SkylinePacker_Pack_FirstRectangle_GoesInCorner)
+  {
+    SkylinePacker packer(64, 64);
+    glm::uvec2 position(10, 10);
+
+    Assert::IsTrue(packer.pack(16, 8, position));
+    Assert::AreEqual(0u, position.x);
+    Assert::AreEqual(0u, position.y);
+    Assert::AreEqual(static_cast<uint64_t>(128), packer.getUsedArea());
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(SkylinePacker_Pack_GoesWhereItLeavesTheSkylineLowest)
+  {
+    SkylinePacker packer(64, 64);
+    glm::uvec2 position;
+
+    packer.pack(32, 20, position);
+    packer.pack(32, 10, position);
+
+    Assert::AreEqual(32u, position.x);
+    Assert::AreEqual(0u, position.y);
+
+    // On top of the shorter rectangle rather than the taller one
+    Assert::IsTrue(packer.pack(32, 5, position));
+    Assert::AreEqual(32u, position.x);
+    Assert::AreEqual(10u, position.y);
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(SkylinePacker_Pack_SpanningSegments_SitsOnTheHighest)
+  {
+    SkylinePacker packer(64, 64);
+    glm::uvec2 position;
+
+    packer.pack(32, 20, position);
+    packer.pack(32, 10, position);
+
+    Assert::IsTrue(packer.pack(64, 4, position));
+    Assert::AreEqual(0u, position.x);
+    Assert::AreEqual(20u, position.y);
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(SkylinePacker_Pack_TooLarge_ReturnsFalse)
+  {
+    SkylinePacker packer(64, 64);
+    glm::uvec2 position;
+
+    Assert::IsFalse(packer.pack(65, 1, position));
+    Assert::IsFalse(packer.pack(1, 65, position));
+    Assert::IsFalse(packer.pack(0, 10, position));
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(SkylinePacker_Pack_UntilFull_NeverOverlaps)
+  {
+    SkylinePacker packer(128, 128);
+    std::vector<std::pair<glm::uvec2, glm::uvec2>> packed;
+
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+      glm::uvec2 size(1 + (i * 7) % 23, 1 + (i * 13) % 17);
+      glm::uvec2 position;
+
+      if (packer.pack(size.x, size.y, position))
+      {
+        Assert::IsTrue(position.x + size.x <= 128 && position.y + size.y <= 128);
+        packed.emplace_back(position, size);
+      }
+    }
+
+    for (size_t i = 0; i < packed.size(); ++i)
+    {
+      for (size_t j = i + 1; j < packed.size(); ++j)
+      {
+        const glm::uvec2& a = packed[i].first;
+        const glm::uvec2& aSize = packed[i].second;
+        const glm::uvec2& b = packed[j].first;
+        const glm::uvec2& bSize = packed[j].second;
+
+        Assert::IsFalse(a.x < b.x + bSize.x && b.x < a.x + aSize.x && a.y < b.y + bSize.y && b.y < a.y + aSize.y);
+      }
+    }
+
+    Assert::IsTrue(packer.getUsedArea() > static_cast<uint64_t>(128 * 128 * 3 / 4));
+  }
+
+#pragma endregion
+
+#pragma region Reset Tests
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(SkylinePacker_Reset_FreesEverything_AndResizes)
+  {
+    SkylinePacker packer(16, 16);
+    glm::uvec2 position;
+    packer.pack(16, 16, position);
+
+    Assert::IsFalse(packer.pack(1, 1, position));
+
+    packer.reset(32, 8);
+
+    Assert::AreEqual(32u, packer.getWidth());
+    Assert::AreEqual(8u, packer.getHeight());
+    Assert::AreEqual(static_cast<uint64_t>(0), packer.getUsedArea());
+    Assert::IsTrue(packer.pack(32, 8, position));
+  }
+
+#pragma endregion
+
+  };
+}
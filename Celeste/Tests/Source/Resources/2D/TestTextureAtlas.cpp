@@ -0,0 +1,116 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Resources/2D/TextureAtlas.h"
+#include "Resources/2D/AtlasBuilder.h"
+#include "TestResources/TestResources.h"
+#include "TestUtils/Assert/AssertCel.h"
+#include "OpenGL/GL.h"
+
+using namespace Celeste;
+using namespace Celeste::Resources;
+
+
+namespace TestCeleste::Resources
+{
+  CELESTE_TEST_CLASS(TestTextureAtlas)
+
+#pragma region Create Tests
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextureAtlas_Create_SetsDimensions_AndHasNoRegions)
+  {
+    TextureAtlas atlas;
+    atlas.create(64, 32);
+
+    Assert::AreEqual(64u, atlas.getWidth());
+    Assert::AreEqual(32u, atlas.getHeight());
+    Assert::AreEqual(static_cast<size_t>(0), atlas.getRegionCount());
+  }
+
+#pragma endregion
+
+#pragma region Add Region Tests
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextureAtlas_AddRegion_PacksRegion_AndCalculatesUVRectangle)
+  {
+    std::vector<unsigned char> pixels(16 * 8 * 4, 255);
+
+    TextureAtlas atlas;
+    atlas.create(64, 32);
+
+    Assert::IsTrue(atlas.addRegion("Block", 16, 8, pixels.data()));
+    Assert::IsTrue(atlas.hasRegion("Block"));
+    Assert::AreEqual(glm::vec4(0, 0, 0.25f, 0.25f), atlas.getUVRectangle("Block"));
+    Assert::AreEqual(glm::vec2(16, 8), atlas.getRegionDimensions("Block"));
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextureAtlas_AddRegion_RegionsDoNotOverlap)
+  {
+    std::vector<unsigned char> pixels(16 * 16 * 4, 255);
+
+    TextureAtlas atlas;
+    atlas.create(64, 64);
+    atlas.addRegion("First", 16, 16, pixels.data());
+    atlas.addRegion("Second", 16, 16, pixels.data());
+
+    const glm::vec4& first = atlas.getUVRectangle("First");
+    const glm::vec4& second = atlas.getUVRectangle("Second");
+
+    Assert::IsTrue(first.z <= second.x || second.z <= first.x || first.w <= second.y || second.w <= first.y);
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextureAtlas_AddRegion_NoRoomLeft_ReturnsFalse)
+  {
+    std::vector<unsigned char> pixels(32 * 32 * 4, 255);
+
+    TextureAtlas atlas;
+    atlas.create(32, 32);
+
+    Assert::IsTrue(atlas.addRegion("Full", 32, 32, pixels.data()));
+    Assert::IsFalse(atlas.addRegion("Extra", 1, 1, pixels.data()));
+    Assert::IsFalse(atlas.hasRegion("Extra"));
+  }
+
+#pragma endregion
+
+#pragma region Load From File Tests
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextureAtlas_LoadFromFile_NonExistentFile_ReturnsFalse)
+  {
+    TextureAtlas atlas;
+
+    Assert::IsFalse(atlas.loadFromFile(Path("ThisAtlasShouldntExist.atlas")));
+    Assert::AreEqual(static_cast<size_t>(0), atlas.getRegionCount());
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(TextureAtlas_LoadFromFile_BuiltManifest_HasEveryRegion)
+  {
+    if (GL::isInitialized())
+    {
+      AtlasBuilder builder;
+      builder.addImage("Block", TestResources::getBlockPngFullPath());
+      builder.build(4096);
+      builder.save(TempDirectory::getFullPath(), "TestTextureAtlas");
+
+      TextureAtlas atlas;
+
+      Assert::IsTrue(atlas.loadFromFile(Path(TempDirectory::getFullPath(), std::string("TestTextureAtlas") + TextureAtlas::FILE_EXTENSION)));
+      Assert::AreEqual(static_cast<size_t>(1), atlas.getRegionCount());
+      Assert::IsTrue(atlas.hasRegion("Block"));
+      Assert::AreEqual(glm::vec2(static_cast<float>(builder.getWidth()), static_cast<float>(builder.getHeight())), atlas.getTexture().getDimensions());
+
+      // Packed offline, so there is no free space to add to
+      std::vector<unsigned char> pixels(4, 255);
+      Assert::IsFalse(atlas.addRegion("Extra", 1, 1, pixels.data()));
+    }
+  }
+
+#pragma endregion
+
+  };
+}
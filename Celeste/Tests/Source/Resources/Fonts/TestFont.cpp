@@ -180,6 +180,67 @@ namespace TestCeleste
       Assert::AreEqual(font.getResourceId(), secondInstance.getFontName());
     }
 
+#pragma endregion
+
+#pragma region Glyph Atlas Tests
+
+    //----------------------------------------------------------------------------------------------------------
+    TEST_METHOD(Font_CreateInstance_FontNotLoaded_ReturnsFontInstance_WithNoAtlas)
+    {
+      MockFont font;
+      FontInstance instance = font.createInstance(4);
+
+      Assert::IsNull(instance.getAtlas());
+    }
+
+    //----------------------------------------------------------------------------------------------------------
+    TEST_METHOD(Font_CreateInstance_WithSameHeight_SharesAtlas)
+    {
+      MockFont font;
+      font.loadFromFile(TestResources::getArialTtfFullPath());
+
+      FontInstance instance = font.createInstance(12);
+      FontInstance secondInstance = font.createInstance(12);
+
+      Assert::IsNotNull(instance.getAtlas());
+      Assert::IsTrue(instance.getAtlas() == secondInstance.getAtlas());
+    }
+
+    //----------------------------------------------------------------------------------------------------------
+    TEST_METHOD(Font_CreateInstance_WithDifferentHeights_UsesDifferentAtlases)
+    {
+      MockFont font;
+      font.loadFromFile(TestResources::getArialTtfFullPath());
+
+      FontInstance instance = font.createInstance(12);
+      FontInstance secondInstance = font.createInstance(24);
+
+      Assert::IsNotNull(instance.getAtlas());
+      Assert::IsNotNull(secondInstance.getAtlas());
+      Assert::IsFalse(instance.getAtlas() == secondInstance.getAtlas());
+    }
+
+    //----------------------------------------------------------------------------------------------------------
+    TEST_METHOD(Font_CreateInstance_PacksEveryVisibleGlyphInsideAtlas)
+    {
+      MockFont font;
+      font.loadFromFile(TestResources::getArialTtfFullPath());
+
+      FontInstance instance = font.createInstance(12);
+      const glm::vec2& atlasDimensions = instance.getAtlas()->getDimensions();
+
+      for (char letter = 'A'; letter <= 'z'; ++letter)
+      {
+        const Character* character = instance.getCharacter(letter);
+        const glm::vec4& uvRectangle = character->m_uvRectangle;
+
+        Assert::IsTrue(uvRectangle.x >= 0 && uvRectangle.y >= 0);
+        Assert::IsTrue(uvRectangle.z <= 1 && uvRectangle.w <= 1);
+        AssertExt::AreAlmostEqual(static_cast<float>(character->m_size.x), (uvRectangle.z - uvRectangle.x) * atlasDimensions.x, 0.001f);
+        AssertExt::AreAlmostEqual(static_cast<float>(character->m_size.y), (uvRectangle.w - uvRectangle.y) * atlasDimensions.y, 0.001f);
+      }
+    }
+
 #pragma endregion
     };
   }
@@ -23,6 +23,7 @@ namespace TestCeleste::Resources
     Assert::AreEqual(0.0f, instance.getHeight());
     Assert::AreEqual((StringId)0, instance.getFontName());
     Assert::AreEqual((size_t)0, instance.getNumberOfCharacters_Public());
+    Assert::IsNull(instance.getAtlas());
   }
 
 #pragma endregion
@@ -53,11 +54,13 @@ namespace TestCeleste::Resources
 
     Assert::AreEqual(6.0f, instance.getHeight());
     Assert::AreEqual(font->getResourceId(), instance.getFontName());
+    Assert::IsNotNull(instance.getAtlas());
 
     instance.reset();
 
     Assert::AreEqual(0.0f, instance.getHeight());
     Assert::AreEqual((StringId)0, instance.getFontName());
+    Assert::IsNull(instance.getAtlas());
   }
 
 #pragma endregion
@@ -81,6 +84,23 @@ namespace TestCeleste::Resources
     Assert::IsNotNull(instance.getCharacter('a'));
   }
 
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(Font_GetCharacter_OutsideAsciiRange_ReturnsNull)
+  {
+    FontInstance instance = getResourceManager().load<Font>(TestResources::getArialTtfRelativePath())->createInstance(6);
+
+    Assert::IsNull(instance.getCharacter(static_cast<GLchar>(200)));
+  }
+
+  //----------------------------------------------------------------------------------------------------------
+  TEST_METHOD(Font_GetCharacter_SameCharacter_ReturnsSameEntry)
+  {
+    FontInstance instance = getResourceManager().load<Font>(TestResources::getArialTtfRelativePath())->createInstance(6);
+
+    Assert::IsTrue(instance.getCharacter('a') == instance.getCharacter('a'));
+    Assert::IsFalse(instance.getCharacter('a') == instance.getCharacter('b'));
+  }
+
 #pragma endregion
 
 #pragma region Measure String Tests
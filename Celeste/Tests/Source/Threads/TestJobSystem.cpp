@@ -0,0 +1,470 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+
+#include "Threads/JobSystem.h"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+
+using namespace Celeste;
+
+
+namespace TestCeleste
+{
+  CELESTE_TEST_CLASS(TestJobSystem)
+
+#pragma region Constructor Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_Constructor_SetsThreadCountToWorkerCountPlusOne)
+    {
+      JobSystem jobSystem(3);
+
+      Assert::AreEqual(static_cast<size_t>(4), jobSystem.getThreadCount());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_GetDefaultWorkerThreadCount_ReturnsAtLeastOne)
+    {
+      Assert::IsTrue(JobSystem::getDefaultWorkerThreadCount() >= 1);
+    }
+
+#pragma endregion
+
+#pragma region Get Current Thread Index Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_GetCurrentThreadIndex_CreatingThread_ReturnsZero)
+    {
+      JobSystem jobSystem(2);
+
+      Assert::AreEqual(static_cast<size_t>(0), jobSystem.getCurrentThreadIndex());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_GetCurrentThreadIndex_OtherThread_ReturnsThreadCount)
+    {
+      JobSystem jobSystem(2);
+      size_t threadIndex = 0;
+
+      std::thread otherThread([&jobSystem, &threadIndex]() { threadIndex = jobSystem.getCurrentThreadIndex(); });
+      otherThread.join();
+
+      Assert::AreEqual(jobSystem.getThreadCount(), threadIndex);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_GetCurrentThreadIndex_InsideJobs_ReturnsIndexOfExecutingThread)
+    {
+      JobSystem jobSystem(3);
+      std::vector<std::atomic<int>> threadUsage(jobSystem.getThreadCount() + 1);
+      for (std::atomic<int>& usage : threadUsage)
+      {
+        usage.store(0);
+      }
+
+      jobSystem.parallelFor(10000, 1, [&jobSystem, &threadUsage](size_t, size_t)
+      {
+        threadUsage[jobSystem.getCurrentThreadIndex()].fetch_add(1);
+      });
+
+      // Only the creating thread and the workers took part
+      Assert::AreEqual(0, threadUsage.back().load());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_GetCurrentThreadIndex_SecondJobSystemCreatedOnSameThread_BothReturnZero)
+    {
+      JobSystem first(1);
+
+      {
+        JobSystem second(1);
+
+        Assert::AreEqual(static_cast<size_t>(0), first.getCurrentThreadIndex());
+        Assert::AreEqual(static_cast<size_t>(0), second.getCurrentThreadIndex());
+      }
+
+      Assert::AreEqual(static_cast<size_t>(0), first.getCurrentThreadIndex());
+    }
+
+#pragma endregion
+
+#pragma region Work Stealing Queue Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(WorkStealingQueue_Pop_EmptyQueue_ReturnsNullptr)
+    {
+      WorkStealingQueue queue;
+
+      Assert::IsNull(queue.pop());
+      Assert::IsNull(queue.steal());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(WorkStealingQueue_PopAndSteal_TakeFromOppositeEnds)
+    {
+      WorkStealingQueue queue;
+      Job jobs[3];
+
+      Assert::IsTrue(queue.push(&jobs[0]));
+      Assert::IsTrue(queue.push(&jobs[1]));
+      Assert::IsTrue(queue.push(&jobs[2]));
+
+      Assert::IsTrue(&jobs[2] == queue.pop());
+      Assert::IsTrue(&jobs[0] == queue.steal());
+      Assert::IsTrue(&jobs[1] == queue.pop());
+      Assert::IsNull(queue.pop());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(WorkStealingQueue_Push_FullQueue_ReturnsFalse)
+    {
+      WorkStealingQueue queue;
+      Job job;
+
+      for (size_t i = 0; i < WorkStealingQueue::CAPACITY; ++i)
+      {
+        Assert::IsTrue(queue.push(&job));
+      }
+
+      Assert::IsFalse(queue.push(&job));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(WorkStealingQueue_ConcurrentPopAndSteal_EachJobTakenExactlyOnce)
+    {
+      const size_t jobCount = 2000;
+      std::vector<Job> jobs(jobCount);
+      std::vector<std::atomic<int>> takenCounts(jobCount);
+      for (std::atomic<int>& takenCount : takenCounts)
+      {
+        takenCount.store(0);
+      }
+
+      WorkStealingQueue queue;
+      std::atomic<bool> finished(false);
+
+      auto take = [&jobs, &takenCounts](Job* job)
+      {
+        if (job != nullptr)
+        {
+          takenCounts[job - jobs.data()].fetch_add(1);
+        }
+      };
+
+      std::vector<std::thread> thieves;
+      for (size_t i = 0; i < 3; ++i)
+      {
+        thieves.emplace_back([&queue, &finished, &take]()
+        {
+          while (!finished.load())
+          {
+            take(queue.steal());
+          }
+        });
+      }
+
+      for (size_t i = 0; i < jobCount; ++i)
+      {
+        while (!queue.push(&jobs[i]))
+        {
+          take(queue.pop());
+        }
+
+        if (i % 3 == 0)
+        {
+          take(queue.pop());
+        }
+      }
+
+      for (Job* job = queue.pop(); job != nullptr; job = queue.pop())
+      {
+        take(job);
+      }
+
+      finished.store(true);
+      for (std::thread& thief : thieves)
+      {
+        thief.join();
+      }
+
+      for (size_t i = 0; i < jobCount; ++i)
+      {
+        Assert::AreEqual(1, takenCounts[i].load());
+      }
+    }
+
+#pragma endregion
+
+#pragma region Run Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_RunAndWait_ExecutesJob)
+    {
+      JobSystem jobSystem(2);
+      std::atomic<int> value(0);
+
+      Job* job = jobSystem.createJob([&value]() { value.store(5); });
+      Assert::IsFalse(JobSystem::isFinished(job));
+
+      jobSystem.run(job);
+      jobSystem.wait(job);
+
+      Assert::IsTrue(JobSystem::isFinished(job));
+      Assert::AreEqual(5, value.load());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_Run_WorkerAsleep_WakesWorkerToExecuteJob)
+    {
+      JobSystem jobSystem(1);
+
+      // Give the worker time to run out of work and go to sleep
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+      std::atomic<bool> executed(false);
+      jobSystem.run(jobSystem.createJob([&executed]() { executed.store(true); }));
+
+      // We never wait on the job ourselves, so only the worker can run it
+      auto giveUpTime = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (!executed.load() && std::chrono::steady_clock::now() < giveUpTime)
+      {
+        std::this_thread::yield();
+      }
+
+      Assert::IsTrue(executed.load());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_RunAndWait_NoWorkerThreads_ExecutesJobOnWaitingThread)
+    {
+      JobSystem jobSystem(0);
+      std::thread::id executingThread;
+
+      Job* job = jobSystem.createJob([&executingThread]() { executingThread = std::this_thread::get_id(); });
+      jobSystem.run(job);
+      jobSystem.wait(job);
+
+      Assert::IsTrue(std::this_thread::get_id() == executingThread);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_Wait_ParentJob_WaitsForAllChildren)
+    {
+      JobSystem jobSystem(3);
+      std::atomic<int> childCount(0);
+
+      Job* parent = jobSystem.createJob([]() {});
+      for (int i = 0; i < 100; ++i)
+      {
+        jobSystem.run(jobSystem.createJob([&childCount]() { childCount.fetch_add(1); }, parent));
+      }
+
+      jobSystem.run(parent);
+      jobSystem.wait(parent);
+
+      Assert::AreEqual(100, childCount.load());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_Wait_NestedChildren_WaitsForGrandchildren)
+    {
+      JobSystem jobSystem(3);
+      std::atomic<int> grandchildCount(0);
+      JobSystem* jobSystemPtr = &jobSystem;
+      std::atomic<int>* grandchildCountPtr = &grandchildCount;
+
+      Job* root = jobSystem.createJob([]() {});
+      for (int i = 0; i < 10; ++i)
+      {
+        Job* child = jobSystem.createJob([]() {}, root);
+        jobSystem.run(jobSystem.createJob([jobSystemPtr, grandchildCountPtr, child]()
+        {
+          for (int j = 0; j < 10; ++j)
+          {
+            jobSystemPtr->run(jobSystemPtr->createJob([grandchildCountPtr]() { grandchildCountPtr->fetch_add(1); }, child));
+          }
+        }, child));
+        jobSystem.run(child);
+      }
+
+      jobSystem.run(root);
+      jobSystem.wait(root);
+
+      Assert::AreEqual(100, grandchildCount.load());
+    }
+
+#pragma endregion
+
+#pragma region Continuation Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_AddContinuation_RunsContinuationAfterJobFinishes)
+    {
+      JobSystem jobSystem(2);
+      std::atomic<int> value(0);
+      std::atomic<bool> continuationSawValue(false);
+
+      Job* job = jobSystem.createJob([&value]() { value.store(10); });
+      Job* continuation = jobSystem.createJob([&value, &continuationSawValue]() { continuationSawValue.store(value.load() == 10); });
+      jobSystem.addContinuation(job, continuation);
+
+      jobSystem.run(job);
+      jobSystem.wait(continuation);
+
+      Assert::IsTrue(continuationSawValue.load());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_AddContinuation_JobWithChildren_RunsContinuationAfterChildrenFinish)
+    {
+      JobSystem jobSystem(3);
+      std::atomic<int> childCount(0);
+      std::atomic<int> countSeenByContinuation(-1);
+
+      Job* parent = jobSystem.createJob([]() {});
+      for (int i = 0; i < 50; ++i)
+      {
+        jobSystem.run(jobSystem.createJob([&childCount]() { childCount.fetch_add(1); }, parent));
+      }
+
+      Job* continuation = jobSystem.createJob([&childCount, &countSeenByContinuation]() { countSeenByContinuation.store(childCount.load()); });
+      jobSystem.addContinuation(parent, continuation);
+
+      jobSystem.run(parent);
+      jobSystem.wait(continuation);
+
+      Assert::AreEqual(50, countSeenByContinuation.load());
+    }
+
+#pragma endregion
+
+#pragma region Parallel For Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_ParallelFor_ZeroCount_DoesNotCallFunction)
+    {
+      JobSystem jobSystem(2);
+      std::atomic<int> callCount(0);
+
+      jobSystem.parallelFor(0, 1, [&callCount](size_t, size_t) { callCount.fetch_add(1); });
+
+      Assert::AreEqual(0, callCount.load());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_ParallelFor_CountLessThanBatchSize_RunsInlineAsSingleBatch)
+    {
+      JobSystem jobSystem(2);
+      std::vector<std::pair<size_t, size_t>> batches;
+
+      jobSystem.parallelFor(10, 64, [&batches](size_t begin, size_t end) { batches.emplace_back(begin, end); });
+
+      Assert::AreEqual(static_cast<size_t>(1), batches.size());
+      Assert::AreEqual(static_cast<size_t>(0), batches[0].first);
+      Assert::AreEqual(static_cast<size_t>(10), batches[0].second);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_ParallelFor_VisitsEveryIndexExactlyOnce)
+    {
+      JobSystem jobSystem(3);
+      std::vector<std::atomic<int>> visitCounts(10000);
+      for (std::atomic<int>& visitCount : visitCounts)
+      {
+        visitCount.store(0);
+      }
+
+      jobSystem.parallelFor(visitCounts.size(), 16, [&visitCounts](size_t begin, size_t end)
+      {
+        for (size_t i = begin; i < end; ++i)
+        {
+          visitCounts[i].fetch_add(1);
+        }
+      });
+
+      for (const std::atomic<int>& visitCount : visitCounts)
+      {
+        Assert::AreEqual(1, visitCount.load());
+      }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_ParallelFor_CalledFromAnotherThread_VisitsEveryIndexExactlyOnce)
+    {
+      JobSystem jobSystem(2);
+      std::atomic<size_t> sum(0);
+
+      std::thread otherThread([&jobSystem, &sum]()
+      {
+        jobSystem.parallelFor(1000, 10, [&sum](size_t begin, size_t end)
+        {
+          for (size_t i = begin; i < end; ++i)
+          {
+            sum.fetch_add(i);
+          }
+        });
+      });
+      otherThread.join();
+
+      Assert::AreEqual(static_cast<size_t>(999 * 1000 / 2), sum.load());
+    }
+
+#pragma endregion
+
+#pragma region Parallel For Each Tests
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_ParallelForEach_ResizeableAllocator_VisitsOnlyAllocatedObjects)
+    {
+      JobSystem jobSystem(3);
+      ResizeableAllocator<int> allocator(100);
+      std::vector<int*> objects;
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        objects.push_back(allocator.allocate());
+        *objects.back() = 0;
+      }
+
+      for (size_t i = 0; i < objects.size(); i += 3)
+      {
+        allocator.deallocate(*objects[i]);
+      }
+
+      jobSystem.parallelForEach(allocator, [](int& object) { ++object; }, 1);
+
+      for (size_t i = 0; i < objects.size(); ++i)
+      {
+        if (i % 3 != 0)
+        {
+          Assert::AreEqual(1, *objects[i]);
+        }
+      }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(JobSystem_ParallelForEach_DenseAllocator_VisitsEveryAllocatedObject)
+    {
+      JobSystem jobSystem(3);
+      DenseAllocator<int> allocator(100);
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        *allocator.allocate() = 0;
+      }
+
+      jobSystem.parallelForEach(allocator, [](int& object) { ++object; }, 1);
+
+      // Growing moves the objects, so check them where they are now rather than through the pointers allocate returned
+      for (size_t i = 0; i < allocator.size(); ++i)
+      {
+        Assert::AreEqual(1, allocator[i]);
+      }
+    }
+
+#pragma endregion
+
+  };
+}
@@ -202,5 +202,92 @@ namespace TestCeleste
 
       Assert::AreEqual(0.0f, clock.getElapsedDeltaTime());
     }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(Clock_Constructor_SetsMaxSubstepsToDefault_AndLagToZero)
+    {
+      Clock clock;
+
+      Assert::AreEqual(static_cast<size_t>(DEFAULT_MAX_SUBSTEPS), clock.getMaxSubsteps());
+      Assert::AreEqual(0.0f, clock.getLag());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(Clock_ConsumeFixedSteps_LessThanOneStepElapsed_ReturnsZero_AndAccumulatesLag)
+    {
+      Clock clock(10);
+
+      clock.update(0.04f);
+
+      Assert::AreEqual(static_cast<size_t>(0), clock.consumeFixedSteps());
+      AssertExt::AreAlmostEqual(0.04f, clock.getLag());
+
+      clock.update(0.04f);
+
+      Assert::AreEqual(static_cast<size_t>(0), clock.consumeFixedSteps());
+      AssertExt::AreAlmostEqual(0.08f, clock.getLag());
+
+      clock.update(0.04f);
+
+      Assert::AreEqual(static_cast<size_t>(1), clock.consumeFixedSteps());
+      AssertExt::AreAlmostEqual(0.02f, clock.getLag());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(Clock_ConsumeFixedSteps_SeveralStepsElapsed_ReturnsStepCount_AndKeepsRemainder)
+    {
+      Clock clock(10);
+
+      clock.update(0.35f);
+
+      Assert::AreEqual(static_cast<size_t>(3), clock.consumeFixedSteps());
+      AssertExt::AreAlmostEqual(0.05f, clock.getLag());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(Clock_ConsumeFixedSteps_MoreStepsThanMaxSubsteps_ReturnsMaxSubsteps_AndDropsExtraTime)
+    {
+      Clock clock(10);
+      clock.setMaxSubsteps(2);
+
+      clock.update(0.55f);
+
+      Assert::AreEqual(static_cast<size_t>(2), clock.consumeFixedSteps());
+      AssertExt::AreAlmostEqual(0.05f, clock.getLag());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(Clock_ConsumeFixedSteps_UsesScaledTime)
+    {
+      Clock clock(10);
+      clock.setTimeScale(0.5f);
+
+      clock.update(0.4f);
+
+      Assert::AreEqual(static_cast<size_t>(2), clock.consumeFixedSteps());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(Clock_ConsumeFixedSteps_WhenPaused_ReturnsZero)
+    {
+      Clock clock(10);
+      clock.update(0.5f);
+      clock.setPaused(true);
+
+      Assert::AreEqual(static_cast<size_t>(0), clock.consumeFixedSteps());
+      Assert::AreEqual(0.0f, clock.getLag());
+    }
+
+    //------------------------------------------------------------------------------------------------
+    TEST_METHOD(Clock_Reset_ResetsLag)
+    {
+      Clock clock(10);
+      clock.update(0.05f);
+      clock.consumeFixedSteps();
+
+      clock.reset();
+
+      Assert::AreEqual(0.0f, clock.getLag());
+    }
   };
 }
\ No newline at end of file
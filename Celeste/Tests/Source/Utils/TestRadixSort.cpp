@@ -0,0 +1,52 @@
+#include "TestUtils/UtilityHeaders/UnitTestHeaders.h"
+#include "Utils/RadixSort.h"
+
+using namespace Celeste;
+
+
+namespace TestCeleste
+{
+  CELESTE_TEST_CLASS(TestRadixSort)
+
+#pragma region Radix Sort Tests
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(RadixSort_EmptyInput_DoesNothing)
+  {
+    std::vector<uint64_t> items, scratch;
+    radixSort(items, scratch, [](uint64_t item) { return item; });
+
+    Assert::IsTrue(items.empty());
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(RadixSort_SortsByKeyAcrossEveryByte)
+  {
+    std::vector<uint64_t> items { 0xFF00000000000000, 3, 0x0000000100000000, 0, 0x00000000FFFFFFFF, 2 };
+    std::vector<uint64_t> scratch;
+
+    radixSort(items, scratch, [](uint64_t item) { return item; });
+
+    std::vector<uint64_t> expected { 0, 2, 3, 0x00000000FFFFFFFF, 0x0000000100000000, 0xFF00000000000000 };
+    Assert::IsTrue(expected == items);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  TEST_METHOD(RadixSort_EqualKeys_KeepInputOrder)
+  {
+    std::vector<std::pair<uint64_t, int>> items { { 5, 0 }, { 1, 1 }, { 5, 2 }, { 1, 3 }, { 5, 4 } };
+    std::vector<std::pair<uint64_t, int>> scratch;
+
+    radixSort(items, scratch, [](const std::pair<uint64_t, int>& item) { return item.first; });
+
+    Assert::AreEqual(1, items[0].second);
+    Assert::AreEqual(3, items[1].second);
+    Assert::AreEqual(0, items[2].second);
+    Assert::AreEqual(2, items[3].second);
+    Assert::AreEqual(4, items[4].second);
+  }
+
+#pragma endregion
+
+  };
+}
@@ -3,6 +3,8 @@
 #include "StaticLibExport.h"
 #include "Physics/Collider.h"
 
+#include <limits>
+
 
 namespace Celeste::Maths
 {
@@ -25,6 +27,14 @@ namespace CelesteMocks
     public:
       glm::vec2 getCentre() const { return glm::vec2(); }
 
+      /// Defaults to infinite bounds, so the broadphase always passes this collider on to the intersects functions
+      Celeste::Physics::AABB getBounds() const override { return m_bounds; }
+      void setBounds(const Celeste::Physics::AABB& bounds) { m_bounds = bounds; }
+
+      /// Defaults to a degenerate shape, so this collider never intersects other colliders
+      Celeste::Physics::CollisionShape getShape() const override { return m_shape; }
+      void setShape(const Celeste::Physics::CollisionShape& shape) { m_shape = shape; }
+
       void setIntersectsRayResult(bool intersectsRay) { m_intersectsRayResult = intersectsRay; }
       void setIntersectsPointResult(bool intersectsPoint) { m_intersectsPointResult = intersectsPoint; }
       void setIntersectsRectangleResult(bool intersectsRectangle) { m_intersectsRectangleResult = intersectsRectangle; }
@@ -56,5 +66,7 @@ namespace CelesteMocks
       bool m_intersectsPointResult = false;
       bool m_intersectsRectangleResult = false;
       bool m_intersectsEllipseResult = false;
+      Celeste::Physics::AABB m_bounds = Celeste::Physics::AABB(glm::vec2(-std::numeric_limits<float>::infinity()), glm::vec2(std::numeric_limits<float>::infinity()));
+      Celeste::Physics::CollisionShape m_shape = Celeste::Physics::CollisionShape::box(glm::vec2(), glm::vec2());
   };
 }
\ No newline at end of file
@@ -10,6 +10,8 @@ class MockSpriteBatch : public Celeste::Rendering::SpriteBatch
 {
   public:
     size_t renderers_size_Public() const { return renderers_size(); }
+    const glm::mat4& getRenderMatrix_Public(size_t index) const { return getRenderMatrix(index); }
+    const Celeste::Rendering::SpriteInstance& getInstance_Public(size_t index) const { return getInstance(index); }
 };
 
 }
\ No newline at end of file